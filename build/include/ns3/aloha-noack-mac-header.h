@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/model/aloha-noack-mac-header.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/lte-rlc-sdu-status-tag.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/helper/lte-stats-writer.h"
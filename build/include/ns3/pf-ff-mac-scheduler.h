@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/pf-ff-mac-scheduler.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/rem-spectrum-phy.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/tdtbfq-ff-mac-scheduler.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/applications/model/three-gpp-http-header.h"
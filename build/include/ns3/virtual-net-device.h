@@ -0,0 +1 @@
+#include "/root/repo/src/virtual-net-device/model/virtual-net-device.h"
@@ -85,6 +85,15 @@ OnOffApplication::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&OnOffApplication::m_enableSeqTsSizeHeader),
                           MakeBooleanChecker())
+            .AddAttribute("TrafficSchedule",
+                          "The TrafficSchedule driving the transmissions of the application, "
+                          "if any. If null, the application schedules an event per packet. "
+                          "The send times are computed in batches, hence a change of the "
+                          "DataRate or PacketSize while the application is running only "
+                          "applies after the current batch.",
+                          PointerValue(),
+                          MakePointerAccessor(&OnOffApplication::m_schedule),
+                          MakePointerChecker<TrafficSchedule>())
             .AddTraceSource("Tx",
                             "A new packet is created and is sent",
                             MakeTraceSourceAccessor(&OnOffApplication::m_txTrace),
@@ -141,6 +150,9 @@ OnOffApplication::AssignStreams(int64_t stream)
     auto currentStream = stream;
     m_onTime->SetStream(currentStream++);
     m_offTime->SetStream(currentStream++);
+    // discard the values drawn in advance from the previous streams
+    m_onTimes.clear();
+    m_offTimes.clear();
     currentStream += Application::AssignStreams(currentStream);
     return (currentStream - stream);
 }
@@ -151,6 +163,8 @@ OnOffApplication::DoDispose()
     NS_LOG_FUNCTION(this);
 
     CancelEvents();
+    StopScheduledFlow();
+    m_schedule = nullptr;
     m_socket = nullptr;
     m_unsentPacket = nullptr;
     // chain up
@@ -230,6 +244,7 @@ OnOffApplication::StopApplication() // Called at time specified by Stop
     NS_LOG_FUNCTION(this);
 
     CancelEvents();
+    StopScheduledFlow();
     if (m_socket)
     {
         m_socket->Close();
@@ -245,7 +260,7 @@ OnOffApplication::CancelEvents()
 {
     NS_LOG_FUNCTION(this);
 
-    if (m_sendEvent.IsPending() && m_cbrRateFailSafe == m_cbrRate)
+    if ((m_sendEvent.IsPending() || m_scheduledSendPending) && m_cbrRateFailSafe == m_cbrRate)
     { // Cancel the pending send packet event
         // Calculate residual bits since last packet sent
         Time delta(Simulator::Now() - m_lastStartTime);
@@ -253,6 +268,7 @@ OnOffApplication::CancelEvents()
         m_residualBits += bits.GetHigh();
     }
     m_cbrRateFailSafe = m_cbrRate;
+    m_scheduledSendPending = false;
     Simulator::Cancel(m_sendEvent);
     Simulator::Cancel(m_startStopEvent);
     // Canceling events may cause discontinuity in sequence number if the
@@ -292,6 +308,11 @@ OnOffApplication::ScheduleNextTx()
 
     if (m_maxBytes == 0 || m_totBytes < m_maxBytes)
     {
+        if (m_schedule)
+        { // The send time has been computed by ComputeBatch
+            m_scheduledSendPending = true;
+            return;
+        }
         NS_ABORT_MSG_IF(m_residualBits > m_pktSize * 8,
                         "Calculation to compute next send time will overflow");
         uint32_t bits = m_pktSize * 8 - m_residualBits;
@@ -312,6 +333,12 @@ OnOffApplication::ScheduleStartEvent()
 { // Schedules the event to start sending data (switch to the "On" state)
     NS_LOG_FUNCTION(this);
 
+    if (m_schedule)
+    {
+        StartScheduledFlow();
+        return;
+    }
+
     Time offInterval = Seconds(m_offTime->GetValue());
     NS_LOG_LOGIC("start at " << offInterval.As(Time::S));
     m_startStopEvent = Simulator::Schedule(offInterval, &OnOffApplication::StartSending, this);
@@ -413,4 +440,140 @@ OnOffApplication::ConnectionFailed(Ptr<Socket> socket)
     NS_FATAL_ERROR("Can't connect");
 }
 
+void
+OnOffApplication::StartScheduledFlow()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_flowId)
+    {
+        m_flowId = m_schedule->AddFlow(MakeCallback(&OnOffApplication::RunScheduledAction, this),
+                                       MakeCallback(&OnOffApplication::ComputeBatch, this));
+    }
+    StopScheduledFlow();
+    m_batch = BatchState();
+    m_batch.residualBits = m_residualBits;
+    m_batch.nextStart = Simulator::Now() + Seconds(DrawPeriod(m_offTime, m_offTimes));
+    m_schedule->StartFlow(*m_flowId);
+}
+
+void
+OnOffApplication::StopScheduledFlow()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_schedule && m_flowId)
+    {
+        m_schedule->StopFlow(*m_flowId);
+    }
+    // A stand-alone application would not have drawn the durations of the periods
+    // following the transitions not executed yet: put them back, in order
+    while (!m_actions.empty())
+    {
+        const ScheduledAction& action = m_actions.back();
+        if (action.type == ScheduledActionType::START_SENDING)
+        {
+            m_onTimes.push_front(action.period);
+        }
+        else if (action.type == ScheduledActionType::STOP_SENDING)
+        {
+            m_offTimes.push_front(action.period);
+        }
+        m_actions.pop_back();
+    }
+}
+
+double
+OnOffApplication::DrawPeriod(Ptr<RandomVariableStream> rng, std::deque<double>& values)
+{
+    if (values.empty())
+    {
+        for (uint32_t i = 0; i < m_schedule->GetBatchSize(); i++)
+        {
+            values.push_back(rng->GetValue());
+        }
+    }
+    double value = values.front();
+    values.pop_front();
+    return value;
+}
+
+void
+OnOffApplication::ComputeBatch(std::vector<Time>& times)
+{
+    NS_LOG_FUNCTION(this);
+
+    const uint32_t batchSize = m_schedule->GetBatchSize();
+    const uint64_t rate = m_cbrRate.GetBitRate();
+
+    while (times.size() < batchSize)
+    {
+        if (!m_batch.on)
+        { // See StartSending, ScheduleNextTx and ScheduleStopEvent
+            m_batch.on = true;
+            m_batch.first = true;
+            m_batch.lastStart = m_batch.nextStart;
+            NS_ABORT_MSG_IF(m_batch.residualBits > m_pktSize * 8,
+                            "Calculation to compute next send time will overflow");
+            uint32_t bits = m_pktSize * 8 - m_batch.residualBits;
+            m_batch.nextTx = m_batch.nextStart + Seconds(bits / static_cast<double>(rate));
+            double onTime = DrawPeriod(m_onTime, m_onTimes);
+            m_batch.stop = m_batch.nextStart + Seconds(onTime);
+            times.push_back(m_batch.nextStart);
+            m_actions.push_back({ScheduledActionType::START_SENDING, onTime});
+        }
+        else if (m_batch.nextTx < m_batch.stop ||
+                 (m_batch.first && m_batch.nextTx == m_batch.stop))
+        {
+            // See SendPacket and ScheduleNextTx. The stop event is scheduled after the
+            // first send event of the On period and before the following ones, hence
+            // only the first send may happen at the end of the On period
+            Time now = m_batch.nextTx;
+            m_batch.first = false;
+            m_batch.lastStart = now;
+            m_batch.residualBits = 0;
+            m_batch.nextTx = now + Seconds(m_pktSize * 8 / static_cast<double>(rate));
+            times.push_back(now);
+            m_actions.push_back({ScheduledActionType::SEND_PACKET, 0});
+        }
+        else
+        { // See StopSending, CancelEvents and ScheduleStartEvent
+            m_batch.on = false;
+            Time delta(m_batch.stop - m_batch.lastStart);
+            int64x64_t bits = delta.To(Time::S) * rate;
+            m_batch.residualBits += bits.GetHigh();
+            double offTime = DrawPeriod(m_offTime, m_offTimes);
+            m_batch.nextStart = m_batch.stop + Seconds(offTime);
+            times.push_back(m_batch.stop);
+            m_actions.push_back({ScheduledActionType::STOP_SENDING, offTime});
+        }
+    }
+}
+
+void
+OnOffApplication::RunScheduledAction()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_actions.empty());
+
+    ScheduledActionType type = m_actions.front().type;
+    m_actions.pop_front();
+
+    switch (type)
+    {
+    case ScheduledActionType::START_SENDING:
+        m_lastStartTime = Simulator::Now();
+        ScheduleNextTx();
+        m_state = true;
+        break;
+    case ScheduledActionType::SEND_PACKET:
+        SendPacket();
+        break;
+    case ScheduledActionType::STOP_SENDING:
+        CancelEvents();
+        m_state = false;
+        break;
+    }
+}
+
 } // Namespace ns3
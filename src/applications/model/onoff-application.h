@@ -15,6 +15,7 @@
 
 #include "seq-ts-size-header.h"
 #include "source-application.h"
+#include "traffic-schedule.h"
 
 #include "ns3/data-rate.h"
 #include "ns3/event-id.h"
@@ -22,6 +23,10 @@
 #include "ns3/traced-callback.h"
 #include "ns3/traced-value.h"
 
+#include <deque>
+#include <optional>
+#include <vector>
+
 namespace ns3
 {
 
@@ -80,6 +85,16 @@ class Socket;
  * (enable its "EnableSeqTsSizeHeader" attribute), or users may extract
  * the header via trace sources.  Note that the continuity of the sequence
  * number may be disrupted across On/Off cycles.
+ *
+ * If the "TrafficSchedule" attribute is set, the application does not schedule
+ * an event per packet and per On/Off period. Instead, it computes its send times
+ * and the start and end times of its On periods in batches and the transitions
+ * are driven by the given TrafficSchedule. The send times are the same as those
+ * of a stand-alone application, as long as the DataRate and PacketSize attributes
+ * are not changed while the application is running: in this mode, a change only
+ * applies to the send times computed after it, i.e., after the current batch.
+ * The OnTime and OffTime random variables are drawn in bulk, hence they must not
+ * be shared with other objects for the send times to be the same.
  */
 class OnOffApplication : public SourceApplication
 {
@@ -191,6 +206,70 @@ class OnOffApplication : public SourceApplication
      */
     void ConnectionFailed(Ptr<Socket> socket);
 
+    /**
+     * @brief Start computing the transitions of the application, and have them
+     *        driven by the traffic schedule
+     */
+    void StartScheduledFlow();
+    /**
+     * @brief Stop the flow of the application in the traffic schedule, if any
+     */
+    void StopScheduledFlow();
+    /**
+     * @brief Compute the next batch of transition times of the application, in
+     *        the same way as the event handlers of a stand-alone application
+     * @param times the vector to fill with the transition times
+     */
+    void ComputeBatch(std::vector<Time>& times);
+    /**
+     * @brief Execute the next transition computed by ComputeBatch
+     */
+    void RunScheduledAction();
+    /**
+     * @brief Get the next duration of an On or Off period, drawing values in bulk
+     * @param rng the random variable stream of the period
+     * @param values the values already drawn from the random variable stream
+     * @return the duration of the period
+     */
+    double DrawPeriod(Ptr<RandomVariableStream> rng, std::deque<double>& values);
+
+    /// Type of the transitions of the application computed in advance
+    enum class ScheduledActionType : uint8_t
+    {
+        START_SENDING, //!< start of an On period
+        SEND_PACKET,   //!< packet transmission
+        STOP_SENDING,  //!< start of an Off period
+    };
+
+    /// Transition of the application computed in advance
+    struct ScheduledAction
+    {
+        ScheduledActionType type; //!< the type of transition
+        /// The duration of the following On (for a start) or Off (for a stop) period, which
+        /// a stand-alone application draws when executing the transition
+        double period;
+    };
+
+    /// State of the computation of the transitions of the application
+    struct BatchState
+    {
+        bool on{false};           //!< whether the computation is in an On period
+        bool first{false};        //!< whether the next send is the first of the On period
+        Time nextStart;           //!< the start of the next On period
+        Time nextTx;              //!< the next send time in the On period
+        Time stop;                //!< the end of the On period
+        Time lastStart;           //!< the time of the last start or send
+        uint32_t residualBits{0}; //!< the residual bits at the time of the last transition
+    };
+
+    Ptr<TrafficSchedule> m_schedule;       //!< Schedule driving the transitions, if any
+    std::optional<uint32_t> m_flowId;      //!< Flow of the application in the schedule
+    std::deque<ScheduledAction> m_actions; //!< Computed transitions not executed yet
+    BatchState m_batch;                    //!< State of the computation of the transitions
+    std::deque<double> m_onTimes;          //!< Values drawn in advance from m_onTime
+    std::deque<double> m_offTimes;         //!< Values drawn in advance from m_offTime
+    bool m_scheduledSendPending{false};    //!< Whether a send is pending in the schedule
+
     TracedValue<bool> m_state; //!< State of application (0-OFF, 1-ON)
 };
 
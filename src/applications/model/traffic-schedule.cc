@@ -0,0 +1,250 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "traffic-schedule.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TrafficSchedule");
+
+NS_OBJECT_ENSURE_REGISTERED(TrafficSchedule);
+
+TypeId
+TrafficSchedule::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TrafficSchedule")
+            .SetParent<Object>()
+            .SetGroupName("Applications")
+            .AddConstructor<TrafficSchedule>()
+            .AddAttribute("BatchSize",
+                          "The maximum number of send times computed at once for a flow",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&TrafficSchedule::m_batchSize),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+TrafficSchedule::TrafficSchedule()
+    : m_seq(0),
+      m_eventGeneration(0),
+      m_eventPending(false),
+      m_eventContext(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TrafficSchedule::~TrafficSchedule()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TrafficSchedule::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_event);
+    // invalidate the scheduled events that could not be cancelled
+    m_eventGeneration++;
+    m_eventPending = false;
+    m_flows.clear();
+    m_heap = decltype(m_heap)();
+    Object::DoDispose();
+}
+
+uint32_t
+TrafficSchedule::GetBatchSize() const
+{
+    return m_batchSize;
+}
+
+uint32_t
+TrafficSchedule::AddFlow(ActionCallback action, BatchCallback batch)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(!action.IsNull() && !batch.IsNull(), "Flows need non-null callbacks");
+
+    m_flows.push_back({action, batch});
+    return m_flows.size() - 1;
+}
+
+void
+TrafficSchedule::StartFlow(uint32_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+    NS_ASSERT_MSG(flowId < m_flows.size(), "Unknown flow " << flowId);
+
+    Flow& flow = m_flows[flowId];
+    flow.generation++;
+    flow.running = true;
+    flow.context = Simulator::GetContext();
+    flow.times.clear();
+    flow.next = 0;
+    Push(flowId);
+    Reschedule();
+}
+
+void
+TrafficSchedule::StopFlow(uint32_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+
+    // flows are removed when the schedule is disposed of
+    if (flowId >= m_flows.size() || !m_flows[flowId].running)
+    {
+        return;
+    }
+
+    Flow& flow = m_flows[flowId];
+    flow.generation++;
+    flow.running = false;
+    flow.times.clear();
+    flow.next = 0;
+    Reschedule();
+}
+
+bool
+TrafficSchedule::IsRunning(uint32_t flowId) const
+{
+    return flowId < m_flows.size() && m_flows[flowId].running;
+}
+
+bool
+TrafficSchedule::IsStale(const Entry& entry) const
+{
+    return entry.generation != m_flows[entry.flowId].generation;
+}
+
+void
+TrafficSchedule::Push(uint32_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+
+    Flow& flow = m_flows[flowId];
+
+    if (flow.next == flow.times.size())
+    {
+        flow.times.clear();
+        flow.next = 0;
+        flow.batch(flow.times);
+
+        if (flow.times.empty())
+        {
+            NS_LOG_LOGIC("Flow " << flowId << " ended");
+            flow.generation++;
+            flow.running = false;
+            return;
+        }
+    }
+
+    NS_ASSERT_MSG(flow.times[flow.next] >= Simulator::Now(),
+                  "Send time " << flow.times[flow.next].As(Time::S) << " of flow " << flowId
+                               << " is in the past");
+    m_heap.push({flow.times[flow.next], m_seq++, flowId, flow.generation});
+}
+
+void
+TrafficSchedule::Reschedule()
+{
+    NS_LOG_FUNCTION(this);
+
+    while (!m_heap.empty() && IsStale(m_heap.top()))
+    {
+        m_heap.pop();
+    }
+
+    if (m_heap.empty())
+    {
+        Simulator::Cancel(m_event);
+        m_eventGeneration++;
+        m_eventPending = false;
+        return;
+    }
+
+    const Entry& top = m_heap.top();
+    uint32_t context = m_flows[top.flowId].context;
+
+    if (m_eventPending && m_eventTime == top.time && m_eventContext == context)
+    {
+        return;
+    }
+
+    // Events scheduled in another context cannot be cancelled, hence the
+    // generation number allowing Run to discard the superseded events
+    Simulator::Cancel(m_event);
+    m_eventGeneration++;
+    m_eventPending = true;
+    m_eventTime = top.time;
+    m_eventContext = context;
+
+    Ptr<TrafficSchedule> self(this);
+    if (context == Simulator::GetContext())
+    {
+        m_event = Simulator::Schedule(top.time - Simulator::Now(),
+                                      &TrafficSchedule::Run,
+                                      self,
+                                      m_eventGeneration);
+    }
+    else
+    {
+        m_event = EventId();
+        Simulator::ScheduleWithContext(context,
+                                       top.time - Simulator::Now(),
+                                       &TrafficSchedule::Run,
+                                       self,
+                                       m_eventGeneration);
+    }
+}
+
+void
+TrafficSchedule::Run(uint32_t generation)
+{
+    NS_LOG_FUNCTION(this << generation);
+
+    if (generation != m_eventGeneration)
+    {
+        NS_LOG_LOGIC("Superseded event");
+        return;
+    }
+    m_eventPending = false;
+
+    const Time now = Simulator::Now();
+    const uint32_t context = Simulator::GetContext();
+
+    while (!m_heap.empty())
+    {
+        const Entry entry = m_heap.top();
+
+        if (IsStale(entry))
+        {
+            m_heap.pop();
+            continue;
+        }
+        if (entry.time != now || m_flows[entry.flowId].context != context)
+        {
+            break;
+        }
+
+        m_heap.pop();
+        m_flows[entry.flowId].next++;
+        // the action may add flows and hence reallocate m_flows
+        ActionCallback action = m_flows[entry.flowId].action;
+        action();
+
+        // the action may have stopped or restarted the flow
+        if (!IsStale(entry))
+        {
+            Push(entry.flowId);
+        }
+    }
+
+    Reschedule();
+}
+
+} // namespace ns3
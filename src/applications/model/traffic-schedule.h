@@ -0,0 +1,186 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef TRAFFIC_SCHEDULE_H
+#define TRAFFIC_SCHEDULE_H
+
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup applications
+ *
+ * @brief Drive the transmissions of many traffic generators with at most one
+ * pending simulator event
+ *
+ * Traffic generators that can compute their send times in advance (e.g.,
+ * OnOffApplication, UdpClient and UdpEchoClient) can be attached to a
+ * TrafficSchedule through their "TrafficSchedule" attribute. Rather than
+ * scheduling a simulator event per packet, an attached application registers
+ * a flow, which provides its send times in batches (drawing its random variables
+ * in bulk), and the TrafficSchedule keeps the next send time of each of its flows
+ * in a single heap. Only the earliest send time of all the flows is scheduled
+ * in the simulator, hence the simulator holds at most one event of the
+ * TrafficSchedule instead of one per application. An event is still processed
+ * for each distinct send time and context: the event serves the flows due at
+ * its time in its context, and then schedules the next earliest send time.
+ *
+ * The send times of an application are the same whether or not it is attached
+ * to a TrafficSchedule. The actions of a flow are executed in the context in
+ * which the flow was started, i.e., the context of the node of the application.
+ * Actions due at the same time are executed in the order in which they were
+ * computed, but their order with respect to other simulator events scheduled
+ * for the same time may differ from the one of the events scheduled by a
+ * stand-alone application.
+ */
+class TrafficSchedule : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TrafficSchedule();
+    ~TrafficSchedule() override;
+
+    /**
+     * Callback invoked at each send time of a flow.
+     */
+    typedef Callback<void> ActionCallback;
+
+    /**
+     * Callback invoked to get the next batch of send times of a flow. The callback
+     * has to append to the given (empty) vector up to GetBatchSize () absolute times,
+     * in non-decreasing order and not earlier than the times previously provided.
+     * Appending no time ends the flow.
+     */
+    typedef Callback<void, std::vector<Time>&> BatchCallback;
+
+    /**
+     * @brief Register a flow
+     *
+     * @param action the callback invoked at each send time of the flow
+     * @param batch the callback invoked to get the next send times of the flow
+     * @return the identifier of the flow
+     */
+    uint32_t AddFlow(ActionCallback action, BatchCallback batch);
+
+    /**
+     * @brief Start a flow in the current context
+     *
+     * The batch callback of the flow is invoked right away to get its first
+     * send times. Starting a running flow restarts it.
+     *
+     * @param flowId the identifier of the flow
+     */
+    void StartFlow(uint32_t flowId);
+
+    /**
+     * @brief Stop a flow
+     *
+     * The send times of the flow that have been computed and not executed yet
+     * are discarded. Stopping a flow that is not running has no effect.
+     *
+     * @param flowId the identifier of the flow
+     */
+    void StopFlow(uint32_t flowId);
+
+    /**
+     * @brief Check whether a flow is running
+     *
+     * @param flowId the identifier of the flow
+     * @return true if the flow has been started and has not ended yet
+     */
+    bool IsRunning(uint32_t flowId) const;
+
+    /**
+     * @brief Get the maximum number of send times computed per batch
+     * @return the maximum number of send times computed per batch
+     */
+    uint32_t GetBatchSize() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * @brief Serve the flows whose next send time is now, in the current context
+     * @param generation the generation of the scheduled event
+     */
+    void Run(uint32_t generation);
+
+    /**
+     * @brief Insert the next send time of a flow in the heap, computing a new
+     *        batch of send times if needed
+     * @param flowId the identifier of the flow
+     */
+    void Push(uint32_t flowId);
+
+    /**
+     * @brief Make sure that the earliest send time in the heap is scheduled
+     */
+    void Reschedule();
+
+    /// Flow driven by the schedule
+    struct Flow
+    {
+        ActionCallback action;   //!< callback invoked at each send time
+        BatchCallback batch;     //!< callback providing the next send times
+        std::vector<Time> times; //!< send times of the current batch
+        std::size_t next{0};     //!< index of the next send time in the current batch
+        uint32_t context{0};     //!< context in which the flow was started
+        uint32_t generation{0};  //!< incremented every time the flow is started or stopped
+        bool running{false};     //!< whether the flow is running
+    };
+
+    /// Heap entry, holding the next send time of a flow
+    struct Entry
+    {
+        Time time;           //!< the send time
+        uint64_t seq;        //!< insertion order, to break ties between equal send times
+        uint32_t flowId;     //!< the identifier of the flow
+        uint32_t generation; //!< the generation of the flow when the entry was inserted
+
+        /**
+         * @param other the entry to compare with
+         * @return true if this entry has to be served after the given entry
+         */
+        bool operator>(const Entry& other) const
+        {
+            return time > other.time || (time == other.time && seq > other.seq);
+        }
+    };
+
+    /**
+     * @param entry the heap entry
+     * @return true if the entry has been invalidated by a start or stop of its flow
+     */
+    bool IsStale(const Entry& entry) const;
+
+    std::vector<Flow> m_flows; //!< the flows driven by the schedule
+    /// min-heap of the next send times of the running flows
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> m_heap;
+    uint32_t m_batchSize;       //!< maximum number of send times computed per batch
+    uint64_t m_seq;             //!< sequence number of the next heap entry
+    EventId m_event;            //!< last scheduled event, if scheduled in the current context
+    uint32_t m_eventGeneration; //!< generation of the last scheduled event
+    bool m_eventPending;        //!< whether the last scheduled event is pending
+    Time m_eventTime;           //!< expiration time of the last scheduled event
+    uint32_t m_eventContext;    //!< context of the last scheduled event
+};
+
+} // namespace ns3
+
+#endif /* TRAFFIC_SCHEDULE_H */
@@ -15,6 +15,7 @@
 #include "ns3/log.h"
 #include "ns3/nstime.h"
 #include "ns3/packet.h"
+#include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/socket.h"
@@ -49,6 +50,15 @@ UdpClient::GetTypeId()
                           TimeValue(Seconds(1)),
                           MakeTimeAccessor(&UdpClient::m_interval),
                           MakeTimeChecker())
+            .AddAttribute("TrafficSchedule",
+                          "The TrafficSchedule driving the transmissions of the application, "
+                          "if any. If null, the application schedules an event per packet. "
+                          "The send times are computed in batches, hence a change of the "
+                          "Interval while the application is running only applies after "
+                          "the current batch.",
+                          PointerValue(),
+                          MakePointerAccessor(&UdpClient::m_schedule),
+                          MakePointerChecker<TrafficSchedule>())
             .AddAttribute("RemoteAddress",
                           "The destination Address of the outbound packets",
                           AddressValue(),
@@ -99,6 +109,18 @@ UdpClient::~UdpClient()
     NS_LOG_FUNCTION(this);
 }
 
+void
+UdpClient::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_schedule && m_flowId)
+    {
+        m_schedule->StopFlow(*m_flowId);
+    }
+    m_schedule = nullptr;
+    SourceApplication::DoDispose();
+}
+
 void
 UdpClient::SetRemote(const Address& ip, uint16_t port)
 {
@@ -226,6 +248,17 @@ UdpClient::StartApplication()
     m_peerString = peerAddressStringStream.str();
 #endif // NS3_LOG_ENABLE
 
+    if (m_schedule)
+    {
+        if (!m_flowId)
+        {
+            m_flowId = m_schedule->AddFlow(MakeCallback(&UdpClient::Send, this),
+                                           MakeCallback(&UdpClient::ComputeBatch, this));
+        }
+        m_nextTx = Simulator::Now();
+        m_schedule->StartFlow(*m_flowId);
+        return;
+    }
     m_sendEvent = Simulator::Schedule(Seconds(0), &UdpClient::Send, this);
 }
 
@@ -234,6 +267,10 @@ UdpClient::StopApplication()
 {
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_sendEvent);
+    if (m_schedule && m_flowId)
+    {
+        m_schedule->StopFlow(*m_flowId);
+    }
 }
 
 void
@@ -275,7 +312,27 @@ UdpClient::Send()
 
     if (m_sent < m_count || m_count == 0)
     {
-        m_sendEvent = Simulator::Schedule(m_interval, &UdpClient::Send, this);
+        if (!m_schedule)
+        {
+            m_sendEvent = Simulator::Schedule(m_interval, &UdpClient::Send, this);
+        }
+    }
+    else if (m_schedule)
+    {
+        m_schedule->StopFlow(*m_flowId);
+    }
+}
+
+void
+UdpClient::ComputeBatch(std::vector<Time>& times)
+{
+    NS_LOG_FUNCTION(this);
+
+    // See Send: the packets are sent every m_interval from the start of the application
+    for (uint32_t i = 0; i < m_schedule->GetBatchSize(); i++)
+    {
+        times.push_back(m_nextTx);
+        m_nextTx += m_interval;
     }
 }
 
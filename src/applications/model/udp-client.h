@@ -12,6 +12,7 @@
 #define UDP_CLIENT_H
 
 #include "source-application.h"
+#include "traffic-schedule.h"
 
 #include "ns3/deprecated.h"
 #include "ns3/event-id.h"
@@ -20,6 +21,7 @@
 #include <ns3/traced-callback.h>
 
 #include <optional>
+#include <vector>
 
 namespace ns3
 {
@@ -62,6 +64,9 @@ class UdpClient : public SourceApplication
      */
     uint64_t GetTotalTx() const;
 
+  protected:
+    void DoDispose() override;
+
   private:
     void StartApplication() override;
     void StopApplication() override;
@@ -71,6 +76,12 @@ class UdpClient : public SourceApplication
      */
     void Send();
 
+    /**
+     * @brief Compute the next batch of send times of the application
+     * @param times the vector to fill with the send times
+     */
+    void ComputeBatch(std::vector<Time>& times);
+
     /**
      * @brief Set the remote port (temporary function until deprecated attributes are removed)
      * @param port remote port
@@ -105,6 +116,10 @@ class UdpClient : public SourceApplication
     std::optional<uint16_t> m_peerPort; //!< Remote peer port (deprecated) // NS_DEPRECATED_3_44
     EventId m_sendEvent;                //!< Event to send the next packet
 
+    Ptr<TrafficSchedule> m_schedule;  //!< Schedule driving the transmissions, if any
+    std::optional<uint32_t> m_flowId; //!< Flow of the application in the schedule
+    Time m_nextTx;                    //!< Next send time computed by ComputeBatch
+
 #ifdef NS3_LOG_ENABLE
     std::string m_peerString; //!< Remote peer address string
 #endif                        // NS3_LOG_ENABLE
@@ -9,6 +9,7 @@
 #include "ns3/log.h"
 #include "ns3/nstime.h"
 #include "ns3/packet.h"
+#include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/socket.h"
@@ -41,6 +42,15 @@ UdpEchoClient::GetTypeId()
                           TimeValue(Seconds(1)),
                           MakeTimeAccessor(&UdpEchoClient::m_interval),
                           MakeTimeChecker())
+            .AddAttribute("TrafficSchedule",
+                          "The TrafficSchedule driving the transmissions of the application, "
+                          "if any. If null, the application schedules an event per packet. "
+                          "The send times are computed in batches, hence a change of the "
+                          "Interval while the application is running only applies after "
+                          "the current batch.",
+                          PointerValue(),
+                          MakePointerAccessor(&UdpEchoClient::m_schedule),
+                          MakePointerChecker<TrafficSchedule>())
             .AddAttribute(
                 "RemoteAddress",
                 "The destination Address of the outbound packets",
@@ -106,6 +116,18 @@ UdpEchoClient::~UdpEchoClient()
     m_dataSize = 0;
 }
 
+void
+UdpEchoClient::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_schedule && m_flowId)
+    {
+        m_schedule->StopFlow(*m_flowId);
+    }
+    m_schedule = nullptr;
+    SourceApplication::DoDispose();
+}
+
 void
 UdpEchoClient::SetRemote(const Address& ip, uint16_t port)
 {
@@ -217,6 +239,17 @@ UdpEchoClient::StartApplication()
         m_socket->SetAllowBroadcast(true);
     }
 
+    if (m_schedule)
+    {
+        if (!m_flowId)
+        {
+            m_flowId = m_schedule->AddFlow(MakeCallback(&UdpEchoClient::Send, this),
+                                           MakeCallback(&UdpEchoClient::ComputeBatch, this));
+        }
+        m_nextTx = Simulator::Now();
+        m_schedule->StartFlow(*m_flowId);
+        return;
+    }
     ScheduleTransmit(Seconds(0.));
 }
 
@@ -233,6 +266,10 @@ UdpEchoClient::StopApplication()
     }
 
     Simulator::Cancel(m_sendEvent);
+    if (m_schedule && m_flowId)
+    {
+        m_schedule->StopFlow(*m_flowId);
+    }
 }
 
 void
@@ -401,7 +438,27 @@ UdpEchoClient::Send()
 
     if (m_sent < m_count || m_count == 0)
     {
-        ScheduleTransmit(m_interval);
+        if (!m_schedule)
+        {
+            ScheduleTransmit(m_interval);
+        }
+    }
+    else if (m_schedule)
+    {
+        m_schedule->StopFlow(*m_flowId);
+    }
+}
+
+void
+UdpEchoClient::ComputeBatch(std::vector<Time>& times)
+{
+    NS_LOG_FUNCTION(this);
+
+    // See Send: the packets are sent every m_interval from the start of the application
+    for (uint32_t i = 0; i < m_schedule->GetBatchSize(); i++)
+    {
+        times.push_back(m_nextTx);
+        m_nextTx += m_interval;
     }
 }
 
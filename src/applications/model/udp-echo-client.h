@@ -8,6 +8,7 @@
 #define UDP_ECHO_CLIENT_H
 
 #include "source-application.h"
+#include "traffic-schedule.h"
 
 #include "ns3/deprecated.h"
 #include "ns3/event-id.h"
@@ -16,6 +17,7 @@
 #include "ns3/traced-callback.h"
 
 #include <optional>
+#include <vector>
 
 namespace ns3
 {
@@ -121,6 +123,9 @@ class UdpEchoClient : public SourceApplication
      */
     void SetFill(uint8_t* fill, uint32_t fillSize, uint32_t dataSize);
 
+  protected:
+    void DoDispose() override;
+
   private:
     void StartApplication() override;
     void StopApplication() override;
@@ -153,6 +158,12 @@ class UdpEchoClient : public SourceApplication
      */
     void Send();
 
+    /**
+     * @brief Compute the next batch of send times of the application
+     * @param times the vector to fill with the send times
+     */
+    void ComputeBatch(std::vector<Time>& times);
+
     /**
      * @brief Handle a packet reception.
      *
@@ -174,6 +185,10 @@ class UdpEchoClient : public SourceApplication
     std::optional<uint16_t> m_peerPort; //!< Remote peer port (deprecated) // NS_DEPRECATED_3_44
     EventId m_sendEvent;                //!< Event to send the next packet
 
+    Ptr<TrafficSchedule> m_schedule;  //!< Schedule driving the transmissions, if any
+    std::optional<uint32_t> m_flowId; //!< Flow of the application in the schedule
+    Time m_nextTx;                    //!< Next send time computed by ComputeBatch
+
     /// Callbacks for tracing the packet Tx events
     TracedCallback<Ptr<const Packet>> m_txTrace;
 
@@ -0,0 +1,213 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/application-container.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/onoff-application.h"
+#include "ns3/pointer.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traffic-schedule.h"
+#include "ns3/udp-client-server-helper.h"
+#include "ns3/udp-echo-helper.h"
+#include "ns3/uinteger.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * Check that applications driven by a TrafficSchedule send their packets and
+ * switch between the On and Off states at the same times as stand-alone
+ * applications.
+ */
+class TrafficScheduleSendTimesTestCase : public TestCase
+{
+  public:
+    TrafficScheduleSendTimesTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Times of the events notified by the applications, indexed by application
+    using Events = std::map<std::string, std::vector<Time>>;
+
+    /**
+     * Run the scenario
+     * @param useSchedule whether the applications are driven by a TrafficSchedule
+     * @return the times of the events notified by the applications
+     */
+    Events RunScenario(bool useSchedule);
+    /**
+     * Record a packet transmission
+     * @param context the application
+     * @param p the packet
+     */
+    void Tx(std::string context, Ptr<const Packet> p);
+    /**
+     * Record a state change of an OnOffApplication
+     * @param context the application
+     * @param oldValue the previous state
+     * @param newValue the new state
+     */
+    void StateChange(std::string context, bool oldValue, bool newValue);
+
+    Events m_tx;    //!< the transmission times
+    Events m_state; //!< the state change times
+};
+
+TrafficScheduleSendTimesTestCase::TrafficScheduleSendTimesTestCase()
+    : TestCase("Check the send times of applications driven by a TrafficSchedule")
+{
+}
+
+void
+TrafficScheduleSendTimesTestCase::Tx(std::string context, Ptr<const Packet> p)
+{
+    m_tx[context].push_back(Simulator::Now());
+}
+
+void
+TrafficScheduleSendTimesTestCase::StateChange(std::string context, bool oldValue, bool newValue)
+{
+    m_state[context].push_back(Simulator::Now());
+}
+
+TrafficScheduleSendTimesTestCase::Events
+TrafficScheduleSendTimesTestCase::RunScenario(bool useSchedule)
+{
+    m_tx.clear();
+    m_state.clear();
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(devices);
+
+    // a small batch size, so that the batches are refilled several times
+    Ptr<TrafficSchedule> schedule =
+        useSchedule ? CreateObjectWithAttributes<TrafficSchedule>("BatchSize", UintegerValue(4))
+                    : nullptr;
+
+    ApplicationContainer apps;
+    OnOffHelper onoff("ns3::UdpSocketFactory", InetSocketAddress(i.GetAddress(1), 9));
+    onoff.SetAttribute("OnTime", StringValue("ns3::ExponentialRandomVariable[Mean=0.05]"));
+    onoff.SetAttribute("OffTime", StringValue("ns3::ExponentialRandomVariable[Mean=0.05]"));
+    onoff.SetAttribute("TrafficSchedule", PointerValue(schedule));
+    // the residual bits are carried over the On periods with the default data rate
+    apps.Add(onoff.Install(nodes.Get(0)));
+    onoff.SetAttribute("DataRate", StringValue("2Mbps"));
+    onoff.SetAttribute("PacketSize", UintegerValue(1000));
+    onoff.SetAttribute("MaxBytes", UintegerValue(40000));
+    apps.Add(onoff.Install(nodes.Get(0)));
+    onoff.SetAttribute("DataRate", StringValue("1Mbps"));
+    onoff.SetAttribute("MaxBytes", UintegerValue(0));
+    apps.Add(onoff.Install(nodes.Get(1)));
+    for (uint32_t n = 0; n < apps.GetN(); n++)
+    {
+        apps.Get(n)->AssignStreams(10 * n);
+    }
+
+    UdpClientHelper client(InetSocketAddress(i.GetAddress(1), 10));
+    client.SetAttribute("Interval", TimeValue(MilliSeconds(10)));
+    client.SetAttribute("MaxPackets", UintegerValue(150));
+    client.SetAttribute("TrafficSchedule", PointerValue(schedule));
+    apps.Add(client.Install(nodes.Get(0)));
+
+    UdpEchoClientHelper echoClient(InetSocketAddress(i.GetAddress(0), 11));
+    echoClient.SetAttribute("Interval", TimeValue(MilliSeconds(15)));
+    echoClient.SetAttribute("MaxPackets", UintegerValue(0));
+    echoClient.SetAttribute("TrafficSchedule", PointerValue(schedule));
+    apps.Add(echoClient.Install(nodes.Get(1)));
+
+    for (uint32_t n = 0; n < apps.GetN(); n++)
+    {
+        apps.Get(n)->SetStartTime(MilliSeconds(100 * n + 1));
+        apps.Get(n)->TraceConnect("Tx",
+                                  std::to_string(n),
+                                  MakeCallback(&TrafficScheduleSendTimesTestCase::Tx, this));
+        if (n < 3)
+        {
+            apps.Get(n)->TraceConnect(
+                "OnOffState",
+                std::to_string(n),
+                MakeCallback(&TrafficScheduleSendTimesTestCase::StateChange, this));
+        }
+    }
+    apps.Get(0)->SetStopTime(Seconds(2.5));
+    apps.Stop(Seconds(3));
+
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    Events events = m_tx;
+    for (const auto& [app, times] : m_state)
+    {
+        events["state" + app] = times;
+    }
+    return events;
+}
+
+void
+TrafficScheduleSendTimesTestCase::DoRun()
+{
+    Events expected = RunScenario(false);
+    Events actual = RunScenario(true);
+
+    NS_TEST_ASSERT_MSG_EQ(expected.size(), 8, "Unexpected number of event kinds");
+    NS_TEST_ASSERT_MSG_EQ(actual.size(), expected.size(), "Different number of event kinds");
+
+    for (const auto& [key, times] : expected)
+    {
+        NS_TEST_ASSERT_MSG_GT(times.size(), 0, "No event for " << key);
+        NS_TEST_ASSERT_MSG_EQ(actual[key].size(), times.size(), "Different number for " << key);
+        for (std::size_t n = 0; n < times.size(); n++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(actual[key][n], times[n], "Different time for " << key);
+        }
+    }
+    // the echo client sends packets until it is stopped
+    NS_TEST_EXPECT_MSG_EQ(expected["4"].back(),
+                          MilliSeconds(401 + 15 * 173),
+                          "Unexpected last send");
+}
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * @brief TrafficSchedule TestSuite
+ */
+class TrafficScheduleTestSuite : public TestSuite
+{
+  public:
+    TrafficScheduleTestSuite();
+};
+
+TrafficScheduleTestSuite::TrafficScheduleTestSuite()
+    : TestSuite("applications-traffic-schedule", Type::UNIT)
+{
+    AddTestCase(new TrafficScheduleSendTimesTestCase, TestCase::Duration::QUICK);
+}
+
+static TrafficScheduleTestSuite g_trafficScheduleTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/building-spatial-index.h"
+#include "ns3/buildings-module.h"
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BuildingsSpatialIndexBenchmark");
+
+static double g_totalLoss = 0;  //!< the sum of the losses computed by the benchmark
+static uint64_t g_nLosses = 0; //!< the number of losses computed by the benchmark
+
+/**
+ * Compute the loss between all the pairs of nodes
+ * @param lossModel the propagation loss model
+ * @param mobilities the mobility models of the nodes
+ */
+static void
+ComputeLosses(Ptr<PropagationLossModel> lossModel, std::vector<Ptr<MobilityModel>> mobilities)
+{
+    for (const auto& a : mobilities)
+    {
+        for (const auto& b : mobilities)
+        {
+            if (a != b)
+            {
+                g_totalLoss -= lossModel->CalcRxPower(0, a, b);
+                g_nLosses++;
+            }
+        }
+    }
+}
+
+/**
+ * This program measures the time spent by the building-aware models on a
+ * city of thousands of buildings: the indoor state of the nodes, the
+ * HybridBuildingsPropagationLossModel between all the pairs of nodes, and
+ * the RandomWalk2dOutdoorMobilityModel of the moving nodes. For reference,
+ * it also measures the time spent to find the building containing each node
+ * by testing all the buildings, as done without the spatial index of
+ * BuildingList.
+ */
+int
+main(int argc, char* argv[])
+{
+    uint32_t numBuildingsX = 80;
+    uint32_t numBuildingsY = 50;
+    uint32_t numNodes = 100;
+    double simTime = 10;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("numBuildingsX", "The number of buildings along the x axis", numBuildingsX);
+    cmd.AddValue("numBuildingsY", "The number of buildings along the y axis", numBuildingsY);
+    cmd.AddValue("numNodes", "The number of nodes, half static and half moving", numNodes);
+    cmd.AddValue("simTime", "The simulation time, in seconds", simTime);
+    cmd.Parse(argc, argv);
+
+    // create a grid of buildings
+    double buildingSizeX = 40; // m
+    double buildingSizeY = 30; // m
+    double streetWidth = 20;   // m
+    double maxAxisX = (buildingSizeX + streetWidth) * numBuildingsX;
+    double maxAxisY = (buildingSizeY + streetWidth) * numBuildingsY;
+    for (uint32_t buildingIdX = 0; buildingIdX < numBuildingsX; ++buildingIdX)
+    {
+        for (uint32_t buildingIdY = 0; buildingIdY < numBuildingsY; ++buildingIdY)
+        {
+            Ptr<Building> building = CreateObject<Building>();
+            building->SetBoundaries(Box(buildingIdX * (buildingSizeX + streetWidth),
+                                        buildingIdX * (buildingSizeX + streetWidth) + buildingSizeX,
+                                        buildingIdY * (buildingSizeY + streetWidth),
+                                        buildingIdY * (buildingSizeY + streetWidth) + buildingSizeY,
+                                        0.0,
+                                        20.0));
+            building->SetNFloors(5);
+        }
+    }
+
+    uint32_t numBuildings = BuildingList::GetNBuildings();
+    SystemWallClockMs clock;
+    clock.Start();
+    BuildingList::GetSpatialIndex();
+    int64_t indexTime = clock.End();
+
+    // half of the nodes are static, indoor or outdoor, and half walk outdoor
+    NodeContainer staticNodes;
+    staticNodes.Create(numNodes / 2);
+    NodeContainer movingNodes;
+    movingNodes.Create(numNodes - numNodes / 2);
+
+    MobilityHelper mobility;
+    Ptr<RandomBoxPositionAllocator> boxAllocator = CreateObject<RandomBoxPositionAllocator>();
+    boxAllocator->SetAttribute("X", StringValue("ns3::UniformRandomVariable[Min=0|Max=" +
+                                                std::to_string(maxAxisX) + "]"));
+    boxAllocator->SetAttribute("Y", StringValue("ns3::UniformRandomVariable[Min=0|Max=" +
+                                                std::to_string(maxAxisY) + "]"));
+    boxAllocator->SetAttribute("Z", StringValue("ns3::UniformRandomVariable[Min=1|Max=19]"));
+    mobility.SetPositionAllocator(boxAllocator);
+    mobility.Install(staticNodes);
+
+    Ptr<OutdoorPositionAllocator> outdoorAllocator = CreateObject<OutdoorPositionAllocator>();
+    outdoorAllocator->SetAttribute("X", StringValue("ns3::UniformRandomVariable[Min=0|Max=" +
+                                                    std::to_string(maxAxisX) + "]"));
+    outdoorAllocator->SetAttribute("Y", StringValue("ns3::UniformRandomVariable[Min=0|Max=" +
+                                                    std::to_string(maxAxisY) + "]"));
+    outdoorAllocator->SetAttribute("Z", StringValue("ns3::ConstantRandomVariable[Constant=1.5]"));
+    mobility.SetPositionAllocator(outdoorAllocator);
+    mobility.SetMobilityModel(
+        "ns3::RandomWalk2dOutdoorMobilityModel",
+        "Bounds",
+        RectangleValue(Rectangle(-streetWidth, maxAxisX, -streetWidth, maxAxisY)));
+    mobility.Install(movingNodes);
+
+    NodeContainer nodes(staticNodes, movingNodes);
+    BuildingsHelper::Install(nodes);
+
+    std::vector<Ptr<MobilityModel>> mobilities;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        mobilities.push_back(nodes.Get(i)->GetObject<MobilityModel>());
+    }
+
+    // the building containing each node, testing all the buildings
+    clock.Start();
+    uint32_t indoorNodes = 0;
+    for (const auto& mm : mobilities)
+    {
+        Vector position = mm->GetPosition();
+        for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+        {
+            if ((*bit)->IsInside(position))
+            {
+                indoorNodes++;
+                break;
+            }
+        }
+    }
+    int64_t linearTime = clock.End();
+
+    // the same, with the spatial index
+    clock.Start();
+    uint32_t indexedIndoorNodes = 0;
+    for (const auto& mm : mobilities)
+    {
+        if (BuildingList::GetSpatialIndex().GetBuildingAt(mm->GetPosition()))
+        {
+            indexedIndoorNodes++;
+        }
+    }
+    int64_t indexedTime = clock.End();
+    NS_ABORT_MSG_IF(indoorNodes != indexedIndoorNodes, "Wrong number of indoor nodes");
+
+    Ptr<HybridBuildingsPropagationLossModel> lossModel =
+        CreateObject<HybridBuildingsPropagationLossModel>();
+    for (double t = 0; t < simTime; t += 1)
+    {
+        Simulator::Schedule(Seconds(t), &ComputeLosses, lossModel, mobilities);
+    }
+
+    clock.Start();
+    Simulator::Stop(Seconds(simTime));
+    Simulator::Run();
+    int64_t runTime = clock.End();
+    Simulator::Destroy();
+
+    std::cout << "buildings: " << numBuildings << ", nodes: " << nodes.GetN()
+              << " (" << indoorNodes << " indoor)" << std::endl
+              << "spatial index build time: " << indexTime << " ms" << std::endl
+              << "indoor lookups, all buildings: " << linearTime
+              << " ms, spatial index: " << indexedTime << " ms" << std::endl
+              << "simulation time (losses and outdoor walks): " << runTime << " ms" << std::endl
+              << "losses computed: " << g_nLosses << ", average loss: " << g_totalLoss / g_nLosses
+              << " dB" << std::endl;
+
+    return 0;
+}
@@ -9,6 +9,7 @@
  */
 #include "building-list.h"
 
+#include "building-spatial-index.h"
 #include "building.h"
 
 #include "ns3/assert.h"
@@ -66,6 +67,16 @@ class BuildingListPriv : public Object
      * @returns the container size
      */
     uint32_t GetNBuildings();
+    /**
+     * Gets the spatial index of the buildings in the container, building
+     * it again if outdated
+     * @returns the spatial index
+     */
+    const BuildingSpatialIndex& GetSpatialIndex();
+    /**
+     * Marks the spatial index as outdated
+     */
+    void InvalidateSpatialIndex();
 
     /**
      * Get the Singleton instance of BuildingListPriv (or create one)
@@ -88,6 +99,8 @@ class BuildingListPriv : public Object
      */
     static void Delete();
     std::vector<Ptr<Building>> m_buildings; //!< Container of Building
+    BuildingSpatialIndex m_spatialIndex;    //!< Spatial index of the buildings
+    bool m_spatialIndexValid;               //!< True if the spatial index is up to date
 };
 
 NS_OBJECT_ENSURE_REGISTERED(BuildingListPriv);
@@ -135,6 +148,7 @@ BuildingListPriv::Delete()
 }
 
 BuildingListPriv::BuildingListPriv()
+    : m_spatialIndexValid(false)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -154,6 +168,8 @@ BuildingListPriv::DoDispose()
         *i = nullptr;
     }
     m_buildings.erase(m_buildings.begin(), m_buildings.end());
+    m_spatialIndex.Clear();
+    m_spatialIndexValid = false;
     Object::DoDispose();
 }
 
@@ -162,6 +178,7 @@ BuildingListPriv::Add(Ptr<Building> building)
 {
     uint32_t index = m_buildings.size();
     m_buildings.push_back(building);
+    m_spatialIndexValid = false;
     Simulator::ScheduleWithContext(index, TimeStep(0), &Building::Initialize, building);
     return index;
 }
@@ -193,6 +210,24 @@ BuildingListPriv::GetBuilding(uint32_t n)
     return m_buildings.at(n);
 }
 
+const BuildingSpatialIndex&
+BuildingListPriv::GetSpatialIndex()
+{
+    if (!m_spatialIndexValid)
+    {
+        NS_LOG_LOGIC("building the spatial index of " << m_buildings.size() << " buildings");
+        m_spatialIndex.Build(m_buildings.begin(), m_buildings.end());
+        m_spatialIndexValid = true;
+    }
+    return m_spatialIndex;
+}
+
+void
+BuildingListPriv::InvalidateSpatialIndex()
+{
+    m_spatialIndexValid = false;
+}
+
 } // namespace ns3
 
 /**
@@ -233,4 +268,16 @@ BuildingList::GetNBuildings()
     return BuildingListPriv::Get()->GetNBuildings();
 }
 
+const BuildingSpatialIndex&
+BuildingList::GetSpatialIndex()
+{
+    return BuildingListPriv::Get()->GetSpatialIndex();
+}
+
+void
+BuildingList::InvalidateSpatialIndex()
+{
+    BuildingListPriv::Get()->InvalidateSpatialIndex();
+}
+
 } // namespace ns3
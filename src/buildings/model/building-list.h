@@ -19,6 +19,7 @@ namespace ns3
 {
 
 class Building;
+class BuildingSpatialIndex;
 
 /**
  * @ingroup buildings
@@ -58,6 +59,21 @@ class BuildingList
      * @returns the number of buildings currently in the list.
      */
     static uint32_t GetNBuildings();
+    /**
+     * @returns the spatial index of the buildings currently in the list.
+     *
+     * The index is built the first time it is requested after a building
+     * has been added or the boundaries of a building have changed.
+     */
+    static const BuildingSpatialIndex& GetSpatialIndex();
+    /**
+     * Mark the spatial index as outdated, so that it is built again the
+     * next time it is requested.
+     *
+     * This method is called automatically when a building is added or its
+     * boundaries are set, so the user has little reason to call it itself.
+     */
+    static void InvalidateSpatialIndex();
 };
 
 } // namespace ns3
@@ -0,0 +1,281 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "building-spatial-index.h"
+
+#include "building.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BuildingSpatialIndex");
+
+BuildingSpatialIndex::BuildingSpatialIndex()
+    : m_xMin(0),
+      m_xMax(0),
+      m_yMin(0),
+      m_yMax(0),
+      m_cellSize(1),
+      m_margin(0),
+      m_nColumns(0),
+      m_nRows(0),
+      m_stamp(0)
+{
+}
+
+void
+BuildingSpatialIndex::Clear()
+{
+    m_buildings.clear();
+    m_boxes.clear();
+    m_cellStart.clear();
+    m_cellBuildings.clear();
+    m_stamps.clear();
+    m_nColumns = 0;
+    m_nRows = 0;
+}
+
+void
+BuildingSpatialIndex::Build(BuildingList::Iterator begin, BuildingList::Iterator end)
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+    for (auto it = begin; it != end; ++it)
+    {
+        m_buildings.push_back(*it);
+        m_boxes.push_back((*it)->GetBoundaries());
+    }
+    if (m_boxes.empty())
+    {
+        return;
+    }
+
+    m_xMin = m_boxes.front().xMin;
+    m_xMax = m_boxes.front().xMax;
+    m_yMin = m_boxes.front().yMin;
+    m_yMax = m_boxes.front().yMax;
+    for (const auto& box : m_boxes)
+    {
+        m_xMin = std::min(m_xMin, box.xMin);
+        m_xMax = std::max(m_xMax, box.xMax);
+        m_yMin = std::min(m_yMin, box.yMin);
+        m_yMax = std::max(m_yMax, box.yMax);
+    }
+
+    // about one cell per building
+    double width = m_xMax - m_xMin;
+    double height = m_yMax - m_yMin;
+    m_cellSize = std::sqrt(width * height / m_boxes.size());
+    if (!(m_cellSize > 0))
+    {
+        m_cellSize = std::max({width, height, 1.0}) / m_boxes.size();
+    }
+    // the positions closer than m_margin to the boundary of a cell are
+    // considered in both cells, to be robust against rounding errors
+    m_margin = 1e-6 * m_cellSize;
+    m_nColumns = static_cast<uint32_t>(std::floor(width / m_cellSize)) + 1;
+    m_nRows = static_cast<uint32_t>(std::floor(height / m_cellSize)) + 1;
+
+    // store the buildings of each cell contiguously, counting them first
+    m_cellStart.assign(m_nColumns * m_nRows + 1, 0);
+    for (const auto& box : m_boxes)
+    {
+        for (uint32_t row = GetRow(box.yMin - m_margin); row <= GetRow(box.yMax + m_margin); row++)
+        {
+            for (uint32_t col = GetColumn(box.xMin - m_margin);
+                 col <= GetColumn(box.xMax + m_margin);
+                 col++)
+            {
+                m_cellStart[row * m_nColumns + col + 1]++;
+            }
+        }
+    }
+    for (std::size_t cell = 1; cell < m_cellStart.size(); cell++)
+    {
+        m_cellStart[cell] += m_cellStart[cell - 1];
+    }
+    m_cellBuildings.resize(m_cellStart.back());
+    std::vector<uint32_t> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (uint32_t i = 0; i < m_boxes.size(); i++)
+    {
+        const auto& box = m_boxes[i];
+        for (uint32_t row = GetRow(box.yMin - m_margin); row <= GetRow(box.yMax + m_margin); row++)
+        {
+            for (uint32_t col = GetColumn(box.xMin - m_margin);
+                 col <= GetColumn(box.xMax + m_margin);
+                 col++)
+            {
+                m_cellBuildings[fill[row * m_nColumns + col]++] = i;
+            }
+        }
+    }
+    m_stamps.assign(m_boxes.size(), 0);
+    m_stamp = 0;
+    NS_LOG_DEBUG("indexed " << m_boxes.size() << " buildings in " << m_nColumns << "x" << m_nRows
+                            << " cells of side " << m_cellSize << " m");
+}
+
+uint32_t
+BuildingSpatialIndex::GetNBuildings() const
+{
+    return m_buildings.size();
+}
+
+uint32_t
+BuildingSpatialIndex::GetColumn(double x) const
+{
+    double col = std::floor((x - m_xMin) / m_cellSize);
+    return static_cast<uint32_t>(std::clamp(col, 0.0, static_cast<double>(m_nColumns - 1)));
+}
+
+uint32_t
+BuildingSpatialIndex::GetRow(double y) const
+{
+    double row = std::floor((y - m_yMin) / m_cellSize);
+    return static_cast<uint32_t>(std::clamp(row, 0.0, static_cast<double>(m_nRows - 1)));
+}
+
+uint32_t
+BuildingSpatialIndex::NextStamp() const
+{
+    if (++m_stamp == 0)
+    {
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_stamp = 1;
+    }
+    return m_stamp;
+}
+
+template <typename Visitor>
+bool
+BuildingSpatialIndex::VisitSegmentCells(const Vector& l1, const Vector& l2, Visitor visit) const
+{
+    if (m_boxes.empty())
+    {
+        return false;
+    }
+
+    double sxMin = std::min(l1.x, l2.x);
+    double sxMax = std::max(l1.x, l2.x);
+    double syMin = std::min(l1.y, l2.y);
+    double syMax = std::max(l1.y, l2.y);
+    if (sxMax < m_xMin || sxMin > m_xMax || syMax < m_yMin || syMin > m_yMax)
+    {
+        // the segment is outside the area covered by the buildings
+        return false;
+    }
+
+    // visit the cells crossed by the horizontal projection of the segment,
+    // one row at a time
+    uint32_t stamp = NextStamp();
+    double dx = l2.x - l1.x;
+    double dy = l2.y - l1.y;
+    uint32_t lastRow = GetRow(syMax + m_margin);
+    for (uint32_t row = GetRow(syMin - m_margin); row <= lastRow; row++)
+    {
+        double xa = sxMin;
+        double xb = sxMax;
+        if (dy != 0)
+        {
+            // x coordinates of the segment at the bottom and top of the row
+            double yLo = std::clamp(m_yMin + row * m_cellSize - m_margin, syMin, syMax);
+            double yHi = std::clamp(m_yMin + (row + 1) * m_cellSize + m_margin, syMin, syMax);
+            xa = l1.x + (yLo - l1.y) * dx / dy;
+            xb = l1.x + (yHi - l1.y) * dx / dy;
+            if (xa > xb)
+            {
+                std::swap(xa, xb);
+            }
+        }
+        uint32_t lastCol = GetColumn(xb + m_margin);
+        for (uint32_t col = GetColumn(xa - m_margin); col <= lastCol; col++)
+        {
+            uint32_t cell = row * m_nColumns + col;
+            for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; k++)
+            {
+                uint32_t i = m_cellBuildings[k];
+                if (m_stamps[i] == stamp)
+                {
+                    continue;
+                }
+                m_stamps[i] = stamp;
+                if (visit(i))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool
+BuildingSpatialIndex::IntersectsAnyBuilding(const Vector& l1, const Vector& l2) const
+{
+    return VisitSegmentCells(l1, l2, [&](uint32_t i) {
+        if (m_boxes[i].IsIntersect(l1, l2))
+        {
+            NS_LOG_LOGIC("segment intersects building " << m_buildings[i]->GetId());
+            return true;
+        }
+        return false;
+    });
+}
+
+std::vector<Ptr<Building>>
+BuildingSpatialIndex::GetIntersectingBuildings(const Vector& l1, const Vector& l2) const
+{
+    std::vector<uint32_t> indices;
+    VisitSegmentCells(l1, l2, [&](uint32_t i) {
+        if (m_boxes[i].IsIntersect(l1, l2))
+        {
+            indices.push_back(i);
+        }
+        return false;
+    });
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<Ptr<Building>> buildings;
+    buildings.reserve(indices.size());
+    for (auto i : indices)
+    {
+        buildings.push_back(m_buildings[i]);
+    }
+    return buildings;
+}
+
+Ptr<Building>
+BuildingSpatialIndex::GetBuildingAt(const Vector& position) const
+{
+    if (m_boxes.empty() || position.x < m_xMin || position.x > m_xMax || position.y < m_yMin ||
+        position.y > m_yMax)
+    {
+        return nullptr;
+    }
+
+    // the boundaries of a building containing the position overlap its cell
+    Ptr<Building> building;
+    uint32_t cell = GetRow(position.y) * m_nColumns + GetColumn(position.x);
+    for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; k++)
+    {
+        uint32_t i = m_cellBuildings[k];
+        if (m_boxes[i].IsInside(position))
+        {
+            NS_ABORT_MSG_IF(building,
+                            "Position " << position << " is inside buildings "
+                                        << building->GetId() << " and "
+                                        << m_buildings[i]->GetId());
+            building = m_buildings[i];
+        }
+    }
+    return building;
+}
+
+} // namespace ns3
@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BUILDING_SPATIAL_INDEX_H
+#define BUILDING_SPATIAL_INDEX_H
+
+#include "building-list.h"
+
+#include "ns3/box.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+class Building;
+
+/**
+ * @ingroup buildings
+ *
+ * @brief Uniform grid over the horizontal footprint of the buildings
+ *
+ * Each cell of the grid stores the indices of the buildings whose boundaries
+ * overlap it, so that the queries only test the buildings close to the
+ * queried position or segment instead of every building of the scenario.
+ * The size of the cells is chosen so that the number of cells is about the
+ * number of buildings. The buildings are tested with the same predicates
+ * used by the Building class (Box::IsIntersect and Box::IsInside), hence the
+ * results of the queries do not depend on the index.
+ *
+ * The index is a snapshot: it has to be built again when buildings are
+ * added or their boundaries change. BuildingList takes care of this for
+ * the index it owns, see BuildingList::GetSpatialIndex.
+ */
+class BuildingSpatialIndex
+{
+  public:
+    BuildingSpatialIndex();
+
+    /**
+     * Build the index over a range of buildings
+     * @param begin the first building
+     * @param end the end of the range of buildings
+     */
+    void Build(BuildingList::Iterator begin, BuildingList::Iterator end);
+
+    /**
+     * Remove all the buildings from the index
+     */
+    void Clear();
+
+    /**
+     * @return the number of buildings in the index
+     */
+    uint32_t GetNBuildings() const;
+
+    /**
+     * Check if the segment between two positions intersects any building
+     * @param l1 the first end of the segment
+     * @param l2 the second end of the segment
+     * @return true if at least one building intersects the segment
+     */
+    bool IntersectsAnyBuilding(const Vector& l1, const Vector& l2) const;
+
+    /**
+     * Get the buildings intersecting the segment between two positions
+     * @param l1 the first end of the segment
+     * @param l2 the second end of the segment
+     * @return the buildings intersecting the segment, in the order in which
+     *         they have been indexed
+     */
+    std::vector<Ptr<Building>> GetIntersectingBuildings(const Vector& l1, const Vector& l2) const;
+
+    /**
+     * Get the building containing a position. The program is aborted if the
+     * position is inside more than one building.
+     * @param position the position
+     * @return the building containing the position, or nullptr if the position is outdoor
+     */
+    Ptr<Building> GetBuildingAt(const Vector& position) const;
+
+  private:
+    /**
+     * @param x the x coordinate
+     * @return the column of the cell containing x, clamped to the grid
+     */
+    uint32_t GetColumn(double x) const;
+
+    /**
+     * @param y the y coordinate
+     * @return the row of the cell containing y, clamped to the grid
+     */
+    uint32_t GetRow(double y) const;
+
+    /**
+     * @return a new stamp used to test each building at most once per query
+     */
+    uint32_t NextStamp() const;
+
+    /**
+     * Visit the buildings stored in the cells crossed by the horizontal
+     * projection of a segment, each building at most once
+     * @param l1 the first end of the segment
+     * @param l2 the second end of the segment
+     * @param visit called with the index of each building; the visit stops
+     *        when it returns true
+     * @return true if the visit has been stopped
+     */
+    template <typename Visitor>
+    bool VisitSegmentCells(const Vector& l1, const Vector& l2, Visitor visit) const;
+
+    std::vector<Ptr<Building>> m_buildings; //!< the indexed buildings
+    std::vector<Box> m_boxes;               //!< the boundaries of the indexed buildings
+    double m_xMin;                          //!< the minimum x coordinate of the grid
+    double m_xMax;                          //!< the maximum x coordinate of the grid
+    double m_yMin;                          //!< the minimum y coordinate of the grid
+    double m_yMax;                          //!< the maximum y coordinate of the grid
+    double m_cellSize;                      //!< the side of a cell
+    double m_margin;                        //!< tolerance on the cell boundaries
+    uint32_t m_nColumns;                    //!< the number of columns of the grid
+    uint32_t m_nRows;                       //!< the number of rows of the grid
+    std::vector<uint32_t> m_cellStart;      //!< offset of each cell in m_cellBuildings
+    std::vector<uint32_t> m_cellBuildings;  //!< the indices of the buildings of each cell
+    mutable std::vector<uint32_t> m_stamps; //!< the stamp of the last query testing a building
+    mutable uint32_t m_stamp;               //!< the stamp of the last query
+};
+
+} // namespace ns3
+
+#endif /* BUILDING_SPATIAL_INDEX_H */
@@ -10,6 +10,7 @@
 #include "buildings-channel-condition-model.h"
 
 #include "building-list.h"
+#include "building-spatial-index.h"
 #include "mobility-building-info.h"
 
 #include "ns3/log.h"
@@ -50,6 +51,19 @@ BuildingsChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
     Ptr<MobilityBuildingInfo> b1 = b->GetObject<MobilityBuildingInfo>();
     NS_ASSERT_MSG(a1 && b1, "BuildingsChannelConditionModel only works with MobilityBuildingInfo");
 
+    bool blocked = false;
+    if (!a1->IsIndoor() && !b1->IsIndoor())
+    {
+        blocked = IsLineOfSightBlocked(a->GetPosition(), b->GetPosition());
+    }
+    return CreateChannelCondition(a1, b1, blocked);
+}
+
+Ptr<ChannelCondition>
+BuildingsChannelConditionModel::CreateChannelCondition(Ptr<MobilityBuildingInfo> a1,
+                                                       Ptr<MobilityBuildingInfo> b1,
+                                                       bool blocked) const
+{
     Ptr<ChannelCondition> cond = CreateObject<ChannelCondition>();
 
     bool isAIndoor = a1->IsIndoor();
@@ -62,7 +76,6 @@ BuildingsChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
         // The outdoor case, determine LOS/NLOS
         // The channel condition should be LOS if the line of sight is not blocked,
         // otherwise NLOS
-        bool blocked = IsLineOfSightBlocked(a->GetPosition(), b->GetPosition());
         NS_LOG_DEBUG("a and b are outdoor, blocked " << blocked);
         if (!blocked)
         {
@@ -160,19 +173,10 @@ bool
 BuildingsChannelConditionModel::IsLineOfSightBlocked(const ns3::Vector& l1,
                                                      const ns3::Vector& l2) const
 {
-    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
-    {
-        if ((*bit)->IsIntersect(l1, l2))
-        {
-            // The line of sight should be blocked if the line-segment between
-            // l1 and l2 intersects one of the buildings.
-            return true;
-        }
-    }
-
-    // The line of sight should not be blocked if the line-segment between
-    // l1 and l2 did not intersect any building.
-    return false;
+    // The line of sight should be blocked if the line-segment between
+    // l1 and l2 intersects one of the buildings. Only the buildings close to
+    // the segment are tested, using the spatial index of the buildings.
+    return BuildingList::GetSpatialIndex().IntersectsAnyBuilding(l1, l2);
 }
 
 int64_t
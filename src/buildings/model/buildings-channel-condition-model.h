@@ -16,6 +16,7 @@ namespace ns3
 {
 
 class MobilityModel;
+class MobilityBuildingInfo;
 
 /**
  * @ingroup buildings
@@ -68,6 +69,19 @@ class BuildingsChannelConditionModel : public ChannelConditionModel
     int64_t AssignStreams(int64_t stream) override;
 
   private:
+    /**
+     * Creates the condition of the channel between a and b
+     *
+     * @param a1 the building information of a
+     * @param b1 the building information of b
+     * @param blocked true if both a and b are outdoor and the line of sight
+     *        between them is blocked by a building
+     * @return the condition of the channel between a and b
+     */
+    Ptr<ChannelCondition> CreateChannelCondition(Ptr<MobilityBuildingInfo> a1,
+                                                 Ptr<MobilityBuildingInfo> b1,
+                                                 bool blocked) const;
+
     /**
      * @brief Checks if the line of sight between position l1 and position l2 is
      *        blocked by a building.
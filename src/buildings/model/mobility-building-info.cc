@@ -10,8 +10,10 @@
 #include "mobility-building-info.h"
 
 #include "building-list.h"
+#include "building-spatial-index.h"
 
 #include <ns3/assert.h>
+#include <ns3/constant-position-mobility-model.h>
 #include <ns3/log.h>
 #include <ns3/pointer.h>
 #include <ns3/position-allocator.h>
@@ -43,6 +45,15 @@ MobilityBuildingInfo::DoInitialize()
     MakeConsistent(mm);
 }
 
+void
+MobilityBuildingInfo::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_mobility = nullptr;
+    m_myBuilding = nullptr;
+    Object::DoDispose();
+}
+
 MobilityBuildingInfo::MobilityBuildingInfo()
 {
     NS_LOG_FUNCTION(this);
@@ -51,6 +62,8 @@ MobilityBuildingInfo::MobilityBuildingInfo()
     m_roomX = 1;
     m_roomY = 1;
     m_cachedPosition = Vector(0, 0, 0);
+    m_static = false;
+    m_courseChanged = true;
 }
 
 MobilityBuildingInfo::MobilityBuildingInfo(Ptr<Building> building)
@@ -61,23 +74,48 @@ MobilityBuildingInfo::MobilityBuildingInfo(Ptr<Building> building)
     m_nFloor = 1;
     m_roomX = 1;
     m_roomY = 1;
+    m_static = false;
+    m_courseChanged = true;
 }
 
 bool
 MobilityBuildingInfo::IsIndoor()
 {
     NS_LOG_FUNCTION(this);
-    Ptr<MobilityModel> mm = this->GetObject<MobilityModel>();
-    Vector currentPosition = mm->GetPosition();
+    if (!m_mobility)
+    {
+        m_mobility = this->GetObject<MobilityModel>();
+        m_mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityBuildingInfo::CourseChange, this));
+        m_static = DynamicCast<ConstantPositionMobilityModel>(m_mobility) != nullptr;
+        // the position may have changed before the first call
+        m_courseChanged = true;
+    }
+    if (m_static && !m_courseChanged)
+    {
+        NS_LOG_LOGIC("the position did not change");
+        return m_indoor;
+    }
+    m_courseChanged = false;
+
+    Vector currentPosition = m_mobility->GetPosition();
     bool posNotEqual = (currentPosition < m_cachedPosition) || (m_cachedPosition < currentPosition);
     if (posNotEqual)
     {
-        MakeConsistent(mm);
+        MakeConsistent(m_mobility);
     }
 
     return m_indoor;
 }
 
+void
+MobilityBuildingInfo::CourseChange(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    m_courseChanged = true;
+}
+
 void
 MobilityBuildingInfo::SetIndoor(Ptr<Building> building,
                                 uint8_t nfloor,
@@ -155,26 +193,19 @@ MobilityBuildingInfo::GetBuilding()
 void
 MobilityBuildingInfo::MakeConsistent(Ptr<MobilityModel> mm)
 {
-    bool found = false;
     Vector pos = mm->GetPosition();
-    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    // the spatial index aborts if the position is inside more than one building
+    Ptr<Building> building = BuildingList::GetSpatialIndex().GetBuildingAt(pos);
+    if (building)
     {
-        NS_LOG_LOGIC("checking building " << (*bit)->GetId() << " with boundaries "
-                                          << (*bit)->GetBoundaries());
-        if ((*bit)->IsInside(pos))
-        {
-            NS_LOG_LOGIC("MobilityBuildingInfo " << this << " pos " << pos
-                                                 << " falls inside building " << (*bit)->GetId());
-            NS_ABORT_MSG_UNLESS(found == false,
-                                " MobilityBuildingInfo already inside another building!");
-            found = true;
-            uint16_t floor = (*bit)->GetFloor(pos);
-            uint16_t roomX = (*bit)->GetRoomX(pos);
-            uint16_t roomY = (*bit)->GetRoomY(pos);
-            SetIndoor(*bit, floor, roomX, roomY);
-        }
+        NS_LOG_LOGIC("MobilityBuildingInfo " << this << " pos " << pos
+                                             << " falls inside building " << building->GetId());
+        uint16_t floor = building->GetFloor(pos);
+        uint16_t roomX = building->GetRoomX(pos);
+        uint16_t roomY = building->GetRoomY(pos);
+        SetIndoor(building, floor, roomX, roomY);
     }
-    if (!found)
+    else
     {
         NS_LOG_LOGIC("MobilityBuildingInfo " << this << " pos " << pos << " is outdoor");
         SetOutdoor();
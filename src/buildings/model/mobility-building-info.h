@@ -54,6 +54,10 @@ class MobilityBuildingInfo : public Object
     /**
      * @brief Is indoor method.
      *
+     * The indoor state is updated when the position of the node changed since
+     * the last update. The position of a ConstantPositionMobilityModel is read
+     * again only after its CourseChange trace fired.
+     *
      * @return true if the MobilityBuildingInfo instance is indoor, false otherwise
      */
     bool IsIndoor();
@@ -128,8 +132,15 @@ class MobilityBuildingInfo : public Object
   protected:
     // inherited from Object
     void DoInitialize() override;
+    void DoDispose() override;
 
   private:
+    /**
+     * Record that the course of the mobility model changed
+     * @param mobility the mobility model
+     */
+    void CourseChange(Ptr<const MobilityModel> mobility);
+
     Ptr<Building> m_myBuilding; ///< Building
     bool m_indoor;              ///< Node position (indoor/outdoor) ?
     uint8_t m_nFloor; ///< The floor number at which the MobilityBuildingInfo instance is located
@@ -139,6 +150,9 @@ class MobilityBuildingInfo : public Object
                      ///< located
     Vector
         m_cachedPosition; ///< The node position cached after making its mobility model consistent
+    Ptr<MobilityModel> m_mobility; ///< The mobility model, connected to its CourseChange trace
+    bool m_static;                 ///< True if the position changes only with a course change
+    bool m_courseChanged;          ///< True if the course changed since the last position read
 };
 
 } // namespace ns3
@@ -10,6 +10,7 @@
 #include "random-walk-2d-outdoor-mobility-model.h"
 
 #include "building-list.h"
+#include "building-spatial-index.h"
 #include "building.h"
 
 #include "ns3/double.h"
@@ -260,24 +261,22 @@ RandomWalk2dOutdoorMobilityModel::IsLineClearOfBuildings(Vector currentPosition,
     double minIntersectionDistance = std::numeric_limits<double>::max();
     Ptr<Building> minIntersectionDistanceBuilding;
 
-    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    // the buildings which intersect the line between the current and next positions,
+    // including the building containing the next position, if any
+    for (const auto& building :
+         BuildingList::GetSpatialIndex().GetIntersectingBuildings(currentPosition, nextPosition))
     {
-        // check if this building intersects the line between the current and next positions
-        // this checks also if the next position is inside the building
-        if ((*bit)->IsIntersect(currentPosition, nextPosition))
+        NS_LOG_LOGIC("Building " << building->GetBoundaries() << " intersects the line between "
+                                 << currentPosition << " and " << nextPosition);
+        auto intersection = CalculateIntersectionFromOutside(currentPosition,
+                                                             nextPosition,
+                                                             building->GetBoundaries());
+        double distance = CalculateDistance(intersection, currentPosition);
+        intersectBuilding = true;
+        if (distance < minIntersectionDistance)
         {
-            NS_LOG_LOGIC("Building " << (*bit)->GetBoundaries() << " intersects the line between "
-                                     << currentPosition << " and " << nextPosition);
-            auto intersection = CalculateIntersectionFromOutside(currentPosition,
-                                                                 nextPosition,
-                                                                 (*bit)->GetBoundaries());
-            double distance = CalculateDistance(intersection, currentPosition);
-            intersectBuilding = true;
-            if (distance < minIntersectionDistance)
-            {
-                minIntersectionDistance = distance;
-                minIntersectionDistanceBuilding = (*bit);
-            }
+            minIntersectionDistance = distance;
+            minIntersectionDistanceBuilding = building;
         }
     }
 
@@ -6,11 +6,13 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/building-spatial-index.h"
 #include "ns3/buildings-channel-condition-model.h"
 #include "ns3/buildings-module.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
@@ -113,6 +115,17 @@ BuildingsChannelConditionModelTestCase::DoRun()
 
     BuildingsHelper::Install(nodes);
 
+    // the indoor state follows the course changes
+    Ptr<MobilityBuildingInfo> buildingInfo = nodes.Get(0)->GetObject<MobilityBuildingInfo>();
+    Ptr<MobilityModel> mobility = nodes.Get(0)->GetObject<MobilityModel>();
+    mobility->SetPosition(Vector(20.0, 5.0, 1.5));
+    NS_TEST_ASSERT_MSG_EQ(buildingInfo->IsIndoor(), false, "The node should be outdoor");
+    mobility->SetPosition(Vector(5.0, 5.0, 1.5));
+    NS_TEST_ASSERT_MSG_EQ(buildingInfo->IsIndoor(), true, "The node should be indoor");
+    NS_TEST_ASSERT_MSG_EQ(buildingInfo->GetBuilding(), building, "Wrong building");
+    mobility->SetPosition(Vector(20.0, 5.0, 1.5));
+    NS_TEST_ASSERT_MSG_EQ(buildingInfo->IsIndoor(), false, "The node should be outdoor");
+
     for (uint32_t i = 0; i < m_testVectors.GetN(); ++i)
     {
         testVector = m_testVectors.Get(i);
@@ -134,6 +147,197 @@ BuildingsChannelConditionModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup building-test
+ *
+ * Test case for the spatial index of the buildings. It checks that the
+ * segments intersecting a building and the buildings containing a position
+ * are the same found by testing all the buildings, that the indoor state of
+ * the nodes follows their course changes, and that the channel conditions
+ * computed for many nodes at once are the same computed for each pair of
+ * nodes
+ */
+class BuildingSpatialIndexTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    BuildingSpatialIndexTestCase();
+
+  private:
+    /**
+     * Builds the simulation scenario and perform the tests
+     */
+    void DoRun() override;
+
+    /**
+     * Check if a segment intersects a building by testing all the buildings
+     * @param l1 the first end of the segment
+     * @param l2 the second end of the segment
+     * @return true if at least one building intersects the segment
+     */
+    static bool IntersectsAnyBuilding(const Vector& l1, const Vector& l2);
+
+    /**
+     * Get the buildings intersecting a segment by testing all the buildings
+     * @param l1 the first end of the segment
+     * @param l2 the second end of the segment
+     * @return the buildings intersecting the segment
+     */
+    static std::vector<Ptr<Building>> GetIntersectingBuildings(const Vector& l1, const Vector& l2);
+
+    /**
+     * Get the buildings containing a position by testing all the buildings
+     * @param position the position
+     * @return the buildings containing the position
+     */
+    static std::vector<Ptr<Building>> GetBuildingsAt(const Vector& position);
+};
+
+BuildingSpatialIndexTestCase::BuildingSpatialIndexTestCase()
+    : TestCase("Test case for the spatial index of the buildings")
+{
+}
+
+bool
+BuildingSpatialIndexTestCase::IntersectsAnyBuilding(const Vector& l1, const Vector& l2)
+{
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        if ((*bit)->IsIntersect(l1, l2))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<Ptr<Building>>
+BuildingSpatialIndexTestCase::GetIntersectingBuildings(const Vector& l1, const Vector& l2)
+{
+    std::vector<Ptr<Building>> buildings;
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        if ((*bit)->IsIntersect(l1, l2))
+        {
+            buildings.push_back(*bit);
+        }
+    }
+    return buildings;
+}
+
+std::vector<Ptr<Building>>
+BuildingSpatialIndexTestCase::GetBuildingsAt(const Vector& position)
+{
+    std::vector<Ptr<Building>> buildings;
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        if ((*bit)->IsInside(position))
+        {
+            buildings.push_back(*bit);
+        }
+    }
+    return buildings;
+}
+
+void
+BuildingSpatialIndexTestCase::DoRun()
+{
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    uniform->SetStream(1);
+
+    // an empty index never reports an intersection
+    NS_TEST_ASSERT_MSG_EQ(BuildingList::GetSpatialIndex().GetNBuildings(), 0, "Unexpected size");
+    NS_TEST_ASSERT_MSG_EQ(
+        BuildingList::GetSpatialIndex().IntersectsAnyBuilding(Vector(0, 0, 1), Vector(1, 1, 1)),
+        false,
+        "Unexpected intersection with no buildings");
+
+    const uint32_t nBuildings = 300;
+    for (uint32_t i = 0; i < nBuildings; ++i)
+    {
+        double x = uniform->GetValue(0.0, 1000.0);
+        double y = uniform->GetValue(0.0, 500.0);
+        Ptr<Building> building = CreateObject<Building>();
+        building->SetBoundaries(Box(x,
+                                    x + uniform->GetValue(5.0, 40.0),
+                                    y,
+                                    y + uniform->GetValue(5.0, 40.0),
+                                    0.0,
+                                    uniform->GetValue(3.0, 30.0)));
+    }
+    const BuildingSpatialIndex& index = BuildingList::GetSpatialIndex();
+    NS_TEST_ASSERT_MSG_EQ(index.GetNBuildings(), nBuildings, "Unexpected size");
+
+    // random segments, including the axis aligned ones and the ones with the
+    // ends outside the area of the buildings
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        Vector l1(uniform->GetValue(-100.0, 1100.0),
+                  uniform->GetValue(-100.0, 600.0),
+                  uniform->GetValue(0.0, 40.0));
+        Vector l2(uniform->GetValue(-100.0, 1100.0),
+                  uniform->GetValue(-100.0, 600.0),
+                  uniform->GetValue(0.0, 40.0));
+        if (i % 4 == 1)
+        {
+            l2.x = l1.x;
+        }
+        else if (i % 4 == 2)
+        {
+            l2.y = l1.y;
+        }
+        else if (i % 4 == 3)
+        {
+            l2 = l1 + Vector(uniform->GetValue(-20.0, 20.0), uniform->GetValue(-20.0, 20.0), 0);
+        }
+        NS_TEST_ASSERT_MSG_EQ(index.IntersectsAnyBuilding(l1, l2),
+                              IntersectsAnyBuilding(l1, l2),
+                              "Wrong intersection between " << l1 << " and " << l2);
+        NS_TEST_ASSERT_MSG_EQ((index.GetIntersectingBuildings(l1, l2) ==
+                               GetIntersectingBuildings(l1, l2)),
+                              true,
+                              "Wrong buildings intersecting " << l1 << " and " << l2);
+    }
+
+    // random positions and the centers of the buildings; the positions
+    // inside overlapping buildings are skipped
+    std::vector<Vector> positions;
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        Box box = (*bit)->GetBoundaries();
+        positions.emplace_back((box.xMin + box.xMax) / 2, (box.yMin + box.yMax) / 2, 1.5);
+    }
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        positions.emplace_back(uniform->GetValue(-100.0, 1100.0),
+                               uniform->GetValue(-100.0, 600.0),
+                               uniform->GetValue(0.0, 40.0));
+    }
+    for (const auto& position : positions)
+    {
+        std::vector<Ptr<Building>> buildings = GetBuildingsAt(position);
+        if (buildings.size() <= 1)
+        {
+            NS_TEST_ASSERT_MSG_EQ(index.GetBuildingAt(position),
+                                  (buildings.empty() ? nullptr : buildings.front()),
+                                  "Wrong building at " << position);
+        }
+    }
+
+    // a building added later is indexed, too
+    Ptr<Building> building = CreateObject<Building>();
+    building->SetBoundaries(Box(2000.0, 2010.0, 2000.0, 2010.0, 0.0, 10.0));
+    NS_TEST_ASSERT_MSG_EQ(BuildingList::GetSpatialIndex().IntersectsAnyBuilding(
+                              Vector(1990.0, 2005.0, 1.5),
+                              Vector(2020.0, 2005.0, 1.5)),
+                          true,
+                          "The index has not been updated");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup building-test
  * Test suite for the buildings channel condition model
@@ -148,6 +352,7 @@ BuildingsChannelConditionModelsTestSuite::BuildingsChannelConditionModelsTestSui
     : TestSuite("buildings-channel-condition-model", Type::UNIT)
 {
     AddTestCase(new BuildingsChannelConditionModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BuildingSpatialIndexTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
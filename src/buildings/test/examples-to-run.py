@@ -10,6 +10,11 @@ cpp_examples = [
     ("buildings-pathloss-profiler", "True", "True"),
     ("outdoor-group-mobility-example --useHelper=0", "True", "True"),
     ("outdoor-group-mobility-example --useHelper=1", "True", "True"),
+    (
+        "buildings-spatial-index-benchmark --numBuildingsX=20 --numBuildingsY=20 --numNodes=20 --simTime=2",
+        "True",
+        "False",
+    ),
 ]
 
 # A list of Python examples to run in order to ensure that they remain
@@ -13,6 +13,7 @@
 #include <functional>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 /**
  * @file
@@ -138,7 +139,7 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_function(std::bind(function, obj, std::forward<Ts>(args)...))
         {
         }
 
@@ -154,7 +155,7 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         }
 
         std::function<void()> m_function;
-    }* ev = new EventMemberImpl(obj, mem_ptr, args...);
+    }* ev = new EventMemberImpl(obj, mem_ptr, std::forward<Ts>(args)...);
 
     return ev;
 }
@@ -168,7 +169,7 @@ MakeEvent(void (*f)(Us...), Ts... args)
       public:
         EventFunctionImpl(void (*function)(Us...), Ts... args)
             : m_function(function),
-              m_arguments(args...)
+              m_arguments(std::forward<Ts>(args)...)
         {
         }
 
@@ -185,7 +186,7 @@ MakeEvent(void (*f)(Us...), Ts... args)
 
         void (*m_function)(Us...);
         std::tuple<std::remove_reference_t<Ts>...> m_arguments;
-    }* ev = new EventFunctionImpl(f, args...);
+    }* ev = new EventFunctionImpl(f, std::forward<Ts>(args)...);
 
     return ev;
 }
@@ -198,7 +199,7 @@ MakeEvent(T function)
     {
       public:
         EventImplFunctional(T function)
-            : m_function(function)
+            : m_function(std::move(function))
         {
         }
 
@@ -213,7 +214,7 @@ MakeEvent(T function)
         }
 
         T m_function;
-    }* ev = new EventImplFunctional(function);
+    }* ev = new EventImplFunctional(std::move(function));
 
     return ev;
 }
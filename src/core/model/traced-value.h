@@ -216,6 +216,16 @@ class TracedValue
         m_cb.Disconnect(cb, path);
     }
 
+    /**
+     * Check if no Callback is connected.
+     *
+     * @returns \c true if no Callback is connected.
+     */
+    bool IsEmpty() const
+    {
+        return m_cb.IsEmpty();
+    }
+
     /**
      * Set the value of the underlying variable.
      *
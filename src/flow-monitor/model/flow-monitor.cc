@@ -8,11 +8,15 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <sstream>
 
@@ -70,7 +74,66 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("StreamInterval",
+                          "The interval between two writes of the statistics of the flows "
+                          "updated in the meantime to the StreamFilename file, or zero to "
+                          "disable the streaming of the statistics.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_streamInterval),
+                          MakeTimeChecker())
+            .AddAttribute("StreamFilename",
+                          "The name of the CSV file of the streamed statistics.",
+                          StringValue("FlowMonitorStats.csv"),
+                          MakeStringAccessor(&FlowMonitor::m_streamFilename),
+                          MakeStringChecker())
+            .AddAttribute("SketchEnabled",
+                          "If true, approximate statistics are collected in a sketch of fixed "
+                          "size, instead of the exact per-flow and per-probe statistics.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_sketchEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("SamplingRate",
+                          "When SketchEnabled is true, one packet out of SamplingRate is "
+                          "monitored, and its counts are scaled by SamplingRate.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_samplingRate),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SketchWidth",
+                          "The number of cells of a row of the count-min sketch of the flow "
+                          "counters.",
+                          UintegerValue(2048),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchWidth),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SketchDepth",
+                          "The number of rows of the count-min sketch of the flow counters.",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchDepth),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SketchHeavyHitters",
+                          "The number of flows with the most transmitted bytes kept by the "
+                          "sketch.",
+                          UintegerValue(16),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchHeavyHitters),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("SketchHllPrecision",
+                          "The base 2 logarithm of the number of registers of the HyperLogLog "
+                          "estimate of the number of flows.",
+                          UintegerValue(12),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchHllPrecision),
+                          MakeUintegerChecker<uint8_t>(4, 24))
+            .AddAttribute("SketchDelayAccuracy",
+                          "The relative accuracy of the delay quantiles of the sketch, "
+                          "strictly between 0 and 1.",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&FlowMonitor::m_sketchDelayAccuracy),
+                          MakeDoubleChecker<double>(std::nextafter(0.0, 1.0),
+                                                    std::nextafter(1.0, 0.0)))
+            .AddAttribute("SketchDelayBins",
+                          "The maximum number of bins of the delays of the sketch.",
+                          UintegerValue(2048),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchDelayBins),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -92,6 +155,7 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    m_streamFile.close();
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -108,10 +172,20 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
-    auto iter = m_flowStats.find(flowId);
-    if (iter == m_flowStats.end())
+    if (flowId >= m_flowIndex.size())
+    {
+        m_flowIndex.resize(flowId + 1);
+    }
+    FlowIndexEntry& entry = m_flowIndex[flowId];
+    if (m_streamFile.is_open() && !entry.updated)
+    {
+        entry.updated = true;
+        m_updatedFlows.push_back(flowId);
+    }
+    if (!entry.stats)
     {
         FlowMonitor::FlowStats& ref = m_flowStats[flowId];
+        entry.stats = &ref;
         ref.delaySum = Seconds(0);
         ref.jitterSum = Seconds(0);
         ref.lastDelay = Seconds(0);
@@ -131,7 +205,25 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
     }
     else
     {
-        return iter->second;
+        return *entry.stats;
+    }
+}
+
+void
+FlowMonitor::TrackPacket(const std::pair<FlowId, FlowPacketId>& key, Time now)
+{
+    m_trackedPacketsExpiry.emplace_back(key, now);
+    if (m_trackedPacketsExpiry.size() > 2 * m_trackedPackets.size() + 1024)
+    {
+        // too many stale entries: rebuild the entries from the tracked packets
+        m_trackedPacketsExpiry.clear();
+        for (const auto& tracked : m_trackedPackets)
+        {
+            m_trackedPacketsExpiry.emplace_back(tracked.first, tracked.second.lastSeenTime);
+        }
+        std::sort(m_trackedPacketsExpiry.begin(),
+                  m_trackedPacketsExpiry.end(),
+                  [](const auto& e1, const auto& e2) { return e1.second < e2.second; });
     }
 }
 
@@ -147,14 +239,30 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (m_sketchEnabled)
+    {
+        m_sketch.AddFlow(flowId);
+        if (!FlowSketch::IsSampled(flowId, packetId, m_samplingRate))
+        {
+            return;
+        }
+    }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
+    TrackedPacket& tracked = m_trackedPackets[key];
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
+    TrackPacket(key, now);
     NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
                                                                  << packetId << ").");
 
+    if (m_sketchEnabled)
+    {
+        m_sketch.AddTx(flowId, m_samplingRate, uint64_t(packetSize) * m_samplingRate);
+        return;
+    }
+
     probe->AddPacketStats(flowId, packetSize, Seconds(0));
 
     FlowStats& stats = GetStatsForFlow(flowId);
@@ -179,6 +287,10 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (m_sketchEnabled && !FlowSketch::IsSampled(flowId, packetId, m_samplingRate))
+    {
+        return;
+    }
     std::pair<FlowId, FlowPacketId> key(flowId, packetId);
     auto tracked = m_trackedPackets.find(key);
     if (tracked == m_trackedPackets.end())
@@ -190,6 +302,11 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
 
     tracked->second.timesForwarded++;
     tracked->second.lastSeenTime = Simulator::Now();
+    TrackPacket(key, tracked->second.lastSeenTime);
+    if (m_sketchEnabled)
+    {
+        return;
+    }
 
     Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
@@ -207,6 +324,10 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (m_sketchEnabled && !FlowSketch::IsSampled(flowId, packetId, m_samplingRate))
+    {
+        return;
+    }
     auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
     if (tracked == m_trackedPackets.end())
     {
@@ -217,6 +338,13 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
 
     Time now = Simulator::Now();
     Time delay = (now - tracked->second.firstSeenTime);
+    if (m_sketchEnabled)
+    {
+        m_sketch.AddRx(flowId, m_samplingRate, uint64_t(packetSize) * m_samplingRate);
+        m_sketch.AddDelay(delay);
+        m_trackedPackets.erase(tracked);
+        return;
+    }
     probe->AddPacketStats(flowId, packetSize, delay);
 
     FlowStats& stats = GetStatsForFlow(flowId);
@@ -284,6 +412,15 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (m_sketchEnabled)
+    {
+        if (FlowSketch::IsSampled(flowId, packetId, m_samplingRate))
+        {
+            m_sketch.AddLost(flowId, m_samplingRate);
+            m_trackedPackets.erase(std::make_pair(flowId, packetId));
+        }
+        return;
+    }
 
     probe->AddPacketDropStats(flowId, packetSize, reasonCode);
 
@@ -316,28 +453,44 @@ FlowMonitor::GetFlowStats() const
     return m_flowStats;
 }
 
+const FlowSketch&
+FlowMonitor::GetFlowSketch() const
+{
+    return m_sketch;
+}
+
 void
 FlowMonitor::CheckForLostPackets(Time maxDelay)
 {
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+    // the packets are visited in increasing order of the time when they were last seen
+    while (!m_trackedPacketsExpiry.empty() &&
+           now - m_trackedPacketsExpiry.front().second >= maxDelay)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
+        auto [key, time] = m_trackedPacketsExpiry.front();
+        m_trackedPacketsExpiry.pop_front();
+        auto iter = m_trackedPackets.find(key);
+        if (iter == m_trackedPackets.end() || iter->second.lastSeenTime != time)
         {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+            // stale entry: the packet was received, dropped or seen again
+            continue;
+        }
 
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
+        // packet is considered lost, add it to the loss statistics
+        if (m_sketchEnabled)
+        {
+            m_sketch.AddLost(key.first, m_samplingRate);
         }
         else
         {
-            iter++;
+            NS_ASSERT(key.first < m_flowIndex.size() && m_flowIndex[key.first].stats);
+            GetStatsForFlow(key.first).lostPackets++;
         }
+
+        // we won't track it anymore
+        m_trackedPackets.erase(iter);
     }
 }
 
@@ -359,6 +512,53 @@ FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
+    if (m_sketchEnabled)
+    {
+        m_sketch.Configure(m_sketchWidth,
+                           m_sketchDepth,
+                           m_sketchHeavyHitters,
+                           m_sketchHllPrecision,
+                           m_sketchDelayAccuracy,
+                           m_sketchDelayBins);
+    }
+    if (m_streamInterval.IsStrictlyPositive())
+    {
+        m_streamFile.open(m_streamFilename);
+        if (!m_streamFile.is_open())
+        {
+            NS_FATAL_ERROR("Can't open file " << m_streamFilename);
+        }
+        m_streamFile << "Time,FlowId,TxPackets,TxBytes,RxPackets,RxBytes,LostPackets,DelaySum,"
+                        "JitterSum,TimesForwarded\n";
+        Simulator::Schedule(m_streamInterval, &FlowMonitor::PeriodicStreamFlowStats, this);
+    }
+}
+
+void
+FlowMonitor::StreamFlowStats()
+{
+    NS_LOG_FUNCTION(this);
+    double now = Simulator::Now().GetSeconds();
+    std::sort(m_updatedFlows.begin(), m_updatedFlows.end());
+    for (FlowId flowId : m_updatedFlows)
+    {
+        FlowIndexEntry& entry = m_flowIndex[flowId];
+        const FlowStats& stats = *entry.stats;
+        entry.updated = false;
+        m_streamFile << now << "," << flowId << "," << stats.txPackets << "," << stats.txBytes
+                     << "," << stats.rxPackets << "," << stats.rxBytes << ","
+                     << stats.lostPackets << "," << stats.delaySum.GetSeconds() << ","
+                     << stats.jitterSum.GetSeconds() << "," << stats.timesForwarded << "\n";
+    }
+    m_updatedFlows.clear();
+    m_streamFile.flush();
+}
+
+void
+FlowMonitor::PeriodicStreamFlowStats()
+{
+    StreamFlowStats();
+    Simulator::Schedule(m_streamInterval, &FlowMonitor::PeriodicStreamFlowStats, this);
 }
 
 void
@@ -419,6 +619,10 @@ FlowMonitor::StopRightNow()
     }
     m_enabled = false;
     CheckForLostPackets();
+    if (m_streamFile.is_open())
+    {
+        StreamFlowStats();
+    }
 }
 
 void
@@ -487,6 +691,11 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowStats>\n";
 
+    if (m_sketchEnabled)
+    {
+        m_sketch.SerializeToXmlStream(os, indent);
+    }
+
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         (*iter)->SerializeToXmlStream(os, indent);
@@ -532,6 +741,8 @@ FlowMonitor::ResetAllStats()
 {
     NS_LOG_FUNCTION(this);
 
+    m_sketch.Clear();
+
     for (auto& iter : m_flowStats)
     {
         auto& flowStat = iter.second;
@@ -553,6 +764,14 @@ FlowMonitor::ResetAllStats()
         flowStat.jitterHistogram.Clear();
         flowStat.packetSizeHistogram.Clear();
         flowStat.flowInterruptionsHistogram.Clear();
+
+        // the reset statistics are streamed as well
+        FlowIndexEntry& entry = m_flowIndex[iter.first];
+        if (m_streamFile.is_open() && !entry.updated)
+        {
+            entry.updated = true;
+            m_updatedFlows.push_back(iter.first);
+        }
     }
 }
 
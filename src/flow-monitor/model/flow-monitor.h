@@ -11,6 +11,7 @@
 
 #include "flow-classifier.h"
 #include "flow-probe.h"
+#include "flow-sketch.h"
 
 #include "ns3/event-id.h"
 #include "ns3/histogram.h"
@@ -18,7 +19,10 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <deque>
+#include <fstream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -36,6 +40,9 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * When the SketchEnabled attribute is true, the FlowMonitor keeps approximate
+ * statistics in a FlowSketch of fixed size instead of the per-flow and
+ * per-probe statistics, and only one packet out of SamplingRate is monitored.
  */
 class FlowMonitor : public Object
 {
@@ -240,6 +247,11 @@ class FlowMonitor : public Object
     /// @returns the flows statistics
     const FlowStatsContainer& GetFlowStats() const;
 
+    /// Retrieve the approximate flow statistics, collected when the
+    /// SketchEnabled attribute is true.
+    /// @returns the sketch of the flow statistics
+    const FlowSketch& GetFlowSketch() const;
+
     /// Get a list of all FlowProbe's associated with this FlowMonitor
     /// @returns a list of all the probes
     const FlowProbeContainer& GetAllProbes() const;
@@ -283,14 +295,41 @@ class FlowMonitor : public Object
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
     };
 
+    /// Hash function of the (FlowId,PacketId) pair of a tracked packet
+    struct TrackedPacketHash
+    {
+        /// @param key the (FlowId,PacketId) pair
+        /// @return the hash of the pair
+        std::size_t operator()(const std::pair<FlowId, FlowPacketId>& key) const
+        {
+            return std::hash<uint64_t>()((uint64_t(key.first) << 32) | key.second);
+        }
+    };
+
+    /// Structure to represent a flow in the index of the flow statistics
+    struct FlowIndexEntry
+    {
+        FlowStats* stats{nullptr}; //!< the statistics of the flow, nullptr if not seen yet
+        bool updated{false};       //!< true if the statistics changed since the last stream
+    };
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
+    /// FlowId --> FlowIndexEntry, pointing to the statistics in m_flowStats
+    std::vector<FlowIndexEntry> m_flowIndex;
+    /// the flows whose statistics changed since the last stream
+    std::vector<FlowId> m_updatedFlows;
 
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+    typedef std::unordered_map<std::pair<FlowId, FlowPacketId>, TrackedPacket, TrackedPacketHash>
+        TrackedPacketMap;
     TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    /// (FlowId,PacketId) of the tracked packets, with the time when they were seen,
+    /// in increasing order of time. An entry is stale when the packet is not tracked
+    /// anymore, or has been seen again since.
+    std::deque<std::pair<std::pair<FlowId, FlowPacketId>, Time>> m_trackedPacketsExpiry;
+    Time m_maxPerHopDelay;           //!< Minimum per-hop delay
+    FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
@@ -303,14 +342,37 @@ class FlowMonitor : public Object
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    Time m_streamInterval;              //!< Interval between the streamed statistics
+    std::string m_streamFilename;       //!< Name of the file of the streamed statistics
+    std::ofstream m_streamFile;         //!< File of the streamed statistics
+    bool m_sketchEnabled;               //!< Whether the approximate statistics are collected
+    uint32_t m_samplingRate;            //!< One packet out of m_samplingRate is monitored
+    uint32_t m_sketchWidth;             //!< Width of the count-min sketch
+    uint32_t m_sketchDepth;             //!< Depth of the count-min sketch
+    uint32_t m_sketchHeavyHitters;      //!< Number of heavy hitters
+    uint8_t m_sketchHllPrecision;       //!< Precision of the estimate of the number of flows
+    double m_sketchDelayAccuracy;       //!< Relative accuracy of the delay quantiles
+    uint32_t m_sketchDelayBins;         //!< Maximum number of bins of the delays
+    FlowSketch m_sketch;                //!< Approximate flow statistics
 
     /// Get the stats for a given flow
     /// @param flowId the Flow identification
     /// @returns the stats of the flow
     FlowStats& GetStatsForFlow(FlowId flowId);
 
+    /// Record that a tracked packet has been seen now, for the loss detection
+    /// @param key the (FlowId,PacketId) pair of the packet
+    /// @param now the current time
+    void TrackPacket(const std::pair<FlowId, FlowPacketId>& key, Time now);
+
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Write the statistics of the flows updated since the last stream
+    void StreamFlowStats();
+
+    /// Periodic function to stream the statistics of the updated flows
+    void PeriodicStreamFlowStats();
 };
 
 } // namespace ns3
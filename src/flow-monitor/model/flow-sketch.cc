@@ -0,0 +1,335 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "flow-sketch.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FlowSketch");
+
+/**
+ * @ingroup flow-monitor
+ * Mix the bits of a 64 bits value (the finalizer of SplitMix64), so that
+ * consecutive flow identifiers are spread over the whole hash range.
+ * @param value the value
+ * @return the hash of the value
+ */
+static uint64_t
+Mix(uint64_t value)
+{
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+FlowSketch::FlowSketch()
+{
+    // a minimal sketch, until it is configured
+    Configure(1, 1, 0, 4, 0.01, 1);
+}
+
+void
+FlowSketch::Configure(uint32_t width,
+                      uint32_t depth,
+                      uint32_t heavyHitters,
+                      uint8_t hllPrecision,
+                      double delayAccuracy,
+                      uint32_t maxDelayBins)
+{
+    NS_LOG_FUNCTION(this << width << depth << heavyHitters << +hllPrecision << delayAccuracy
+                         << maxDelayBins);
+    NS_ABORT_MSG_IF(width == 0 || depth == 0, "The count-min sketch can't be empty");
+    NS_ABORT_MSG_IF(hllPrecision < 4 || hllPrecision > 24,
+                    "The HyperLogLog precision must be between 4 and 24");
+    NS_ABORT_MSG_IF(delayAccuracy <= 0 || delayAccuracy >= 1,
+                    "The delay accuracy must be strictly between 0 and 1");
+    NS_ABORT_MSG_IF(maxDelayBins == 0, "The delay sketch can't be empty");
+    m_width = width;
+    m_depth = depth;
+    m_maxHeavyHitters = heavyHitters;
+    m_hllPrecision = hllPrecision;
+    m_delayLogGamma = std::log((1 + delayAccuracy) / (1 - delayAccuracy));
+    m_maxDelayBins = maxDelayBins;
+    m_cells.assign(std::size_t(m_width) * m_depth, FlowCounters());
+    m_hllRegisters.assign(std::size_t(1) << m_hllPrecision, 0);
+    m_heavyHitters.clear();
+    m_heavyHitters.reserve(m_maxHeavyHitters);
+    m_delayBins.clear();
+    m_delayMinIndex = 0;
+    m_zeroDelays = 0;
+    m_delayCount = 0;
+}
+
+void
+FlowSketch::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    std::fill(m_cells.begin(), m_cells.end(), FlowCounters());
+    std::fill(m_hllRegisters.begin(), m_hllRegisters.end(), 0);
+    m_heavyHitters.clear();
+    m_delayBins.clear();
+    m_delayMinIndex = 0;
+    m_zeroDelays = 0;
+    m_delayCount = 0;
+}
+
+std::size_t
+FlowSketch::GetCell(uint32_t row, FlowId flowId) const
+{
+    return std::size_t(row) * m_width + Mix((uint64_t(row) << 32) | flowId) % m_width;
+}
+
+void
+FlowSketch::AddFlow(FlowId flowId)
+{
+    // the first bits of the hash select the register, and the register keeps
+    // the largest position of the first 1 bit in the remaining bits
+    uint64_t hash = Mix(~uint64_t(flowId));
+    std::size_t index = hash >> (64 - m_hllPrecision);
+    uint64_t remaining = (hash << m_hllPrecision) | (uint64_t(1) << (m_hllPrecision - 1));
+    uint8_t rank = std::countl_zero(remaining) + 1;
+    m_hllRegisters[index] = std::max(m_hllRegisters[index], rank);
+}
+
+void
+FlowSketch::AddTx(FlowId flowId, uint64_t packets, uint64_t bytes)
+{
+    uint64_t estimate = std::numeric_limits<uint64_t>::max();
+    for (uint32_t row = 0; row < m_depth; ++row)
+    {
+        FlowCounters& cell = m_cells[GetCell(row, flowId)];
+        cell.txPackets += packets;
+        cell.txBytes += bytes;
+        estimate = std::min(estimate, cell.txBytes);
+    }
+    UpdateHeavyHitters(flowId, estimate);
+}
+
+void
+FlowSketch::AddRx(FlowId flowId, uint64_t packets, uint64_t bytes)
+{
+    for (uint32_t row = 0; row < m_depth; ++row)
+    {
+        FlowCounters& cell = m_cells[GetCell(row, flowId)];
+        cell.rxPackets += packets;
+        cell.rxBytes += bytes;
+    }
+}
+
+void
+FlowSketch::AddLost(FlowId flowId, uint64_t packets)
+{
+    for (uint32_t row = 0; row < m_depth; ++row)
+    {
+        m_cells[GetCell(row, flowId)].lostPackets += packets;
+    }
+}
+
+void
+FlowSketch::UpdateHeavyHitters(FlowId flowId, uint64_t bytes)
+{
+    if (m_maxHeavyHitters == 0)
+    {
+        return;
+    }
+    for (auto& heavyHitter : m_heavyHitters)
+    {
+        if (heavyHitter.first == flowId)
+        {
+            heavyHitter.second = bytes;
+            return;
+        }
+    }
+    if (m_heavyHitters.size() < m_maxHeavyHitters)
+    {
+        m_heavyHitters.emplace_back(flowId, bytes);
+        return;
+    }
+    auto smallest = std::min_element(m_heavyHitters.begin(),
+                                     m_heavyHitters.end(),
+                                     [](const auto& h1, const auto& h2) {
+                                         return h1.second < h2.second;
+                                     });
+    if (bytes > smallest->second)
+    {
+        *smallest = {flowId, bytes};
+    }
+}
+
+void
+FlowSketch::AddDelay(Time delay)
+{
+    m_delayCount++;
+    double value = delay.GetSeconds();
+    if (value <= 0)
+    {
+        m_zeroDelays++;
+        return;
+    }
+
+    // bin k holds the delays in (gamma^(k-1), gamma^k]
+    auto index = static_cast<int32_t>(std::ceil(std::log(value) / m_delayLogGamma));
+    if (m_delayBins.empty())
+    {
+        m_delayMinIndex = index;
+        m_delayBins.push_back(0);
+    }
+    int32_t maxIndex = m_delayMinIndex + static_cast<int32_t>(m_delayBins.size()) - 1;
+    if (index < m_delayMinIndex)
+    {
+        // the delays below the lowest allowed bin are counted in that bin
+        index = std::max(index, maxIndex - static_cast<int32_t>(m_maxDelayBins) + 1);
+        m_delayBins.insert(m_delayBins.begin(), m_delayMinIndex - index, 0);
+        m_delayMinIndex = index;
+    }
+    else if (index > maxIndex)
+    {
+        m_delayBins.resize(index - m_delayMinIndex + 1, 0);
+        if (m_delayBins.size() > m_maxDelayBins)
+        {
+            // merge the lowest bins
+            std::size_t excess = m_delayBins.size() - m_maxDelayBins;
+            for (std::size_t i = 0; i < excess; ++i)
+            {
+                m_delayBins[excess] += m_delayBins[i];
+            }
+            m_delayBins.erase(m_delayBins.begin(), m_delayBins.begin() + excess);
+            m_delayMinIndex += excess;
+        }
+    }
+    m_delayBins[index - m_delayMinIndex]++;
+}
+
+FlowSketch::FlowCounters
+FlowSketch::GetCounters(FlowId flowId) const
+{
+    FlowCounters counters = m_cells[GetCell(0, flowId)];
+    for (uint32_t row = 1; row < m_depth; ++row)
+    {
+        const FlowCounters& cell = m_cells[GetCell(row, flowId)];
+        counters.txBytes = std::min(counters.txBytes, cell.txBytes);
+        counters.rxBytes = std::min(counters.rxBytes, cell.rxBytes);
+        counters.txPackets = std::min(counters.txPackets, cell.txPackets);
+        counters.rxPackets = std::min(counters.rxPackets, cell.rxPackets);
+        counters.lostPackets = std::min(counters.lostPackets, cell.lostPackets);
+    }
+    return counters;
+}
+
+std::vector<std::pair<FlowId, uint64_t>>
+FlowSketch::GetHeavyHitters() const
+{
+    std::vector<std::pair<FlowId, uint64_t>> heavyHitters = m_heavyHitters;
+    std::sort(heavyHitters.begin(), heavyHitters.end(), [](const auto& h1, const auto& h2) {
+        return h1.second > h2.second || (h1.second == h2.second && h1.first < h2.first);
+    });
+    return heavyHitters;
+}
+
+double
+FlowSketch::GetFlowCount() const
+{
+    double m = m_hllRegisters.size();
+    double sum = 0;
+    uint32_t zeros = 0;
+    for (uint8_t reg : m_hllRegisters)
+    {
+        sum += std::ldexp(1.0, -reg);
+        zeros += (reg == 0);
+    }
+    double alpha = m >= 128 ? 0.7213 / (1 + 1.079 / m) : m >= 64 ? 0.709 : m >= 32 ? 0.697 : 0.673;
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0)
+    {
+        // small range correction: linear counting
+        estimate = m * std::log(m / zeros);
+    }
+    return estimate;
+}
+
+uint64_t
+FlowSketch::GetDelayCount() const
+{
+    return m_delayCount;
+}
+
+Time
+FlowSketch::GetDelayQuantile(double quantile) const
+{
+    NS_ASSERT_MSG(quantile >= 0 && quantile <= 1, "Invalid quantile " << quantile);
+    if (m_delayCount == 0)
+    {
+        return Seconds(0);
+    }
+    double rank = quantile * (m_delayCount - 1);
+    uint64_t count = m_zeroDelays;
+    if (count > rank)
+    {
+        return Seconds(0);
+    }
+    double gamma = std::exp(m_delayLogGamma);
+    for (std::size_t i = 0; i < m_delayBins.size(); ++i)
+    {
+        count += m_delayBins[i];
+        if (count > rank)
+        {
+            double upper = std::exp((m_delayMinIndex + static_cast<int32_t>(i)) * m_delayLogGamma);
+            return Seconds(2 * upper / (gamma + 1));
+        }
+    }
+    NS_ASSERT_MSG(false, "The delay bins do not hold all the delays");
+    return Seconds(0);
+}
+
+bool
+FlowSketch::IsSampled(FlowId flowId, FlowPacketId packetId, uint32_t samplingRate)
+{
+    return samplingRate <= 1 || Mix((uint64_t(flowId) << 32) | packetId) % samplingRate == 0;
+}
+
+std::size_t
+FlowSketch::GetMemorySize() const
+{
+    return m_cells.size() * sizeof(FlowCounters) +
+           m_maxHeavyHitters * sizeof(std::pair<FlowId, uint64_t>) + m_hllRegisters.size() +
+           m_maxDelayBins * sizeof(uint64_t);
+}
+
+void
+FlowSketch::SerializeToXmlStream(std::ostream& os, uint16_t indent) const
+{
+    os << std::string(indent, ' ') << "<FlowSketch flows=\"" << GetFlowCount() << "\""
+       << " delays=\"" << m_delayCount << "\">\n";
+    indent += 2;
+    for (const auto& heavyHitter : GetHeavyHitters())
+    {
+        FlowCounters counters = GetCounters(heavyHitter.first);
+        os << std::string(indent, ' ') << "<HeavyHitter flowId=\"" << heavyHitter.first << "\""
+           << " txBytes=\"" << counters.txBytes << "\""
+           << " rxBytes=\"" << counters.rxBytes << "\""
+           << " txPackets=\"" << counters.txPackets << "\""
+           << " rxPackets=\"" << counters.rxPackets << "\""
+           << " lostPackets=\"" << counters.lostPackets << "\" />\n";
+    }
+    for (double quantile : {0.5, 0.9, 0.95, 0.99})
+    {
+        os << std::string(indent, ' ') << "<DelayQuantile quantile=\"" << quantile << "\""
+           << " delay=\"" << GetDelayQuantile(quantile).As(Time::NS) << "\" />\n";
+    }
+    indent -= 2;
+    os << std::string(indent, ' ') << "</FlowSketch>\n";
+}
+
+} // namespace ns3
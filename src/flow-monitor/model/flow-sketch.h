@@ -0,0 +1,212 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef FLOW_SKETCH_H
+#define FLOW_SKETCH_H
+
+#include "flow-classifier.h"
+
+#include "ns3/nstime.h"
+
+#include <ostream>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup flow-monitor
+ * @brief Approximate statistics of the flows, kept in a fixed amount of memory
+ *
+ * The FlowSketch is used by the FlowMonitor in place of the per-flow
+ * FlowStats when the number of flows is too large to keep exact statistics.
+ * Its memory depends on its configuration only, and not on the number of
+ * flows or of packets:
+ *
+ * - the counters of the flows are kept in a count-min sketch of \a depth
+ *   rows of \a width cells. The counters of a flow are never underestimated,
+ *   and are overestimated by at most e/width times the sum of the counters
+ *   of all the flows, with probability 1 - exp(-depth);
+ * - the flows with the most transmitted bytes (the heavy hitters) are kept,
+ *   with the estimate of their transmitted bytes;
+ * - the number of flows is estimated by a HyperLogLog counter of 2^precision
+ *   registers, with a relative standard error of 1.04 / sqrt(2^precision);
+ * - the quantiles of the delays are estimated by a DDSketch, with a relative
+ *   error of at most \a delayAccuracy. When the delays span more than
+ *   \a maxDelayBins bins, the lowest bins are merged, and only the quantiles
+ *   above the merged bins keep this guarantee.
+ */
+class FlowSketch
+{
+  public:
+    /// Estimated counters of a flow
+    struct FlowCounters
+    {
+        uint64_t txBytes{0};     //!< transmitted bytes
+        uint64_t rxBytes{0};     //!< received bytes
+        uint64_t txPackets{0};   //!< transmitted packets
+        uint64_t rxPackets{0};   //!< received packets
+        uint64_t lostPackets{0}; //!< dropped or lost packets
+    };
+
+    /**
+     * @brief Constructor of a minimal sketch, to be configured with Configure()
+     */
+    FlowSketch();
+
+    /**
+     * @brief Set the size of the sketch, and clear it
+     * @param width the number of cells of a row of the count-min sketch
+     * @param depth the number of rows of the count-min sketch
+     * @param heavyHitters the number of heavy hitters
+     * @param hllPrecision the base 2 logarithm of the number of HyperLogLog registers
+     * @param delayAccuracy the relative accuracy of the delay quantiles
+     * @param maxDelayBins the maximum number of bins of the delays
+     */
+    void Configure(uint32_t width,
+                   uint32_t depth,
+                   uint32_t heavyHitters,
+                   uint8_t hllPrecision,
+                   double delayAccuracy,
+                   uint32_t maxDelayBins);
+
+    /**
+     * @brief Clear the sketch content
+     */
+    void Clear();
+
+    /**
+     * @brief Count a new flow in the estimate of the number of flows
+     *
+     * Counting a flow more than once does not change the estimate.
+     *
+     * @param flowId the flow identifier
+     */
+    void AddFlow(FlowId flowId);
+
+    /**
+     * @brief Add transmitted packets to the counters of a flow
+     * @param flowId the flow identifier
+     * @param packets the number of packets
+     * @param bytes the number of bytes
+     */
+    void AddTx(FlowId flowId, uint64_t packets, uint64_t bytes);
+
+    /**
+     * @brief Add received packets to the counters of a flow
+     * @param flowId the flow identifier
+     * @param packets the number of packets
+     * @param bytes the number of bytes
+     */
+    void AddRx(FlowId flowId, uint64_t packets, uint64_t bytes);
+
+    /**
+     * @brief Add dropped or lost packets to the counters of a flow
+     * @param flowId the flow identifier
+     * @param packets the number of packets
+     */
+    void AddLost(FlowId flowId, uint64_t packets);
+
+    /**
+     * @brief Add a packet delay to the estimate of the delay quantiles
+     * @param delay the delay
+     */
+    void AddDelay(Time delay);
+
+    /**
+     * @brief Get the estimated counters of a flow
+     * @param flowId the flow identifier
+     * @return the counters
+     */
+    FlowCounters GetCounters(FlowId flowId) const;
+
+    /**
+     * @brief Get the heavy hitters
+     * @return the flow identifier and the estimated transmitted bytes of the
+     * heavy hitters, in decreasing order of transmitted bytes
+     */
+    std::vector<std::pair<FlowId, uint64_t>> GetHeavyHitters() const;
+
+    /**
+     * @brief Get the estimated number of flows
+     * @return the number of flows
+     */
+    double GetFlowCount() const;
+
+    /**
+     * @brief Get the number of delays added to the sketch
+     * @return the number of delays
+     */
+    uint64_t GetDelayCount() const;
+
+    /**
+     * @brief Get an estimated quantile of the delays
+     * @param quantile the quantile, between 0 and 1
+     * @return the estimated delay, or zero if no delay was added
+     */
+    Time GetDelayQuantile(double quantile) const;
+
+    /**
+     * @brief Check if a packet is sampled
+     *
+     * The decision depends only on the identifiers of the packet, so that a
+     * packet is sampled either by all the probes, or by none.
+     *
+     * @param flowId the flow identifier
+     * @param packetId the packet identifier
+     * @param samplingRate the sampling rate: one packet out of samplingRate is sampled
+     * @return true if the packet is sampled
+     */
+    static bool IsSampled(FlowId flowId, FlowPacketId packetId, uint32_t samplingRate);
+
+    /**
+     * @brief Get the memory used by the sketch content
+     * @return the number of bytes
+     */
+    std::size_t GetMemorySize() const;
+
+    /**
+     * @brief Serializes the results to an std::ostream in XML format
+     * @param os the output stream
+     * @param indent number of spaces to use as base indentation level
+     */
+    void SerializeToXmlStream(std::ostream& os, uint16_t indent) const;
+
+  private:
+    /**
+     * @brief Get the cell of a flow in a row of the count-min sketch
+     * @param row the row
+     * @param flowId the flow identifier
+     * @return the index of the cell in m_cells
+     */
+    std::size_t GetCell(uint32_t row, FlowId flowId) const;
+
+    /**
+     * @brief Update the heavy hitters with the estimated bytes of a flow
+     * @param flowId the flow identifier
+     * @param bytes the estimated transmitted bytes of the flow
+     */
+    void UpdateHeavyHitters(FlowId flowId, uint64_t bytes);
+
+    uint32_t m_width;                    //!< cells of a row of the count-min sketch
+    uint32_t m_depth;                    //!< rows of the count-min sketch
+    std::vector<FlowCounters> m_cells;   //!< cells of the count-min sketch, row by row
+    uint32_t m_maxHeavyHitters;          //!< maximum number of heavy hitters
+    /// heavy hitters: flow identifier and estimated transmitted bytes
+    std::vector<std::pair<FlowId, uint64_t>> m_heavyHitters;
+    uint8_t m_hllPrecision;              //!< log2 of the number of HyperLogLog registers
+    std::vector<uint8_t> m_hllRegisters; //!< HyperLogLog registers
+    double m_delayLogGamma;              //!< logarithm of the ratio of the bounds of a delay bin
+    uint32_t m_maxDelayBins;             //!< maximum number of delay bins
+    std::vector<uint64_t> m_delayBins;   //!< number of delays of each bin
+    int32_t m_delayMinIndex;             //!< index of the first delay bin
+    uint64_t m_zeroDelays;               //!< number of null delays
+    uint64_t m_delayCount;               //!< number of delays
+};
+
+} // namespace ns3
+
+#endif /* FLOW_SKETCH_H */
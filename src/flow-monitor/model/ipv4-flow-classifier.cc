@@ -80,6 +80,17 @@ operator==(const Ipv4FlowClassifier::FiveTuple& t1, const Ipv4FlowClassifier::Fi
             t1.sourcePort == t2.sourcePort && t1.destinationPort == t2.destinationPort);
 }
 
+std::size_t
+Ipv4FlowClassifier::FiveTupleHash::operator()(const FiveTuple& tuple) const
+{
+    uint64_t addresses =
+        (uint64_t(tuple.sourceAddress.Get()) << 32) | tuple.destinationAddress.Get();
+    uint64_t ports = (uint64_t(tuple.protocol) << 32) | (uint32_t(tuple.sourcePort) << 16) |
+                     tuple.destinationPort;
+    uint64_t hash = (addresses ^ (ports * 0x9e3779b97f4a7c15ULL)) * 0x9e3779b97f4a7c15ULL;
+    return hash ^ (hash >> 32);
+}
+
 Ipv4FlowClassifier::Ipv4FlowClassifier()
 {
 }
@@ -134,47 +145,49 @@ Ipv4FlowClassifier::Classify(const Ipv4Header& ipHeader,
     tuple.destinationPort = dstPort;
 
     // try to insert the tuple, but check if it already exists
-    auto insert = m_flowMap.insert(std::pair<FiveTuple, FlowId>(tuple, 0));
+    auto insert = m_flowMap.emplace(tuple, m_flows.size());
 
     // if the insertion succeeded, we need to assign this tuple a new flow identifier
     if (insert.second)
     {
-        FlowId newFlowId = GetNewFlowId();
-        insert.first->second = newFlowId;
-        m_flowPktIdMap[newFlowId] = 0;
-        m_flowDscpMap[newFlowId];
+        m_flows.push_back({tuple, GetNewFlowId(), 0, {}});
     }
     else
     {
-        m_flowPktIdMap[insert.first->second]++;
+        m_flows[insert.first->second].lastPacketId++;
     }
+    Flow& flow = m_flows[insert.first->second];
 
     // increment the counter of packets with the same DSCP value
-    Ipv4Header::DscpType dscp = ipHeader.GetDscp();
-    auto dscpInserter = m_flowDscpMap[insert.first->second].insert(
-        std::pair<Ipv4Header::DscpType, uint32_t>(dscp, 1));
+    flow.dscpCounts[ipHeader.GetDscp()]++;
 
-    // if the insertion did not succeed, we need to increment the counter
-    if (!dscpInserter.second)
-    {
-        m_flowDscpMap[insert.first->second][dscp]++;
-    }
-
-    *out_flowId = insert.first->second;
-    *out_packetId = m_flowPktIdMap[*out_flowId];
+    *out_flowId = flow.flowId;
+    *out_packetId = flow.lastPacketId;
 
     return true;
 }
 
+const Ipv4FlowClassifier::Flow*
+Ipv4FlowClassifier::GetFlow(FlowId flowId) const
+{
+    auto flow = std::lower_bound(m_flows.begin(),
+                                 m_flows.end(),
+                                 flowId,
+                                 [](const Flow& f, FlowId id) { return f.flowId < id; });
+    if (flow == m_flows.end() || flow->flowId != flowId)
+    {
+        return nullptr;
+    }
+    return &*flow;
+}
+
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow(FlowId flowId) const
 {
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    const Flow* flow = GetFlow(flowId);
+    if (flow)
     {
-        if (iter->second == flowId)
-        {
-            return iter->first;
-        }
+        return flow->tuple;
     }
     NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     FiveTuple retval = {Ipv4Address::GetZero(), Ipv4Address::GetZero(), 0, 0, 0};
@@ -191,15 +204,15 @@ Ipv4FlowClassifier::SortByCount::operator()(std::pair<Ipv4Header::DscpType, uint
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t>>
 Ipv4FlowClassifier::GetDscpCounts(FlowId flowId) const
 {
-    auto flow = m_flowDscpMap.find(flowId);
+    const Flow* flow = GetFlow(flowId);
 
-    if (flow == m_flowDscpMap.end())
+    if (!flow)
     {
         NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
 
-    std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> v(flow->second.begin(),
-                                                             flow->second.end());
+    std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> v(flow->dscpCounts.begin(),
+                                                             flow->dscpCounts.end());
     std::sort(v.begin(), v.end(), SortByCount());
     return v;
 }
@@ -210,28 +223,34 @@ Ipv4FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     Indent(os, indent);
     os << "<Ipv4FlowClassifier>\n";
 
+    // the flows are written in the order of their tuples
+    std::vector<const Flow*> flows;
+    flows.reserve(m_flows.size());
+    for (const auto& flow : m_flows)
+    {
+        flows.push_back(&flow);
+    }
+    std::sort(flows.begin(), flows.end(), [](const Flow* f1, const Flow* f2) {
+        return f1->tuple < f2->tuple;
+    });
+
     indent += 2;
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    for (const Flow* flow : flows)
     {
         Indent(os, indent);
-        os << "<Flow flowId=\"" << iter->second << "\""
-           << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-           << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-           << " protocol=\"" << int(iter->first.protocol) << "\""
-           << " sourcePort=\"" << iter->first.sourcePort << "\""
-           << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
+        os << "<Flow flowId=\"" << flow->flowId << "\""
+           << " sourceAddress=\"" << flow->tuple.sourceAddress << "\""
+           << " destinationAddress=\"" << flow->tuple.destinationAddress << "\""
+           << " protocol=\"" << int(flow->tuple.protocol) << "\""
+           << " sourcePort=\"" << flow->tuple.sourcePort << "\""
+           << " destinationPort=\"" << flow->tuple.destinationPort << "\">\n";
 
         indent += 2;
-        auto flow = m_flowDscpMap.find(iter->second);
-
-        if (flow != m_flowDscpMap.end())
+        for (auto i = flow->dscpCounts.begin(); i != flow->dscpCounts.end(); i++)
         {
-            for (auto i = flow->second.begin(); i != flow->second.end(); i++)
-            {
-                Indent(os, indent);
-                os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
-                   << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+            Indent(os, indent);
+            os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
+               << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
         indent -= 2;
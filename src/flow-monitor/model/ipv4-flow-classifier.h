@@ -15,6 +15,8 @@
 
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -82,12 +84,33 @@ class Ipv4FlowClassifier : public FlowClassifier
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
   private:
-    /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t>> m_flowDscpMap;
+    /// Hash function of a FiveTuple
+    struct FiveTupleHash
+    {
+        /// @param tuple the FiveTuple
+        /// @return the hash of the FiveTuple
+        std::size_t operator()(const FiveTuple& tuple) const;
+    };
+
+    /// Structure to represent a classified flow
+    struct Flow
+    {
+        FiveTuple tuple;           //!< the tuple of the flow
+        FlowId flowId;             //!< the identifier of the flow
+        FlowPacketId lastPacketId; //!< the identifier of the last packet of the flow
+        /// (DSCP value, packet count) pairs
+        std::map<Ipv4Header::DscpType, uint32_t> dscpCounts;
+    };
+
+    /// Get a flow from its identifier
+    /// @param flowId the FlowId to search for
+    /// @returns the flow, or nullptr if not found
+    const Flow* GetFlow(FlowId flowId) const;
+
+    /// Flows, in increasing order of FlowId
+    std::vector<Flow> m_flows;
+    /// Map FiveTuples to the index of their flow in m_flows
+    std::unordered_map<FiveTuple, std::size_t, FiveTupleHash> m_flowMap;
 };
 
 /**
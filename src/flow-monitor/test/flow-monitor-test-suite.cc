@@ -0,0 +1,293 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * A FlowProbe reporting the packets of the test to the FlowMonitor.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param monitor the FlowMonitor of the probe
+     */
+    FlowMonitorTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * Check the packets found lost by the FlowMonitor, which only visits the
+ * expired packets, against a walk of all the tracked packets, as done by
+ * the previous implementation.
+ */
+class FlowMonitorLostPacketsTestCase : public TestCase
+{
+  public:
+    FlowMonitorLostPacketsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Report a random event of a random packet, or check for lost packets
+     * @param step the index of the step
+     */
+    void Step(uint32_t step);
+
+    /**
+     * Check for lost packets with a full walk of the reference tracked
+     * packets, and compare the lost packets with the ones of the monitor
+     * @param maxDelay the time after which a packet not seen is lost
+     */
+    void CheckForLostPackets(Time maxDelay);
+
+    /// (FlowId,PacketId) of a packet
+    using PacketKey = std::pair<FlowId, FlowPacketId>;
+
+    Ptr<FlowMonitor> m_monitor;            //!< the monitor under test
+    Ptr<FlowProbe> m_probe;                //!< the probe of the monitor
+    std::mt19937 m_rng;                    //!< the random number generator
+    std::map<PacketKey, Time> m_tracked;   //!< reference tracked packets, with their last seen time
+    std::map<FlowId, uint32_t> m_lost;     //!< reference lost packets of each flow
+    std::map<FlowId, FlowPacketId> m_next; //!< next PacketId of each flow
+    uint32_t m_checks;                     //!< number of checks for lost packets
+};
+
+FlowMonitorLostPacketsTestCase::FlowMonitorLostPacketsTestCase()
+    : TestCase("Check the detection of the lost packets against a full walk"),
+      m_rng(1),
+      m_checks(0)
+{
+}
+
+void
+FlowMonitorLostPacketsTestCase::CheckForLostPackets(Time maxDelay)
+{
+    m_monitor->CheckForLostPackets(maxDelay);
+    Time now = Simulator::Now();
+    for (auto it = m_tracked.begin(); it != m_tracked.end();)
+    {
+        if (now - it->second >= maxDelay)
+        {
+            m_lost[it->first.first]++;
+            it = m_tracked.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    m_checks++;
+
+    const FlowMonitor::FlowStatsContainer& stats = m_monitor->GetFlowStats();
+    for (const auto& [flowId, lost] : m_lost)
+    {
+        auto it = stats.find(flowId);
+        NS_TEST_ASSERT_MSG_EQ((it != stats.end()), true, "Unknown flow " << flowId);
+        NS_TEST_ASSERT_MSG_EQ(it->second.lostPackets,
+                              lost,
+                              "Wrong lost packets of flow " << flowId << " at " << now.As(Time::S)
+                                                            << " with max delay "
+                                                            << maxDelay.As(Time::MS));
+    }
+}
+
+void
+FlowMonitorLostPacketsTestCase::Step(uint32_t step)
+{
+    // the last steps only send and forward a few packets, so that the stale
+    // entries of the expiry queue pile up and the queue is rebuilt
+    const uint32_t steps = 12000;
+    const uint32_t lastSteps = 3000;
+    std::uniform_int_distribution<uint32_t> percent(0, 99);
+    uint32_t action = percent(m_rng);
+    if (step >= steps - lastSteps)
+    {
+        action = action < 5 ? 0 : 50;
+    }
+
+    auto randomTracked = [this]() {
+        std::uniform_int_distribution<std::size_t> index(0, m_tracked.size() - 1);
+        return std::next(m_tracked.begin(), index(m_rng));
+    };
+    const uint32_t size = 100;
+    Time now = Simulator::Now();
+    if (action < 40)
+    {
+        FlowId flowId = std::uniform_int_distribution<FlowId>(1, 20)(m_rng);
+        FlowPacketId packetId = m_next[flowId]++;
+        m_monitor->ReportFirstTx(m_probe, flowId, packetId, size);
+        m_tracked[{flowId, packetId}] = now;
+    }
+    else if (action < 90 && !m_tracked.empty())
+    {
+        auto it = randomTracked();
+        m_monitor->ReportForwarding(m_probe, it->first.first, it->first.second, size);
+        it->second = now;
+    }
+    else if (action < 95 && !m_tracked.empty())
+    {
+        auto it = randomTracked();
+        m_monitor->ReportLastRx(m_probe, it->first.first, it->first.second, size);
+        m_tracked.erase(it);
+    }
+    else if (action < 97 && !m_tracked.empty())
+    {
+        auto it = randomTracked();
+        m_monitor->ReportDrop(m_probe, it->first.first, it->first.second, size, 0);
+        m_lost[it->first.first]++;
+        m_tracked.erase(it);
+    }
+    else if (action >= 97)
+    {
+        const std::vector<Time> maxDelays{MilliSeconds(0),
+                                          MilliSeconds(5),
+                                          MilliSeconds(50),
+                                          MilliSeconds(500),
+                                          Seconds(2)};
+        std::uniform_int_distribution<std::size_t> index(0, maxDelays.size() - 1);
+        CheckForLostPackets(maxDelays[index(m_rng)]);
+    }
+
+    if (step + 1 < steps)
+    {
+        Simulator::Schedule(MilliSeconds(1), &FlowMonitorLostPacketsTestCase::Step, this, step + 1);
+    }
+}
+
+void
+FlowMonitorLostPacketsTestCase::DoRun()
+{
+    // the periodic check of the monitor never finds a lost packet during the test
+    m_monitor = CreateObjectWithAttributes<FlowMonitor>("MaxPerHopDelay", TimeValue(Seconds(100)));
+    m_monitor->StartRightNow();
+    m_probe = Create<FlowMonitorTestProbe>(m_monitor);
+    Simulator::Schedule(MilliSeconds(1), &FlowMonitorLostPacketsTestCase::Step, this, 0);
+    Simulator::Stop(Seconds(13));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT(m_checks, 100, "Too few checks for lost packets");
+    NS_TEST_EXPECT_MSG_GT(m_tracked.size(), 0, "No packet left to find lost");
+    CheckForLostPackets(Seconds(0));
+    NS_TEST_EXPECT_MSG_EQ(m_tracked.size(), 0, "Packets not found lost");
+
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+    m_probe = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * Check the rows of the CSV file of the streamed statistics, including the
+ * rows of the flows whose statistics are reset.
+ */
+class FlowMonitorStreamTestCase : public TestCase
+{
+  public:
+    FlowMonitorStreamTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorStreamTestCase::FlowMonitorStreamTestCase()
+    : TestCase("Check the streamed statistics of the updated flows")
+{
+}
+
+void
+FlowMonitorStreamTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("flow-monitor-stream.csv");
+    Ptr<FlowMonitor> monitor = CreateObjectWithAttributes<FlowMonitor>("StreamInterval",
+                                                                       TimeValue(Seconds(1)),
+                                                                       "StreamFilename",
+                                                                       StringValue(filename));
+    monitor->StartRightNow();
+    Ptr<FlowProbe> probe = Create<FlowMonitorTestProbe>(monitor);
+
+    // both flows are updated in the first second, only flow 2 in the second one,
+    // and both are reset in the third one
+    Simulator::Schedule(Seconds(0.1), [=]() {
+        monitor->ReportFirstTx(probe, 1, 0, 100);
+        monitor->ReportFirstTx(probe, 2, 0, 200);
+    });
+    Simulator::Schedule(Seconds(0.2), [=]() { monitor->ReportLastRx(probe, 1, 0, 100); });
+    Simulator::Schedule(Seconds(1.5), [=]() { monitor->ReportLastRx(probe, 2, 0, 200); });
+    Simulator::Schedule(Seconds(2.5), [=]() { monitor->ResetAllStats(); });
+    // nothing is updated between the last periodic write and the stop
+    Simulator::Schedule(Seconds(3.5), [=]() { monitor->StopRightNow(); });
+    Simulator::Stop(Seconds(3.9));
+    Simulator::Run();
+    monitor->Dispose();
+    Simulator::Destroy();
+
+    std::ifstream file(filename);
+    NS_TEST_ASSERT_MSG_EQ(file.is_open(), true, "Can't open " << filename);
+    std::vector<std::string> rows;
+    std::string row;
+    while (std::getline(file, row))
+    {
+        rows.push_back(row);
+    }
+    const std::vector<std::string> expected{
+        "Time,FlowId,TxPackets,TxBytes,RxPackets,RxBytes,LostPackets,DelaySum,JitterSum,"
+        "TimesForwarded",
+        "1,1,1,100,1,100,0,0.1,0,0",
+        "1,2,1,200,0,0,0,0,0,0",
+        "2,2,1,200,1,200,0,1.4,0,0",
+        "3,1,0,0,0,0,0,0,0,0",
+        "3,2,0,0,0,0,0,0,0,0",
+    };
+    NS_TEST_ASSERT_MSG_EQ(rows.size(), expected.size(), "Wrong number of rows");
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rows[i], expected[i], "Wrong row " << i);
+    }
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * Flow Monitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", Type::UNIT)
+{
+    AddTestCase(new FlowMonitorLostPacketsTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorStreamTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static FlowMonitorTestSuite g_flowMonitorTestSuite;
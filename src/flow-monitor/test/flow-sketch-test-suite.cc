@@ -0,0 +1,468 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/flow-sketch.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+
+using namespace ns3;
+
+/**
+ * @ingroup flow-monitor
+ * @defgroup flow-monitor-test Flow Monitor module tests
+ */
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * Check the flow counters and the heavy hitters of the sketch against the
+ * exact counters.
+ */
+class FlowSketchCountersTestCase : public TestCase
+{
+  public:
+    FlowSketchCountersTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowSketchCountersTestCase::FlowSketchCountersTestCase()
+    : TestCase("Check the flow counters and the heavy hitters of the sketch")
+{
+}
+
+void
+FlowSketchCountersTestCase::DoRun()
+{
+    const uint32_t width = 4096;
+    const uint32_t depth = 4;
+    const uint32_t heavyHitters = 10;
+    FlowSketch sketch;
+    sketch.Configure(width, depth, heavyHitters, 12, 0.01, 2048);
+
+    // flows 1 to 10 are the heavy hitters, the others send 1 to 20 packets
+    const uint32_t flows = 5000;
+    std::vector<uint32_t> packets(flows + 1);
+    for (FlowId flowId = 1; flowId <= flows; ++flowId)
+    {
+        packets[flowId] = flowId <= heavyHitters ? 1000 * (heavyHitters + 1 - flowId)
+                                                 : 1 + flowId % 20;
+    }
+    std::map<FlowId, FlowSketch::FlowCounters> exact;
+    uint64_t totalBytes = 0;
+    for (bool added = true; added;)
+    {
+        added = false;
+        for (FlowId flowId = 1; flowId <= flows; ++flowId)
+        {
+            if (packets[flowId] > 0)
+            {
+                uint32_t size = 100 + flowId % 1400;
+                packets[flowId]--;
+                sketch.AddTx(flowId, 1, size);
+                exact[flowId].txPackets++;
+                exact[flowId].txBytes += size;
+                totalBytes += size;
+                if (flowId % 3 > 0)
+                {
+                    sketch.AddRx(flowId, 1, size);
+                    exact[flowId].rxPackets++;
+                    exact[flowId].rxBytes += size;
+                }
+                else
+                {
+                    sketch.AddLost(flowId, 1);
+                    exact[flowId].lostPackets++;
+                }
+                added = true;
+            }
+        }
+    }
+
+    // the counters are never underestimated, and are overestimated by at most
+    // e / width of the total with probability 1 - exp(-depth)
+    double bound = std::exp(1.0) / width * totalBytes;
+    uint32_t outOfBound = 0;
+    for (const auto& [flowId, counters] : exact)
+    {
+        FlowSketch::FlowCounters estimate = sketch.GetCounters(flowId);
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(estimate.txBytes, counters.txBytes, "Underestimated flow");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(estimate.rxBytes, counters.rxBytes, "Underestimated flow");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(estimate.txPackets, counters.txPackets, "Underestimated flow");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(estimate.rxPackets, counters.rxPackets, "Underestimated flow");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(estimate.lostPackets,
+                                    counters.lostPackets,
+                                    "Underestimated flow");
+        outOfBound += (estimate.txBytes - counters.txBytes > bound);
+    }
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(outOfBound,
+                                2 * std::exp(-double(depth)) * flows,
+                                "Too many flows exceed the error bound");
+
+    auto heavy = sketch.GetHeavyHitters();
+    NS_TEST_ASSERT_MSG_EQ(heavy.size(), heavyHitters, "Wrong number of heavy hitters");
+    for (uint32_t i = 0; i < heavyHitters; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(heavy[i].first, i + 1, "Wrong heavy hitter " << i);
+        NS_TEST_EXPECT_MSG_EQ(heavy[i].second,
+                              sketch.GetCounters(i + 1).txBytes,
+                              "Wrong bytes of heavy hitter " << i);
+    }
+    NS_TEST_EXPECT_MSG_LT(sketch.GetMemorySize(), 1000000, "The sketch is too large");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * Check the estimated number of flows of the sketch.
+ */
+class FlowSketchFlowCountTestCase : public TestCase
+{
+  public:
+    FlowSketchFlowCountTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowSketchFlowCountTestCase::FlowSketchFlowCountTestCase()
+    : TestCase("Check the estimated number of flows of the sketch")
+{
+}
+
+void
+FlowSketchFlowCountTestCase::DoRun()
+{
+    const uint8_t precision = 12;
+    // three times the relative standard error
+    const double tolerance = 3 * 1.04 / std::sqrt(std::ldexp(1.0, precision));
+    FlowSketch sketch;
+    sketch.Configure(16, 1, 0, precision, 0.01, 16);
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetFlowCount(), 0, "No flow was added");
+
+    uint32_t count = 0;
+    for (uint32_t flows : {100, 1000, 10000, 100000, 1000000})
+    {
+        for (; count < flows; ++count)
+        {
+            // each flow is counted twice
+            sketch.AddFlow(count + 1);
+            sketch.AddFlow(count / 2 + 1);
+        }
+        NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetFlowCount(),
+                                  flows,
+                                  flows * tolerance,
+                                  "Wrong number of flows");
+    }
+
+    sketch.Clear();
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetFlowCount(), 0, "The sketch was cleared");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * Check the delay quantiles of the sketch against the exact quantiles.
+ */
+class FlowSketchDelayTestCase : public TestCase
+{
+  public:
+    FlowSketchDelayTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the quantiles of the delays
+     * @param maxBins the maximum number of bins of the sketch
+     * @param minQuantile the smallest quantile that is checked
+     */
+    void CheckQuantiles(uint32_t maxBins, double minQuantile);
+};
+
+FlowSketchDelayTestCase::FlowSketchDelayTestCase()
+    : TestCase("Check the delay quantiles of the sketch")
+{
+}
+
+void
+FlowSketchDelayTestCase::CheckQuantiles(uint32_t maxBins, double minQuantile)
+{
+    const double accuracy = 0.01;
+    FlowSketch sketch;
+    sketch.Configure(16, 1, 0, 4, accuracy, maxBins);
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetDelayQuantile(0.5), Seconds(0), "No delay was added");
+
+    // delays spread between 1 us and 1 s, with a few null delays
+    std::mt19937 generator(1);
+    std::vector<double> delays;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        Time delay = i % 100 == 0 ? Seconds(0)
+                                  : Seconds(std::pow(10, -6.0 + 6.0 * generator() /
+                                                               double(generator.max())));
+        sketch.AddDelay(delay);
+        delays.push_back(delay.GetSeconds());
+    }
+    std::sort(delays.begin(), delays.end());
+    NS_TEST_ASSERT_MSG_EQ(sketch.GetDelayCount(), delays.size(), "Wrong number of delays");
+
+    for (double quantile : {0.0, 0.005, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0})
+    {
+        if (quantile < minQuantile)
+        {
+            continue;
+        }
+        double exact = delays[static_cast<std::size_t>(quantile * (delays.size() - 1))];
+        NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetDelayQuantile(quantile).GetSeconds(),
+                                  exact,
+                                  exact * accuracy + 1e-9,
+                                  "Wrong quantile " << quantile << " with " << maxBins
+                                                    << " bins");
+    }
+}
+
+void
+FlowSketchDelayTestCase::DoRun()
+{
+    // all the delays fit in the bins
+    CheckQuantiles(2048, 0);
+    // the bins of the smallest delays are merged
+    CheckQuantiles(200, 0.75);
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * A FlowProbe reporting the packets of the test to the FlowMonitor.
+ */
+class FlowSketchTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param monitor the FlowMonitor of the probe
+     */
+    FlowSketchTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * Check the approximate statistics of the FlowMonitor against its exact
+ * statistics, for the same packet reports.
+ */
+class FlowMonitorSketchTestCase : public TestCase
+{
+  public:
+    FlowMonitorSketchTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Report the packets of the test to the FlowMonitors
+     * @param monitors the FlowMonitors
+     * @param probes a probe of each FlowMonitor
+     */
+    void ReportPackets(const std::vector<Ptr<FlowMonitor>>& monitors,
+                       const std::vector<Ptr<FlowProbe>>& probes);
+};
+
+FlowMonitorSketchTestCase::FlowMonitorSketchTestCase()
+    : TestCase("Check the approximate statistics of the FlowMonitor against the exact ones")
+{
+}
+
+void
+FlowMonitorSketchTestCase::ReportPackets(const std::vector<Ptr<FlowMonitor>>& monitors,
+                                         const std::vector<Ptr<FlowProbe>>& probes)
+{
+    // packet p of flow f is sent at p ms, forwarded, and received after
+    // (1 + f + p % 7) ms; one packet out of 10 is dropped, and one out of
+    // 13 is lost
+    for (FlowId flowId = 1; flowId <= 50; ++flowId)
+    {
+        for (FlowPacketId packetId = 0; packetId < 40 * flowId; ++packetId)
+        {
+            uint32_t size = 100 + 10 * flowId;
+            Time tx = MilliSeconds(packetId);
+            Time delay = MilliSeconds(1 + flowId + packetId % 7);
+            for (std::size_t i = 0; i < monitors.size(); ++i)
+            {
+                Ptr<FlowMonitor> monitor = monitors[i];
+                Ptr<FlowProbe> probe = probes[i];
+                Simulator::Schedule(tx, [=]() {
+                    monitor->ReportFirstTx(probe, flowId, packetId, size);
+                });
+                Simulator::Schedule(tx + delay / 2, [=]() {
+                    monitor->ReportForwarding(probe, flowId, packetId, size);
+                });
+                if (packetId % 10 == 3)
+                {
+                    Simulator::Schedule(tx + delay, [=]() {
+                        monitor->ReportDrop(probe, flowId, packetId, size, 0);
+                    });
+                }
+                else if (packetId % 13 != 5)
+                {
+                    Simulator::Schedule(tx + delay, [=]() {
+                        monitor->ReportLastRx(probe, flowId, packetId, size);
+                    });
+                }
+            }
+        }
+    }
+}
+
+void
+FlowMonitorSketchTestCase::DoRun()
+{
+    const double accuracy = 0.01;
+    const uint32_t samplingRate = 4;
+    std::vector<Ptr<FlowMonitor>> monitors;
+    std::vector<Ptr<FlowProbe>> probes;
+
+    // the sketch can't be configured with these accuracies
+    Ptr<FlowMonitor> invalid = CreateObject<FlowMonitor>();
+    for (double value : {0.0, 1.0})
+    {
+        NS_TEST_EXPECT_MSG_EQ(
+            invalid->SetAttributeFailSafe("SketchDelayAccuracy", DoubleValue(value)),
+            false,
+            "The delay accuracy " << value << " should be rejected");
+    }
+
+    // an exact monitor, a sketch without sampling, and a sketch with sampling
+    for (uint32_t rate : {0U, 1U, samplingRate})
+    {
+        Ptr<FlowMonitor> monitor = CreateObjectWithAttributes<FlowMonitor>(
+            "SketchEnabled",
+            BooleanValue(rate > 0),
+            "SamplingRate",
+            UintegerValue(std::max(rate, 1U)),
+            "SketchDelayAccuracy",
+            DoubleValue(accuracy));
+        monitor->StartRightNow();
+        monitors.push_back(monitor);
+        probes.push_back(Create<FlowSketchTestProbe>(monitor));
+    }
+    ReportPackets(monitors, probes);
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    for (const auto& monitor : monitors)
+    {
+        monitor->CheckForLostPackets(Seconds(0));
+    }
+
+    const FlowMonitor::FlowStatsContainer& stats = monitors[0]->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), 50, "Wrong number of exact flows");
+    NS_TEST_EXPECT_MSG_EQ(monitors[1]->GetFlowStats().size(), 0, "No exact flows in the sketch");
+    const FlowSketch& sketch = monitors[1]->GetFlowSketch();
+    const FlowSketch& sampled = monitors[2]->GetFlowSketch();
+    NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetFlowCount(), 50, 2, "Wrong number of flows");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sampled.GetFlowCount(), 50, 2, "Wrong number of sampled flows");
+
+    // without sampling, the sketch is exact for a few flows
+    FlowSketch::FlowCounters total;
+    FlowSketch::FlowCounters sampledTotal;
+    std::vector<double> delays;
+    for (const auto& [flowId, flow] : stats)
+    {
+        FlowSketch::FlowCounters counters = sketch.GetCounters(flowId);
+        NS_TEST_EXPECT_MSG_EQ(counters.txBytes, flow.txBytes, "Wrong tx bytes of " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(counters.rxBytes, flow.rxBytes, "Wrong rx bytes of " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(counters.txPackets, flow.txPackets, "Wrong tx packets " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(counters.rxPackets, flow.rxPackets, "Wrong rx packets " << flowId);
+        NS_TEST_EXPECT_MSG_EQ(counters.lostPackets,
+                              flow.lostPackets,
+                              "Wrong lost packets of " << flowId);
+        total.txPackets += flow.txPackets;
+        total.rxPackets += flow.rxPackets;
+        total.lostPackets += flow.lostPackets;
+        FlowSketch::FlowCounters sampledCounters = sampled.GetCounters(flowId);
+        sampledTotal.txPackets += sampledCounters.txPackets;
+        sampledTotal.rxPackets += sampledCounters.rxPackets;
+        sampledTotal.lostPackets += sampledCounters.lostPackets;
+        for (FlowPacketId packetId = 0; packetId < 40 * flowId; ++packetId)
+        {
+            if (packetId % 10 != 3 && packetId % 13 != 5)
+            {
+                delays.push_back(MilliSeconds(1 + flowId + packetId % 7).GetSeconds());
+            }
+        }
+    }
+
+    // with sampling, the totals are within a few standard deviations
+    NS_TEST_EXPECT_MSG_EQ_TOL(sampledTotal.txPackets,
+                              total.txPackets,
+                              total.txPackets * 0.05,
+                              "Wrong sampled tx packets");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sampledTotal.rxPackets,
+                              total.rxPackets,
+                              total.rxPackets * 0.05,
+                              "Wrong sampled rx packets");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sampledTotal.lostPackets,
+                              total.lostPackets,
+                              total.lostPackets * 0.15,
+                              "Wrong sampled lost packets");
+
+    std::sort(delays.begin(), delays.end());
+    NS_TEST_ASSERT_MSG_EQ(sketch.GetDelayCount(), delays.size(), "Wrong number of delays");
+    for (double quantile : {0.0, 0.5, 0.9, 0.99, 1.0})
+    {
+        double exact = delays[static_cast<std::size_t>(quantile * (delays.size() - 1))];
+        NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetDelayQuantile(quantile).GetSeconds(),
+                                  exact,
+                                  exact * accuracy + 1e-9,
+                                  "Wrong quantile " << quantile);
+    }
+
+    auto heavy = sketch.GetHeavyHitters();
+    NS_TEST_ASSERT_MSG_EQ(heavy.empty(), false, "No heavy hitters");
+    NS_TEST_EXPECT_MSG_EQ(heavy[0].first, 50, "Wrong heaviest flow");
+
+    for (const auto& monitor : monitors)
+    {
+        monitor->Dispose();
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * Flow Monitor sketch TestSuite
+ */
+class FlowSketchTestSuite : public TestSuite
+{
+  public:
+    FlowSketchTestSuite();
+};
+
+FlowSketchTestSuite::FlowSketchTestSuite()
+    : TestSuite("flow-monitor-sketch", Type::UNIT)
+{
+    AddTestCase(new FlowSketchCountersTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowSketchFlowCountTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowSketchDelayTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorSketchTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static FlowSketchTestSuite g_flowSketchTestSuite;
@@ -51,6 +51,7 @@
 #include <ns3/lte-ue-phy.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/node-list.h>
 #include <ns3/object-factory.h>
 #include <ns3/object-map.h>
 #include <ns3/pointer.h>
@@ -1601,6 +1602,54 @@ LteHelper::AssignStreams(NetDeviceContainer c, int64_t stream)
     return (currentStream - stream);
 }
 
+/**
+ * Collect the eNB devices of the simulation. The statistics trace sinks are
+ * connected to them without context, so that the sinks neither build nor
+ * parse a Config path for each trace.
+ *
+ * @return the LteEnbNetDevice objects of all the nodes
+ */
+static std::vector<Ptr<LteEnbNetDevice>>
+GetAllEnbDevices()
+{
+    std::vector<Ptr<LteEnbNetDevice>> devices;
+    for (auto node = NodeList::Begin(); node != NodeList::End(); ++node)
+    {
+        for (uint32_t i = 0; i < (*node)->GetNDevices(); ++i)
+        {
+            Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice>((*node)->GetDevice(i));
+            if (enbDev)
+            {
+                devices.push_back(enbDev);
+            }
+        }
+    }
+    return devices;
+}
+
+/**
+ * Collect the UE devices of the simulation.
+ *
+ * @return the LteUeNetDevice objects of all the nodes
+ */
+static std::vector<Ptr<LteUeNetDevice>>
+GetAllUeDevices()
+{
+    std::vector<Ptr<LteUeNetDevice>> devices;
+    for (auto node = NodeList::Begin(); node != NodeList::End(); ++node)
+    {
+        for (uint32_t i = 0; i < (*node)->GetNDevices(); ++i)
+        {
+            Ptr<LteUeNetDevice> ueDev = DynamicCast<LteUeNetDevice>((*node)->GetDevice(i));
+            if (ueDev)
+            {
+                devices.push_back(ueDev);
+            }
+        }
+    }
+    return devices;
+}
+
 void
 LteHelper::EnablePhyTraces()
 {
@@ -1615,33 +1664,71 @@ LteHelper::EnablePhyTraces()
 void
 LteHelper::EnableDlTxPhyTraces()
 {
-    Config::Connect(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/DlPhyTransmission",
-        MakeBoundCallback(&PhyTxStatsCalculator::DlPhyTransmissionCallback, m_phyTxStats));
+    NS_LOG_FUNCTION_NOARGS();
+    for (const auto& enbDev : GetAllEnbDevices())
+    {
+        for (const auto& [ccId, cc] : enbDev->GetCcMap())
+        {
+            Ptr<LteEnbPhy> phy = DynamicCast<ComponentCarrierEnb>(cc)->GetPhy();
+            phy->TraceConnectWithoutContext(
+                "DlPhyTransmission",
+                MakeBoundCallback(&PhyTxStatsCalculator::DlPhyTransmissionSink,
+                                  m_phyTxStats,
+                                  enbDev->GetRrc()));
+        }
+    }
 }
 
 void
 LteHelper::EnableUlTxPhyTraces()
 {
-    Config::Connect(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/UlPhyTransmission",
-        MakeBoundCallback(&PhyTxStatsCalculator::UlPhyTransmissionCallback, m_phyTxStats));
+    NS_LOG_FUNCTION_NOARGS();
+    for (const auto& ueDev : GetAllUeDevices())
+    {
+        for (const auto& [ccId, cc] : ueDev->GetCcMap())
+        {
+            cc->GetPhy()->TraceConnectWithoutContext(
+                "UlPhyTransmission",
+                MakeBoundCallback(&PhyTxStatsCalculator::UlPhyTransmissionSink,
+                                  m_phyTxStats,
+                                  ueDev->GetImsi()));
+        }
+    }
 }
 
 void
 LteHelper::EnableDlRxPhyTraces()
 {
-    Config::Connect(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/DlSpectrumPhy/DlPhyReception",
-        MakeBoundCallback(&PhyRxStatsCalculator::DlPhyReceptionCallback, m_phyRxStats));
+    NS_LOG_FUNCTION_NOARGS();
+    for (const auto& ueDev : GetAllUeDevices())
+    {
+        for (const auto& [ccId, cc] : ueDev->GetCcMap())
+        {
+            cc->GetPhy()->GetDlSpectrumPhy()->TraceConnectWithoutContext(
+                "DlPhyReception",
+                MakeBoundCallback(&PhyRxStatsCalculator::DlPhyReceptionSink,
+                                  m_phyRxStats,
+                                  ueDev->GetImsi()));
+        }
+    }
 }
 
 void
 LteHelper::EnableUlRxPhyTraces()
 {
-    Config::Connect(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/UlSpectrumPhy/UlPhyReception",
-        MakeBoundCallback(&PhyRxStatsCalculator::UlPhyReceptionCallback, m_phyRxStats));
+    NS_LOG_FUNCTION_NOARGS();
+    for (const auto& enbDev : GetAllEnbDevices())
+    {
+        for (const auto& [ccId, cc] : enbDev->GetCcMap())
+        {
+            Ptr<LteEnbPhy> phy = DynamicCast<ComponentCarrierEnb>(cc)->GetPhy();
+            phy->GetUlSpectrumPhy()->TraceConnectWithoutContext(
+                "UlPhyReception",
+                MakeBoundCallback(&PhyRxStatsCalculator::UlPhyReceptionSink,
+                                  m_phyRxStats,
+                                  enbDev->GetRrc()));
+        }
+    }
 }
 
 void
@@ -1655,35 +1742,74 @@ void
 LteHelper::EnableDlMacTraces()
 {
     NS_LOG_FUNCTION_NOARGS();
-    Config::Connect("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbMac/DlScheduling",
-                    MakeBoundCallback(&MacStatsCalculator::DlSchedulingCallback, m_macStats));
+    for (const auto& enbDev : GetAllEnbDevices())
+    {
+        for (const auto& [ccId, cc] : enbDev->GetCcMap())
+        {
+            Ptr<LteEnbMac> mac = DynamicCast<ComponentCarrierEnb>(cc)->GetMac();
+            mac->TraceConnectWithoutContext("DlScheduling",
+                                            MakeBoundCallback(&MacStatsCalculator::DlSchedulingSink,
+                                                              m_macStats,
+                                                              enbDev->GetRrc(),
+                                                              enbDev->GetCellId()));
+        }
+    }
 }
 
 void
 LteHelper::EnableUlMacTraces()
 {
     NS_LOG_FUNCTION_NOARGS();
-    Config::Connect("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbMac/UlScheduling",
-                    MakeBoundCallback(&MacStatsCalculator::UlSchedulingCallback, m_macStats));
+    for (const auto& enbDev : GetAllEnbDevices())
+    {
+        for (const auto& [ccId, cc] : enbDev->GetCcMap())
+        {
+            Ptr<LteEnbMac> mac = DynamicCast<ComponentCarrierEnb>(cc)->GetMac();
+            mac->TraceConnectWithoutContext("UlScheduling",
+                                            MakeBoundCallback(&MacStatsCalculator::UlSchedulingSink,
+                                                              m_macStats,
+                                                              enbDev->GetRrc(),
+                                                              enbDev->GetCellId()));
+        }
+    }
 }
 
 void
 LteHelper::EnableDlPhyTraces()
 {
     NS_LOG_FUNCTION_NOARGS();
-    Config::Connect(
-        "/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/ReportCurrentCellRsrpSinr",
-        MakeBoundCallback(&PhyStatsCalculator::ReportCurrentCellRsrpSinrCallback, m_phyStats));
+    for (const auto& ueDev : GetAllUeDevices())
+    {
+        for (const auto& [ccId, cc] : ueDev->GetCcMap())
+        {
+            cc->GetPhy()->TraceConnectWithoutContext(
+                "ReportCurrentCellRsrpSinr",
+                MakeBoundCallback(&PhyStatsCalculator::ReportCurrentCellRsrpSinrSink,
+                                  m_phyStats,
+                                  ueDev->GetImsi()));
+        }
+    }
 }
 
 void
 LteHelper::EnableUlPhyTraces()
 {
     NS_LOG_FUNCTION_NOARGS();
-    Config::Connect("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/ReportUeSinr",
-                    MakeBoundCallback(&PhyStatsCalculator::ReportUeSinr, m_phyStats));
-    Config::Connect("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/ReportInterference",
-                    MakeBoundCallback(&PhyStatsCalculator::ReportInterference, m_phyStats));
+    for (const auto& enbDev : GetAllEnbDevices())
+    {
+        for (const auto& [ccId, cc] : enbDev->GetCcMap())
+        {
+            Ptr<LteEnbPhy> phy = DynamicCast<ComponentCarrierEnb>(cc)->GetPhy();
+            phy->TraceConnectWithoutContext(
+                "ReportUeSinr",
+                MakeBoundCallback(&PhyStatsCalculator::ReportUeSinrSink,
+                                  m_phyStats,
+                                  enbDev->GetRrc()));
+            phy->TraceConnectWithoutContext(
+                "ReportInterference",
+                MakeBoundCallback(&PhyStatsCalculator::ReportInterferenceSink, m_phyStats));
+        }
+    }
 }
 
 Ptr<RadioBearerStatsCalculator>
@@ -8,12 +8,14 @@
 
 #include "lte-stats-calculator.h"
 
+#include <ns3/boolean.h>
 #include <ns3/config.h>
 #include <ns3/log.h>
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-ue-net-device.h>
 #include <ns3/lte-ue-rrc.h>
+#include <ns3/uinteger.h>
 
 namespace ns3
 {
@@ -24,7 +26,9 @@ NS_OBJECT_ENSURE_REGISTERED(LteStatsCalculator);
 
 LteStatsCalculator::LteStatsCalculator()
     : m_dlOutputFilename(""),
-      m_ulOutputFilename("")
+      m_ulOutputFilename(""),
+      m_binaryOutput(false),
+      m_rowGroupSize(1024)
 {
     // Nothing to do here
 }
@@ -40,7 +44,19 @@ LteStatsCalculator::GetTypeId()
     static TypeId tid = TypeId("ns3::LteStatsCalculator")
                             .SetParent<Object>()
                             .SetGroupName("Lte")
-                            .AddConstructor<LteStatsCalculator>();
+                            .AddConstructor<LteStatsCalculator>()
+                            .AddAttribute("BinaryOutput",
+                                          "If true, the statistics written for every TTI are "
+                                          "saved in binary columnar files instead of text",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&LteStatsCalculator::m_binaryOutput),
+                                          MakeBooleanChecker())
+                            .AddAttribute("RowGroupSize",
+                                          "Number of rows of the binary files which are buffered "
+                                          "before being written by a separate thread",
+                                          UintegerValue(1024),
+                                          MakeUintegerAccessor(&LteStatsCalculator::m_rowGroupSize),
+                                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -106,6 +122,46 @@ LteStatsCalculator::GetCellIdPath(std::string path)
     return m_pathCellIdMap.find(path)->second;
 }
 
+bool
+LteStatsCalculator::IsBinaryOutput() const
+{
+    return m_binaryOutput;
+}
+
+Ptr<LteStatsWriter>
+LteStatsCalculator::CreateWriter(const std::string& fileName,
+                                 const std::vector<LteStatsWriter::Column>& columns) const
+{
+    NS_LOG_FUNCTION(this << fileName);
+    Ptr<LteStatsWriter> writer = Create<LteStatsWriter>(fileName, columns, m_rowGroupSize);
+    if (!writer->IsOpen())
+    {
+        NS_LOG_ERROR("Can't open file " << fileName);
+        return nullptr;
+    }
+    return writer;
+}
+
+void
+LteStatsCalculator::CloseWriter(Ptr<LteStatsWriter>& writer)
+{
+    if (writer)
+    {
+        writer->Close();
+        writer = nullptr;
+    }
+}
+
+uint64_t
+LteStatsCalculator::FindImsiFromEnbRrc(Ptr<LteEnbRrc> rrc, uint16_t rnti)
+{
+    if (!rrc->HasUeManager(rnti))
+    {
+        return 0;
+    }
+    return rrc->GetUeManager(rnti)->GetImsi();
+}
+
 uint64_t
 LteStatsCalculator::FindImsiFromEnbRlcPath(std::string path)
 {
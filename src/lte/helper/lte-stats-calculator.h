@@ -9,6 +9,8 @@
 #ifndef LTE_STATS_CALCULATOR_H_
 #define LTE_STATS_CALCULATOR_H_
 
+#include "lte-stats-writer.h"
+
 #include "ns3/object.h"
 #include "ns3/string.h"
 
@@ -17,12 +19,17 @@
 namespace ns3
 {
 
+class LteEnbRrc;
+
 /**
  * @ingroup lte
  *
  * Base class for ***StatsCalculator classes. Provides
  * basic functionality to parse and store IMSI and CellId.
  * Also stores names of output files.
+ *
+ * With the `BinaryOutput` attribute, the calculators which write one row per
+ * TTI write binary columnar files through LteStatsWriter instead of text.
  */
 
 class LteStatsCalculator : public Object
@@ -113,6 +120,37 @@ class LteStatsCalculator : public Object
     uint16_t GetCellIdPath(std::string path);
 
   protected:
+    /**
+     * @return true if the statistics written for every TTI are saved in binary files
+     */
+    bool IsBinaryOutput() const;
+
+    /**
+     * Create the writer of a binary statistics file.
+     *
+     * @param fileName the name of the file
+     * @param columns the columns of the file
+     * @return the writer, or nullptr if the file cannot be opened
+     */
+    Ptr<LteStatsWriter> CreateWriter(const std::string& fileName,
+                                     const std::vector<LteStatsWriter::Column>& columns) const;
+
+    /**
+     * Write the pending rows of a binary statistics file, close it and release
+     * its writer.
+     *
+     * @param writer the writer, possibly nullptr
+     */
+    static void CloseWriter(Ptr<LteStatsWriter>& writer);
+
+    /**
+     * Retrieves the IMSI of a UE from the RRC of its eNB
+     * @param rrc the eNB RRC
+     * @param rnti RNTI of UE for which IMSI is needed
+     * @return the IMSI of the UE, or 0 if the eNB has no context for the RNTI
+     */
+    static uint64_t FindImsiFromEnbRrc(Ptr<LteEnbRrc> rrc, uint16_t rnti);
+
     /**
      * Retrieves IMSI from Enb RLC path in the attribute system
      * @param path Path in the attribute system to get
@@ -193,6 +231,9 @@ class LteStatsCalculator : public Object
      * Name of the file where the uplink results will be saved
      */
     std::string m_ulOutputFilename;
+
+    bool m_binaryOutput;     ///< The `BinaryOutput` attribute.
+    uint32_t m_rowGroupSize; ///< The `RowGroupSize` attribute.
 };
 
 } // namespace ns3
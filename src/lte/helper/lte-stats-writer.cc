@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "lte-stats-writer.h"
+
+#include "ns3/log.h"
+
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LteStatsWriter");
+
+/// The magic string at the beginning of the file
+static const char LTE_STATS_MAGIC[8] = {'n', 's', '3', 'l', 't', 's', '0', '1'};
+
+LteStatsWriter::LteStatsWriter(const std::string& fileName,
+                               const std::vector<Column>& columns,
+                               uint32_t rowGroupSize)
+    : m_columns(columns),
+      m_rowGroupSize(rowGroupSize),
+      m_column(0),
+      m_stop(false)
+{
+    NS_LOG_FUNCTION(this << fileName << columns.size() << rowGroupSize);
+    NS_ASSERT(rowGroupSize > 0);
+    m_file.open(fileName, std::ios::out | std::ios::binary);
+    if (!m_file.is_open())
+    {
+        return;
+    }
+
+    m_file.write(LTE_STATS_MAGIC, sizeof(LTE_STATS_MAGIC));
+    uint32_t n = m_columns.size();
+    m_file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    for (const auto& column : m_columns)
+    {
+        NS_ASSERT(column.name.size() <= std::numeric_limits<uint8_t>::max());
+        uint8_t description[2] = {column.type, static_cast<uint8_t>(column.name.size())};
+        m_file.write(reinterpret_cast<const char*>(description), sizeof(description));
+        m_file.write(column.name.data(), column.name.size());
+    }
+
+    m_current.rows = 0;
+    m_current.values.resize(m_columns.size());
+    m_thread = std::thread(&LteStatsWriter::Run, this);
+}
+
+LteStatsWriter::~LteStatsWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+LteStatsWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_one();
+    m_thread.join();
+    m_file.close();
+}
+
+bool
+LteStatsWriter::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+void
+LteStatsWriter::EndRow()
+{
+    NS_ASSERT_MSG(m_column == m_columns.size(), "Missing values in the row");
+    m_column = 0;
+    if (++m_current.rows == m_rowGroupSize)
+    {
+        Flush();
+    }
+}
+
+void
+LteStatsWriter::Flush()
+{
+    NS_LOG_FUNCTION(this << m_current.rows);
+    if (m_current.rows == 0)
+    {
+        return;
+    }
+    RowGroup next;
+    next.rows = 0;
+    next.values.resize(m_columns.size());
+    for (std::size_t i = 0; i < m_columns.size(); ++i)
+    {
+        next.values[i].reserve(m_current.values[i].size());
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(std::move(m_current));
+    }
+    m_cond.notify_one();
+    m_current = std::move(next);
+}
+
+void
+LteStatsWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cond.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+        if (m_pending.empty())
+        {
+            // stopping, and every row group has been written
+            return;
+        }
+        RowGroup group = std::move(m_pending.front());
+        m_pending.pop_front();
+        lock.unlock();
+        m_file.write(reinterpret_cast<const char*>(&group.rows), sizeof(group.rows));
+        for (const auto& values : group.values)
+        {
+            m_file.write(values.data(), values.size());
+        }
+        lock.lock();
+    }
+}
+
+} // namespace ns3
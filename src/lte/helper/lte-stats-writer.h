@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LTE_STATS_WRITER_H_
+#define LTE_STATS_WRITER_H_
+
+#include "ns3/assert.h"
+#include "ns3/simple-ref-count.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup lte
+ *
+ * Writes the rows of a statistics table to a binary columnar file. The rows
+ * are stored column by column in memory, and every `rowGroupSize` rows the
+ * row group is handed to a thread which writes it to the file, so that the
+ * simulation neither formats nor writes the statistics.
+ *
+ * The file starts with the magic string "ns3lts01", the number of columns as
+ * a 32 bit unsigned integer and, for each column, its type (one byte, see
+ * ColumnType), the length of its name (one byte) and its name. Each row group
+ * follows, made of the number of rows as a 32 bit unsigned integer and of the
+ * values of each column, in the order of the columns. All the values are in
+ * the byte order of the host.
+ */
+class LteStatsWriter : public SimpleRefCount<LteStatsWriter>
+{
+  public:
+    /// The type of the values of a column
+    enum ColumnType : uint8_t
+    {
+        UINT8 = 0,
+        UINT16 = 1,
+        UINT32 = 2,
+        UINT64 = 3,
+        INT64 = 4,
+        DOUBLE = 5
+    };
+
+    /// A column of the table
+    struct Column
+    {
+        std::string name; ///< the name of the column
+        ColumnType type;  ///< the type of the values of the column
+    };
+
+    /**
+     * Open the file and write the description of the columns.
+     *
+     * @param fileName the name of the file
+     * @param columns the columns of the table
+     * @param rowGroupSize the number of rows of a row group
+     */
+    LteStatsWriter(const std::string& fileName,
+                   const std::vector<Column>& columns,
+                   uint32_t rowGroupSize);
+
+    /// Write the pending rows and close the file, if not closed yet.
+    ~LteStatsWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LteStatsWriter(const LteStatsWriter&) = delete;
+    LteStatsWriter& operator=(const LteStatsWriter&) = delete;
+
+    /**
+     * @return true if the file could be opened
+     */
+    bool IsOpen() const;
+
+    /**
+     * Set the value of the next column of the current row.
+     *
+     * @param value the value, converted to the type of the column
+     * @return this writer
+     */
+    template <typename T>
+    LteStatsWriter& operator<<(T value);
+
+    /// End the current row, and hand the row group to the writing thread if it is complete.
+    void EndRow();
+
+    /**
+     * Write the pending rows, terminate the writing thread and close the file.
+     * No row can be added afterwards.
+     */
+    void Close();
+
+  private:
+    /// A row group waiting to be written
+    struct RowGroup
+    {
+        uint32_t rows;                        ///< the number of rows
+        std::vector<std::vector<char>> values; ///< the values of each column
+    };
+
+    /**
+     * Append a value to the current column.
+     * @param value the value, in the type of the column
+     */
+    template <typename U>
+    void Append(U value);
+
+    /// Hand the current row group to the writing thread.
+    void Flush();
+
+    /// Body of the writing thread.
+    void Run();
+
+    std::ofstream m_file;           ///< the output file
+    std::vector<Column> m_columns;  ///< the columns of the table
+    uint32_t m_rowGroupSize;        ///< the number of rows of a row group
+    uint32_t m_column;              ///< the next column of the current row
+    RowGroup m_current;             ///< the row group being filled
+    std::deque<RowGroup> m_pending; ///< the row groups waiting to be written
+    bool m_stop;                    ///< set when the writing thread has to terminate
+    std::mutex m_mutex;             ///< protects m_pending and m_stop
+    std::condition_variable m_cond; ///< signals the writing thread
+    std::thread m_thread;           ///< the writing thread
+};
+
+template <typename U>
+void
+LteStatsWriter::Append(U value)
+{
+    std::vector<char>& values = m_current.values[m_column];
+    std::size_t size = values.size();
+    values.resize(size + sizeof(U));
+    std::memcpy(values.data() + size, &value, sizeof(U));
+}
+
+template <typename T>
+LteStatsWriter&
+LteStatsWriter::operator<<(T value)
+{
+    NS_ASSERT_MSG(m_column < m_columns.size(), "Too many values in the row");
+    switch (m_columns[m_column].type)
+    {
+    case UINT8:
+        Append(static_cast<uint8_t>(value));
+        break;
+    case UINT16:
+        Append(static_cast<uint16_t>(value));
+        break;
+    case UINT32:
+        Append(static_cast<uint32_t>(value));
+        break;
+    case UINT64:
+        Append(static_cast<uint64_t>(value));
+        break;
+    case INT64:
+        Append(static_cast<int64_t>(value));
+        break;
+    case DOUBLE:
+        Append(static_cast<double>(value));
+        break;
+    }
+    ++m_column;
+    return *this;
+}
+
+} // namespace ns3
+
+#endif /* LTE_STATS_WRITER_H_ */
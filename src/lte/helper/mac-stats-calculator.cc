@@ -11,6 +11,7 @@
 #include "mac-stats-calculator.h"
 
 #include "ns3/string.h"
+#include <ns3/lte-enb-rrc.h>
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 
@@ -42,6 +43,24 @@ MacStatsCalculator::~MacStatsCalculator()
     }
 }
 
+void
+MacStatsCalculator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // write the buffered rows as soon as the calculator is disposed of
+    CloseWriter(m_dlWriter);
+    CloseWriter(m_ulWriter);
+    if (m_dlOutFile.is_open())
+    {
+        m_dlOutFile.close();
+    }
+    if (m_ulOutFile.is_open())
+    {
+        m_ulOutFile.close();
+    }
+    LteStatsCalculator::DoDispose();
+}
+
 TypeId
 MacStatsCalculator::GetTypeId()
 {
@@ -101,16 +120,50 @@ MacStatsCalculator::DlScheduling(uint16_t cellId,
 
     if (m_dlFirstWrite)
     {
-        m_dlOutFile.open(GetDlOutputFilename());
-        if (!m_dlOutFile.is_open())
+        if (IsBinaryOutput())
         {
-            NS_LOG_ERROR("Can't open file " << GetDlOutputFilename());
-            return;
+            m_dlWriter = CreateWriter(GetDlOutputFilename(),
+                                      {{"time", LteStatsWriter::DOUBLE},
+                                       {"cellId", LteStatsWriter::UINT16},
+                                       {"IMSI", LteStatsWriter::UINT64},
+                                       {"frame", LteStatsWriter::UINT32},
+                                       {"sframe", LteStatsWriter::UINT32},
+                                       {"RNTI", LteStatsWriter::UINT16},
+                                       {"mcsTb1", LteStatsWriter::UINT8},
+                                       {"sizeTb1", LteStatsWriter::UINT16},
+                                       {"mcsTb2", LteStatsWriter::UINT8},
+                                       {"sizeTb2", LteStatsWriter::UINT16},
+                                       {"ccId", LteStatsWriter::UINT8}});
+            if (!m_dlWriter)
+            {
+                return;
+            }
+        }
+        else
+        {
+            m_dlOutFile.open(GetDlOutputFilename());
+            if (!m_dlOutFile.is_open())
+            {
+                NS_LOG_ERROR("Can't open file " << GetDlOutputFilename());
+                return;
+            }
+            m_dlOutFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2"
+                           "\tsizeTb2\tccId";
+            m_dlOutFile << "\n";
         }
         m_dlFirstWrite = false;
-        m_dlOutFile
-            << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId";
-        m_dlOutFile << "\n";
+    }
+
+    if (m_dlWriter)
+    {
+        *m_dlWriter << Simulator::Now().GetSeconds() << cellId << imsi
+                    << dlSchedulingCallbackInfo.frameNo << dlSchedulingCallbackInfo.subframeNo
+                    << dlSchedulingCallbackInfo.rnti << dlSchedulingCallbackInfo.mcsTb1
+                    << dlSchedulingCallbackInfo.sizeTb1 << dlSchedulingCallbackInfo.mcsTb2
+                    << dlSchedulingCallbackInfo.sizeTb2
+                    << dlSchedulingCallbackInfo.componentCarrierId;
+        m_dlWriter->EndRow();
+        return;
     }
 
     m_dlOutFile << Simulator::Now().GetSeconds() << "\t";
@@ -123,7 +176,7 @@ MacStatsCalculator::DlScheduling(uint16_t cellId,
     m_dlOutFile << dlSchedulingCallbackInfo.sizeTb1 << "\t";
     m_dlOutFile << (uint32_t)dlSchedulingCallbackInfo.mcsTb2 << "\t";
     m_dlOutFile << dlSchedulingCallbackInfo.sizeTb2 << "\t";
-    m_dlOutFile << (uint32_t)dlSchedulingCallbackInfo.componentCarrierId << std::endl;
+    m_dlOutFile << (uint32_t)dlSchedulingCallbackInfo.componentCarrierId << "\n";
 }
 
 void
@@ -142,15 +195,43 @@ MacStatsCalculator::UlScheduling(uint16_t cellId,
 
     if (m_ulFirstWrite)
     {
-        m_ulOutFile.open(GetUlOutputFilename());
-        if (!m_ulOutFile.is_open())
+        if (IsBinaryOutput())
+        {
+            m_ulWriter = CreateWriter(GetUlOutputFilename(),
+                                      {{"time", LteStatsWriter::DOUBLE},
+                                       {"cellId", LteStatsWriter::UINT16},
+                                       {"IMSI", LteStatsWriter::UINT64},
+                                       {"frame", LteStatsWriter::UINT32},
+                                       {"sframe", LteStatsWriter::UINT32},
+                                       {"RNTI", LteStatsWriter::UINT16},
+                                       {"mcs", LteStatsWriter::UINT8},
+                                       {"size", LteStatsWriter::UINT16},
+                                       {"ccId", LteStatsWriter::UINT8}});
+            if (!m_ulWriter)
+            {
+                return;
+            }
+        }
+        else
         {
-            NS_LOG_ERROR("Can't open file " << GetUlOutputFilename());
-            return;
+            m_ulOutFile.open(GetUlOutputFilename());
+            if (!m_ulOutFile.is_open())
+            {
+                NS_LOG_ERROR("Can't open file " << GetUlOutputFilename());
+                return;
+            }
+            m_ulOutFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId";
+            m_ulOutFile << "\n";
         }
         m_ulFirstWrite = false;
-        m_ulOutFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId";
-        m_ulOutFile << "\n";
+    }
+
+    if (m_ulWriter)
+    {
+        *m_ulWriter << Simulator::Now().GetSeconds() << cellId << imsi << frameNo << subframeNo
+                    << rnti << mcsTb << size << componentCarrierId;
+        m_ulWriter->EndRow();
+        return;
     }
 
     m_ulOutFile << Simulator::Now().GetSeconds() << "\t";
@@ -161,7 +242,7 @@ MacStatsCalculator::UlScheduling(uint16_t cellId,
     m_ulOutFile << rnti << "\t";
     m_ulOutFile << (uint32_t)mcsTb << "\t";
     m_ulOutFile << size << "\t";
-    m_ulOutFile << (uint32_t)componentCarrierId << std::endl;
+    m_ulOutFile << (uint32_t)componentCarrierId << "\n";
 }
 
 void
@@ -236,4 +317,31 @@ MacStatsCalculator::UlSchedulingCallback(Ptr<MacStatsCalculator> macStats,
     macStats->UlScheduling(cellId, imsi, frameNo, subframeNo, rnti, mcs, size, componentCarrierId);
 }
 
+void
+MacStatsCalculator::DlSchedulingSink(Ptr<MacStatsCalculator> macStats,
+                                     Ptr<LteEnbRrc> rrc,
+                                     uint16_t cellId,
+                                     DlSchedulingCallbackInfo dlSchedulingCallbackInfo)
+{
+    NS_LOG_FUNCTION(macStats << cellId);
+    uint64_t imsi = FindImsiFromEnbRrc(rrc, dlSchedulingCallbackInfo.rnti);
+    macStats->DlScheduling(cellId, imsi, dlSchedulingCallbackInfo);
+}
+
+void
+MacStatsCalculator::UlSchedulingSink(Ptr<MacStatsCalculator> macStats,
+                                     Ptr<LteEnbRrc> rrc,
+                                     uint16_t cellId,
+                                     uint32_t frameNo,
+                                     uint32_t subframeNo,
+                                     uint16_t rnti,
+                                     uint8_t mcs,
+                                     uint16_t size,
+                                     uint8_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(macStats << cellId);
+    uint64_t imsi = FindImsiFromEnbRrc(rrc, rnti);
+    macStats->UlScheduling(cellId, imsi, frameNo, subframeNo, rnti, mcs, size, componentCarrierId);
+}
+
 } // namespace ns3
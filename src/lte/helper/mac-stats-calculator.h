@@ -55,6 +55,7 @@ class MacStatsCalculator : public LteStatsCalculator
      * @return The object TypeId.
      */
     static TypeId GetTypeId();
+    void DoDispose() override;
 
     /**
      * Set the name of the file where the uplink statistics will be stored.
@@ -154,6 +155,45 @@ class MacStatsCalculator : public LteStatsCalculator
                                      uint16_t size,
                                      uint8_t componentCarrierId);
 
+    /**
+     * Trace sink for the ns3::LteEnbMac::DlScheduling trace source, connected
+     * without context by LteHelper::EnableDlMacTraces()
+     *
+     * @param macStats
+     * @param rrc the RRC of the eNB, which maps the RNTIs to the IMSIs
+     * @param cellId the cell ID of the eNB
+     * @param dlSchedulingCallbackInfo DlSchedulingCallbackInfo structure containing all downlink
+     * information that is generated what DlScheduling traces is fired
+     */
+    static void DlSchedulingSink(Ptr<MacStatsCalculator> macStats,
+                                 Ptr<LteEnbRrc> rrc,
+                                 uint16_t cellId,
+                                 DlSchedulingCallbackInfo dlSchedulingCallbackInfo);
+
+    /**
+     * Trace sink for the ns3::LteEnbMac::UlScheduling trace source, connected
+     * without context by LteHelper::EnableUlMacTraces()
+     *
+     * @param macStats
+     * @param rrc the RRC of the eNB, which maps the RNTIs to the IMSIs
+     * @param cellId the cell ID of the eNB
+     * @param frameNo
+     * @param subframeNo
+     * @param rnti
+     * @param mcs
+     * @param size
+     * @param componentCarrierId
+     */
+    static void UlSchedulingSink(Ptr<MacStatsCalculator> macStats,
+                                 Ptr<LteEnbRrc> rrc,
+                                 uint16_t cellId,
+                                 uint32_t frameNo,
+                                 uint32_t subframeNo,
+                                 uint16_t rnti,
+                                 uint8_t mcs,
+                                 uint16_t size,
+                                 uint8_t componentCarrierId);
+
   private:
     /**
      * When writing DL MAC statistics first time to file,
@@ -180,6 +220,9 @@ class MacStatsCalculator : public LteStatsCalculator
      * Uplink output trace file
      */
     std::ofstream m_ulOutFile;
+
+    Ptr<LteStatsWriter> m_dlWriter; ///< Downlink output binary file
+    Ptr<LteStatsWriter> m_ulWriter; ///< Uplink output binary file
 };
 
 } // namespace ns3
@@ -11,6 +11,7 @@
 #include "phy-rx-stats-calculator.h"
 
 #include "ns3/string.h"
+#include <ns3/lte-enb-rrc.h>
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 
@@ -42,6 +43,24 @@ PhyRxStatsCalculator::~PhyRxStatsCalculator()
     }
 }
 
+void
+PhyRxStatsCalculator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // write the buffered rows as soon as the calculator is disposed of
+    CloseWriter(m_dlRxWriter);
+    CloseWriter(m_ulRxWriter);
+    if (m_dlRxOutFile.is_open())
+    {
+        m_dlRxOutFile.close();
+    }
+    if (m_ulRxOutFile.is_open())
+    {
+        m_ulRxOutFile.close();
+    }
+    LteStatsCalculator::DoDispose();
+}
+
 TypeId
 PhyRxStatsCalculator::GetTypeId()
 {
@@ -97,16 +116,48 @@ PhyRxStatsCalculator::DlPhyReception(PhyReceptionStatParameters params)
 
     if (m_dlRxFirstWrite)
     {
-        m_dlRxOutFile.open(GetDlRxOutputFilename());
-        if (!m_dlRxOutFile.is_open())
+        if (IsBinaryOutput())
         {
-            NS_LOG_ERROR("Can't open file " << GetDlRxOutputFilename());
-            return;
+            m_dlRxWriter = CreateWriter(GetDlRxOutputFilename(),
+                                        {{"time", LteStatsWriter::INT64},
+                                         {"cellId", LteStatsWriter::UINT16},
+                                         {"IMSI", LteStatsWriter::UINT64},
+                                         {"RNTI", LteStatsWriter::UINT16},
+                                         {"txMode", LteStatsWriter::UINT8},
+                                         {"layer", LteStatsWriter::UINT8},
+                                         {"mcs", LteStatsWriter::UINT8},
+                                         {"size", LteStatsWriter::UINT16},
+                                         {"rv", LteStatsWriter::UINT8},
+                                         {"ndi", LteStatsWriter::UINT8},
+                                         {"correct", LteStatsWriter::UINT8},
+                                         {"ccId", LteStatsWriter::UINT8}});
+            if (!m_dlRxWriter)
+            {
+                return;
+            }
+        }
+        else
+        {
+            m_dlRxOutFile.open(GetDlRxOutputFilename());
+            if (!m_dlRxOutFile.is_open())
+            {
+                NS_LOG_ERROR("Can't open file " << GetDlRxOutputFilename());
+                return;
+            }
+            m_dlRxOutFile
+                << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
+            m_dlRxOutFile << "\n";
         }
         m_dlRxFirstWrite = false;
-        m_dlRxOutFile
-            << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
-        m_dlRxOutFile << "\n";
+    }
+
+    if (m_dlRxWriter)
+    {
+        *m_dlRxWriter << params.m_timestamp << params.m_cellId << params.m_imsi << params.m_rnti
+                      << params.m_txMode << params.m_layer << params.m_mcs << params.m_size
+                      << params.m_rv << params.m_ndi << params.m_correctness << params.m_ccId;
+        m_dlRxWriter->EndRow();
+        return;
     }
 
     m_dlRxOutFile << params.m_timestamp << "\t";
@@ -120,7 +171,7 @@ PhyRxStatsCalculator::DlPhyReception(PhyReceptionStatParameters params)
     m_dlRxOutFile << (uint32_t)params.m_rv << "\t";
     m_dlRxOutFile << (uint32_t)params.m_ndi << "\t";
     m_dlRxOutFile << (uint32_t)params.m_correctness << "\t";
-    m_dlRxOutFile << (uint32_t)params.m_ccId << std::endl;
+    m_dlRxOutFile << (uint32_t)params.m_ccId << "\n";
 }
 
 void
@@ -133,15 +184,46 @@ PhyRxStatsCalculator::UlPhyReception(PhyReceptionStatParameters params)
 
     if (m_ulRxFirstWrite)
     {
-        m_ulRxOutFile.open(GetUlRxOutputFilename());
-        if (!m_ulRxOutFile.is_open())
+        if (IsBinaryOutput())
         {
-            NS_LOG_ERROR("Can't open file " << GetUlRxOutputFilename());
-            return;
+            m_ulRxWriter = CreateWriter(GetUlRxOutputFilename(),
+                                        {{"time", LteStatsWriter::INT64},
+                                         {"cellId", LteStatsWriter::UINT16},
+                                         {"IMSI", LteStatsWriter::UINT64},
+                                         {"RNTI", LteStatsWriter::UINT16},
+                                         {"layer", LteStatsWriter::UINT8},
+                                         {"mcs", LteStatsWriter::UINT8},
+                                         {"size", LteStatsWriter::UINT16},
+                                         {"rv", LteStatsWriter::UINT8},
+                                         {"ndi", LteStatsWriter::UINT8},
+                                         {"correct", LteStatsWriter::UINT8},
+                                         {"ccId", LteStatsWriter::UINT8}});
+            if (!m_ulRxWriter)
+            {
+                return;
+            }
+        }
+        else
+        {
+            m_ulRxOutFile.open(GetUlRxOutputFilename());
+            if (!m_ulRxOutFile.is_open())
+            {
+                NS_LOG_ERROR("Can't open file " << GetUlRxOutputFilename());
+                return;
+            }
+            m_ulRxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
+            m_ulRxOutFile << "\n";
         }
         m_ulRxFirstWrite = false;
-        m_ulRxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
-        m_ulRxOutFile << "\n";
+    }
+
+    if (m_ulRxWriter)
+    {
+        *m_ulRxWriter << params.m_timestamp << params.m_cellId << params.m_imsi << params.m_rnti
+                      << params.m_layer << params.m_mcs << params.m_size << params.m_rv
+                      << params.m_ndi << params.m_correctness << params.m_ccId;
+        m_ulRxWriter->EndRow();
+        return;
     }
 
     m_ulRxOutFile << params.m_timestamp << "\t";
@@ -154,7 +236,7 @@ PhyRxStatsCalculator::UlPhyReception(PhyReceptionStatParameters params)
     m_ulRxOutFile << (uint32_t)params.m_rv << "\t";
     m_ulRxOutFile << (uint32_t)params.m_ndi << "\t";
     m_ulRxOutFile << (uint32_t)params.m_correctness << "\t";
-    m_ulRxOutFile << (uint32_t)params.m_ccId << std::endl;
+    m_ulRxOutFile << (uint32_t)params.m_ccId << "\n";
 }
 
 void
@@ -205,4 +287,25 @@ PhyRxStatsCalculator::UlPhyReceptionCallback(Ptr<PhyRxStatsCalculator> phyRxStat
     phyRxStats->UlPhyReception(params);
 }
 
+
+void
+PhyRxStatsCalculator::DlPhyReceptionSink(Ptr<PhyRxStatsCalculator> phyRxStats,
+                                         uint64_t imsi,
+                                         PhyReceptionStatParameters params)
+{
+    NS_LOG_FUNCTION(phyRxStats << imsi);
+    params.m_imsi = imsi;
+    phyRxStats->DlPhyReception(params);
+}
+
+void
+PhyRxStatsCalculator::UlPhyReceptionSink(Ptr<PhyRxStatsCalculator> phyRxStats,
+                                         Ptr<LteEnbRrc> rrc,
+                                         PhyReceptionStatParameters params)
+{
+    NS_LOG_FUNCTION(phyRxStats);
+    params.m_imsi = FindImsiFromEnbRrc(rrc, params.m_rnti);
+    phyRxStats->UlPhyReception(params);
+}
+
 } // namespace ns3
@@ -57,6 +57,7 @@ class PhyRxStatsCalculator : public LteStatsCalculator
      * @return The object TypeId.
      */
     static TypeId GetTypeId();
+    void DoDispose() override;
 
     /**
      * Set the name of the file where the UL Rx PHY statistics will be stored.
@@ -118,6 +119,30 @@ class PhyRxStatsCalculator : public LteStatsCalculator
                                        std::string path,
                                        PhyReceptionStatParameters params);
 
+    /**
+     * Trace sink for the ns3::LteSpectrumPhy::DlPhyReception trace source,
+     * connected without context by LteHelper::EnableDlRxPhyTraces()
+     *
+     * @param phyRxStats
+     * @param imsi the IMSI of the UE
+     * @param params
+     */
+    static void DlPhyReceptionSink(Ptr<PhyRxStatsCalculator> phyRxStats,
+                                   uint64_t imsi,
+                                   PhyReceptionStatParameters params);
+
+    /**
+     * Trace sink for the ns3::LteSpectrumPhy::UlPhyReception trace source,
+     * connected without context by LteHelper::EnableUlRxPhyTraces()
+     *
+     * @param phyRxStats
+     * @param rrc the RRC of the eNB, which maps the RNTIs to the IMSIs
+     * @param params
+     */
+    static void UlPhyReceptionSink(Ptr<PhyRxStatsCalculator> phyRxStats,
+                                   Ptr<LteEnbRrc> rrc,
+                                   PhyReceptionStatParameters params);
+
   private:
     /**
      * When writing DL RX PHY statistics first time to file,
@@ -144,6 +169,9 @@ class PhyRxStatsCalculator : public LteStatsCalculator
      * UL RX PHY output trace file
      */
     std::ofstream m_ulRxOutFile;
+
+    Ptr<LteStatsWriter> m_dlRxWriter; ///< DL RX PHY output binary file
+    Ptr<LteStatsWriter> m_ulRxWriter; ///< UL RX PHY output binary file
 };
 
 } // namespace ns3
@@ -11,6 +11,7 @@
 #include "phy-stats-calculator.h"
 
 #include "ns3/string.h"
+#include <ns3/lte-enb-rrc.h>
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 
@@ -48,6 +49,28 @@ PhyStatsCalculator::~PhyStatsCalculator()
     }
 }
 
+void
+PhyStatsCalculator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // write the buffered rows as soon as the calculator is disposed of
+    CloseWriter(m_rsrpWriter);
+    CloseWriter(m_ueSinrWriter);
+    if (m_interferenceOutFile.is_open())
+    {
+        m_interferenceOutFile.close();
+    }
+    if (m_rsrpOutFile.is_open())
+    {
+        m_rsrpOutFile.close();
+    }
+    if (m_ueSinrOutFile.is_open())
+    {
+        m_ueSinrOutFile.close();
+    }
+    LteStatsCalculator::DoDispose();
+}
+
 TypeId
 PhyStatsCalculator::GetTypeId()
 {
@@ -123,15 +146,41 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr(uint16_t cellId,
 
     if (m_RsrpSinrFirstWrite)
     {
-        m_rsrpOutFile.open(GetCurrentCellRsrpSinrFilename());
-        if (!m_rsrpOutFile.is_open())
+        if (IsBinaryOutput())
         {
-            NS_LOG_ERROR("Can't open file " << GetCurrentCellRsrpSinrFilename());
-            return;
+            m_rsrpWriter = CreateWriter(GetCurrentCellRsrpSinrFilename(),
+                                        {{"time", LteStatsWriter::DOUBLE},
+                                         {"cellId", LteStatsWriter::UINT16},
+                                         {"IMSI", LteStatsWriter::UINT64},
+                                         {"RNTI", LteStatsWriter::UINT16},
+                                         {"rsrp", LteStatsWriter::DOUBLE},
+                                         {"sinr", LteStatsWriter::DOUBLE},
+                                         {"ComponentCarrierId", LteStatsWriter::UINT8}});
+            if (!m_rsrpWriter)
+            {
+                return;
+            }
+        }
+        else
+        {
+            m_rsrpOutFile.open(GetCurrentCellRsrpSinrFilename());
+            if (!m_rsrpOutFile.is_open())
+            {
+                NS_LOG_ERROR("Can't open file " << GetCurrentCellRsrpSinrFilename());
+                return;
+            }
+            m_rsrpOutFile << "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId";
+            m_rsrpOutFile << "\n";
         }
         m_RsrpSinrFirstWrite = false;
-        m_rsrpOutFile << "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId";
-        m_rsrpOutFile << "\n";
+    }
+
+    if (m_rsrpWriter)
+    {
+        *m_rsrpWriter << Simulator::Now().GetSeconds() << cellId << imsi << rnti << rsrp << sinr
+                      << componentCarrierId;
+        m_rsrpWriter->EndRow();
+        return;
     }
 
     m_rsrpOutFile << Simulator::Now().GetSeconds() << "\t";
@@ -140,7 +189,7 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr(uint16_t cellId,
     m_rsrpOutFile << rnti << "\t";
     m_rsrpOutFile << rsrp << "\t";
     m_rsrpOutFile << sinr << "\t";
-    m_rsrpOutFile << (uint32_t)componentCarrierId << std::endl;
+    m_rsrpOutFile << (uint32_t)componentCarrierId << "\n";
 }
 
 void
@@ -155,22 +204,47 @@ PhyStatsCalculator::ReportUeSinr(uint16_t cellId,
 
     if (m_UeSinrFirstWrite)
     {
-        m_ueSinrOutFile.open(GetUeSinrFilename());
-        if (!m_ueSinrOutFile.is_open())
+        if (IsBinaryOutput())
         {
-            NS_LOG_ERROR("Can't open file " << GetUeSinrFilename());
-            return;
+            m_ueSinrWriter = CreateWriter(GetUeSinrFilename(),
+                                          {{"time", LteStatsWriter::DOUBLE},
+                                           {"cellId", LteStatsWriter::UINT16},
+                                           {"IMSI", LteStatsWriter::UINT64},
+                                           {"RNTI", LteStatsWriter::UINT16},
+                                           {"sinrLinear", LteStatsWriter::DOUBLE},
+                                           {"componentCarrierId", LteStatsWriter::UINT8}});
+            if (!m_ueSinrWriter)
+            {
+                return;
+            }
+        }
+        else
+        {
+            m_ueSinrOutFile.open(GetUeSinrFilename());
+            if (!m_ueSinrOutFile.is_open())
+            {
+                NS_LOG_ERROR("Can't open file " << GetUeSinrFilename());
+                return;
+            }
+            m_ueSinrOutFile << "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId";
+            m_ueSinrOutFile << "\n";
         }
         m_UeSinrFirstWrite = false;
-        m_ueSinrOutFile << "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId";
-        m_ueSinrOutFile << "\n";
+    }
+
+    if (m_ueSinrWriter)
+    {
+        *m_ueSinrWriter << Simulator::Now().GetSeconds() << cellId << imsi << rnti << sinrLinear
+                        << componentCarrierId;
+        m_ueSinrWriter->EndRow();
+        return;
     }
     m_ueSinrOutFile << Simulator::Now().GetSeconds() << "\t";
     m_ueSinrOutFile << cellId << "\t";
     m_ueSinrOutFile << imsi << "\t";
     m_ueSinrOutFile << rnti << "\t";
     m_ueSinrOutFile << sinrLinear << "\t";
-    m_ueSinrOutFile << (uint32_t)componentCarrierId << std::endl;
+    m_ueSinrOutFile << (uint32_t)componentCarrierId << "\n";
 }
 
 void
@@ -260,4 +334,40 @@ PhyStatsCalculator::ReportInterference(Ptr<PhyStatsCalculator> phyStats,
     phyStats->ReportInterference(cellId, interference);
 }
 
+
+void
+PhyStatsCalculator::ReportCurrentCellRsrpSinrSink(Ptr<PhyStatsCalculator> phyStats,
+                                                  uint64_t imsi,
+                                                  uint16_t cellId,
+                                                  uint16_t rnti,
+                                                  double rsrp,
+                                                  double sinr,
+                                                  uint8_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(phyStats << imsi);
+    phyStats->ReportCurrentCellRsrpSinr(cellId, imsi, rnti, rsrp, sinr, componentCarrierId);
+}
+
+void
+PhyStatsCalculator::ReportUeSinrSink(Ptr<PhyStatsCalculator> phyStats,
+                                     Ptr<LteEnbRrc> rrc,
+                                     uint16_t cellId,
+                                     uint16_t rnti,
+                                     double sinrLinear,
+                                     uint8_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(phyStats);
+    uint64_t imsi = FindImsiFromEnbRrc(rrc, rnti);
+    phyStats->ReportUeSinr(cellId, imsi, rnti, sinrLinear, componentCarrierId);
+}
+
+void
+PhyStatsCalculator::ReportInterferenceSink(Ptr<PhyStatsCalculator> phyStats,
+                                           uint16_t cellId,
+                                           Ptr<SpectrumValue> interference)
+{
+    NS_LOG_FUNCTION(phyStats);
+    phyStats->ReportInterference(cellId, interference);
+}
+
 } // namespace ns3
@@ -64,6 +64,7 @@ class PhyStatsCalculator : public LteStatsCalculator
      * @return The object TypeId.
      */
     static TypeId GetTypeId();
+    void DoDispose() override;
 
     /**
      * Set the name of the file where the RSRP/SINR statistics will be stored.
@@ -190,6 +191,56 @@ class PhyStatsCalculator : public LteStatsCalculator
                                    uint16_t cellId,
                                    Ptr<SpectrumValue> interference);
 
+    /**
+     * Trace sink for the ns3::LteUePhy::ReportCurrentCellRsrpSinr trace
+     * source, connected without context by LteHelper::EnableDlPhyTraces()
+     *
+     * @param phyStats
+     * @param imsi the IMSI of the UE
+     * @param cellId
+     * @param rnti
+     * @param rsrp
+     * @param sinr
+     * @param componentCarrierId
+     */
+    static void ReportCurrentCellRsrpSinrSink(Ptr<PhyStatsCalculator> phyStats,
+                                              uint64_t imsi,
+                                              uint16_t cellId,
+                                              uint16_t rnti,
+                                              double rsrp,
+                                              double sinr,
+                                              uint8_t componentCarrierId);
+
+    /**
+     * Trace sink for the ns3::LteEnbPhy::ReportUeSinr trace source,
+     * connected without context by LteHelper::EnableUlPhyTraces()
+     *
+     * @param phyStats
+     * @param rrc the RRC of the eNB, which maps the RNTIs to the IMSIs
+     * @param cellId
+     * @param rnti
+     * @param sinrLinear
+     * @param componentCarrierId
+     */
+    static void ReportUeSinrSink(Ptr<PhyStatsCalculator> phyStats,
+                                 Ptr<LteEnbRrc> rrc,
+                                 uint16_t cellId,
+                                 uint16_t rnti,
+                                 double sinrLinear,
+                                 uint8_t componentCarrierId);
+
+    /**
+     * Trace sink for the ns3::LteEnbPhy::ReportInterference trace source,
+     * connected without context by LteHelper::EnableUlPhyTraces()
+     *
+     * @param phyStats
+     * @param cellId
+     * @param interference
+     */
+    static void ReportInterferenceSink(Ptr<PhyStatsCalculator> phyStats,
+                                       uint16_t cellId,
+                                       Ptr<SpectrumValue> interference);
+
   private:
     /**
      * When writing RSRP SINR statistics first time to file,
@@ -244,6 +295,9 @@ class PhyStatsCalculator : public LteStatsCalculator
      * Interference statistics output trace file
      */
     std::ofstream m_interferenceOutFile;
+
+    Ptr<LteStatsWriter> m_rsrpWriter;    ///< RSRP statistics output binary file
+    Ptr<LteStatsWriter> m_ueSinrWriter;  ///< UE SINR statistics output binary file
 };
 
 } // namespace ns3
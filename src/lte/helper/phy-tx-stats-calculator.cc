@@ -11,6 +11,7 @@
 #include "phy-tx-stats-calculator.h"
 
 #include "ns3/string.h"
+#include <ns3/lte-enb-rrc.h>
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 
@@ -42,6 +43,24 @@ PhyTxStatsCalculator::~PhyTxStatsCalculator()
     }
 }
 
+void
+PhyTxStatsCalculator::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // write the buffered rows as soon as the calculator is disposed of
+    CloseWriter(m_dlTxWriter);
+    CloseWriter(m_ulTxWriter);
+    if (m_dlTxOutFile.is_open())
+    {
+        m_dlTxOutFile.close();
+    }
+    if (m_ulTxOutFile.is_open())
+    {
+        m_ulTxOutFile.close();
+    }
+    LteStatsCalculator::DoDispose();
+}
+
 TypeId
 PhyTxStatsCalculator::GetTypeId()
 {
@@ -97,15 +116,45 @@ PhyTxStatsCalculator::DlPhyTransmission(PhyTransmissionStatParameters params)
 
     if (m_dlTxFirstWrite)
     {
-        m_dlTxOutFile.open(GetDlOutputFilename());
-        if (!m_dlTxOutFile.is_open())
+        if (IsBinaryOutput())
         {
-            NS_LOG_ERROR("Can't open file " << GetDlTxOutputFilename());
-            return;
+            m_dlTxWriter = CreateWriter(GetDlTxOutputFilename(),
+                                        {{"time", LteStatsWriter::INT64},
+                                         {"cellId", LteStatsWriter::UINT16},
+                                         {"IMSI", LteStatsWriter::UINT64},
+                                         {"RNTI", LteStatsWriter::UINT16},
+                                         {"layer", LteStatsWriter::UINT8},
+                                         {"mcs", LteStatsWriter::UINT8},
+                                         {"size", LteStatsWriter::UINT16},
+                                         {"rv", LteStatsWriter::UINT8},
+                                         {"ndi", LteStatsWriter::UINT8},
+                                         {"ccId", LteStatsWriter::UINT8}});
+            if (!m_dlTxWriter)
+            {
+                return;
+            }
+        }
+        else
+        {
+            m_dlTxOutFile.open(GetDlOutputFilename());
+            if (!m_dlTxOutFile.is_open())
+            {
+                NS_LOG_ERROR("Can't open file " << GetDlTxOutputFilename());
+                return;
+            }
+            m_dlTxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
+            m_dlTxOutFile << "\n";
         }
         m_dlTxFirstWrite = false;
-        m_dlTxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
-        m_dlTxOutFile << "\n";
+    }
+
+    if (m_dlTxWriter)
+    {
+        *m_dlTxWriter << params.m_timestamp << params.m_cellId << params.m_imsi << params.m_rnti
+                      << params.m_layer << params.m_mcs << params.m_size << params.m_rv
+                      << params.m_ndi << params.m_ccId;
+        m_dlTxWriter->EndRow();
+        return;
     }
 
     m_dlTxOutFile << params.m_timestamp << "\t";
@@ -118,7 +167,7 @@ PhyTxStatsCalculator::DlPhyTransmission(PhyTransmissionStatParameters params)
     m_dlTxOutFile << params.m_size << "\t";
     m_dlTxOutFile << (uint32_t)params.m_rv << "\t";
     m_dlTxOutFile << (uint32_t)params.m_ndi << "\t";
-    m_dlTxOutFile << (uint32_t)params.m_ccId << std::endl;
+    m_dlTxOutFile << (uint32_t)params.m_ccId << "\n";
 }
 
 void
@@ -131,16 +180,46 @@ PhyTxStatsCalculator::UlPhyTransmission(PhyTransmissionStatParameters params)
 
     if (m_ulTxFirstWrite)
     {
-        m_ulTxOutFile.open(GetUlTxOutputFilename());
-        if (!m_ulTxOutFile.is_open())
+        if (IsBinaryOutput())
         {
-            NS_LOG_ERROR("Can't open file " << GetUlTxOutputFilename());
-            return;
+            m_ulTxWriter = CreateWriter(GetUlTxOutputFilename(),
+                                        {{"time", LteStatsWriter::INT64},
+                                         {"cellId", LteStatsWriter::UINT16},
+                                         {"IMSI", LteStatsWriter::UINT64},
+                                         {"RNTI", LteStatsWriter::UINT16},
+                                         {"layer", LteStatsWriter::UINT8},
+                                         {"mcs", LteStatsWriter::UINT8},
+                                         {"size", LteStatsWriter::UINT16},
+                                         {"rv", LteStatsWriter::UINT8},
+                                         {"ndi", LteStatsWriter::UINT8},
+                                         {"ccId", LteStatsWriter::UINT8}});
+            if (!m_ulTxWriter)
+            {
+                return;
+            }
+        }
+        else
+        {
+            m_ulTxOutFile.open(GetUlTxOutputFilename());
+            if (!m_ulTxOutFile.is_open())
+            {
+                NS_LOG_ERROR("Can't open file " << GetUlTxOutputFilename());
+                return;
+            }
+            // m_ulTxOutFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi";
+            m_ulTxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
+            m_ulTxOutFile << "\n";
         }
         m_ulTxFirstWrite = false;
-        // m_ulTxOutFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi";
-        m_ulTxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
-        m_ulTxOutFile << "\n";
+    }
+
+    if (m_ulTxWriter)
+    {
+        *m_ulTxWriter << params.m_timestamp << params.m_cellId << params.m_imsi << params.m_rnti
+                      << params.m_layer << params.m_mcs << params.m_size << params.m_rv
+                      << params.m_ndi << params.m_ccId;
+        m_ulTxWriter->EndRow();
+        return;
     }
 
     m_ulTxOutFile << params.m_timestamp << "\t";
@@ -153,7 +232,7 @@ PhyTxStatsCalculator::UlPhyTransmission(PhyTransmissionStatParameters params)
     m_ulTxOutFile << params.m_size << "\t";
     m_ulTxOutFile << (uint32_t)params.m_rv << "\t";
     m_ulTxOutFile << (uint32_t)params.m_ndi << "\t";
-    m_ulTxOutFile << (uint32_t)params.m_ccId << std::endl;
+    m_ulTxOutFile << (uint32_t)params.m_ccId << "\n";
 }
 
 void
@@ -204,4 +283,25 @@ PhyTxStatsCalculator::UlPhyTransmissionCallback(Ptr<PhyTxStatsCalculator> phyTxS
     phyTxStats->UlPhyTransmission(params);
 }
 
+
+void
+PhyTxStatsCalculator::DlPhyTransmissionSink(Ptr<PhyTxStatsCalculator> phyTxStats,
+                                            Ptr<LteEnbRrc> rrc,
+                                            PhyTransmissionStatParameters params)
+{
+    NS_LOG_FUNCTION(phyTxStats);
+    params.m_imsi = FindImsiFromEnbRrc(rrc, params.m_rnti);
+    phyTxStats->DlPhyTransmission(params);
+}
+
+void
+PhyTxStatsCalculator::UlPhyTransmissionSink(Ptr<PhyTxStatsCalculator> phyTxStats,
+                                            uint64_t imsi,
+                                            PhyTransmissionStatParameters params)
+{
+    NS_LOG_FUNCTION(phyTxStats << imsi);
+    params.m_imsi = imsi;
+    phyTxStats->UlPhyTransmission(params);
+}
+
 } // namespace ns3
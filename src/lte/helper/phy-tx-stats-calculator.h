@@ -57,6 +57,7 @@ class PhyTxStatsCalculator : public LteStatsCalculator
      * @return The object TypeId.
      */
     static TypeId GetTypeId();
+    void DoDispose() override;
 
     /**
      * Set the name of the file where the UL Tx PHY statistics will be stored.
@@ -118,6 +119,30 @@ class PhyTxStatsCalculator : public LteStatsCalculator
                                           std::string path,
                                           PhyTransmissionStatParameters params);
 
+    /**
+     * Trace sink for the ns3::LteEnbPhy::DlPhyTransmission trace source,
+     * connected without context by LteHelper::EnableDlTxPhyTraces()
+     *
+     * @param phyTxStats
+     * @param rrc the RRC of the eNB, which maps the RNTIs to the IMSIs
+     * @param params
+     */
+    static void DlPhyTransmissionSink(Ptr<PhyTxStatsCalculator> phyTxStats,
+                                      Ptr<LteEnbRrc> rrc,
+                                      PhyTransmissionStatParameters params);
+
+    /**
+     * Trace sink for the ns3::LteUePhy::UlPhyTransmission trace source,
+     * connected without context by LteHelper::EnableUlTxPhyTraces()
+     *
+     * @param phyTxStats
+     * @param imsi the IMSI of the UE
+     * @param params
+     */
+    static void UlPhyTransmissionSink(Ptr<PhyTxStatsCalculator> phyTxStats,
+                                      uint64_t imsi,
+                                      PhyTransmissionStatParameters params);
+
   private:
     /**
      * When writing DL TX PHY statistics first time to file,
@@ -144,6 +169,9 @@ class PhyTxStatsCalculator : public LteStatsCalculator
      * UL TX PHY statistics output trace file
      */
     std::ofstream m_ulTxOutFile;
+
+    Ptr<LteStatsWriter> m_dlTxWriter; ///< DL TX PHY statistics output binary file
+    Ptr<LteStatsWriter> m_ulTxWriter; ///< UL TX PHY statistics output binary file
 };
 
 } // namespace ns3
@@ -9,6 +9,7 @@
 #include "radio-environment-map-helper.h"
 
 #include <ns3/abort.h>
+#include <ns3/antenna-model.h>
 #include <ns3/boolean.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/config.h>
@@ -16,18 +17,29 @@
 #include <ns3/double.h>
 #include <ns3/integer.h>
 #include <ns3/log.h>
+#include <ns3/lte-spectrum-signal-parameters.h>
 #include <ns3/lte-spectrum-value-helper.h>
 #include <ns3/mobility-building-info.h>
 #include <ns3/node.h>
 #include <ns3/pointer.h>
+#include <ns3/propagation-loss-model.h>
 #include <ns3/rem-spectrum-phy.h>
 #include <ns3/simulator.h>
 #include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/spectrum-transmit-filter.h>
 #include <ns3/string.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iostream>
 #include <limits>
+#include <sstream>
+#include <thread>
 
 namespace ns3
 {
@@ -36,6 +48,27 @@ NS_LOG_COMPONENT_DEFINE("RadioEnvironmentMapHelper");
 
 NS_OBJECT_ENSURE_REGISTERED(RadioEnvironmentMapHelper);
 
+/**
+ * Header of the binary output of RadioEnvironmentMapHelper. It is followed by
+ * the SINR of the XRes x YRes points as 32 bit floats, in the order of the
+ * text output, i.e., the YRes points of the first column, then the ones of the
+ * second column, and so on.
+ */
+struct RemRasterHeader
+{
+    char m_magic[8];  ///< "ns3rem01"
+    uint32_t m_xRes;  ///< the number of columns
+    uint32_t m_yRes;  ///< the number of points per column
+    double m_xMin;    ///< the x coordinate of the first column
+    double m_xMax;    ///< the x coordinate of the last column
+    double m_yMin;    ///< the y coordinate of the first point of a column
+    double m_yMax;    ///< the y coordinate of the last point of a column
+    double m_z;       ///< the z coordinate of the map
+};
+
+/// The magic string of the binary output
+static const char REM_RASTER_MAGIC[8] = {'n', 's', '3', 'r', 'e', 'm', '0', '1'};
+
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper()
 {
 }
@@ -48,6 +81,7 @@ void
 RadioEnvironmentMapHelper::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_transmitters.clear();
 }
 
 TypeId
@@ -131,7 +165,9 @@ RadioEnvironmentMapHelper::GetTypeId()
                 MakeDoubleChecker<double>())
             .AddAttribute("MaxPointsPerIteration",
                           "Maximum number of REM points to be calculated per iteration. Every "
-                          "point consumes approximately 5KB of memory.",
+                          "point consumes approximately 5KB of memory. With DirectEvaluation, "
+                          "the map is computed by blocks of columns of at most this number of "
+                          "points (but at least one column), whose received powers are kept.",
                           UintegerValue(20000),
                           MakeUintegerAccessor(&RadioEnvironmentMapHelper::m_maxPointsPerIteration),
                           MakeUintegerChecker<uint32_t>(1, std::numeric_limits<uint32_t>::max()))
@@ -158,7 +194,29 @@ RadioEnvironmentMapHelper::GetTypeId()
                           "default value is -1, what means REM will be averaged from all RBs",
                           IntegerValue(-1),
                           MakeIntegerAccessor(&RadioEnvironmentMapHelper::m_rbId),
-                          MakeIntegerChecker<int32_t>());
+                          MakeIntegerChecker<int32_t>())
+            .AddAttribute("DirectEvaluation",
+                          "If true, the signals of the transmitters are recorded during one "
+                          "subframe and the map is computed directly from them, instead of "
+                          "deploying RemSpectrumPhy listeners on the channel",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RadioEnvironmentMapHelper::m_directEvaluation),
+                          MakeBooleanChecker())
+            .AddAttribute("Workers",
+                          "Number of threads among which the computation of the SINR of the "
+                          "points and their formatting are split with DirectEvaluation. The "
+                          "propagation loss models are not thread-safe, hence the powers "
+                          "received at the points are computed in the simulation thread, in "
+                          "the same order whatever the number of workers: the map and the "
+                          "random values drawn by the models do not depend on it.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&RadioEnvironmentMapHelper::m_workers),
+                          MakeUintegerChecker<uint32_t>(1, 1024))
+            .AddAttribute("BinaryOutput",
+                          "If true, the map is saved as a binary raster instead of text",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RadioEnvironmentMapHelper::m_binaryOutput),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -192,7 +250,7 @@ void
 RadioEnvironmentMapHelper::Install()
 {
     NS_LOG_FUNCTION(this);
-    if (!m_rem.empty())
+    if (!m_rem.empty() || m_outFile.is_open())
     {
         NS_FATAL_ERROR("only one REM supported per instance of RadioEnvironmentMapHelper");
     }
@@ -209,13 +267,28 @@ RadioEnvironmentMapHelper::Install()
                         "object at " << m_channelPath << " is not of type SpectrumChannel");
     }
 
-    m_outFile.open(m_outputFile.c_str());
+    m_outFile.open(m_outputFile.c_str(),
+                   m_binaryOutput ? std::ios::out | std::ios::binary : std::ios::out);
     if (!m_outFile.is_open())
     {
         NS_FATAL_ERROR("Can't open file " << (m_outputFile));
         return;
     }
 
+    if (m_binaryOutput)
+    {
+        RemRasterHeader header;
+        std::memcpy(header.m_magic, REM_RASTER_MAGIC, sizeof(header.m_magic));
+        header.m_xRes = m_xRes;
+        header.m_yRes = m_yRes;
+        header.m_xMin = m_xMin;
+        header.m_xMax = m_xMax;
+        header.m_yMin = m_yMin;
+        header.m_yMax = m_yMax;
+        header.m_z = m_z;
+        m_outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
     double startDelay = 0.0026;
 
     if (m_useDataChannel)
@@ -234,6 +307,16 @@ RadioEnvironmentMapHelper::DelayedInstall()
     m_xStep = (m_xMax - m_xMin) / (m_xRes - 1);
     m_yStep = (m_yMax - m_yMin) / (m_yRes - 1);
 
+    if (m_directEvaluation)
+    {
+        // record the signals transmitted during one subframe
+        m_channel->TraceConnectWithoutContext(
+            "TxSigParams",
+            MakeCallback(&RadioEnvironmentMapHelper::RecordSignal, this));
+        Simulator::Schedule(MilliSeconds(1), &RadioEnvironmentMapHelper::RunDirectEvaluation, this);
+        return;
+    }
+
     if ((double)m_xRes * (double)m_yRes < (double)m_maxPointsPerIteration)
     {
         m_maxPointsPerIteration = m_xRes * m_yRes;
@@ -342,12 +425,244 @@ RadioEnvironmentMapHelper::PrintAndReset()
         Vector pos = it->bmm->GetPosition();
         NS_LOG_LOGIC("output: " << pos.x << "\t" << pos.y << "\t" << pos.z << "\t"
                                 << it->phy->GetSinr(m_noisePower));
-        m_outFile << pos.x << "\t" << pos.y << "\t" << pos.z << "\t"
-                  << it->phy->GetSinr(m_noisePower) << std::endl;
+        WritePoint(m_outFile, pos, it->phy->GetSinr(m_noisePower));
         it->phy->Reset();
     }
 }
 
+void
+RadioEnvironmentMapHelper::WritePoint(std::ostream& os, const Vector& pos, double sinr) const
+{
+    if (m_binaryOutput)
+    {
+        float value = sinr;
+        os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    else
+    {
+        os << pos.x << "\t" << pos.y << "\t" << pos.z << "\t" << sinr << "\n";
+    }
+}
+
+void
+RadioEnvironmentMapHelper::RecordSignal(Ptr<SpectrumSignalParameters> params)
+{
+    NS_LOG_FUNCTION(this << params);
+    // the same signals as the ones RemSpectrumPhy accounts for
+    if (m_useDataChannel ? !DynamicCast<LteSpectrumSignalParametersDataFrame>(params)
+                         : !DynamicCast<LteSpectrumSignalParametersDlCtrlFrame>(params))
+    {
+        return;
+    }
+    for (auto& tx : m_transmitters)
+    {
+        if (tx.params->txPhy == params->txPhy)
+        {
+            tx.params = params;
+            return;
+        }
+    }
+    RemTransmitter tx;
+    tx.params = params;
+    m_transmitters.push_back(tx);
+}
+
+double
+RadioEnvironmentMapHelper::GetPower(const SpectrumValue& psd) const
+{
+    if (m_rbId >= 0)
+    {
+        return psd[m_rbId] * 180000;
+    }
+    return Integral(psd);
+}
+
+void
+RadioEnvironmentMapHelper::RunDirectEvaluation()
+{
+    NS_LOG_FUNCTION(this);
+    m_channel->TraceDisconnectWithoutContext(
+        "TxSigParams",
+        MakeCallback(&RadioEnvironmentMapHelper::RecordSignal, this));
+    NS_ABORT_MSG_IF(m_channel->GetPhasedArraySpectrumPropagationLossModel() &&
+                        !m_channel->GetSpectrumPropagationLossModel(),
+                    "the REM listening points have no phased array antenna");
+
+    DoubleValue maxLossDb;
+    m_channel->GetAttribute("MaxLossDb", maxLossDb);
+    m_maxLossDb = maxLossDb.Get();
+
+    // convert the signals once to the spectrum model of the map
+    Ptr<const SpectrumModel> remModel = LteSpectrumValueHelper::GetSpectrumModel(m_earfcn,
+                                                                                 m_bandwidth);
+    for (auto it = m_transmitters.begin(); it != m_transmitters.end();)
+    {
+        Ptr<const SpectrumModel> txModel = it->params->psd->GetSpectrumModel();
+        if (txModel->GetUid() == remModel->GetUid())
+        {
+            it->psd = it->params->psd;
+        }
+        else if (txModel->IsOrthogonal(*remModel))
+        {
+            it = m_transmitters.erase(it);
+            continue;
+        }
+        else
+        {
+            it->psd = SpectrumConverter(txModel, remModel).Convert(it->params->psd);
+        }
+        it->power = GetPower(*it->psd);
+        it->mobility = it->params->txPhy->GetMobility();
+        ++it;
+    }
+    NS_LOG_LOGIC(m_transmitters.size() << " transmitters");
+
+    // a listener like the ones of the other mode, which is not attached to the
+    // channel, but through which the transmit filter of the channel is applied
+    Ptr<MobilityModel> rxMobility = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo>();
+    rxMobility->AggregateObject(buildingInfo);
+    Ptr<RemSpectrumPhy> listener = CreateObject<RemSpectrumPhy>();
+    listener->SetRxSpectrumModel(remModel);
+    listener->SetMobility(rxMobility);
+    listener->SetUseDataChannel(m_useDataChannel);
+    listener->SetRbId(m_rbId);
+
+    // The propagation loss models and the transmit filter are neither
+    // thread-safe nor free of random draws, hence the received powers are
+    // computed in the simulation thread, in the order of the points, which
+    // does not depend on the number of workers. The worker threads compute
+    // the SINR of the points from the powers of a block of columns, which
+    // they only read, and format them into buffers of their own.
+    const std::size_t nTransmitters = m_transmitters.size();
+    const uint16_t blockColumns =
+        std::max<uint32_t>(1, std::min<uint32_t>(m_maxPointsPerIteration / m_yRes, m_xRes));
+    std::vector<double> powers;
+    for (uint16_t xBegin = 0; xBegin < m_xRes; xBegin += blockColumns)
+    {
+        uint16_t xEnd = std::min<uint32_t>(xBegin + blockColumns, m_xRes);
+        uint32_t points = (xEnd - xBegin) * m_yRes;
+        powers.assign(points * nTransmitters, 0);
+        uint32_t point = 0;
+        for (uint16_t i = xBegin; i < xEnd; ++i)
+        {
+            for (uint16_t j = 0; j < m_yRes; ++j)
+            {
+                rxMobility->SetPosition(Vector(m_xMin + i * m_xStep, m_yMin + j * m_yStep, m_z));
+                buildingInfo->MakeConsistent(rxMobility);
+                EvaluatePoint(listener, powers.data() + point * nTransmitters);
+                ++point;
+            }
+        }
+
+        uint32_t workers = std::min(m_workers, points);
+        if (workers == 1)
+        {
+            WritePoints(xBegin, 0, points, powers, m_outFile);
+            continue;
+        }
+        std::vector<std::ostringstream> buffers(workers);
+        std::vector<std::thread> threads;
+        for (uint32_t w = 1; w < workers; ++w)
+        {
+            threads.emplace_back(&RadioEnvironmentMapHelper::WritePoints,
+                                 this,
+                                 xBegin,
+                                 w * points / workers,
+                                 (w + 1) * points / workers,
+                                 std::cref(powers),
+                                 std::ref(buffers[w]));
+        }
+        WritePoints(xBegin, 0, points / workers, powers, buffers[0]);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (const auto& buffer : buffers)
+        {
+            m_outFile << buffer.str();
+        }
+    }
+    Finalize();
+}
+
+void
+RadioEnvironmentMapHelper::EvaluatePoint(Ptr<RemSpectrumPhy> listener, double* powers) const
+{
+    // the same computation as the one of the channel for a receiver without antenna
+    Ptr<PropagationLossModel> propagationLoss = m_channel->GetPropagationLossModel();
+    Ptr<SpectrumPropagationLossModel> spectrumLoss = m_channel->GetSpectrumPropagationLossModel();
+    Ptr<SpectrumTransmitFilter> filter = m_channel->GetSpectrumTransmitFilter();
+    Ptr<MobilityModel> rxMobility = listener->GetMobility();
+    Vector rxPos = rxMobility->GetPosition();
+    for (std::size_t k = 0; k < m_transmitters.size(); ++k)
+    {
+        const RemTransmitter& tx = m_transmitters[k];
+        if (filter && filter->Filter(tx.params, listener))
+        {
+            continue;
+        }
+        double pathLossDb = 0;
+        if (tx.mobility)
+        {
+            Vector txPos = tx.mobility->GetPosition();
+            if (tx.params->txAntenna)
+            {
+                pathLossDb -= tx.params->txAntenna->GetGainDb(Angles(rxPos, txPos));
+            }
+            if (propagationLoss && txPos != rxPos)
+            {
+                pathLossDb -= propagationLoss->CalcRxPower(0, tx.mobility, rxMobility);
+            }
+            if (pathLossDb > m_maxLossDb)
+            {
+                continue;
+            }
+        }
+        double pathLossLinear = std::pow(10.0, -pathLossDb / 10.0);
+        powers[k] = tx.power * pathLossLinear;
+        if (spectrumLoss && tx.mobility)
+        {
+            Ptr<SpectrumSignalParameters> params = tx.params->Copy();
+            params->psd = Copy<SpectrumValue>(tx.psd);
+            *(params->psd) *= pathLossLinear;
+            powers[k] = GetPower(*spectrumLoss->CalcRxPowerSpectralDensity(params,
+                                                                           tx.mobility,
+                                                                           rxMobility));
+        }
+    }
+}
+
+void
+RadioEnvironmentMapHelper::WritePoints(uint16_t xBegin,
+                                       uint32_t begin,
+                                       uint32_t end,
+                                       const std::vector<double>& powers,
+                                       std::ostream& os) const
+{
+    const std::size_t nTransmitters = m_transmitters.size();
+    for (uint32_t point = begin; point < end; ++point)
+    {
+        double sumPower = 0;
+        double referenceSignalPower = 0;
+        for (std::size_t k = 0; k < nTransmitters; ++k)
+        {
+            double power = powers[point * nTransmitters + k];
+            sumPower += power;
+            if (power > referenceSignalPower)
+            {
+                referenceSignalPower = power;
+            }
+        }
+        Vector pos(m_xMin + (xBegin + point / m_yRes) * m_xStep,
+                   m_yMin + (point % m_yRes) * m_yStep,
+                   m_z);
+        WritePoint(os,
+                   pos,
+                   referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower));
+    }
+}
+
 void
 RadioEnvironmentMapHelper::Finalize()
 {
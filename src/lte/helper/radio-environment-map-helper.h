@@ -10,8 +10,10 @@
 #define RADIO_ENVIRONMENT_MAP_HELPER_H
 
 #include <ns3/object.h>
+#include <ns3/vector.h>
 
 #include <fstream>
+#include <vector>
 
 namespace ns3
 {
@@ -20,6 +22,8 @@ class RemSpectrumPhy;
 class Node;
 class NetDevice;
 class SpectrumChannel;
+class SpectrumSignalParameters;
+class SpectrumValue;
 // class BuildingsMobilityModel;
 class MobilityModel;
 
@@ -29,6 +33,13 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * By default, the map is computed by RemSpectrumPhy listeners attached to
+ * the channel, in successive iterations of the simulation. With the
+ * `DirectEvaluation` attribute, the signals of the transmitters are recorded
+ * during one subframe instead, and the map is computed from them through the
+ * propagation loss models of the channel, without the event loop, optionally
+ * with several worker threads.
  */
 class RadioEnvironmentMapHelper : public Object
 {
@@ -93,6 +104,65 @@ class RadioEnvironmentMapHelper : public Object
     /// Called when the map generation procedure has been completed.
     void Finalize();
 
+    /**
+     * Sink of the TxSigParams trace of the channel, which records the last
+     * signal of each transmitter in the direct evaluation mode.
+     *
+     * @param params the parameters of the transmitted signal
+     */
+    void RecordSignal(Ptr<SpectrumSignalParameters> params);
+
+    /**
+     * Scheduled one subframe after DelayedInstall() in the direct evaluation
+     * mode, to compute the whole map from the recorded signals, block of
+     * columns by block of columns.
+     */
+    void RunDirectEvaluation();
+
+    /**
+     * Compute the power received from each recorded transmitter at a listening
+     * point, as the channel does for a RemSpectrumPhy listener. The propagation
+     * loss models and the transmit filter of the channel are used, hence this
+     * method is only called in the simulation thread.
+     *
+     * @param listener the listener, whose mobility is at the listening point
+     * @param powers the received powers, one per transmitter, zero if the
+     *               signal of the transmitter is not received
+     */
+    void EvaluatePoint(Ptr<RemSpectrumPhy> listener, double* powers) const;
+
+    /**
+     * Compute the SINR of a range of the points of a block of columns, from
+     * the received powers of the block, and write them. This method only reads
+     * the powers and the attributes, hence it is run by the worker threads.
+     *
+     * @param xBegin the index of the first column of the block
+     * @param begin the index of the first point in the block
+     * @param end the index past the last point in the block
+     * @param powers the received powers of the points of the block
+     * @param os the stream to which the points are written
+     */
+    void WritePoints(uint16_t xBegin,
+                     uint32_t begin,
+                     uint32_t end,
+                     const std::vector<double>& powers,
+                     std::ostream& os) const;
+
+    /**
+     * @param psd the received PSD
+     * @return the received power over the RBs of the map
+     */
+    double GetPower(const SpectrumValue& psd) const;
+
+    /**
+     * Write a point of the map in the output format.
+     *
+     * @param os the output stream
+     * @param pos the position of the point
+     * @param sinr the SINR at the point
+     */
+    void WritePoint(std::ostream& os, const Vector& pos, double sinr) const;
+
     /// A complete Radio Environment Map is composed of many of this structure.
     struct RemPoint
     {
@@ -105,6 +175,22 @@ class RadioEnvironmentMapHelper : public Object
     /// List of listeners in the environment.
     std::list<RemPoint> m_rem;
 
+    /// A transmitter whose signal is recorded in the direct evaluation mode.
+    struct RemTransmitter
+    {
+        /// The parameters of the last signal of the transmitter.
+        Ptr<SpectrumSignalParameters> params;
+        /// The PSD of the signal converted to the spectrum model of the map.
+        Ptr<SpectrumValue> psd;
+        /// The transmitted power over the RBs of the map.
+        double power;
+        /// Position of the transmitter.
+        Ptr<MobilityModel> mobility;
+    };
+
+    /// Transmitters recorded in the direct evaluation mode.
+    std::vector<RemTransmitter> m_transmitters;
+
     double m_xMin;   ///< The `XMin` attribute.
     double m_xMax;   ///< The `XMax` attribute.
     uint16_t m_xRes; ///< The `XRes` attribute.
@@ -148,6 +234,11 @@ class RadioEnvironmentMapHelper : public Object
     bool m_useDataChannel; ///< The `UseDataChannel` attribute.
     int32_t m_rbId;        ///< The `RbId` attribute.
 
+    bool m_directEvaluation; ///< The `DirectEvaluation` attribute.
+    uint32_t m_workers;      ///< The `Workers` attribute.
+    bool m_binaryOutput;     ///< The `BinaryOutput` attribute.
+    double m_maxLossDb;      ///< The `MaxLossDb` attribute of the channel.
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 } // namespace ns3
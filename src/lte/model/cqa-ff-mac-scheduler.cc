@@ -14,6 +14,7 @@
 #include "cqa-ff-mac-scheduler.h"
 
 #include "ff-mac-common.h"
+#include "ff-mac-dl-ue-table.h"
 #include "lte-amc.h"
 #include "lte-vendor-specific-parameters.h"
 
@@ -117,6 +118,24 @@ CqaKeyDescComparator(uint16_t key1, uint16_t key2)
     return key1 > key2;
 }
 
+/**
+ * Get the CQI of an RBG used by the CoItA metric
+ * @param sbMeas the subband CQIs of the UE
+ * @param rbg the RBG
+ * @returns the CQI of the first layer, or 1 if it is not known
+ */
+static int
+GetCoitaCqi(const SbMeasResult_s& sbMeas, int rbg)
+{
+    if (static_cast<std::size_t>(rbg) >= sbMeas.m_higherLayerSelected.size() ||
+        sbMeas.m_higherLayerSelected[rbg].m_sbCqi.empty() ||
+        sbMeas.m_higherLayerSelected[rbg].m_sbCqi[0] == 0)
+    {
+        return 1; // if no info on channel use the worst cqi
+    }
+    return sbMeas.m_higherLayerSelected[rbg].m_sbCqi[0];
+}
+
 CqaFfMacScheduler::CqaFfMacScheduler()
     : m_cschedSapUser(nullptr),
       m_schedSapUser(nullptr),
@@ -502,21 +521,7 @@ CqaFfMacScheduler::GetRbgSize(int dlbandwidth)
 unsigned int
 CqaFfMacScheduler::LcActivePerFlow(uint16_t rnti)
 {
-    unsigned int lcActive = 0;
-    for (auto it = m_rlcBufferReq.begin(); it != m_rlcBufferReq.end(); it++)
-    {
-        if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcStatusPduSize > 0)))
-        {
-            lcActive++;
-        }
-        if ((*it).first.m_rnti > rnti)
-        {
-            break;
-        }
-    }
-    return lcActive;
+    return FfMacDlUeTable::CountActiveLcs(m_rlcBufferReq, rnti);
 }
 
 bool
@@ -1273,6 +1278,10 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
         }
     }
 
+    // the sum of the CQIs of each UE over the available RBGs, used by the CoItA metric; it is
+    // computed the first time the UE is evaluated, and updated when an RBG is no longer available
+    std::map<uint16_t, std::pair<const SbMeasResult_s*, double>> coitaSums;
+
     auto itGBRgroups = map_GBRHOLgroupToUE.begin();
     auto itnonGBRgroups = map_nonGBRHOLgroupToUE.begin();
 
@@ -1330,7 +1339,7 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
                 double metric = 0;
                 uint8_t worstCQIAmongRBGsAllocatedForThisUser = 15;
                 int numberOfRBGAllocatedForThisUser = 0;
-                LogicalChannelConfigListElement_s lc =
+                const LogicalChannelConfigListElement_s& lc =
                     m_ueLogicalChannelsConfigList.find(flowId)->second;
                 auto itRntiCQIsMap = m_a30CqiRxed.find(flowId.m_rnti);
 
@@ -1355,32 +1364,20 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
 
                 if (itRntiCQIsMap != m_a30CqiRxed.end())
                 {
-                    for (auto it = availableRBGs.begin(); it != availableRBGs.end(); it++)
+                    auto itCoitaSum = coitaSums.find(flowId.m_rnti);
+                    if (itCoitaSum == coitaSums.end())
                     {
-                        try
-                        {
-                            int val =
-                                (itRntiCQIsMap->second.m_higherLayerSelected.at(*it).m_sbCqi.at(0));
-                            if (val == 0)
-                            {
-                                val = 1; // if no info, use minimum
-                            }
-                            if (*it == currentRB)
-                            {
-                                cqi_value = val;
-                            }
-                            coita_sum += val;
-                        }
-                        catch (std::out_of_range&)
+                        const SbMeasResult_s& sbMeas = itRntiCQIsMap->second;
+                        double sum = 0;
+                        for (auto it = availableRBGs.begin(); it != availableRBGs.end(); it++)
                         {
-                            coita_sum += 1; // if no info on channel use the worst cqi
-                            NS_LOG_INFO("No CQI for lcId:" << flowId.m_lcId
-                                                           << " rnti:" << flowId.m_rnti
-                                                           << " at subband:" << currentRB);
-                            // std::cout<<"\n No CQI for
-                            // lcId:.....................................";
+                            sum += GetCoitaCqi(sbMeas, *it);
                         }
+                        itCoitaSum =
+                            coitaSums.insert({flowId.m_rnti, std::make_pair(&sbMeas, sum)}).first;
                     }
+                    cqi_value = GetCoitaCqi(itRntiCQIsMap->second, currentRB);
+                    coita_sum = itCoitaSum->second.second;
                     coita_metric = cqi_value / coita_sum;
                     UeToCQIValue.insert(std::pair<LteFlowId_t, CQI_value>(flowId, cqi_value));
                     UeToCoitaMetric.insert(std::pair<LteFlowId_t, double>(flowId, coita_metric));
@@ -1426,8 +1423,6 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
                 double pf_weight = achievableRate / (*itStats).second.secondLastAveragedThroughput;
 
                 UeToAmountOfAssignedResources.find(flowId)->second = 8 * tbSize;
-                FfMacSchedSapProvider::SchedDlRlcBufferReqParameters lcBufferInfo =
-                    m_rlcBufferReq.find(flowId)->second;
 
                 if (UeToAmountOfDataToTransfer.find(flowId)->second -
                         UeToAmountOfAssignedResources.find(flowId)->second <
@@ -1491,6 +1486,10 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
             {
                 // erase current RBG from the list of available RBG
                 availableRBGs.erase(currentRB);
+                for (auto& coitaSum : coitaSums)
+                {
+                    coitaSum.second.second -= GetCoitaCqi(*coitaSum.second.first, currentRB);
+                }
                 continue;
             }
 
@@ -1520,6 +1519,10 @@ CqaFfMacScheduler::DoSchedDlTriggerReq(
 
             // erase current RBG from the list of available RBG
             availableRBGs.erase(currentRB);
+            for (auto& coitaSum : coitaSums)
+            {
+                coitaSum.second.second -= GetCoitaCqi(*coitaSum.second.first, currentRB);
+            }
 
             if (UeToAmountOfDataToTransfer.find(userWithMaximumMetric)->second <=
                 UeToAmountOfAssignedResources.find(userWithMaximumMetric)->second * tolerance)
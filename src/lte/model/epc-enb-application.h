@@ -24,6 +24,7 @@
 #include <ns3/virtual-net-device.h>
 
 #include <map>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -276,13 +277,13 @@ class EpcEnbApplication : public Application
      * map of maps telling for each RNTI and BID the corresponding  S1-U TEID
      *
      */
-    std::map<uint16_t, std::map<uint8_t, uint32_t>> m_rbidTeidMap;
+    std::unordered_map<uint16_t, std::map<uint8_t, uint32_t>> m_rbidTeidMap;
 
     /**
      * map telling for each S1-U TEID the corresponding RNTI,BID
      *
      */
-    std::map<uint32_t, EpsFlowId_t> m_teidRbidMap;
+    std::unordered_map<uint32_t, EpsFlowId_t> m_teidRbidMap;
 
     /**
      * UDP port to be used for GTP
@@ -17,6 +17,8 @@
 #include "ns3/socket.h"
 #include "ns3/virtual-net-device.h"
 
+#include <unordered_map>
+
 namespace ns3
 {
 
@@ -290,12 +292,12 @@ class EpcPgwApplication : public Application
     /**
      * UeInfo stored by UE IPv4 address
      */
-    std::map<Ipv4Address, Ptr<UeInfo>> m_ueInfoByAddrMap;
+    std::unordered_map<Ipv4Address, Ptr<UeInfo>, Ipv4AddressHash> m_ueInfoByAddrMap;
 
     /**
      * UeInfo stored by UE IPv6 address
      */
-    std::map<Ipv6Address, Ptr<UeInfo>> m_ueInfoByAddrMap6;
+    std::unordered_map<Ipv6Address, Ptr<UeInfo>, Ipv6AddressHash> m_ueInfoByAddrMap6;
 
     /**
      * UeInfo stored by IMSI
@@ -133,7 +133,7 @@ EpcSgwApplication::RecvFromS5uSocket(Ptr<Socket> socket)
     packet->RemoveHeader(gtpu);
     uint32_t teid = gtpu.GetTeid();
 
-    Ipv4Address enbAddr = m_enbByTeidMap[teid];
+    Ipv4Address enbAddr = teid < m_enbByTeid.size() ? m_enbByTeid[teid] : Ipv4Address();
     NS_LOG_DEBUG("eNB " << enbAddr << " TEID " << teid);
     SendToS1uSocket(packet, enbAddr, teid);
 }
@@ -256,7 +256,9 @@ EpcSgwApplication::DoRecvCreateSessionRequest(Ptr<Packet> packet)
         uint32_t teid = ++m_teidCount;
 
         NS_LOG_DEBUG("  TEID " << teid);
-        m_enbByTeidMap[teid] = enbAddr;
+        // the TEIDs are allocated sequentially, hence the table only grows
+        m_enbByTeid.resize(teid + 1);
+        m_enbByTeid[teid] = enbAddr;
 
         GtpcCreateSessionRequestMessage::BearerContextToBeCreated bearerContextOut;
         bearerContextOut.sgwS5uFteid.interfaceType = GtpcHeader::S5_SGW_GTPU;
@@ -310,9 +312,8 @@ EpcSgwApplication::DoRecvModifyBearerRequest(Ptr<Packet> packet)
         uint32_t teid = bearerContext.fteid.teid;
         Ipv4Address enbAddr = bearerContext.fteid.addr;
         NS_LOG_DEBUG("bearerId " << (uint16_t)bearerContext.epsBearerId << " TEID " << teid);
-        auto addrit = m_enbByTeidMap.find(teid);
-        NS_ASSERT_MSG(addrit != m_enbByTeidMap.end(), "unknown TEID " << teid);
-        addrit->second = enbAddr;
+        NS_ASSERT_MSG(teid > 0 && teid < m_enbByTeid.size(), "unknown TEID " << teid);
+        m_enbByTeid[teid] = enbAddr;
         GtpcModifyBearerRequestMessage::BearerContextToBeModified bearerContextOut;
         bearerContextOut.epsBearerId = bearerContext.epsBearerId;
         bearerContextOut.fteid.interfaceType = GtpcHeader::S5_SGW_GTPU;
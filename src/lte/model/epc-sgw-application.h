@@ -16,6 +16,7 @@
 #include "ns3/socket.h"
 
 #include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -249,9 +250,10 @@ class EpcSgwApplication : public Application
     std::map<uint16_t, EnbInfo> m_enbInfoByCellId;
 
     /**
-     * Map for eNB address by TEID
+     * eNB address by TEID. The TEIDs are allocated sequentially, so that the
+     * address of the eNB of a TEID is directly indexed by the TEID.
      */
-    std::map<uint32_t, Ipv4Address> m_enbByTeidMap;
+    std::vector<Ipv4Address> m_enbByTeid;
 
     /**
      * MME S11 FTEID by SGW S5C TEID
@@ -23,9 +23,7 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
-#include "ns3/tcp-header.h"
 #include "ns3/tcp-l4-protocol.h"
-#include "ns3/udp-header.h"
 #include "ns3/udp-l4-protocol.h"
 
 namespace ns3
@@ -55,12 +53,56 @@ EpcTftClassifier::Delete(uint32_t id)
     m_tftMap.erase(id);
 }
 
+/**
+ * Read the ports of the UDP or TCP header following the IP header of a packet,
+ * without copying the packet.
+ *
+ * @param p the IP packet
+ * @param ipHeaderSize the size of the IP header
+ * @param direction the EPC TFT direction
+ * @param [out] localPort the port of the UE
+ * @param [out] remotePort the port of the remote host
+ */
+static void
+ReadPorts(Ptr<const Packet> p,
+          uint32_t ipHeaderSize,
+          EpcTft::Direction direction,
+          uint16_t& localPort,
+          uint16_t& remotePort)
+{
+    // the source and the destination ports are the first 4 bytes of both UDP and TCP headers
+    uint8_t buffer[64];
+    NS_ASSERT(ipHeaderSize + 4 <= sizeof(buffer));
+    if (p->CopyData(buffer, ipHeaderSize + 4) < ipHeaderSize + 4)
+    {
+        return;
+    }
+    uint16_t sourcePort = (buffer[ipHeaderSize] << 8) | buffer[ipHeaderSize + 1];
+    uint16_t destinationPort = (buffer[ipHeaderSize + 2] << 8) | buffer[ipHeaderSize + 3];
+    if (direction == EpcTft::UPLINK)
+    {
+        localPort = sourcePort;
+        remotePort = destinationPort;
+    }
+    else
+    {
+        remotePort = sourcePort;
+        localPort = destinationPort;
+    }
+}
+
 uint32_t
 EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION(this << p << p->GetSize() << direction);
 
-    Ptr<Packet> pCopy = p->Copy();
+    if (!m_tftMap.empty() && m_tftMap.rbegin()->second->MatchesAll(direction))
+    {
+        // the TFT evaluated first, usually the one of the default bearer when there is no
+        // dedicated bearer, matches any packet: there is no need to parse the headers
+        NS_LOG_LOGIC("matches with TFT ID = " << m_tftMap.rbegin()->first);
+        return m_tftMap.rbegin()->first;
+    }
 
     Ipv4Address localAddressIpv4;
     Ipv4Address remoteAddressIpv4;
@@ -77,7 +119,7 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
     if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
     {
         Ipv4Header ipv4Header;
-        pCopy->RemoveHeader(ipv4Header);
+        p->PeekHeader(ipv4Header);
 
         if (direction == EpcTft::UPLINK)
         {
@@ -104,60 +146,24 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         protocol = ipv4Header.GetProtocol();
         tos = ipv4Header.GetTos();
 
+        std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
+            std::make_tuple(ipv4Header.GetSource().Get(),
+                            ipv4Header.GetDestination().Get(),
+                            protocol,
+                            ipv4Header.GetIdentification());
+
         // Port info only can be get if it is the first fragment and
         // there is enough data in the payload
         // We keep the port info for fragmented packets,
         // i.e. it is the first one but it is not the last one
         if (fragmentOffset == 0)
         {
-            if (protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
-            {
-                UdpHeader udpHeader;
-                pCopy->RemoveHeader(udpHeader);
-                if (direction == EpcTft::UPLINK)
-                {
-                    localPort = udpHeader.GetSourcePort();
-                    remotePort = udpHeader.GetDestinationPort();
-                }
-                else
-                {
-                    remotePort = udpHeader.GetSourcePort();
-                    localPort = udpHeader.GetDestinationPort();
-                }
-                if (!isLastFragment)
-                {
-                    std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                        std::make_tuple(ipv4Header.GetSource().Get(),
-                                        ipv4Header.GetDestination().Get(),
-                                        protocol,
-                                        ipv4Header.GetIdentification());
-
-                    m_classifiedIpv4Fragments[fragmentKey] = std::make_pair(localPort, remotePort);
-                }
-            }
-            else if (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20)
+            if ((protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8) ||
+                (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20))
             {
-                TcpHeader tcpHeader;
-                pCopy->RemoveHeader(tcpHeader);
-                if (direction == EpcTft::UPLINK)
-                {
-                    localPort = tcpHeader.GetSourcePort();
-                    remotePort = tcpHeader.GetDestinationPort();
-                }
-                else
-                {
-                    remotePort = tcpHeader.GetSourcePort();
-                    localPort = tcpHeader.GetDestinationPort();
-                }
-
+                ReadPorts(p, ipv4Header.GetSerializedSize(), direction, localPort, remotePort);
                 if (!isLastFragment)
                 {
-                    std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                        std::make_tuple(ipv4Header.GetSource().Get(),
-                                        ipv4Header.GetDestination().Get(),
-                                        protocol,
-                                        ipv4Header.GetIdentification());
-
                     m_classifiedIpv4Fragments[fragmentKey] = std::make_pair(localPort, remotePort);
                 }
             }
@@ -170,12 +176,6 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         {
             // Not first fragment, so port info is not available but
             // port info should already be known (if there is not fragment reordering)
-            std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                std::make_tuple(ipv4Header.GetSource().Get(),
-                                ipv4Header.GetDestination().Get(),
-                                protocol,
-                                ipv4Header.GetIdentification());
-
             auto it = m_classifiedIpv4Fragments.find(fragmentKey);
 
             if (it != m_classifiedIpv4Fragments.end())
@@ -185,7 +185,7 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
 
                 if (isLastFragment)
                 {
-                    m_classifiedIpv4Fragments.erase(fragmentKey);
+                    m_classifiedIpv4Fragments.erase(it);
                 }
             }
         }
@@ -193,7 +193,7 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
     else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
         Ipv6Header ipv6Header;
-        pCopy->RemoveHeader(ipv6Header);
+        p->PeekHeader(ipv6Header);
 
         if (direction == EpcTft::UPLINK)
         {
@@ -212,36 +212,9 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         protocol = ipv6Header.GetNextHeader();
         tos = ipv6Header.GetTrafficClass();
 
-        if (protocol == UdpL4Protocol::PROT_NUMBER)
+        if (protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
         {
-            UdpHeader udpHeader;
-            pCopy->RemoveHeader(udpHeader);
-
-            if (direction == EpcTft::UPLINK)
-            {
-                localPort = udpHeader.GetSourcePort();
-                remotePort = udpHeader.GetDestinationPort();
-            }
-            else
-            {
-                remotePort = udpHeader.GetSourcePort();
-                localPort = udpHeader.GetDestinationPort();
-            }
-        }
-        else if (protocol == TcpL4Protocol::PROT_NUMBER)
-        {
-            TcpHeader tcpHeader;
-            pCopy->RemoveHeader(tcpHeader);
-            if (direction == EpcTft::UPLINK)
-            {
-                localPort = tcpHeader.GetSourcePort();
-                remotePort = tcpHeader.GetDestinationPort();
-            }
-            else
-            {
-                remotePort = tcpHeader.GetSourcePort();
-                localPort = tcpHeader.GetDestinationPort();
-            }
+            ReadPorts(p, ipv6Header.GetSerializedSize(), direction, localPort, remotePort);
         }
     }
     else
@@ -11,6 +11,8 @@
 #include "ns3/abort.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -214,6 +216,27 @@ EpcTft::PacketFilter::Matches(Direction d,
     return false;
 }
 
+/**
+ * @param prefix an IPv6 prefix
+ * @return true if the prefix matches all the IPv6 addresses
+ */
+static bool
+IsZeroPrefix(const Ipv6Prefix& prefix)
+{
+    uint8_t bytes[16];
+    prefix.GetBytes(bytes);
+    return std::all_of(std::begin(bytes), std::end(bytes), [](uint8_t b) { return b == 0; });
+}
+
+bool
+EpcTft::PacketFilter::MatchesAll(Direction d) const
+{
+    return (d & direction) && remoteMask.Get() == 0 && localMask.Get() == 0 &&
+           IsZeroPrefix(remoteIpv6Prefix) && IsZeroPrefix(localIpv6Prefix) &&
+           remotePortStart == 0 && remotePortEnd == 65535 && localPortStart == 0 &&
+           localPortEnd == 65535 && typeOfServiceMask == 0;
+}
+
 Ptr<EpcTft>
 EpcTft::Default()
 {
@@ -301,4 +324,12 @@ EpcTft::GetPacketFilters() const
     return m_filters;
 }
 
+bool
+EpcTft::MatchesAll(Direction direction) const
+{
+    return std::any_of(m_filters.begin(), m_filters.end(), [direction](const PacketFilter& f) {
+        return f.MatchesAll(direction);
+    });
+}
+
 } // namespace ns3
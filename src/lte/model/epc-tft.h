@@ -98,6 +98,13 @@ class EpcTft : public SimpleRefCount<EpcTft>
                      uint16_t lp,
                      uint8_t tos);
 
+        /**
+         * @param d the direction of the packets
+         * @return true if the filter matches all the packets of that direction, whatever their
+         * addresses, ports and type of service
+         */
+        bool MatchesAll(Direction d) const;
+
         /// Used to specify the precedence for the packet filter among all packet filters in the
         /// TFT; higher values will be evaluated last.
         uint8_t precedence;
@@ -180,6 +187,12 @@ class EpcTft : public SimpleRefCount<EpcTft>
      */
     std::list<PacketFilter> GetPacketFilters() const;
 
+    /**
+     * @param direction the direction of the packets
+     * @return true if any PacketFilter in the TFT matches all the packets of that direction
+     */
+    bool MatchesAll(Direction direction) const;
+
   private:
     std::list<PacketFilter> m_filters; ///< packet filter list
     uint8_t m_numFilters;              ///< number of packet filters applied to this TFT
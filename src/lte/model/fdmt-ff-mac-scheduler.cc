@@ -9,6 +9,7 @@
 
 #include "fdmt-ff-mac-scheduler.h"
 
+#include "ff-mac-dl-ue-table.h"
 #include "lte-amc.h"
 #include "lte-vendor-specific-parameters.h"
 
@@ -316,21 +317,7 @@ FdMtFfMacScheduler::GetRbgSize(int dlbandwidth)
 unsigned int
 FdMtFfMacScheduler::LcActivePerFlow(uint16_t rnti)
 {
-    unsigned int lcActive = 0;
-    for (auto it = m_rlcBufferReq.begin(); it != m_rlcBufferReq.end(); it++)
-    {
-        if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcStatusPduSize > 0)))
-        {
-            lcActive++;
-        }
-        if ((*it).first.m_rnti > rnti)
-        {
-            break;
-        }
-    }
-    return lcActive;
+    return FfMacDlUeTable::CountActiveLcs(m_rlcBufferReq, rnti);
 }
 
 bool
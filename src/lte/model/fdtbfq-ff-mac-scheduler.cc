@@ -381,21 +381,7 @@ FdTbfqFfMacScheduler::GetRbgSize(int dlbandwidth)
 unsigned int
 FdTbfqFfMacScheduler::LcActivePerFlow(uint16_t rnti)
 {
-    unsigned int lcActive = 0;
-    for (auto it = m_rlcBufferReq.begin(); it != m_rlcBufferReq.end(); it++)
-    {
-        if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcStatusPduSize > 0)))
-        {
-            lcActive++;
-        }
-        if ((*it).first.m_rnti > rnti)
-        {
-            break;
-        }
-    }
-    return lcActive;
+    return FfMacDlUeTable::CountActiveLcs(m_rlcBufferReq, rnti);
 }
 
 bool
@@ -975,66 +961,75 @@ FdTbfqFfMacScheduler::DoSchedDlTriggerReq(
     std::set<uint16_t> allocatedRnti; // store UEs which are already assigned RBGs
     std::set<uint8_t> allocatedRbg;   // store RBGs which are already allocated to UE
 
-    int totalRbg = 0;
-    while (totalRbg < rbgNum)
+    // the UEs which can be scheduled in this TTI
+    std::vector<std::map<uint16_t, fdtbfqsFlowPerf_t>::iterator> candidates;
+    for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
     {
-        // select UE with largest metric
-        std::map<uint16_t, fdtbfqsFlowPerf_t>::iterator it;
-        auto itMax = m_flowStatsDl.end();
-        double metricMax = 0.0;
-        bool firstRnti = true;
-        for (it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+        auto itRnti = rntiAllocated.find((*it).first);
+        if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it).first)))
         {
-            auto itRnti = rntiAllocated.find((*it).first);
-            if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it).first)))
+            // UE already allocated for HARQ or without HARQ process available -> drop it
+            if (itRnti != rntiAllocated.end())
             {
-                // UE already allocated for HARQ or without HARQ process available -> drop it
-                if (itRnti != rntiAllocated.end())
-                {
-                    NS_LOG_DEBUG(this << " RNTI discarded for HARQ tx" << (uint16_t)(*it).first);
-                }
-                if (!HarqProcessAvailability((*it).first))
-                {
-                    NS_LOG_DEBUG(this << " RNTI discarded for HARQ id" << (uint16_t)(*it).first);
-                }
-                continue;
+                NS_LOG_DEBUG(this << " RNTI discarded for HARQ tx" << (uint16_t)(*it).first);
             }
-            // check first the channel conditions for this UE, if CQI!=0
-            auto itCqi = m_a30CqiRxed.find((*it).first);
-            auto itTxMode = m_uesTxMode.find((*it).first);
-            if (itTxMode == m_uesTxMode.end())
+            if (!HarqProcessAvailability((*it).first))
             {
-                NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+                NS_LOG_DEBUG(this << " RNTI discarded for HARQ id" << (uint16_t)(*it).first);
             }
-            auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+            continue;
+        }
+        // check first the channel conditions for this UE, if CQI!=0
+        auto itCqi = m_a30CqiRxed.find((*it).first);
+        auto itTxMode = m_uesTxMode.find((*it).first);
+        if (itTxMode == m_uesTxMode.end())
+        {
+            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+        }
+        auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
 
-            uint8_t cqiSum = 0;
-            for (int k = 0; k < rbgNum; k++)
+        uint8_t cqiSum = 0;
+        for (int k = 0; k < rbgNum; k++)
+        {
+            for (uint8_t j = 0; j < nLayer; j++)
             {
-                for (uint8_t j = 0; j < nLayer; j++)
+                if (itCqi == m_a30CqiRxed.end())
                 {
-                    if (itCqi == m_a30CqiRxed.end())
-                    {
-                        cqiSum += 1; // no info on this user -> lowest MCS
-                    }
-                    else
-                    {
-                        cqiSum += (*itCqi).second.m_higherLayerSelected.at(k).m_sbCqi.at(j);
-                    }
+                    cqiSum += 1; // no info on this user -> lowest MCS
+                }
+                else
+                {
+                    cqiSum += (*itCqi).second.m_higherLayerSelected.at(k).m_sbCqi.at(j);
                 }
             }
+        }
 
-            if (cqiSum == 0)
-            {
-                NS_LOG_INFO("Skip this flow, CQI==0, rnti:" << (*it).first);
-                continue;
-            }
+        if (cqiSum == 0)
+        {
+            NS_LOG_INFO("Skip this flow, CQI==0, rnti:" << (*it).first);
+            continue;
+        }
 
-            if (LcActivePerFlow((*it).first) == 0)
-            {
-                continue;
-            }
+        if (LcActivePerFlow((*it).first) == 0)
+        {
+            continue;
+        }
+
+        candidates.push_back(it);
+    }
+
+    // the achievable rates of the UEs selected on each RBG
+    m_dlUeTable.Start(m_amc, rbgSize, rbgNum);
 
+    int totalRbg = 0;
+    while (totalRbg < rbgNum)
+    {
+        // select UE with largest metric
+        auto itMax = m_flowStatsDl.end();
+        double metricMax = 0.0;
+        bool firstRnti = true;
+        for (auto it : candidates)
+        {
             auto rnti = allocatedRnti.find((*it).first);
             if (rnti != allocatedRnti.end()) //  already allocated RBGs to this UE
             {
@@ -1095,13 +1090,11 @@ FdTbfqFfMacScheduler::DoSchedDlTriggerReq(
             // calculate rlc buffer size
             uint32_t rlcBufSize = 0;
             uint8_t lcid = 0;
-            for (auto itRlcBuf = m_rlcBufferReq.begin(); itRlcBuf != m_rlcBufferReq.end();
+            for (auto itRlcBuf = m_rlcBufferReq.lower_bound(LteFlowId_t((*itMax).first, 0));
+                 itRlcBuf != m_rlcBufferReq.end() && (*itRlcBuf).first.m_rnti == (*itMax).first;
                  itRlcBuf++)
             {
-                if ((*itRlcBuf).first.m_rnti == (*itMax).first)
-                {
-                    lcid = (*itRlcBuf).first.m_lcId;
-                }
+                lcid = (*itRlcBuf).first.m_lcId;
             }
             LteFlowId_t flow((*itMax).first, lcid);
             auto itRlcBuf = m_rlcBufferReq.find(flow);
@@ -1120,6 +1113,16 @@ FdTbfqFfMacScheduler::DoSchedDlTriggerReq(
         }
 
         // assign RBGs to this UE
+        auto itCqi = m_a30CqiRxed.find((*itMax).first);
+        auto itTxMode = m_uesTxMode.find((*itMax).first);
+        if (itTxMode == m_uesTxMode.end())
+        {
+            NS_FATAL_ERROR("No Transmission Mode info on user " << (*itMax).first);
+        }
+        auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+        std::size_t ue = m_dlUeTable.Add((*itMax).first,
+                                         nLayer,
+                                         itCqi == m_a30CqiRxed.end() ? nullptr : &(*itCqi).second);
         uint32_t bytesTxed = 0;
         uint32_t bytesTxedTmp = 0;
         int rbgIndex = 0;
@@ -1127,14 +1130,6 @@ FdTbfqFfMacScheduler::DoSchedDlTriggerReq(
         {
             totalRbg++;
 
-            auto itCqi = m_a30CqiRxed.find((*itMax).first);
-            auto itTxMode = m_uesTxMode.find((*itMax).first);
-            if (itTxMode == m_uesTxMode.end())
-            {
-                NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-            }
-            auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-
             // find RBG with largest achievableRate
             double achievableRateMax = 0.0;
             rbgIndex = rbgNum;
@@ -1156,53 +1151,14 @@ FdTbfqFfMacScheduler::DoSchedDlTriggerReq(
                     continue;
                 }
 
-                std::vector<uint8_t> sbCqi;
-                if (itCqi == m_a30CqiRxed.end())
-                {
-                    sbCqi = std::vector<uint8_t>(nLayer, 1); // start with lowest value
-                }
-                else
+                // negative if CQI == 0, which means "out of range" (see table 7.2.3-1 of 36.213)
+                double achievableRate = m_dlUeTable.GetRate(ue, k);
+                if (achievableRate > achievableRateMax)
                 {
-                    sbCqi = (*itCqi).second.m_higherLayerSelected.at(k).m_sbCqi;
+                    achievableRateMax = achievableRate;
+                    rbgIndex = k;
                 }
-                uint8_t cqi1 = sbCqi.at(0);
-                uint8_t cqi2 = 0;
-                if (sbCqi.size() > 1)
-                {
-                    cqi2 = sbCqi.at(1);
-                }
-
-                if ((cqi1 > 0) ||
-                    (cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                {
-                    if (LcActivePerFlow((*itMax).first) > 0)
-                    {
-                        // this UE has data to transmit
-                        double achievableRate = 0.0;
-                        for (uint8_t j = 0; j < nLayer; j++)
-                        {
-                            uint8_t mcs = 0;
-                            if (sbCqi.size() > j)
-                            {
-                                mcs = m_amc->GetMcsFromCqi(sbCqi.at(j));
-                            }
-                            else
-                            {
-                                // no info on this subband -> worst MCS
-                                mcs = 0;
-                            }
-                            achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                               0.001); // = TB size / TTI
-                        }
-
-                        if (achievableRate > achievableRateMax)
-                        {
-                            achievableRateMax = achievableRate;
-                            rbgIndex = k;
-                        }
-                    } // end of LcActivePerFlow
-                }     // end of cqi
-            }         // end of for rbgNum
+            } // end of for rbgNum
 
             if (rbgIndex == rbgNum) // impossible
             {
@@ -11,6 +11,7 @@
 #define FDTBFQ_FF_MAC_SCHEDULER_H
 
 #include "ff-mac-csched-sap.h"
+#include "ff-mac-dl-ue-table.h"
 #include "ff-mac-sched-sap.h"
 #include "ff-mac-scheduler.h"
 #include "lte-amc.h"
@@ -296,6 +297,8 @@ class FdTbfqFfMacScheduler : public FfMacScheduler
 
     Ptr<LteAmc> m_amc; ///< amc
 
+    FfMacDlUeTable m_dlUeTable; ///< the UEs selected in the current TTI
+
     /**
      * Vectors of UE's LC info
      */
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ff-mac-dl-ue-table.h"
+
+#include "lte-amc.h"
+
+#include <ns3/log.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FfMacDlUeTable");
+
+/// The highest CQI
+static const uint8_t MAX_CQI = 15;
+
+FfMacDlUeTable::FfMacDlUeTable()
+    : m_noCqiRate(0),
+      m_rbgNum(0)
+{
+}
+
+void
+FfMacDlUeTable::Start(Ptr<LteAmc> amc, int rbgSize, int rbgNum)
+{
+    NS_LOG_FUNCTION(this << rbgSize << rbgNum);
+    m_ues.clear();
+    m_rates.clear();
+    m_rbgNum = rbgNum;
+    // = TB size / TTI, as computed by the schedulers
+    m_cqiRate.resize(MAX_CQI + 1);
+    for (int cqi = 0; cqi <= MAX_CQI; cqi++)
+    {
+        m_cqiRate[cqi] = (amc->GetDlTbSizeFromMcs(amc->GetMcsFromCqi(cqi), rbgSize) / 8) / 0.001;
+    }
+    m_noCqiRate = (amc->GetDlTbSizeFromMcs(0, rbgSize) / 8) / 0.001;
+}
+
+std::size_t
+FfMacDlUeTable::Add(uint16_t rnti, uint8_t nLayer, const SbMeasResult_s* sbMeas)
+{
+    NS_LOG_FUNCTION(this << rnti << (uint16_t)nLayer);
+    if (m_noReportCqi.size() <= nLayer)
+    {
+        m_noReportCqi.resize(nLayer + 1);
+    }
+    if (m_noReportCqi[nLayer].empty())
+    {
+        m_noReportCqi[nLayer] = std::vector<uint8_t>(nLayer, 1); // start with lowest value
+    }
+
+    std::size_t i = m_ues.size();
+    m_ues.push_back({rnti, nLayer, sbMeas});
+    m_rates.resize(m_rates.size() + m_rbgNum, -1.0);
+    for (int rbg = 0; rbg < m_rbgNum; rbg++)
+    {
+        if (sbMeas && static_cast<std::size_t>(rbg) >= sbMeas->m_higherLayerSelected.size())
+        {
+            continue;
+        }
+        const std::vector<uint8_t>& sbCqi = GetSbCqi(i, rbg);
+        uint8_t cqi1 = sbCqi.empty() ? 0 : sbCqi[0];
+        uint8_t cqi2 = sbCqi.size() > 1 ? sbCqi[1] : 0;
+        if (cqi1 == 0 && cqi2 == 0)
+        {
+            // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+            continue;
+        }
+        double achievableRate = 0.0;
+        for (uint8_t k = 0; k < nLayer; k++)
+        {
+            if (sbCqi.size() > k)
+            {
+                NS_ASSERT_MSG(sbCqi[k] <= MAX_CQI, "CQI must be in [0..15] = " << +sbCqi[k]);
+                achievableRate += m_cqiRate[sbCqi[k]];
+            }
+            else
+            {
+                // no info on this subband -> worst MCS
+                achievableRate += m_noCqiRate;
+            }
+        }
+        m_rates[i * m_rbgNum + rbg] = achievableRate;
+    }
+    return i;
+}
+
+const std::vector<uint8_t>&
+FfMacDlUeTable::GetSbCqi(std::size_t i, int rbg) const
+{
+    const Ue& ue = m_ues[i];
+    if (!ue.sbMeas)
+    {
+        return m_noReportCqi[ue.nLayer];
+    }
+    return ue.sbMeas->m_higherLayerSelected.at(rbg).m_sbCqi;
+}
+
+unsigned int
+FfMacDlUeTable::CountActiveLcs(
+    const std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>&
+        rlcBufferReq,
+    uint16_t rnti)
+{
+    unsigned int lcActive = 0;
+    for (auto it = rlcBufferReq.lower_bound(LteFlowId_t(rnti, 0));
+         it != rlcBufferReq.end() && (*it).first.m_rnti == rnti;
+         it++)
+    {
+        if (((*it).second.m_rlcTransmissionQueueSize > 0) ||
+            ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
+            ((*it).second.m_rlcStatusPduSize > 0))
+        {
+            lcActive++;
+        }
+    }
+    return lcActive;
+}
+
+} // namespace ns3
@@ -0,0 +1,153 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FF_MAC_DL_UE_TABLE_H
+#define FF_MAC_DL_UE_TABLE_H
+
+#include "ff-mac-common.h"
+#include "ff-mac-sched-sap.h"
+#include "lte-common.h"
+
+#include <ns3/ptr.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+class LteAmc;
+
+/**
+ * @ingroup ff-api
+ *
+ * The downlink state of the schedulable UEs of a TTI, shared by the FF MAC
+ * schedulers which look for the best UE of each RBG.
+ *
+ * The UEs are stored densely, in the order they are added, with their
+ * achievable rate on each RBG. The rates are computed once per TTI from the
+ * subband CQIs, through a table of the rate of each CQI, instead of once per
+ * RBG and per UE through the AMC module. The rates are bit-for-bit equal to
+ * the ones computed by the schedulers, so that the scheduling decisions are
+ * unchanged.
+ */
+class FfMacDlUeTable
+{
+  public:
+    /// A UE of the table
+    struct Ue
+    {
+        uint16_t rnti;                ///< the RNTI of the UE
+        uint8_t nLayer;               ///< the number of layers of the transmission mode of the UE
+        const SbMeasResult_s* sbMeas; ///< the subband CQIs of the UE, nullptr if not received
+    };
+
+    FfMacDlUeTable();
+
+    /**
+     * Remove all the UEs, and compute the rates of the CQIs for a new TTI.
+     *
+     * @param amc the AMC module of the scheduler
+     * @param rbgSize the number of RBs of an RBG
+     * @param rbgNum the number of RBGs
+     */
+    void Start(Ptr<LteAmc> amc, int rbgSize, int rbgNum);
+
+    /**
+     * Add a UE, and compute its achievable rate on each RBG.
+     *
+     * @param rnti the RNTI of the UE
+     * @param nLayer the number of layers of the transmission mode of the UE
+     * @param sbMeas the subband CQIs of the UE, nullptr if not received
+     * @return the index of the UE in the table
+     */
+    std::size_t Add(uint16_t rnti, uint8_t nLayer, const SbMeasResult_s* sbMeas);
+
+    /**
+     * @return the number of UEs
+     */
+    std::size_t GetN() const
+    {
+        return m_ues.size();
+    }
+
+    /**
+     * @param i the index of the UE
+     * @return the UE
+     */
+    const Ue& Get(std::size_t i) const
+    {
+        return m_ues[i];
+    }
+
+    /**
+     * Get the achievable rate of a UE on an RBG, i.e., the sum over the
+     * layers of the size of the TB of one RBG per TTI, in bytes/s. A layer
+     * without subband CQI uses MCS 0.
+     *
+     * @param i the index of the UE
+     * @param rbg the RBG
+     * @return the rate, or a negative value if the CQI of the RBG is out of
+     * range or has not been reported
+     */
+    double GetRate(std::size_t i, int rbg) const
+    {
+        return m_rates[i * m_rbgNum + rbg];
+    }
+
+    /**
+     * Get the subband CQIs of a UE on an RBG. A UE without subband CQI
+     * reports has CQI 1 on all its layers.
+     *
+     * @param i the index of the UE
+     * @param rbg the RBG
+     * @return the CQIs of the layers
+     */
+    const std::vector<uint8_t>& GetSbCqi(std::size_t i, int rbg) const;
+
+    /**
+     * Count the logical channels of a UE having data to transmit.
+     *
+     * The buffer requests are ordered by RNTI, so that only the logical
+     * channels of the UE are visited.
+     *
+     * @param rlcBufferReq the RLC buffer requests of the scheduler
+     * @param rnti the RNTI of the UE
+     * @return the number of active logical channels
+     */
+    static unsigned int CountActiveLcs(
+        const std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>&
+            rlcBufferReq,
+        uint16_t rnti);
+
+    /**
+     * Sort the first elements of a vector in descending order. The first k
+     * elements are the same, and in the same order, as after sorting the
+     * whole vector in descending order, provided that the elements are all
+     * different.
+     *
+     * @param v the vector
+     * @param k the number of elements to sort
+     */
+    template <typename T>
+    static void SortTopK(std::vector<T>& v, std::size_t k)
+    {
+        k = std::min(k, v.size());
+        std::partial_sort(v.begin(), v.begin() + k, v.end(), std::greater<T>());
+    }
+
+  private:
+    std::vector<Ue> m_ues;                           ///< the UEs
+    std::vector<double> m_rates;                     ///< the rate of each UE on each RBG
+    std::vector<double> m_cqiRate;                   ///< the rate of one layer for each CQI
+    double m_noCqiRate;                              ///< the rate of a layer without CQI
+    int m_rbgNum;                                    ///< the number of RBGs
+    std::vector<std::vector<uint8_t>> m_noReportCqi; ///< the CQIs of a UE without reports
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_DL_UE_TABLE_H */
@@ -589,12 +589,17 @@ LteAmc::CreateCqiFeedbacks(const SpectrumValue& sinr, uint8_t rbgSize)
             {
                 uint8_t mcs = 0;
                 TbStats_t tbStats;
+                HarqProcessInfoList_t harqInfoList;
+                // the MI of the RBG depends only on the modulation of the MCS
+                double mi = 0;
                 while (mcs <= 28)
                 {
-                    HarqProcessInfoList_t harqInfoList;
+                    if (mcs == 0 || mcs == MI_QPSK_MAX_ID + 1 || mcs == MI_16QAM_MAX_ID + 1)
+                    {
+                        mi = LteMiErrorModel::Mib(sinr, rbgMap, mcs);
+                    }
                     tbStats = LteMiErrorModel::GetTbDecodificationStats(
-                        sinr,
-                        rbgMap,
+                        mi,
                         (uint16_t)GetDlTbSizeFromMcs(mcs, rbgSize) / 8,
                         mcs,
                         harqInfoList);
@@ -13,6 +13,7 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -58,12 +59,30 @@ class Asn1Header : public Header
     mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
     mutable bool m_isDataSerialized;               //!< true if data is serialized
     mutable Buffer m_serializationResult;          //!< serialization result
+    /// octets serialized but not yet copied to m_serializationResult
+    mutable std::vector<uint8_t> m_serializationOctets;
 
     /**
      * Function to write in m_serializationResult, after resizing its size
      * @param octet bits to write
      */
     void WriteOctet(uint8_t octet) const;
+    /**
+     * Copy the serialized octets to m_serializationResult in a single write
+     */
+    void FlushOctets() const;
+    /**
+     * Serialize the least significant bits of a value, the most significant first
+     * @param value value to serialize
+     * @param numBits number of bits to serialize, at most 32
+     */
+    void SerializeBits(uint32_t value, int numBits) const;
+    /**
+     * Get the number of bits of a constrained whole number (clause 11.5.6 ITU-T X.691)
+     * @param range the number of values of the constrained whole number
+     * @returns the number of bits
+     */
+    static int GetRequiredBits(int range);
 
     // Serialization functions
 
@@ -259,6 +278,14 @@ class Asn1Header : public Header
      */
     template <int N>
     Buffer::Iterator DeserializeBitset(std::bitset<N>* data, Buffer::Iterator bIterator);
+    /**
+     * Deserialize bits, the most significant first
+     * @param value buffer to store the result
+     * @param numBits number of bits to deserialize, at most 32
+     * @param bIterator buffer iterator
+     * @returns the modified buffer iterator
+     */
+    Buffer::Iterator DeserializeBits(uint32_t* value, int numBits, Buffer::Iterator bIterator);
     /**
      * Deserialize a bitset
      * @param data buffer to store the result
@@ -39,19 +39,33 @@ void
 LteChunkProcessor::Start()
 {
     NS_LOG_FUNCTION(this);
-    m_sumValues = nullptr;
     m_totDuration = MicroSeconds(0);
+    m_empty = true;
 }
 
 void
 LteChunkProcessor::EvaluateChunk(const SpectrumValue& sinr, Time duration)
 {
     NS_LOG_FUNCTION(this << sinr << duration);
-    if (!m_sumValues)
+    if (m_empty)
     {
-        m_sumValues = Create<SpectrumValue>(sinr.GetSpectrumModel());
+        if (!m_sumValues || m_sumValues->GetSpectrumModel() != sinr.GetSpectrumModel())
+        {
+            m_sumValues = Create<SpectrumValue>(sinr.GetSpectrumModel());
+        }
+        else
+        {
+            (*m_sumValues) = 0.0;
+        }
+        m_empty = false;
+    }
+    NS_ASSERT(m_sumValues->GetSpectrumModel() == sinr.GetSpectrumModel());
+    double seconds = duration.GetSeconds();
+    auto sum = m_sumValues->ValuesBegin();
+    for (auto it = sinr.ConstValuesBegin(); it != sinr.ConstValuesEnd(); ++it, ++sum)
+    {
+        *sum += *it * seconds;
     }
-    (*m_sumValues) += sinr * duration.GetSeconds();
     m_totDuration += duration;
 }
 
@@ -61,11 +75,18 @@ LteChunkProcessor::End()
     NS_LOG_FUNCTION(this);
     if (m_totDuration.GetSeconds() > 0)
     {
+        if (!m_meanValues)
+        {
+            m_meanValues = Create<SpectrumValue>(m_sumValues->GetSpectrumModel());
+        }
+        // the assignment reuses the storage of the previous mean values
+        (*m_meanValues) = (*m_sumValues);
+        (*m_meanValues) /= m_totDuration.GetSeconds();
         for (auto it = m_lteChunkProcessorCallbacks.begin();
              it != m_lteChunkProcessorCallbacks.end();
              it++)
         {
-            (*it)((*m_sumValues) / m_totDuration.GetSeconds());
+            (*it)(*m_meanValues);
         }
     }
     else
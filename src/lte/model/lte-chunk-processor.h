@@ -30,6 +30,9 @@ typedef Callback<void, const SpectrumValue&> LteChunkProcessorCallback;
  * This abstract class is used to process the time-vs-frequency
  * SINR/interference/power chunk of a received LTE signal
  * which was calculated by the LteInterference object.
+ *
+ * The chunks are accumulated in place, in buffers which are kept from one
+ * RX to the next, so that no SpectrumValue is allocated per chunk.
  */
 class LteChunkProcessor : public SimpleRefCount<LteChunkProcessor>
 {
@@ -71,13 +74,16 @@ class LteChunkProcessor : public SimpleRefCount<LteChunkProcessor>
      *
      * During this function all callbacks from list are executed
      * to inform interested object about calculated value. This
-     * function is called at the end of calculation.
+     * function is called at the end of calculation. The value passed to
+     * the callbacks is only valid during the call.
      */
     virtual void End();
 
   private:
-    Ptr<SpectrumValue> m_sumValues; ///< sum values
-    Time m_totDuration;             ///< total duration
+    Ptr<SpectrumValue> m_sumValues;  ///< sum values
+    Ptr<SpectrumValue> m_meanValues; ///< mean values, passed to the callbacks
+    Time m_totDuration;              ///< total duration
+    bool m_empty{true};              ///< whether no chunk was collected since Start()
 
     std::vector<LteChunkProcessorCallback>
         m_lteChunkProcessorCallbacks; ///< chunk processor callback
@@ -41,6 +41,8 @@ LteInterference::DoDispose()
     m_rxSignal = nullptr;
     m_allSignals = nullptr;
     m_noise = nullptr;
+    m_interf = nullptr;
+    m_sinr = nullptr;
     Object::DoDispose();
 }
 
@@ -58,7 +60,15 @@ LteInterference::StartRx(Ptr<const SpectrumValue> rxPsd)
     if (!m_receiving)
     {
         NS_LOG_LOGIC("first signal");
-        m_rxSignal = rxPsd->Copy();
+        if (m_rxSignal)
+        {
+            // reuse the storage of the previous RX
+            (*m_rxSignal) = (*rxPsd);
+        }
+        else
+        {
+            m_rxSignal = rxPsd->Copy();
+        }
         m_lastChangeTime = Now();
         m_receiving = true;
         for (auto it = m_rsPowerChunkProcessorList.begin(); it != m_rsPowerChunkProcessorList.end();
@@ -172,18 +182,35 @@ LteInterference::ConditionallyEvaluateChunk()
         NS_LOG_LOGIC(this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals
                           << " noise = " << *m_noise);
 
-        SpectrumValue interf = (*m_allSignals) - (*m_rxSignal) + (*m_noise);
+        Ptr<const SpectrumModel> sm = m_rxSignal->GetSpectrumModel();
+        if (!m_interf || m_interf->GetSpectrumModel() != sm)
+        {
+            m_interf = Create<SpectrumValue>(sm);
+            m_sinr = Create<SpectrumValue>(sm);
+        }
+        NS_ASSERT(m_allSignals->GetSpectrumModel() == sm && m_noise->GetSpectrumModel() == sm);
+
+        // compute the interference and the SINR in a single pass
+        auto signal = m_rxSignal->ConstValuesBegin();
+        auto allSignals = m_allSignals->ConstValuesBegin();
+        auto noise = m_noise->ConstValuesBegin();
+        auto sinr = m_sinr->ValuesBegin();
+        for (auto interf = m_interf->ValuesBegin(); interf != m_interf->ValuesEnd();
+             ++interf, ++signal, ++allSignals, ++noise, ++sinr)
+        {
+            *interf = *allSignals - *signal + *noise;
+            *sinr = *signal / *interf;
+        }
 
-        SpectrumValue sinr = (*m_rxSignal) / interf;
         Time duration = Now() - m_lastChangeTime;
         for (auto it = m_sinrChunkProcessorList.begin(); it != m_sinrChunkProcessorList.end(); ++it)
         {
-            (*it)->EvaluateChunk(sinr, duration);
+            (*it)->EvaluateChunk(*m_sinr, duration);
         }
         for (auto it = m_interfChunkProcessorList.begin(); it != m_interfChunkProcessorList.end();
              ++it)
         {
-            (*it)->EvaluateChunk(interf, duration);
+            (*it)->EvaluateChunk(*m_interf, duration);
         }
         for (auto it = m_rsPowerChunkProcessorList.begin(); it != m_rsPowerChunkProcessorList.end();
              ++it)
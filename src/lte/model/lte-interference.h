@@ -131,6 +131,9 @@ class LteInterference : public Object
 
     Ptr<const SpectrumValue> m_noise{nullptr}; ///< the noise value
 
+    Ptr<SpectrumValue> m_interf{nullptr}; ///< the interference plus noise of the last chunk
+    Ptr<SpectrumValue> m_sinr{nullptr};   ///< the SINR of the last chunk
+
     Time m_lastChangeTime{Seconds(0)}; /**< the time of the last change in
                                         * m_TotalPower
                                         */
@@ -22,6 +22,8 @@
 #include <ns3/log.h>
 #include <ns3/pointer.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <list>
 #include <stdint.h>
@@ -892,90 +894,124 @@ static const double cEcrTable [9][38] = {
 
 // clang-format on
 
-double
-LteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/// The mutual information (MI) map of a modulation, for uniformly spaced SINR values
+struct MiMap
 {
-    NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
+    const double* mi;    ///< the MI of each SINR value
+    const double* axis;  ///< the SINR values, in linear units
+    uint16_t size;       ///< the number of SINR values
+    double scalingCoeff; ///< the number of SINR values per linear unit
+};
 
-    double MI;
-    double MIsum = 0.0;
+/**
+ * Build the MI map of a modulation
+ * @param mi the MI of each SINR value
+ * @param axis the SINR values, in linear units
+ * @param size the number of SINR values
+ * @return the MI map
+ */
+static MiMap
+MakeMiMap(const double* mi, const double* axis, uint16_t size)
+{
+    // since the values of the axis are uniformly spaced, we have
+    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+    // the scaling coefficient is always the same, so it is computed once
+    // to speed up the calculation
+    return {mi, axis, size, (size - 1) / (axis[size - 1] - axis[0])};
+}
 
-    for (uint32_t i = 0; i < map.size(); i++)
+/// MI map of QPSK
+static const MiMap g_miMapQpsk = MakeMiMap(MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE);
+/// MI map of 16QAM
+static const MiMap g_miMap16qam = MakeMiMap(MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE);
+/// MI map of 64QAM
+static const MiMap g_miMap64qam = MakeMiMap(MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE);
+
+/**
+ * Get the MI of a SINR value
+ * @param miMap the MI map of the modulation
+ * @param sinrLin the SINR, in linear units
+ * @return the MI
+ */
+static inline double
+GetMi(const MiMap& miMap, double sinrLin)
+{
+    if (sinrLin > miMap.axis[miMap.size - 1])
     {
-        double sinrLin = sinr[map.at(i)];
-        if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
-            if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
-            {
-                MI = 1;
-            }
-            else
-            {
-                // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-                // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                // the scaling coefficient is always the same, so we use a static const
-                // to speed up the calculation
-                static const double scalingCoeffQpsk =
-                    (MI_MAP_QPSK_SIZE - 1) /
-                    (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-                double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-                uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-                MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-        else
+        return 1;
+    }
+    double sinrIndexDouble = (sinrLin - miMap.axis[0]) * miMap.scalingCoeff + 1;
+    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
+    NS_ASSERT_MSG(sinrIndex < miMap.size, "MI map out of data");
+    return miMap.mi[sinrIndex];
+}
+
+/// The parameters of the BLER curve of an ECR for a CB size
+struct BlerCurve
+{
+    double b; ///< the mean of the curve
+    double c; ///< the standard deviation of the curve
+};
+
+/**
+ * Get the parameters of the BLER curves, for each CB size of cbMiSizeTable
+ * and for each ECR of BlerCurvesEcrMap. For the ECRs not available for a CB
+ * size, the parameters are those of the lowest CB size including the CB, for
+ * removing CB size quantization errors.
+ * @return the BLER curves, indexed by CB size index and ECR ID
+ */
+static const std::array<std::array<BlerCurve, 38>, 9>&
+GetBlerCurves()
+{
+    static const auto curves = []() {
+        std::array<std::array<BlerCurve, 38>, 9> curves;
+        for (int cbIndex = 0; cbIndex < 9; cbIndex++)
         {
-            if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID) // 16-QAM
+            for (int ecrId = 0; ecrId < 38; ecrId++)
             {
-                if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1])
+                double b = bEcrTable[cbIndex][ecrId];
+                int i = cbIndex;
+                while ((i < 9) && (b < 0))
                 {
-                    MI = 1;
+                    b = bEcrTable[i++][ecrId];
                 }
-                else
+                double c = cEcrTable[cbIndex][ecrId];
+                i = cbIndex;
+                while ((i < 9) && (c < 0))
                 {
-                    // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff16qam =
-                        (MI_MAP_16QAM_SIZE - 1) /
-                        (MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                    MI = MI_map_16qam[sinrIndex];
-                }
-            }
-            else // 64-QAM
-            {
-                if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff64qam =
-                        (MI_MAP_64QAM_SIZE - 1) /
-                        (MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                    MI = MI_map_64qam[sinrIndex];
+                    c = cEcrTable[i++][ecrId];
                 }
+                curves[cbIndex][ecrId] = {b, c};
             }
         }
-        NS_LOG_LOGIC(" RB " << map.at(i) << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
+        return curves;
+    }();
+    return curves;
+}
+
+double
+LteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+    NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
+
+    const MiMap& miMap = (mcs <= MI_QPSK_MAX_ID)    ? g_miMapQpsk
+                         : (mcs <= MI_16QAM_MAX_ID) ? g_miMap16qam
+                                                    : g_miMap64qam;
+    auto sinrBegin = sinr.ConstValuesBegin();
+    NS_ASSERT(std::all_of(map.begin(), map.end(), [&sinr](int rb) {
+        return rb >= 0 && static_cast<std::size_t>(rb) < sinr.GetValuesN();
+    }));
+
+    double MIsum = 0.0;
+    for (const auto rb : map)
+    {
+        double sinrLin = sinrBegin[rb];
+        double MI = GetMi(miMap, sinrLin);
+        NS_LOG_LOGIC(" RB " << rb << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
                             << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
         MIsum += MI;
     }
-    MI = MIsum / map.size();
+    double MI = MIsum / map.size();
     NS_LOG_LOGIC(" MI = " << MI);
     return MI;
 }
@@ -984,44 +1020,18 @@ double
 LteMiErrorModel::MappingMiBler(double mib, uint8_t ecrId, uint16_t cbSize)
 {
     NS_LOG_FUNCTION(mib << (uint32_t)ecrId << (uint32_t)cbSize);
-    double b = 0;
-    double c = 0;
 
     NS_ASSERT_MSG(ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t)ecrId);
-    int cbIndex = 1;
-    while ((cbIndex < 9) && (cbMiSizeTable[cbIndex] <= cbSize))
-    {
-        cbIndex++;
-    }
+    // the largest CB size of the curves not greater than cbSize (the first one if none)
+    int cbIndex = std::upper_bound(cbMiSizeTable + 1, cbMiSizeTable + 9, cbSize) - cbMiSizeTable;
     cbIndex--;
     NS_LOG_LOGIC(" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size "
                            << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-    b = bEcrTable[cbIndex][ecrId];
-    if (b < 0.0)
-    {
-        // take the lowest CB size including this CB for removing CB size
-        // quatization errors
-        int i = cbIndex;
-        while ((i < 9) && (b < 0))
-        {
-            b = bEcrTable[i++][ecrId];
-        }
-    }
-    c = cEcrTable[cbIndex][ecrId];
-    if (c < 0.0)
-    {
-        // take the lowest CB size including this CB for removing CB size
-        // quatization errors
-        int i = cbIndex;
-        while ((i < 9) && (c < 0))
-        {
-            c = cEcrTable[i++][ecrId];
-        }
-    }
+    const BlerCurve& curve = GetBlerCurves()[cbIndex][ecrId];
     // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-    double bler = 0.5 * (1 - erf((mib - b) / (sqrt(2) * c)));
-    NS_LOG_LOGIC("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
+    double bler = 0.5 * (1 - erf((mib - curve.b) / (sqrt(2) * curve.c)));
+    NS_LOG_LOGIC("MIB: " << mib << " BLER:" << bler << " b:" << curve.b << " c:" << curve.c);
     return bler;
 }
 
@@ -1036,37 +1046,14 @@ LteMiErrorModel::GetPcfichPdcchError(const SpectrumValue& sinr)
     NS_ASSERT(sinrIt != sinr.ConstValuesEnd());
     while (sinrIt != sinr.ConstValuesEnd())
     {
-        double sinrLin = *sinrIt;
-        if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
-        {
-            MI = 1;
-        }
-        else
-        {
-            // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-            // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-            // the scaling coefficient is always the same, so we use a static const
-            // to speed up the calculation
-            static const double scalingCoeffQpsk =
-                (MI_MAP_QPSK_SIZE - 1) /
-                (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-            double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-            uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-            NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-            MI = MI_map_qpsk[sinrIndex];
-        }
-        MIsum += MI;
+        MIsum += GetMi(g_miMapQpsk, *sinrIt);
         sinrIt++;
         rb++;
     }
     MI = MIsum / rb;
-    // return to the effective SINR value
-    int j = 0;
+    // return to the effective SINR value (the MI map is sorted)
+    int j = std::lower_bound(MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
     double esinr = 0.0;
-    while ((j < MI_MAP_QPSK_SIZE) && (MI_map_qpsk[j] < MI))
-    {
-        j++;
-    }
     if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE - 1])
     {
         esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1];
@@ -1095,12 +1082,11 @@ LteMiErrorModel::GetPcfichPdcchError(const SpectrumValue& sinr)
     double esirnDb = 10 * log10(esinr);
     //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk
     //   [MI_MAP_QPSK_SIZE-1]));
-    uint16_t i = 0;
+    uint16_t i = std::lower_bound(PdcchPcfichBlerCurveXaxis,
+                                  PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE,
+                                  esirnDb) -
+                 PdcchPcfichBlerCurveXaxis;
     double errorRate = 0.0;
-    while ((i < PDCCH_PCFICH_CURVE_SIZE) && (PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-        i++;
-    }
     if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE - 1])
     {
         errorRate = 0.0;
@@ -1119,11 +1105,21 @@ LteMiErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
                                           const std::vector<int>& map,
                                           uint16_t size,
                                           uint8_t mcs,
-                                          HarqProcessInfoList_t miHistory)
+                                          const HarqProcessInfoList_t& miHistory)
 {
     NS_LOG_FUNCTION(sinr << &map << (uint32_t)size << (uint32_t)mcs);
 
-    double tbMi = Mib(sinr, map, mcs);
+    return GetTbDecodificationStats(Mib(sinr, map, mcs), size, mcs, miHistory);
+}
+
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats(double tbMi,
+                                          uint16_t size,
+                                          uint8_t mcs,
+                                          const HarqProcessInfoList_t& miHistory)
+{
+    NS_LOG_FUNCTION(tbMi << (uint32_t)size << (uint32_t)mcs);
+
     double MI = 0.0;
     double Reff = 0.0;
     NS_ASSERT(mcs < 29);
@@ -97,7 +97,25 @@ class LteMiErrorModel
                                               const std::vector<int>& map,
                                               uint16_t size,
                                               uint8_t mcs,
-                                              HarqProcessInfoList_t miHistory);
+                                              const HarqProcessInfoList_t& miHistory);
+
+    /**
+     * @brief run the error-model algorithm for the specified TB, whose mmib
+     * has already been computed with Mib()
+     *
+     * The mmib depends only on the modulation of the MCS, hence it can be
+     * computed once when the TB is evaluated with several MCSs.
+     *
+     * @param tbMi the mmib of the TB
+     * @param size the size in bytes of the TB
+     * @param mcs the MCS of the TB
+     * @param miHistory MI of past transmissions (in case of retx)
+     * @return the TB error rate and MI
+     */
+    static TbStats_t GetTbDecodificationStats(double tbMi,
+                                              uint16_t size,
+                                              uint8_t mcs,
+                                              const HarqProcessInfoList_t& miHistory);
 
     /**
      * @brief run the error-model algorithm for the specified PCFICH+PDCCH channels
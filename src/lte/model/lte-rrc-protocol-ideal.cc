@@ -20,6 +20,8 @@
 #include <ns3/nstime.h>
 #include <ns3/simulator.h>
 
+#include <memory>
+
 namespace ns3
 {
 
@@ -33,6 +35,61 @@ NS_LOG_COMPONENT_DEFINE("LteRrcProtocolIdeal");
 /// RRC ideal message delay
 static const Time RRC_IDEAL_MSG_DELAY;
 
+/**
+ * Deliver an RRC message to an eNB after the ideal delay. The message is moved
+ * once to a shared immutable copy, so that the event only holds a reference
+ * to it.
+ *
+ * @param sap the RRC SAP provider of the eNB
+ * @param recv the method of the SAP receiving the message
+ * @param rnti the RNTI of the UE
+ * @param msg the message
+ */
+template <class T>
+static void
+ScheduleEnbRecv(LteEnbRrcSapProvider* sap,
+                void (LteEnbRrcSapProvider::*recv)(uint16_t, T),
+                uint16_t rnti,
+                T msg)
+{
+    auto shared = std::make_shared<const T>(std::move(msg));
+    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
+                        [sap, recv, rnti, shared]() { (sap->*recv)(rnti, *shared); });
+}
+
+/**
+ * Deliver an RRC message to a UE after the ideal delay. The message is shared
+ * by the events delivering it.
+ *
+ * @param sap the RRC SAP provider of the UE
+ * @param recv the method of the SAP receiving the message
+ * @param msg the shared immutable message
+ */
+template <class T>
+static void
+ScheduleUeRecv(LteUeRrcSapProvider* sap,
+               void (LteUeRrcSapProvider::*recv)(T),
+               std::shared_ptr<const T> msg)
+{
+    Simulator::Schedule(RRC_IDEAL_MSG_DELAY, [sap, recv, msg]() { (sap->*recv)(*msg); });
+}
+
+/**
+ * Deliver an RRC message to a UE after the ideal delay. The message is moved
+ * once to a shared immutable copy, so that the event only holds a reference
+ * to it.
+ *
+ * @param sap the RRC SAP provider of the UE
+ * @param recv the method of the SAP receiving the message
+ * @param msg the message
+ */
+template <class T>
+static void
+ScheduleUeRecv(LteUeRrcSapProvider* sap, void (LteUeRrcSapProvider::*recv)(T), T msg)
+{
+    ScheduleUeRecv(sap, recv, std::make_shared<const T>(std::move(msg)));
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LteUeRrcProtocolIdeal);
 
 LteUeRrcProtocolIdeal::LteUeRrcProtocolIdeal()
@@ -97,21 +154,19 @@ LteUeRrcProtocolIdeal::DoSendRrcConnectionRequest(LteRrcSap::RrcConnectionReques
     m_rnti = m_rrc->GetRnti();
     SetEnbRrcSapProvider();
 
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvRrcConnectionRequest,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        msg);
+    ScheduleEnbRecv(m_enbRrcSapProvider,
+                    &LteEnbRrcSapProvider::RecvRrcConnectionRequest,
+                    m_rnti,
+                    std::move(msg));
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendRrcConnectionSetupCompleted(LteRrcSap::RrcConnectionSetupCompleted msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvRrcConnectionSetupCompleted,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        msg);
+    ScheduleEnbRecv(m_enbRrcSapProvider,
+                    &LteEnbRrcSapProvider::RecvRrcConnectionSetupCompleted,
+                    m_rnti,
+                    std::move(msg));
 }
 
 void
@@ -123,43 +178,39 @@ LteUeRrcProtocolIdeal::DoSendRrcConnectionReconfigurationCompleted(
     m_rnti = m_rrc->GetRnti();
     SetEnbRrcSapProvider();
 
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        msg);
+    ScheduleEnbRecv(m_enbRrcSapProvider,
+                    &LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted,
+                    m_rnti,
+                    std::move(msg));
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendRrcConnectionReestablishmentRequest(
     LteRrcSap::RrcConnectionReestablishmentRequest msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentRequest,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        msg);
+    ScheduleEnbRecv(m_enbRrcSapProvider,
+                    &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentRequest,
+                    m_rnti,
+                    std::move(msg));
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendRrcConnectionReestablishmentComplete(
     LteRrcSap::RrcConnectionReestablishmentComplete msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentComplete,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        msg);
+    ScheduleEnbRecv(m_enbRrcSapProvider,
+                    &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentComplete,
+                    m_rnti,
+                    std::move(msg));
 }
 
 void
 LteUeRrcProtocolIdeal::DoSendMeasurementReport(LteRrcSap::MeasurementReport msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteEnbRrcSapProvider::RecvMeasurementReport,
-                        m_enbRrcSapProvider,
-                        m_rnti,
-                        msg);
+    ScheduleEnbRecv(m_enbRrcSapProvider,
+                    &LteEnbRrcSapProvider::RecvMeasurementReport,
+                    m_rnti,
+                    std::move(msg));
 }
 
 void
@@ -344,6 +395,8 @@ void
 LteEnbRrcProtocolIdeal::DoSendSystemInformation(uint16_t cellId, LteRrcSap::SystemInformation msg)
 {
     NS_LOG_FUNCTION(this << cellId);
+    // the message is shared by all the UEs of the cell
+    auto shared = std::make_shared<const LteRrcSap::SystemInformation>(std::move(msg));
     // walk list of all nodes to get UEs with this cellId
     Ptr<LteUeRrc> ueRrc;
     for (auto i = NodeList::Begin(); i != NodeList::End(); ++i)
@@ -362,10 +415,9 @@ LteEnbRrcProtocolIdeal::DoSendSystemInformation(uint16_t cellId, LteRrcSap::Syst
                 {
                     NS_LOG_LOGIC("sending SI to IMSI " << ueDev->GetImsi());
 
-                    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                                        &LteUeRrcSapProvider::RecvSystemInformation,
-                                        ueRrc->GetLteUeRrcSapProvider(),
-                                        msg);
+                    ScheduleUeRecv(ueRrc->GetLteUeRrcSapProvider(),
+                                   &LteUeRrcSapProvider::RecvSystemInformation,
+                                   shared);
                 }
             }
         }
@@ -375,10 +427,9 @@ LteEnbRrcProtocolIdeal::DoSendSystemInformation(uint16_t cellId, LteRrcSap::Syst
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionSetup(uint16_t rnti, LteRrcSap::RrcConnectionSetup msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteUeRrcSapProvider::RecvRrcConnectionSetup,
-                        GetUeRrcSapProvider(rnti),
-                        msg);
+    ScheduleUeRecv(GetUeRrcSapProvider(rnti),
+                   &LteUeRrcSapProvider::RecvRrcConnectionSetup,
+                   std::move(msg));
 }
 
 void
@@ -386,10 +437,9 @@ LteEnbRrcProtocolIdeal::DoSendRrcConnectionReconfiguration(
     uint16_t rnti,
     LteRrcSap::RrcConnectionReconfiguration msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteUeRrcSapProvider::RecvRrcConnectionReconfiguration,
-                        GetUeRrcSapProvider(rnti),
-                        msg);
+    ScheduleUeRecv(GetUeRrcSapProvider(rnti),
+                   &LteUeRrcSapProvider::RecvRrcConnectionReconfiguration,
+                   std::move(msg));
 }
 
 void
@@ -397,10 +447,9 @@ LteEnbRrcProtocolIdeal::DoSendRrcConnectionReestablishment(
     uint16_t rnti,
     LteRrcSap::RrcConnectionReestablishment msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteUeRrcSapProvider::RecvRrcConnectionReestablishment,
-                        GetUeRrcSapProvider(rnti),
-                        msg);
+    ScheduleUeRecv(GetUeRrcSapProvider(rnti),
+                   &LteUeRrcSapProvider::RecvRrcConnectionReestablishment,
+                   std::move(msg));
 }
 
 void
@@ -408,29 +457,26 @@ LteEnbRrcProtocolIdeal::DoSendRrcConnectionReestablishmentReject(
     uint16_t rnti,
     LteRrcSap::RrcConnectionReestablishmentReject msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteUeRrcSapProvider::RecvRrcConnectionReestablishmentReject,
-                        GetUeRrcSapProvider(rnti),
-                        msg);
+    ScheduleUeRecv(GetUeRrcSapProvider(rnti),
+                   &LteUeRrcSapProvider::RecvRrcConnectionReestablishmentReject,
+                   std::move(msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionRelease(uint16_t rnti,
                                                    LteRrcSap::RrcConnectionRelease msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteUeRrcSapProvider::RecvRrcConnectionRelease,
-                        GetUeRrcSapProvider(rnti),
-                        msg);
+    ScheduleUeRecv(GetUeRrcSapProvider(rnti),
+                   &LteUeRrcSapProvider::RecvRrcConnectionRelease,
+                   std::move(msg));
 }
 
 void
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReject(uint16_t rnti, LteRrcSap::RrcConnectionReject msg)
 {
-    Simulator::Schedule(RRC_IDEAL_MSG_DELAY,
-                        &LteUeRrcSapProvider::RecvRrcConnectionReject,
-                        GetUeRrcSapProvider(rnti),
-                        msg);
+    ScheduleUeRecv(GetUeRrcSapProvider(rnti),
+                   &LteUeRrcSapProvider::RecvRrcConnectionReject,
+                   std::move(msg));
 }
 
 /*
@@ -547,8 +593,7 @@ LteEnbRrcProtocolIdeal::DoEncodeHandoverPreparationInformation(
                       g_handoverPreparationInfoMsgMap.end(),
                   "msgId " << msgId << " already in use");
     NS_LOG_INFO(" encoding msgId = " << msgId);
-    g_handoverPreparationInfoMsgMap.insert(
-        std::pair<uint32_t, LteRrcSap::HandoverPreparationInfo>(msgId, msg));
+    g_handoverPreparationInfoMsgMap.emplace(msgId, std::move(msg));
     IdealHandoverPreparationInfoHeader h;
     h.SetMsgId(msgId);
     Ptr<Packet> p = Create<Packet>();
@@ -565,7 +610,7 @@ LteEnbRrcProtocolIdeal::DoDecodeHandoverPreparationInformation(Ptr<Packet> p)
     NS_LOG_INFO(" decoding msgId = " << msgId);
     auto it = g_handoverPreparationInfoMsgMap.find(msgId);
     NS_ASSERT_MSG(it != g_handoverPreparationInfoMsgMap.end(), "msgId " << msgId << " not found");
-    LteRrcSap::HandoverPreparationInfo msg = it->second;
+    LteRrcSap::HandoverPreparationInfo msg = std::move(it->second);
     g_handoverPreparationInfoMsgMap.erase(it);
     return msg;
 }
@@ -669,8 +714,7 @@ LteEnbRrcProtocolIdeal::DoEncodeHandoverCommand(LteRrcSap::RrcConnectionReconfig
     NS_ASSERT_MSG(g_handoverCommandMsgMap.find(msgId) == g_handoverCommandMsgMap.end(),
                   "msgId " << msgId << " already in use");
     NS_LOG_INFO(" encoding msgId = " << msgId);
-    g_handoverCommandMsgMap.insert(
-        std::pair<uint32_t, LteRrcSap::RrcConnectionReconfiguration>(msgId, msg));
+    g_handoverCommandMsgMap.emplace(msgId, std::move(msg));
     IdealHandoverCommandHeader h;
     h.SetMsgId(msgId);
     Ptr<Packet> p = Create<Packet>();
@@ -687,7 +731,7 @@ LteEnbRrcProtocolIdeal::DoDecodeHandoverCommand(Ptr<Packet> p)
     NS_LOG_INFO(" decoding msgId = " << msgId);
     auto it = g_handoverCommandMsgMap.find(msgId);
     NS_ASSERT_MSG(it != g_handoverCommandMsgMap.end(), "msgId " << msgId << " not found");
-    LteRrcSap::RrcConnectionReconfiguration msg = it->second;
+    LteRrcSap::RrcConnectionReconfiguration msg = std::move(it->second);
     g_handoverCommandMsgMap.erase(it);
     return msg;
 }
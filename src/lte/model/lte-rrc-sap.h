@@ -15,6 +15,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <utility>
 
 namespace ns3
 {
@@ -1375,14 +1376,14 @@ template <class C>
 void
 MemberLteUeRrcSapUser<C>::SendRrcConnectionRequest(RrcConnectionRequest msg)
 {
-    m_owner->DoSendRrcConnectionRequest(msg);
+    m_owner->DoSendRrcConnectionRequest(std::move(msg));
 }
 
 template <class C>
 void
 MemberLteUeRrcSapUser<C>::SendRrcConnectionSetupCompleted(RrcConnectionSetupCompleted msg)
 {
-    m_owner->DoSendRrcConnectionSetupCompleted(msg);
+    m_owner->DoSendRrcConnectionSetupCompleted(std::move(msg));
 }
 
 template <class C>
@@ -1390,7 +1391,7 @@ void
 MemberLteUeRrcSapUser<C>::SendRrcConnectionReconfigurationCompleted(
     RrcConnectionReconfigurationCompleted msg)
 {
-    m_owner->DoSendRrcConnectionReconfigurationCompleted(msg);
+    m_owner->DoSendRrcConnectionReconfigurationCompleted(std::move(msg));
 }
 
 template <class C>
@@ -1398,7 +1399,7 @@ void
 MemberLteUeRrcSapUser<C>::SendRrcConnectionReestablishmentRequest(
     RrcConnectionReestablishmentRequest msg)
 {
-    m_owner->DoSendRrcConnectionReestablishmentRequest(msg);
+    m_owner->DoSendRrcConnectionReestablishmentRequest(std::move(msg));
 }
 
 template <class C>
@@ -1406,14 +1407,14 @@ void
 MemberLteUeRrcSapUser<C>::SendRrcConnectionReestablishmentComplete(
     RrcConnectionReestablishmentComplete msg)
 {
-    m_owner->DoSendRrcConnectionReestablishmentComplete(msg);
+    m_owner->DoSendRrcConnectionReestablishmentComplete(std::move(msg));
 }
 
 template <class C>
 void
 MemberLteUeRrcSapUser<C>::SendMeasurementReport(MeasurementReport msg)
 {
-    m_owner->DoSendMeasurementReport(msg);
+    m_owner->DoSendMeasurementReport(std::move(msg));
 }
 
 template <class C>
@@ -1472,28 +1473,28 @@ template <class C>
 void
 MemberLteUeRrcSapProvider<C>::RecvSystemInformation(SystemInformation msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvSystemInformation, m_owner, msg);
+    Simulator::ScheduleNow(&C::DoRecvSystemInformation, m_owner, std::move(msg));
 }
 
 template <class C>
 void
 MemberLteUeRrcSapProvider<C>::RecvRrcConnectionSetup(RrcConnectionSetup msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionSetup, m_owner, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionSetup, m_owner, std::move(msg));
 }
 
 template <class C>
 void
 MemberLteUeRrcSapProvider<C>::RecvRrcConnectionReconfiguration(RrcConnectionReconfiguration msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReconfiguration, m_owner, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReconfiguration, m_owner, std::move(msg));
 }
 
 template <class C>
 void
 MemberLteUeRrcSapProvider<C>::RecvRrcConnectionReestablishment(RrcConnectionReestablishment msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReestablishment, m_owner, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReestablishment, m_owner, std::move(msg));
 }
 
 template <class C>
@@ -1501,21 +1502,21 @@ void
 MemberLteUeRrcSapProvider<C>::RecvRrcConnectionReestablishmentReject(
     RrcConnectionReestablishmentReject msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReestablishmentReject, m_owner, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReestablishmentReject, m_owner, std::move(msg));
 }
 
 template <class C>
 void
 MemberLteUeRrcSapProvider<C>::RecvRrcConnectionRelease(RrcConnectionRelease msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionRelease, m_owner, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionRelease, m_owner, std::move(msg));
 }
 
 template <class C>
 void
 MemberLteUeRrcSapProvider<C>::RecvRrcConnectionReject(RrcConnectionReject msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReject, m_owner, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReject, m_owner, std::move(msg));
 }
 
 /**
@@ -1581,14 +1582,14 @@ template <class C>
 void
 MemberLteEnbRrcSapUser<C>::SendSystemInformation(uint16_t cellId, SystemInformation msg)
 {
-    m_owner->DoSendSystemInformation(cellId, msg);
+    m_owner->DoSendSystemInformation(cellId, std::move(msg));
 }
 
 template <class C>
 void
 MemberLteEnbRrcSapUser<C>::SendRrcConnectionSetup(uint16_t rnti, RrcConnectionSetup msg)
 {
-    m_owner->DoSendRrcConnectionSetup(rnti, msg);
+    m_owner->DoSendRrcConnectionSetup(rnti, std::move(msg));
 }
 
 template <class C>
@@ -1596,7 +1597,7 @@ void
 MemberLteEnbRrcSapUser<C>::SendRrcConnectionReconfiguration(uint16_t rnti,
                                                             RrcConnectionReconfiguration msg)
 {
-    m_owner->DoSendRrcConnectionReconfiguration(rnti, msg);
+    m_owner->DoSendRrcConnectionReconfiguration(rnti, std::move(msg));
 }
 
 template <class C>
@@ -1604,7 +1605,7 @@ void
 MemberLteEnbRrcSapUser<C>::SendRrcConnectionReestablishment(uint16_t rnti,
                                                             RrcConnectionReestablishment msg)
 {
-    m_owner->DoSendRrcConnectionReestablishment(rnti, msg);
+    m_owner->DoSendRrcConnectionReestablishment(rnti, std::move(msg));
 }
 
 template <class C>
@@ -1613,28 +1614,28 @@ MemberLteEnbRrcSapUser<C>::SendRrcConnectionReestablishmentReject(
     uint16_t rnti,
     RrcConnectionReestablishmentReject msg)
 {
-    m_owner->DoSendRrcConnectionReestablishmentReject(rnti, msg);
+    m_owner->DoSendRrcConnectionReestablishmentReject(rnti, std::move(msg));
 }
 
 template <class C>
 void
 MemberLteEnbRrcSapUser<C>::SendRrcConnectionRelease(uint16_t rnti, RrcConnectionRelease msg)
 {
-    m_owner->DoSendRrcConnectionRelease(rnti, msg);
+    m_owner->DoSendRrcConnectionRelease(rnti, std::move(msg));
 }
 
 template <class C>
 void
 MemberLteEnbRrcSapUser<C>::SendRrcConnectionReject(uint16_t rnti, RrcConnectionReject msg)
 {
-    m_owner->DoSendRrcConnectionReject(rnti, msg);
+    m_owner->DoSendRrcConnectionReject(rnti, std::move(msg));
 }
 
 template <class C>
 Ptr<Packet>
 MemberLteEnbRrcSapUser<C>::EncodeHandoverPreparationInformation(HandoverPreparationInfo msg)
 {
-    return m_owner->DoEncodeHandoverPreparationInformation(msg);
+    return m_owner->DoEncodeHandoverPreparationInformation(std::move(msg));
 }
 
 template <class C>
@@ -1648,7 +1649,7 @@ template <class C>
 Ptr<Packet>
 MemberLteEnbRrcSapUser<C>::EncodeHandoverCommand(RrcConnectionReconfiguration msg)
 {
-    return m_owner->DoEncodeHandoverCommand(msg);
+    return m_owner->DoEncodeHandoverCommand(std::move(msg));
 }
 
 template <class C>
@@ -1712,7 +1713,7 @@ template <class C>
 void
 MemberLteEnbRrcSapProvider<C>::RecvRrcConnectionRequest(uint16_t rnti, RrcConnectionRequest msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionRequest, m_owner, rnti, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionRequest, m_owner, rnti, std::move(msg));
 }
 
 template <class C>
@@ -1720,7 +1721,7 @@ void
 MemberLteEnbRrcSapProvider<C>::RecvRrcConnectionSetupCompleted(uint16_t rnti,
                                                                RrcConnectionSetupCompleted msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionSetupCompleted, m_owner, rnti, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionSetupCompleted, m_owner, rnti, std::move(msg));
 }
 
 template <class C>
@@ -1729,7 +1730,10 @@ MemberLteEnbRrcSapProvider<C>::RecvRrcConnectionReconfigurationCompleted(
     uint16_t rnti,
     RrcConnectionReconfigurationCompleted msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReconfigurationCompleted, m_owner, rnti, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReconfigurationCompleted,
+                           m_owner,
+                           rnti,
+                           std::move(msg));
 }
 
 template <class C>
@@ -1738,7 +1742,10 @@ MemberLteEnbRrcSapProvider<C>::RecvRrcConnectionReestablishmentRequest(
     uint16_t rnti,
     RrcConnectionReestablishmentRequest msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReestablishmentRequest, m_owner, rnti, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReestablishmentRequest,
+                           m_owner,
+                           rnti,
+                           std::move(msg));
 }
 
 template <class C>
@@ -1747,14 +1754,17 @@ MemberLteEnbRrcSapProvider<C>::RecvRrcConnectionReestablishmentComplete(
     uint16_t rnti,
     RrcConnectionReestablishmentComplete msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReestablishmentComplete, m_owner, rnti, msg);
+    Simulator::ScheduleNow(&C::DoRecvRrcConnectionReestablishmentComplete,
+                           m_owner,
+                           rnti,
+                           std::move(msg));
 }
 
 template <class C>
 void
 MemberLteEnbRrcSapProvider<C>::RecvMeasurementReport(uint16_t rnti, MeasurementReport msg)
 {
-    Simulator::ScheduleNow(&C::DoRecvMeasurementReport, m_owner, rnti, msg);
+    Simulator::ScheduleNow(&C::DoRecvMeasurementReport, m_owner, rnti, std::move(msg));
 }
 
 template <class C>
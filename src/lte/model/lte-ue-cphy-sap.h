@@ -191,6 +191,14 @@ class LteUeCphySapProvider
      * @param imsi the IMSI of the UE
      */
     virtual void SetImsi(uint64_t imsi) = 0;
+
+    /**
+     * @brief A method call by UE RRC to tell the UE PHY whether the UE is
+     * camped on a cell in RRC IDLE (IDLE_CAMPED_NORMALLY state), with no
+     * connection being set up, hence no random access procedure pending
+     * @param camped true if the UE is camped on a cell in RRC IDLE
+     */
+    virtual void SetIdleCamped(bool camped) = 0;
 };
 
 /**
@@ -319,6 +327,7 @@ class MemberLteUeCphySapProvider : public LteUeCphySapProvider
     void ResetRlfParams() override;
     void StartInSyncDetection() override;
     void SetImsi(uint64_t imsi) override;
+    void SetIdleCamped(bool camped) override;
 
   private:
     C* m_owner; ///< the owner class
@@ -456,6 +465,13 @@ MemberLteUeCphySapProvider<C>::SetImsi(uint64_t imsi)
     m_owner->DoSetImsi(imsi);
 }
 
+template <class C>
+void
+MemberLteUeCphySapProvider<C>::SetIdleCamped(bool camped)
+{
+    m_owner->DoSetIdleCamped(camped);
+}
+
 /**
  * Template for the implementation of the LteUeCphySapUser as a member
  * of an owner class of type C to which all methods are forwarded
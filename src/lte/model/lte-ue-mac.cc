@@ -176,6 +176,7 @@ class UeMemberLteUePhySapUser : public LteUePhySapUser
     void ReceivePhyPdu(Ptr<Packet> p) override;
     void SubframeIndication(uint32_t frameNo, uint32_t subframeNo) override;
     void ReceiveLteControlMessage(Ptr<LteControlMessage> msg) override;
+    bool IsIdle() override;
 
   private:
     LteUeMac* m_mac; ///< the UE MAC
@@ -204,6 +205,12 @@ UeMemberLteUePhySapUser::ReceiveLteControlMessage(Ptr<LteControlMessage> msg)
     m_mac->DoReceiveLteControlMessage(msg);
 }
 
+bool
+UeMemberLteUePhySapUser::IsIdle()
+{
+    return m_mac->DoIsIdle();
+}
+
 //////////////////////////////////////////////////////////
 // LteUeMac methods
 ///////////////////////////////////////////////////////////
@@ -233,6 +240,8 @@ LteUeMac::LteUeMac()
       m_rnti(0),
       m_imsi(0),
       m_rachConfigured(false),
+      m_frameNo(0),
+      m_subframeNo(0),
       m_waitingForRaResponse(false)
 
 {
@@ -896,6 +905,13 @@ void
 LteUeMac::DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo)
 {
     NS_LOG_FUNCTION(this);
+    if (m_frameNo > 0)
+    {
+        // account for the subframes not indicated by the PHY while the MAC was idle;
+        // all the HARQ timers are expired, so only the HARQ process ID changes
+        uint64_t skipped = (uint64_t)(frameNo - m_frameNo) * 10 + subframeNo - m_subframeNo - 1;
+        m_harqProcessId = (m_harqProcessId + skipped) % HARQ_PERIOD;
+    }
     m_frameNo = frameNo;
     m_subframeNo = subframeNo;
     RefreshHarqProcessesPacketBuffer();
@@ -912,6 +928,23 @@ LteUeMac::DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo)
     m_harqProcessId = (m_harqProcessId + 1) % HARQ_PERIOD;
 }
 
+bool
+LteUeMac::DoIsIdle() const
+{
+    if (m_freshUlBsr || m_waitingForRaResponse)
+    {
+        return false;
+    }
+    for (const auto timer : m_miUlHarqProcessesPacketTimer)
+    {
+        if (timer > 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 int64_t
 LteUeMac::AssignStreams(int64_t stream)
 {
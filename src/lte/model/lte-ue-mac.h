@@ -106,6 +106,14 @@ class LteUeMac : public Object
      */
     void DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo);
 
+    /**
+     * @brief Forwarded from LteUePhySapUser: check whether the MAC has
+     * nothing to do in the next subframes
+     *
+     * @return true if the MAC is idle
+     */
+    bool DoIsIdle() const;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -91,6 +91,18 @@ class LteUePhySapUser
      * @param msg the Ideal Control Message to receive
      */
     virtual void ReceiveLteControlMessage(Ptr<LteControlMessage> msg) = 0;
+
+    /**
+     * @brief Check whether the MAC has nothing to do in the next subframes
+     *
+     * The PHY may then stop the subframe indications until it is asked to
+     * transmit something; the subframes that were not indicated are inferred
+     * from the frame and subframe numbers of the next indication.
+     *
+     * @return true if there is no buffer status to report and no packet in
+     * the UL HARQ buffers
+     */
+    virtual bool IsIdle() = 0;
 };
 
 } // namespace ns3
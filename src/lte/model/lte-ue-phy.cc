@@ -132,7 +132,11 @@ LteUePhy::LteUePhy(Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
       m_ueMeasurementsFilterPeriod(MilliSeconds(200)),
       m_ueMeasurementsFilterLast(),
       m_rsrpSinrSampleCounter(0),
-      m_imsi(0)
+      m_imsi(0),
+      m_idleCamped(false),
+      m_subframeIndicationsStopped(false),
+      m_nextFrameNo(0),
+      m_nextSubframeNo(0)
 {
     m_amc = CreateObject<LteAmc>();
     m_powerControl = CreateObject<LteUePowerControl>();
@@ -279,6 +283,11 @@ LteUePhy::GetTypeId()
                             "Trace fired upon every UE PHY state transition",
                             MakeTraceSourceAccessor(&LteUePhy::m_stateTransitionTrace),
                             "ns3::LteUePhy::StateTracedCallback")
+            .AddTraceSource("SkippedSubframes",
+                            "Trace fired when the subframe indications resume, with the number "
+                            "of subframes not indicated while the UE was idle",
+                            MakeTraceSourceAccessor(&LteUePhy::m_skippedSubframesTrace),
+                            "ns3::LteUePhy::SkippedSubframesTracedCallback")
             .AddAttribute("EnableUplinkPowerControl",
                           "If true, Uplink Power Control will be enabled.",
                           BooleanValue(true),
@@ -316,6 +325,16 @@ LteUePhy::GetTypeId()
                           "If true, RLF detection will be enabled.",
                           BooleanValue(true),
                           MakeBooleanAccessor(&LteUePhy::m_enableRlfDetection),
+                          MakeBooleanChecker())
+            .AddAttribute("IdleSubframeSkipping",
+                          "If true, the subframe indications are stopped while the UE is "
+                          "camped on a cell in RRC IDLE, with no connection being set up, "
+                          "and the MAC has nothing to do, and they are resumed when the UE "
+                          "leaves this state (e.g., to start a random access procedure) or "
+                          "the MAC sends something. The downlink receptions and the UE "
+                          "measurements are not affected.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&LteUePhy::m_idleSubframeSkipping),
                           MakeBooleanChecker());
     return tid;
 }
@@ -459,6 +478,7 @@ LteUePhy::DoSendMacPdu(Ptr<Packet> p)
 {
     NS_LOG_FUNCTION(this);
 
+    ResumeSubframeIndications();
     SetMacPdu(p);
 }
 
@@ -533,6 +553,14 @@ LteUePhy::GenerateCtrlCqiReport(const SpectrumValue& sinr)
     }
     m_ctrlSinrForRlf = sinr;
     GenerateCqiRsrpRsrq(sinr);
+    if (m_subframeIndicationsStopped)
+    {
+        // these are refreshed at the start of every subframe, which is not
+        // indicated while the UE is idle, hence once they have been used
+        m_rsReceivedPowerUpdated = false;
+        m_rsInterferencePowerUpdated = false;
+        m_pssReceived = false;
+    }
 }
 
 void
@@ -957,6 +985,7 @@ LteUePhy::DoSendLteControlMessage(Ptr<LteControlMessage> msg)
 {
     NS_LOG_FUNCTION(this << msg);
 
+    ResumeSubframeIndications();
     SetControlMessages(msg);
 }
 
@@ -965,6 +994,7 @@ LteUePhy::DoSendRachPreamble(uint32_t raPreambleId, uint32_t raRnti)
 {
     NS_LOG_FUNCTION(this << raPreambleId);
 
+    ResumeSubframeIndications();
     // unlike other control messages, RACH preamble is sent ASAP
     Ptr<RachPreambleLteControlMessage> msg = Create<RachPreambleLteControlMessage>();
     msg->SetRapId(raPreambleId);
@@ -1292,6 +1322,17 @@ LteUePhy::SubframeIndication(uint32_t frameNo, uint32_t subframeNo)
         subframeNo = 1;
     }
 
+    if (m_idleSubframeSkipping && m_idleCamped && m_uePhySapUser->IsIdle())
+    {
+        // nothing to transmit until the UE leaves the camped state or the MAC sends something
+        NS_LOG_LOGIC(this << " UE idle, stopping the subframe indications");
+        m_subframeIndicationsStopped = true;
+        m_nextSubframeTime = Simulator::Now() + Seconds(GetTti());
+        m_nextFrameNo = frameNo;
+        m_nextSubframeNo = subframeNo;
+        return;
+    }
+
     // schedule next subframe indication
     Simulator::Schedule(Seconds(GetTti()),
                         &LteUePhy::SubframeIndication,
@@ -1300,6 +1341,42 @@ LteUePhy::SubframeIndication(uint32_t frameNo, uint32_t subframeNo)
                         subframeNo);
 }
 
+void
+LteUePhy::ResumeSubframeIndications()
+{
+    if (!m_subframeIndicationsStopped)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    m_subframeIndicationsStopped = false;
+
+    uint64_t subframe = (uint64_t)(m_nextFrameNo - 1) * 10 + (m_nextSubframeNo - 1);
+    Time nextSubframeTime = m_nextSubframeTime;
+    int64_t skipped = 0;
+    if (Simulator::Now() >= m_nextSubframeTime)
+    {
+        // There was nothing to transmit in the subframes not indicated, so
+        // only the MAC has to be told about the subframe in progress, e.g.,
+        // to compute the RA-RNTI of a preamble sent right now.
+        int64_t tti = Seconds(GetTti()).GetTimeStep();
+        skipped = (Simulator::Now() - m_nextSubframeTime).GetTimeStep() / tti;
+        subframe += skipped;
+        NS_LOG_LOGIC(this << " resuming the subframe indications after " << skipped
+                          << " idle subframes");
+        m_subframeNo = subframe % 10 + 1;
+        m_uePhySapUser->SubframeIndication(subframe / 10 + 1, subframe % 10 + 1);
+        subframe++;
+        nextSubframeTime += TimeStep((skipped + 1) * tti);
+    }
+    m_skippedSubframesTrace(m_cellId, m_imsi, skipped);
+    Simulator::Schedule(nextSubframeTime - Simulator::Now(),
+                        &LteUePhy::SubframeIndication,
+                        this,
+                        static_cast<uint32_t>(subframe / 10 + 1),
+                        static_cast<uint32_t>(subframe % 10 + 1));
+}
+
 void
 LteUePhy::SendSrs()
 {
@@ -1551,6 +1628,19 @@ LteUePhy::DoSetImsi(uint64_t imsi)
     m_imsi = imsi;
 }
 
+void
+LteUePhy::DoSetIdleCamped(bool camped)
+{
+    NS_LOG_FUNCTION(this << camped);
+    m_idleCamped = camped;
+    if (!camped)
+    {
+        // before the RRC starts a random access procedure, whose RA-RNTI is
+        // computed by the MAC from the subframe in progress
+        ResumeSubframeIndications();
+    }
+}
+
 void
 LteUePhy::InitializeRlfParams()
 {
@@ -252,6 +252,15 @@ class LteUePhy : public LtePhy
      */
     void SubframeIndication(uint32_t frameNo, uint32_t subframeNo);
 
+    /**
+     * @brief Resume the subframe indications stopped while the UE was idle
+     *
+     * The MAC is told about the subframe in progress and the next indication
+     * is scheduled at the subframe boundary where it would have happened if
+     * the indications had never been stopped.
+     */
+    void ResumeSubframeIndications();
+
     /**
      * @brief Send the SRS signal in the last symbols of the frame
      */
@@ -291,6 +300,17 @@ class LteUePhy : public LtePhy
                                         State oldState,
                                         State newState);
 
+    /**
+     * TracedCallback signature for the subframes skipped while the UE is idle.
+     *
+     * @param [in] cellId
+     * @param [in] imsi
+     * @param [in] subframes
+     */
+    typedef void (*SkippedSubframesTracedCallback)(uint16_t cellId,
+                                                   uint64_t imsi,
+                                                   uint64_t subframes);
+
     /**
      * TracedCallback signature for cell RSRP and SINR report.
      *
@@ -606,6 +626,12 @@ class LteUePhy : public LtePhy
      * @param imsi the IMSI of the UE
      */
     void DoSetImsi(uint64_t imsi);
+    /**
+     * @brief Set whether the UE is camped on a cell in RRC IDLE
+     *
+     * @param camped true if the UE is camped on a cell in RRC IDLE
+     */
+    void DoSetIdleCamped(bool camped);
     /**
      * @brief Do set RSRP filter coefficient
      *
@@ -703,6 +729,13 @@ class LteUePhy : public LtePhy
      */
     TracedCallback<uint16_t, uint16_t, State, State> m_stateTransitionTrace;
 
+    /**
+     * The `SkippedSubframes` trace source. Fired when the subframe indications
+     * resume. Exporting the serving cell ID, IMSI, and the number of subframes
+     * which were not indicated.
+     */
+    TracedCallback<uint16_t, uint64_t, uint64_t> m_skippedSubframesTrace;
+
     /// @todo Can be removed.
     uint8_t m_subframeNo;
 
@@ -842,6 +875,17 @@ class LteUePhy : public LtePhy
     uint64_t m_imsi;                ///< the IMSI of the UE
     bool m_enableRlfDetection;      ///< Flag to enable/disable RLF detection
 
+    /**
+     * The `IdleSubframeSkipping` attribute. If true, the subframe indications
+     * are stopped while the UE is camped on a cell in RRC IDLE and the MAC is idle.
+     */
+    bool m_idleSubframeSkipping;
+    bool m_idleCamped;                 ///< true if the UE is camped on a cell in RRC IDLE
+    bool m_subframeIndicationsStopped; ///< true if the subframe indications are stopped
+    Time m_nextSubframeTime;           ///< the time of the first subframe not indicated
+    uint32_t m_nextFrameNo;            ///< the frame number of the first subframe not indicated
+    uint32_t m_nextSubframeNo; ///< the subframe number of the first subframe not indicated
+
 }; // end of `class LteUePhy`
 
 /**
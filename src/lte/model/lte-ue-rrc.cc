@@ -28,7 +28,10 @@
 #include <ns3/object-map.h>
 #include <ns3/simulator.h>
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
 
 namespace ns3
 {
@@ -214,6 +217,15 @@ LteUeRrc::GetTypeId()
                 UintegerValue(2), // see 3GPP 36.331 UE-TimersAndConstants & RLF-TimersAndConstants
                 MakeUintegerAccessor(&LteUeRrc::m_n311),
                 MakeUintegerChecker<uint8_t>(1, 10))
+            .AddAttribute("MaxTrackedCells",
+                          "The maximum number of cells of a carrier whose measurements are "
+                          "filtered and evaluated for measurement reporting in CONNECTED mode. "
+                          "Only the cells with the highest RSRP are tracked, together with the "
+                          "serving cells and the cells which are being reported. "
+                          "0 means that all the detected cells are tracked.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&LteUeRrc::m_maxTrackedCells),
+                          MakeUintegerChecker<uint16_t>())
             .AddTraceSource("MibReceived",
                             "trace fired upon reception of Master Information Block",
                             MakeTraceSourceAccessor(&LteUeRrc::m_mibReceivedTrace),
@@ -887,6 +899,29 @@ LteUeRrc::DoReportUeMeasurements(LteUeCphySapUser::UeMeasurementsParameters para
     // layer 3 filtering does not apply in IDLE mode
     bool useLayer3Filtering = (m_state == CONNECTED_NORMALLY);
     bool triggering = true;
+
+    // when the number of tracked cells is bounded, the cells weaker than the
+    // m_maxTrackedCells strongest ones are forgotten, unless they are in use
+    bool bounded = m_maxTrackedCells > 0 && m_state == CONNECTED_NORMALLY &&
+                   params.m_ueMeasurementsList.size() > m_maxTrackedCells;
+    double minTrackedRsrp = -std::numeric_limits<double>::infinity();
+    std::set<uint16_t> cellsInUse;
+    if (bounded)
+    {
+        std::vector<double> rsrps;
+        rsrps.reserve(params.m_ueMeasurementsList.size());
+        for (const auto& meas : params.m_ueMeasurementsList)
+        {
+            rsrps.push_back(meas.m_rsrp);
+        }
+        std::nth_element(rsrps.begin(),
+                         rsrps.begin() + (m_maxTrackedCells - 1),
+                         rsrps.end(),
+                         std::greater<>());
+        minTrackedRsrp = rsrps[m_maxTrackedCells - 1];
+        cellsInUse = GetCellsInUse();
+    }
+
     for (auto newMeasIt = params.m_ueMeasurementsList.begin();
          newMeasIt != params.m_ueMeasurementsList.end();
          ++newMeasIt)
@@ -896,6 +931,13 @@ LteUeRrc::DoReportUeMeasurements(LteUeCphySapUser::UeMeasurementsParameters para
             triggering = false; // report is triggered only when an event is on the primary carrier
             // in this case the measurement received is related to secondary carriers
         }
+        if (bounded && newMeasIt->m_rsrp < minTrackedRsrp &&
+            cellsInUse.find(newMeasIt->m_cellId) == cellsInUse.end())
+        {
+            NS_LOG_LOGIC(this << " not tracking cell " << newMeasIt->m_cellId);
+            m_storedMeasValues.erase(newMeasIt->m_cellId);
+            continue;
+        }
         SaveUeMeasurements(newMeasIt->m_cellId,
                            newMeasIt->m_rsrp,
                            newMeasIt->m_rsrq,
@@ -1877,6 +1919,34 @@ LteUeRrc::SaveUeMeasurements(uint16_t cellId,
 
 } // end of void SaveUeMeasurements
 
+std::set<uint16_t>
+LteUeRrc::GetCellsInUse() const
+{
+    std::set<uint16_t> cells;
+    cells.insert(m_cellId);
+    for (uint16_t componentCarrierId = 1; componentCarrierId < m_numberOfComponentCarriers;
+         componentCarrierId++)
+    {
+        cells.insert(m_cphySapProvider.at(componentCarrierId)->GetCellId());
+    }
+    for (const auto& [measId, varMeasReport] : m_varMeasReportList)
+    {
+        cells.insert(varMeasReport.cellsTriggeredList.begin(),
+                     varMeasReport.cellsTriggeredList.end());
+    }
+    for (const auto* triggerQueue : {&m_enteringTriggerQueue, &m_leavingTriggerQueue})
+    {
+        for (const auto& [measId, triggers] : *triggerQueue)
+        {
+            for (const auto& trigger : triggers)
+            {
+                cells.insert(trigger.concernedCells.begin(), trigger.concernedCells.end());
+            }
+        }
+    }
+    return cells;
+}
+
 void
 LteUeRrc::MeasurementReportTriggering(uint8_t measId)
 {
@@ -3203,6 +3273,16 @@ LteUeRrc::SwitchToState(State newState)
                      << newState);
     m_stateTransitionTrace(m_imsi, m_cellId, m_rnti, oldState, newState);
 
+    if ((oldState == IDLE_CAMPED_NORMALLY) != (newState == IDLE_CAMPED_NORMALLY))
+    {
+        // the PHY may skip the subframes while the UE is camped, and resumes
+        // them before the random access procedure of a connection is started
+        for (auto cphySapProvider : m_cphySapProvider)
+        {
+            cphySapProvider->SetIdleCamped(newState == IDLE_CAMPED_NORMALLY);
+        }
+    }
+
     switch (newState)
     {
     case IDLE_START:
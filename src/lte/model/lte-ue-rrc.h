@@ -648,6 +648,17 @@ class LteUeRrc : public Object
                             bool useLayer3Filtering,
                             uint8_t componentCarrierId);
 
+    /**
+     * @brief Get the cells which are tracked whatever their RSRP, when the
+     *        number of tracked cells is bounded by the MaxTrackedCells
+     *        attribute.
+     * @return the serving cells, and the cells which are part of a reporting
+     *         entry or of a pending trigger
+     *
+     * \sa LteUeRrc::m_maxTrackedCells
+     */
+    std::set<uint16_t> GetCellsInUse() const;
+
     /**
      * @brief Evaluate the reporting criteria of a measurement identity and
      *        invoke some reporting actions based on the result.
@@ -1250,6 +1261,13 @@ class LteUeRrc : public Object
      */
     uint8_t m_n311;
 
+    /**
+     * The 'MaxTrackedCells' attribute. The maximum number of cells of a
+     * measurement report of the PHY which are saved in #m_storedMeasValues in
+     * CONNECTED mode, 0 for no limit.
+     */
+    uint16_t m_maxTrackedCells;
+
     /**
      * Time limit (given by m_t310) before the radio link is considered to have failed.
      * It is set upon detecting physical layer problems i.e. upon receiving
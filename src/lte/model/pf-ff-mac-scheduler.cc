@@ -329,21 +329,7 @@ PfFfMacScheduler::GetRbgSize(int dlbandwidth)
 unsigned int
 PfFfMacScheduler::LcActivePerFlow(uint16_t rnti)
 {
-    unsigned int lcActive = 0;
-    for (auto it = m_rlcBufferReq.begin(); it != m_rlcBufferReq.end(); it++)
-    {
-        if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcStatusPduSize > 0)))
-        {
-            lcActive++;
-        }
-        if ((*it).first.m_rnti > rnti)
-        {
-            break;
-        }
-    }
-    return lcActive;
+    return FfMacDlUeTable::CountActiveLcs(m_rlcBufferReq, rnti);
 }
 
 bool
@@ -901,6 +887,40 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
         return;
     }
 
+    // the UEs with data to transmit and a HARQ process available, and their
+    // achievable rate on each RBG
+    m_dlUeTable.Start(m_amc, rbgSize, rbgNum);
+    std::vector<std::map<uint16_t, pfsFlowPerf_t>::iterator> candidates;
+    for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+    {
+        if (rntiAllocated.find((*it).first) != rntiAllocated.end())
+        {
+            // UE already allocated for HARQ -> drop it
+            NS_LOG_DEBUG(this << " RNTI discarded for HARQ tx" << (uint16_t)(*it).first);
+            continue;
+        }
+        if (!HarqProcessAvailability((*it).first))
+        {
+            // UE without HARQ process available -> drop it
+            NS_LOG_DEBUG(this << " RNTI discarded for HARQ id" << (uint16_t)(*it).first);
+            continue;
+        }
+        if (LcActivePerFlow((*it).first) == 0)
+        {
+            continue;
+        }
+        auto itTxMode = m_uesTxMode.find((*it).first);
+        if (itTxMode == m_uesTxMode.end())
+        {
+            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+        }
+        auto itCqi = m_a30CqiRxed.find((*it).first);
+        m_dlUeTable.Add((*it).first,
+                        TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second),
+                        itCqi == m_a30CqiRxed.end() ? nullptr : &(*itCqi).second);
+        candidates.push_back(it);
+    }
+
     for (int i = 0; i < rbgNum; i++)
     {
         NS_LOG_INFO(this << " ALLOCATION for RBG " << i << " of " << rbgNum);
@@ -908,89 +928,32 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
         {
             auto itMax = m_flowStatsDl.end();
             double rcqiMax = 0.0;
-            for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+            for (std::size_t j = 0; j < candidates.size(); j++)
             {
+                auto it = candidates[j];
                 if (!m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first))
                 {
                     continue;
                 }
 
-                auto itRnti = rntiAllocated.find((*it).first);
-                if (itRnti != rntiAllocated.end() || !HarqProcessAvailability((*it).first))
+                double achievableRate = m_dlUeTable.GetRate(j, i);
+                if (achievableRate < 0)
                 {
-                    // UE already allocated for HARQ or without HARQ process available -> drop it
-                    if (itRnti != rntiAllocated.end())
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discarded for HARQ tx"
-                                          << (uint16_t)(*it).first);
-                    }
-                    if (!HarqProcessAvailability((*it).first))
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discarded for HARQ id"
-                                          << (uint16_t)(*it).first);
-                    }
+                    // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                     continue;
                 }
-                auto itCqi = m_a30CqiRxed.find((*it).first);
-                auto itTxMode = m_uesTxMode.find((*it).first);
-                if (itTxMode == m_uesTxMode.end())
-                {
-                    NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                }
-                auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                std::vector<uint8_t> sbCqi;
-                if (itCqi == m_a30CqiRxed.end())
-                {
-                    sbCqi = std::vector<uint8_t>(nLayer, 1); // start with lowest value
-                }
-                else
-                {
-                    sbCqi = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                }
-                uint8_t cqi1 = sbCqi.at(0);
-                uint8_t cqi2 = 0;
-                if (sbCqi.size() > 1)
-                {
-                    cqi2 = sbCqi.at(1);
-                }
-
-                if ((cqi1 > 0) ||
-                    (cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                {
-                    if (LcActivePerFlow((*it).first) > 0)
-                    {
-                        // this UE has data to transmit
-                        double achievableRate = 0.0;
-                        uint8_t mcs = 0;
-                        for (uint8_t k = 0; k < nLayer; k++)
-                        {
-                            if (sbCqi.size() > k)
-                            {
-                                mcs = m_amc->GetMcsFromCqi(sbCqi.at(k));
-                            }
-                            else
-                            {
-                                // no info on this subband -> worst MCS
-                                mcs = 0;
-                            }
-                            achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                               0.001); // = TB size / TTI
-                        }
 
-                        double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                        NS_LOG_INFO(this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs
-                                         << " achievableRate " << achievableRate << " avgThr "
-                                         << (*it).second.lastAveragedThroughput << " RCQI "
-                                         << rcqi);
+                double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
+                NS_LOG_INFO(this << " RNTI " << (*it).first << " achievableRate "
+                                 << achievableRate << " avgThr "
+                                 << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
 
-                        if (rcqi > rcqiMax)
-                        {
-                            rcqiMax = rcqi;
-                            itMax = it;
-                        }
-                    }
-                } // end if cqi
-            }     // end for m_rlcBufferReq
+                if (rcqi > rcqiMax)
+                {
+                    rcqiMax = rcqi;
+                    itMax = it;
+                }
+            } // end for candidates
 
             if (itMax == m_flowStatsDl.end())
             {
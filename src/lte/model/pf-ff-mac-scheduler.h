@@ -10,6 +10,7 @@
 #define PF_FF_MAC_SCHEDULER_H
 
 #include "ff-mac-csched-sap.h"
+#include "ff-mac-dl-ue-table.h"
 #include "ff-mac-sched-sap.h"
 #include "ff-mac-scheduler.h"
 #include "lte-amc.h"
@@ -282,6 +283,8 @@ class PfFfMacScheduler : public FfMacScheduler
 
     Ptr<LteAmc> m_amc; ///< AMC
 
+    FfMacDlUeTable m_dlUeTable; ///< the UEs which can be scheduled in the current TTI
+
     /**
      * Vectors of UE's LC info
      */
@@ -361,21 +361,7 @@ PssFfMacScheduler::GetRbgSize(int dlbandwidth)
 unsigned int
 PssFfMacScheduler::LcActivePerFlow(uint16_t rnti)
 {
-    unsigned int lcActive = 0;
-    for (auto it = m_rlcBufferReq.begin(); it != m_rlcBufferReq.end(); it++)
-    {
-        if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcStatusPduSize > 0)))
-        {
-            lcActive++;
-        }
-        if ((*it).first.m_rnti > rnti)
-        {
-            break;
-        }
-    }
-    return lcActive;
+    return FfMacDlUeTable::CountActiveLcs(m_rlcBufferReq, rnti);
 }
 
 bool
@@ -936,12 +922,12 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
     std::map<uint16_t, pssFlowPerf_t> tdUeSet; // the result of TD scheduler
 
     // schedulability check
-    std::map<uint16_t, pssFlowPerf_t> ueSet;
+    std::vector<std::map<uint16_t, pssFlowPerf_t>::iterator> ueSet;
     for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
     {
         if (LcActivePerFlow((*it).first) > 0)
         {
-            ueSet[(*it).first] = (*it).second;
+            ueSet.push_back(it);
         }
     }
 
@@ -951,7 +937,7 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
         // Time Domain scheduler
         std::vector<std::pair<double, uint16_t>> ueSet1;
         std::vector<std::pair<double, uint16_t>> ueSet2;
-        for (auto it = ueSet.begin(); it != ueSet.end(); it++)
+        for (auto it : ueSet)
         {
             auto itRnti = rntiAllocated.find((*it).first);
             if ((itRnti != rntiAllocated.end()) || (!HarqProcessAvailability((*it).first)))
@@ -1043,10 +1029,6 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
 
         if (!ueSet1.empty() || !ueSet2.empty())
         {
-            // sorting UE in ueSet1 and ueSet1 in descending order based on their metric value
-            std::sort(ueSet1.rbegin(), ueSet1.rend());
-            std::sort(ueSet2.rbegin(), ueSet2.rend());
-
             // select UE set for frequency domain scheduler
             uint32_t nMux;
             if (m_nMux > 0)
@@ -1067,6 +1049,11 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                 }
             }
 
+            // sorting the nMux UEs with the highest metric value of ueSet1 and ueSet2 in
+            // descending order, the RNTIs make the metric values all different
+            FfMacDlUeTable::SortTopK(ueSet1, nMux);
+            FfMacDlUeTable::SortTopK(ueSet2, nMux - std::min<uint32_t>(nMux, ueSet1.size()));
+
             for (auto itSet = ueSet1.begin(); itSet != ueSet1.end() && nMux != 0; itSet++)
             {
                 auto itUe = m_flowStatsDl.find((*itSet).second);
@@ -1081,32 +1068,41 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                 nMux--;
             }
 
+            // the UEs selected by the TD scheduler, and their achievable rate on each RBG
+            m_dlUeTable.Start(m_amc, rbgSize, rbgNum);
+            std::vector<double> weights;
+            for (auto it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+            {
+                auto itCqi = m_a30CqiRxed.find((*it).first);
+                auto itTxMode = m_uesTxMode.find((*it).first);
+                if (itTxMode == m_uesTxMode.end())
+                {
+                    NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+                }
+                m_dlUeTable.Add((*it).first,
+                                TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second),
+                                itCqi == m_a30CqiRxed.end() ? nullptr : &(*itCqi).second);
+
+                // calculate PF weight
+                double weight = (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
+                if (weight < 1.0)
+                {
+                    weight = 1.0;
+                }
+                weights.push_back(weight);
+            }
+
             if (m_fdSchedulerType == "CoItA")
             {
                 // FD scheduler: Carrier over Interference to Average (CoItA)
-                std::map<uint16_t, uint8_t> sbCqiSum;
-                for (auto it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+                std::vector<uint8_t> sbCqiSum;
+                for (std::size_t j = 0; j < m_dlUeTable.GetN(); j++)
                 {
+                    uint8_t nLayer = m_dlUeTable.Get(j).nLayer;
                     uint8_t sum = 0;
                     for (int i = 0; i < rbgNum; i++)
                     {
-                        auto itCqi = m_a30CqiRxed.find((*it).first);
-                        auto itTxMode = m_uesTxMode.find((*it).first);
-                        if (itTxMode == m_uesTxMode.end())
-                        {
-                            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                        }
-                        auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                        std::vector<uint8_t> sbCqis;
-                        if (itCqi == m_a30CqiRxed.end())
-                        {
-                            sbCqis = std::vector<uint8_t>(nLayer, 1); // start with lowest value
-                        }
-                        else
-                        {
-                            sbCqis = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                        }
-
+                        const std::vector<uint8_t>& sbCqis = m_dlUeTable.GetSbCqi(j, i);
                         uint8_t cqi1 = sbCqis.at(0);
                         uint8_t cqi2 = 0;
                         if (sbCqis.size() > 1)
@@ -1135,7 +1131,7 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                         } // end if cqi
                     }     // end of rbgNum
 
-                    sbCqiSum[(*it).first] = sum;
+                    sbCqiSum.push_back(sum);
                 } // end tdUeSet
 
                 for (int i = 0; i < rbgNum; i++)
@@ -1145,42 +1141,18 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                         continue;
                     }
 
-                    auto itMax = tdUeSet.end();
+                    std::size_t jMax = m_dlUeTable.GetN();
                     double metricMax = 0.0;
-                    for (auto it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+                    for (std::size_t j = 0; j < m_dlUeTable.GetN(); j++)
                     {
-                        if (!m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first))
+                        uint16_t rnti = m_dlUeTable.Get(j).rnti;
+                        if (!m_ffrSapProvider->IsDlRbgAvailableForUe(i, rnti))
                         {
                             continue;
                         }
 
-                        // calculate PF weight
-                        double weight =
-                            (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
-                        if (weight < 1.0)
-                        {
-                            weight = 1.0;
-                        }
-
-                        auto itSbCqiSum = sbCqiSum.find((*it).first);
-
-                        auto itCqi = m_a30CqiRxed.find((*it).first);
-                        auto itTxMode = m_uesTxMode.find((*it).first);
-                        if (itTxMode == m_uesTxMode.end())
-                        {
-                            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                        }
-                        auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                        std::vector<uint8_t> sbCqis;
-                        if (itCqi == m_a30CqiRxed.end())
-                        {
-                            sbCqis = std::vector<uint8_t>(nLayer, 1); // start with lowest value
-                        }
-                        else
-                        {
-                            sbCqis = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                        }
-
+                        uint8_t nLayer = m_dlUeTable.Get(j).nLayer;
+                        const std::vector<uint8_t>& sbCqis = m_dlUeTable.GetSbCqi(j, i);
                         uint8_t cqi1 = sbCqis.at(0);
                         uint8_t cqi2 = 0;
                         if (sbCqis.size() > 1)
@@ -1205,14 +1177,14 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                                     // no info on this subband
                                     sbCqi = 0;
                                 }
-                                colMetric += (double)sbCqi / (double)(*itSbCqiSum).second;
+                                colMetric += (double)sbCqi / (double)sbCqiSum[j];
                             }
                         } // end if cqi
 
                         double metric = 0.0;
                         if (colMetric != 0)
                         {
-                            metric = weight * colMetric;
+                            metric = weights[j] * colMetric;
                         }
                         else
                         {
@@ -1222,17 +1194,17 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                         if (metric > metricMax)
                         {
                             metricMax = metric;
-                            itMax = it;
+                            jMax = j;
                         }
                     } // end of tdUeSet
 
-                    if (itMax == tdUeSet.end())
+                    if (jMax == m_dlUeTable.GetN())
                     {
                         // no UE available for downlink
                     }
                     else
                     {
-                        allocationMap[(*itMax).first].push_back(i);
+                        allocationMap[m_dlUeTable.Get(jMax).rnti].push_back(i);
                         rbgMap.at(i) = true;
                     }
                 } // end of rbgNum
@@ -1242,6 +1214,13 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
             if (m_fdSchedulerType == "PFsch")
             {
                 // FD scheduler: Proportional Fair scheduled (PFsch)
+                std::vector<double> secondLastAveragedThroughputs;
+                for (auto it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+                {
+                    secondLastAveragedThroughputs.push_back(
+                        (*it).second.secondLastAveragedThroughput);
+                }
+
                 for (int i = 0; i < rbgNum; i++)
                 {
                     if (rbgMap.at(i))
@@ -1249,87 +1228,39 @@ PssFfMacScheduler::DoSchedDlTriggerReq(
                         continue;
                     }
 
-                    auto itMax = tdUeSet.end();
+                    std::size_t jMax = m_dlUeTable.GetN();
                     double metricMax = 0.0;
-                    for (auto it = tdUeSet.begin(); it != tdUeSet.end(); it++)
+                    for (std::size_t j = 0; j < m_dlUeTable.GetN(); j++)
                     {
-                        if (!m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first))
+                        if (!m_ffrSapProvider->IsDlRbgAvailableForUe(i, m_dlUeTable.Get(j).rnti))
                         {
                             continue;
                         }
-                        // calculate PF weight
-                        double weight =
-                            (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
-                        if (weight < 1.0)
-                        {
-                            weight = 1.0;
-                        }
-
-                        auto itCqi = m_a30CqiRxed.find((*it).first);
-                        auto itTxMode = m_uesTxMode.find((*it).first);
-                        if (itTxMode == m_uesTxMode.end())
-                        {
-                            NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
-                        }
-                        auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                        std::vector<uint8_t> sbCqis;
-                        if (itCqi == m_a30CqiRxed.end())
-                        {
-                            sbCqis = std::vector<uint8_t>(nLayer, 1); // start with lowest value
-                        }
-                        else
-                        {
-                            sbCqis = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                        }
-
-                        uint8_t cqi1 = sbCqis.at(0);
-                        uint8_t cqi2 = 0;
-                        if (sbCqis.size() > 1)
-                        {
-                            cqi2 = sbCqis.at(1);
-                        }
 
                         double schMetric = 0.0;
-                        if ((cqi1 > 0) ||
-                            (cqi2 >
-                             0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+                        double achievableRate = m_dlUeTable.GetRate(j, i);
+                        if (achievableRate >= 0)
                         {
-                            double achievableRate = 0.0;
-                            for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                                uint8_t mcs = 0;
-                                if (sbCqis.size() > k)
-                                {
-                                    mcs = m_amc->GetMcsFromCqi(sbCqis.at(k));
-                                }
-                                else
-                                {
-                                    // no info on this subband  -> worst MCS
-                                    mcs = 0;
-                                }
-                                achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                                   0.001); // = TB size / TTI
-                            }
-                            schMetric = achievableRate / (*it).second.secondLastAveragedThroughput;
+                            schMetric = achievableRate / secondLastAveragedThroughputs[j];
                         } // end if cqi
 
                         double metric = 0.0;
-                        metric = weight * schMetric;
+                        metric = weights[j] * schMetric;
 
                         if (metric > metricMax)
                         {
                             metricMax = metric;
-                            itMax = it;
+                            jMax = j;
                         }
                     } // end of tdUeSet
 
-                    if (itMax == tdUeSet.end())
+                    if (jMax == m_dlUeTable.GetN())
                     {
                         // no UE available for downlink
                     }
                     else
                     {
-                        allocationMap[(*itMax).first].push_back(i);
+                        allocationMap[m_dlUeTable.Get(jMax).rnti].push_back(i);
                         rbgMap.at(i) = true;
                     }
 
@@ -11,6 +11,7 @@
 #define PSS_FF_MAC_SCHEDULER_H
 
 #include "ff-mac-csched-sap.h"
+#include "ff-mac-dl-ue-table.h"
 #include "ff-mac-sched-sap.h"
 #include "ff-mac-scheduler.h"
 #include "lte-amc.h"
@@ -287,6 +288,8 @@ class PssFfMacScheduler : public FfMacScheduler
 
     Ptr<LteAmc> m_amc; ///< AMC
 
+    FfMacDlUeTable m_dlUeTable; ///< the UEs selected by the TD scheduler in the current TTI
+
     /**
      * Vectors of UE's LC info
      */
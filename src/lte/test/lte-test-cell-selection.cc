@@ -20,6 +20,7 @@
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-helper.h>
 #include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-ue-phy.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/mobility-helper.h>
 #include <ns3/net-device-container.h>
@@ -65,7 +66,17 @@ LteCellSelectionTestSuite::LteCellSelectionTestSuite()
         LteCellSelectionTestCase::UeSetup_t(1.0, 0.45, true, MilliSeconds(283), 4, 0),
     };
 
-    AddTestCase(new LteCellSelectionTestCase("EPC, real RRC", true, false, 60.0 /* isd */, w),
+    AddTestCase(
+        new LteCellSelectionTestCase("EPC, real RRC", true, false, false, 60.0 /* isd */, w),
+        TestCase::Duration::QUICK);
+
+    // the idle UEs do not change the outcome of the procedure
+    AddTestCase(new LteCellSelectionTestCase("EPC, real RRC, idle subframe skipping",
+                                             true,
+                                             false,
+                                             true,
+                                             60.0 /* isd */,
+                                             w),
                 TestCase::Duration::QUICK);
 
     // IDEAL RRC PROTOCOL
@@ -80,8 +91,9 @@ LteCellSelectionTestSuite::LteCellSelectionTestSuite()
         LteCellSelectionTestCase::UeSetup_t(1.0, 0.45, true, MilliSeconds(266), 4, 0),
     };
 
-    AddTestCase(new LteCellSelectionTestCase("EPC, ideal RRC", true, true, 60.0 /* isd */, w),
-                TestCase::Duration::QUICK);
+    AddTestCase(
+        new LteCellSelectionTestCase("EPC, ideal RRC", true, true, false, 60.0 /* isd */, w),
+        TestCase::Duration::QUICK);
 
 } // end of LteCellSelectionTestSuite::LteCellSelectionTestSuite ()
 
@@ -112,11 +124,13 @@ LteCellSelectionTestCase::UeSetup_t::UeSetup_t(double relPosX,
 LteCellSelectionTestCase::LteCellSelectionTestCase(std::string name,
                                                    bool isEpcMode,
                                                    bool isIdealRrc,
+                                                   bool idleSubframeSkipping,
                                                    double interSiteDistance,
                                                    std::vector<UeSetup_t> ueSetupList)
     : TestCase(name),
       m_isEpcMode(isEpcMode),
       m_isIdealRrc(isIdealRrc),
+      m_idleSubframeSkipping(idleSubframeSkipping),
       m_interSiteDistance(interSiteDistance),
       m_ueSetupList(ueSetupList)
 {
@@ -245,6 +259,7 @@ LteCellSelectionTestCase::DoRun()
         NetDeviceContainer devs = lteHelper->InstallUeDevice(*itNode);
         Ptr<LteUeNetDevice> ueDev = devs.Get(0)->GetObject<LteUeNetDevice>();
         NS_ASSERT(ueDev);
+        ueDev->GetPhy()->SetAttribute("IdleSubframeSkipping", BooleanValue(m_idleSubframeSkipping));
         ueDevs.Add(devs);
         Simulator::Schedule(itSetup->checkPoint,
                             &LteCellSelectionTestCase::CheckPoint,
@@ -86,6 +86,8 @@ class LteCellSelectionTestCase : public TestCase
      * @param isEpcMode set to true for setting up simulation with EPC enabled
      * @param isIdealRrc if true, simulation uses Ideal RRC protocol, otherwise
      *                   simulation uses Real RRC protocol
+     * @param idleSubframeSkipping if true, the UEs stop their subframe
+     *                             indications while they are idle
      * @param interSiteDistance the distance between eNodeB in meters
      * @param ueSetupList a list of UE configuration to be installed in the
      *                    simulation
@@ -93,6 +95,7 @@ class LteCellSelectionTestCase : public TestCase
     LteCellSelectionTestCase(std::string name,
                              bool isEpcMode,
                              bool isIdealRrc,
+                             bool idleSubframeSkipping,
                              double interSiteDistance,
                              std::vector<UeSetup_t> ueSetupList);
 
@@ -157,6 +160,7 @@ class LteCellSelectionTestCase : public TestCase
 
     bool m_isEpcMode;                     ///< whether the LTE configuration in test is using EPC
     bool m_isIdealRrc;                    ///< whether the LTE is configured to use ideal RRC
+    bool m_idleSubframeSkipping;          ///< whether the UEs skip the idle subframes
     double m_interSiteDistance;           ///< inter site distance
     std::vector<UeSetup_t> m_ueSetupList; ///< UE setup list
 
@@ -0,0 +1,186 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ff-mac-dl-ue-table.h"
+#include "ns3/log.h"
+#include "ns3/lte-amc.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteTestFfMacDlUeTable");
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Test that the rates of the FfMacDlUeTable are the ones computed by
+ * the schedulers through the AMC module, for UEs with and without subband
+ * CQIs, with one and two layers
+ */
+class FfMacDlUeTableRateTestCase : public TestCase
+{
+  public:
+    FfMacDlUeTableRateTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FfMacDlUeTableRateTestCase::FfMacDlUeTableRateTestCase()
+    : TestCase("Test the rates of the FfMacDlUeTable")
+{
+}
+
+void
+FfMacDlUeTableRateTestCase::DoRun()
+{
+    const int rbgSize = 3;
+    const int rbgNum = 4;
+    Ptr<LteAmc> amc = CreateObject<LteAmc>();
+    // the rate of a layer as computed by the schedulers
+    auto rate = [&](uint8_t cqi) {
+        return (amc->GetDlTbSizeFromMcs(amc->GetMcsFromCqi(cqi), rbgSize) / 8) / 0.001;
+    };
+    const double noCqiRate = (amc->GetDlTbSizeFromMcs(0, rbgSize) / 8) / 0.001;
+
+    // one layer; the third RBG is out of range, the fourth is not reported
+    SbMeasResult_s oneLayer;
+    for (uint8_t cqi : {15, 7, 0})
+    {
+        HigherLayerSelected_s sb;
+        sb.m_sbCqi.push_back(cqi);
+        oneLayer.m_higherLayerSelected.push_back(sb);
+    }
+    // two layers; the second layer of the second RBG is not reported
+    SbMeasResult_s twoLayers;
+    const std::vector<std::vector<uint8_t>> twoLayerCqis{{9, 4}, {6}, {0, 3}, {1, 1}};
+    for (const auto& cqis : twoLayerCqis)
+    {
+        HigherLayerSelected_s sb;
+        sb.m_sbCqi = cqis;
+        twoLayers.m_higherLayerSelected.push_back(sb);
+    }
+
+    FfMacDlUeTable table;
+    table.Start(amc, rbgSize, rbgNum);
+    NS_TEST_ASSERT_MSG_EQ(table.Add(10, 1, &oneLayer), 0, "Unexpected index");
+    NS_TEST_ASSERT_MSG_EQ(table.Add(20, 2, &twoLayers), 1, "Unexpected index");
+    NS_TEST_ASSERT_MSG_EQ(table.Add(30, 2, nullptr), 2, "Unexpected index");
+    NS_TEST_ASSERT_MSG_EQ(table.GetN(), 3, "Unexpected number of UEs");
+    NS_TEST_ASSERT_MSG_EQ(table.Get(1).rnti, 20, "Unexpected RNTI");
+    NS_TEST_ASSERT_MSG_EQ(+table.Get(1).nLayer, 2, "Unexpected number of layers");
+
+    // the rates are compared exactly, since the schedulers compare them
+    NS_TEST_EXPECT_MSG_EQ(table.GetRate(0, 0), rate(15), "Wrong rate");
+    NS_TEST_EXPECT_MSG_EQ(table.GetRate(0, 1), rate(7), "Wrong rate");
+    NS_TEST_EXPECT_MSG_LT(table.GetRate(0, 2), 0, "Out of range CQI has a rate");
+    NS_TEST_EXPECT_MSG_LT(table.GetRate(0, 3), 0, "Unreported RBG has a rate");
+
+    NS_TEST_EXPECT_MSG_EQ(table.GetRate(1, 0), rate(9) + rate(4), "Wrong rate");
+    NS_TEST_EXPECT_MSG_EQ(table.GetRate(1, 1), rate(6) + noCqiRate, "Wrong rate");
+    NS_TEST_EXPECT_MSG_EQ(table.GetRate(1, 2), rate(0) + rate(3), "Wrong rate");
+    NS_TEST_EXPECT_MSG_EQ(table.GetRate(1, 3), rate(1) + rate(1), "Wrong rate");
+
+    // a UE without subband CQIs has CQI 1 on all its layers
+    for (int rbg = 0; rbg < rbgNum; rbg++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(table.GetSbCqi(2, rbg).size(), 2, "Wrong number of CQIs");
+        NS_TEST_EXPECT_MSG_EQ(+table.GetSbCqi(2, rbg).at(1), 1, "Wrong CQI");
+        NS_TEST_EXPECT_MSG_EQ(table.GetRate(2, rbg), rate(1) + rate(1), "Wrong rate");
+    }
+    NS_TEST_EXPECT_MSG_EQ(+table.GetSbCqi(1, 0).at(1), 4, "Wrong CQI");
+
+    // a new TTI starts with an empty table
+    table.Start(amc, rbgSize, rbgNum);
+    NS_TEST_EXPECT_MSG_EQ(table.GetN(), 0, "The table has not been emptied");
+    table.Add(40, 1, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(table.GetRate(0, rbgNum - 1), rate(1), "Wrong rate");
+}
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Test the helpers of the FfMacDlUeTable: the count of the active
+ * logical channels of a UE, and the partial sort of the candidates
+ */
+class FfMacDlUeTableHelpersTestCase : public TestCase
+{
+  public:
+    FfMacDlUeTableHelpersTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FfMacDlUeTableHelpersTestCase::FfMacDlUeTableHelpersTestCase()
+    : TestCase("Test the helpers of the FfMacDlUeTable")
+{
+}
+
+void
+FfMacDlUeTableHelpersTestCase::DoRun()
+{
+    std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters> rlcBufferReq;
+    auto addLc = [&](uint16_t rnti, uint8_t lcid, uint32_t tx, uint32_t retx, uint16_t status) {
+        FfMacSchedSapProvider::SchedDlRlcBufferReqParameters params{};
+        params.m_rnti = rnti;
+        params.m_logicalChannelIdentity = lcid;
+        params.m_rlcTransmissionQueueSize = tx;
+        params.m_rlcRetransmissionQueueSize = retx;
+        params.m_rlcStatusPduSize = status;
+        rlcBufferReq[LteFlowId_t(rnti, lcid)] = params;
+    };
+    addLc(1, 1, 100, 0, 0);
+    addLc(1, 3, 0, 0, 0);
+    addLc(2, 1, 0, 0, 0);
+    addLc(2, 2, 0, 50, 0);
+    addLc(2, 3, 0, 0, 2);
+    addLc(2, 4, 10, 10, 0);
+    addLc(4, 1, 1, 0, 0);
+
+    NS_TEST_EXPECT_MSG_EQ(FfMacDlUeTable::CountActiveLcs(rlcBufferReq, 1), 1, "Wrong count");
+    NS_TEST_EXPECT_MSG_EQ(FfMacDlUeTable::CountActiveLcs(rlcBufferReq, 2), 3, "Wrong count");
+    NS_TEST_EXPECT_MSG_EQ(FfMacDlUeTable::CountActiveLcs(rlcBufferReq, 3), 0, "Wrong count");
+    NS_TEST_EXPECT_MSG_EQ(FfMacDlUeTable::CountActiveLcs(rlcBufferReq, 4), 1, "Wrong count");
+    NS_TEST_EXPECT_MSG_EQ(FfMacDlUeTable::CountActiveLcs(rlcBufferReq, 5), 0, "Wrong count");
+
+    // the first k elements are the ones of the full descending sort
+    std::vector<double> values{3.5, 9.0, -1.0, 7.25, 0.0, 12.0, 4.0, 8.5};
+    std::vector<double> sorted = values;
+    std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+    for (std::size_t k : {0, 1, 3, 8, 20})
+    {
+        std::vector<double> partial = values;
+        FfMacDlUeTable::SortTopK(partial, k);
+        for (std::size_t i = 0; i < std::min(k, values.size()); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(partial[i], sorted[i], "Wrong element " << i << " for k=" << k);
+        }
+    }
+}
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Test suite of the FfMacDlUeTable
+ */
+class FfMacDlUeTableTestSuite : public TestSuite
+{
+  public:
+    FfMacDlUeTableTestSuite();
+};
+
+FfMacDlUeTableTestSuite::FfMacDlUeTableTestSuite()
+    : TestSuite("lte-ff-mac-dl-ue-table", Type::UNIT)
+{
+    AddTestCase(new FfMacDlUeTableRateTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FfMacDlUeTableHelpersTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static FfMacDlUeTableTestSuite g_ffMacDlUeTableTestSuite;
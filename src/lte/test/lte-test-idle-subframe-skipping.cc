@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/epc-ue-nas.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/log.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-ue-mac.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-ue-phy.h"
+#include "ns3/lte-ue-rrc.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteIdleSubframeSkippingTest");
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Check that a UE camped on a cell in RRC IDLE skips its subframes
+ * with the `LteUePhy::IdleSubframeSkipping` attribute, and that it connects
+ * after a resume at the same time as a UE which does not skip its subframes,
+ * i.e., that the RA-RNTI of its preamble matches the one of the random access
+ * response of the eNB.
+ */
+class LteIdleSubframeSkippingTestCase : public TestCase
+{
+  public:
+    LteIdleSubframeSkippingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Camp a UE on a cell and connect it later
+     * @param idleSubframeSkipping the `IdleSubframeSkipping` attribute
+     * @return the time at which the UE is connected
+     */
+    Time Connect(bool idleSubframeSkipping);
+
+    /**
+     * UE PHY `SkippedSubframes` trace sink
+     * @param cellId the cell ID
+     * @param imsi the IMSI
+     * @param subframes the number of skipped subframes
+     */
+    void SkippedSubframes(uint16_t cellId, uint64_t imsi, uint64_t subframes);
+
+    /**
+     * UE MAC `RaResponseTimeout` trace sink
+     * @param imsi the IMSI
+     * @param contention whether the procedure is contention based
+     * @param preambleTxCounter the preamble transmission counter
+     * @param maxPreambleTxLimit the maximum number of preamble transmissions
+     */
+    void RaResponseTimeout(uint64_t imsi,
+                           bool contention,
+                           uint8_t preambleTxCounter,
+                           uint8_t maxPreambleTxLimit);
+
+    /**
+     * UE RRC `StateTransition` trace sink
+     * @param imsi the IMSI
+     * @param cellId the cell ID
+     * @param rnti the RNTI
+     * @param oldState the previous state
+     * @param newState the new state
+     */
+    void StateTransition(uint64_t imsi,
+                         uint16_t cellId,
+                         uint16_t rnti,
+                         LteUeRrc::State oldState,
+                         LteUeRrc::State newState);
+
+    uint64_t m_skippedSubframes; //!< the number of skipped subframes
+    uint32_t m_resumes;          //!< the number of resumes of the subframe indications
+    uint32_t m_raTimeouts;       //!< the number of RA response timeouts
+    Time m_connectedTime;        //!< the time at which the UE is connected
+};
+
+LteIdleSubframeSkippingTestCase::LteIdleSubframeSkippingTestCase()
+    : TestCase("Check the subframes skipped by a camped UE and its random access after a resume")
+{
+}
+
+void
+LteIdleSubframeSkippingTestCase::SkippedSubframes(uint16_t /* cellId */,
+                                                  uint64_t /* imsi */,
+                                                  uint64_t subframes)
+{
+    m_skippedSubframes += subframes;
+    m_resumes++;
+}
+
+void
+LteIdleSubframeSkippingTestCase::RaResponseTimeout(uint64_t /* imsi */,
+                                                   bool /* contention */,
+                                                   uint8_t /* preambleTxCounter */,
+                                                   uint8_t /* maxPreambleTxLimit */)
+{
+    m_raTimeouts++;
+}
+
+void
+LteIdleSubframeSkippingTestCase::StateTransition(uint64_t /* imsi */,
+                                                 uint16_t /* cellId */,
+                                                 uint16_t /* rnti */,
+                                                 LteUeRrc::State /* oldState */,
+                                                 LteUeRrc::State newState)
+{
+    if (newState == LteUeRrc::CONNECTED_NORMALLY)
+    {
+        m_connectedTime = Simulator::Now();
+    }
+}
+
+Time
+LteIdleSubframeSkippingTestCase::Connect(bool idleSubframeSkipping)
+{
+    // both runs draw the same random values
+    RngSeedManager::ResetNextStreamIndex();
+    m_skippedSubframes = 0;
+    m_resumes = 0;
+    m_raTimeouts = 0;
+    m_connectedTime = Time();
+
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    NodeContainer enbNodes;
+    NodeContainer ueNodes;
+    enbNodes.Create(1);
+    ueNodes.Create(1);
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(100.0, 0.0, 0.0));
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.Install(enbNodes);
+    mobility.Install(ueNodes);
+    Ptr<LteEnbNetDevice> enbDev =
+        lteHelper->InstallEnbDevice(enbNodes).Get(0)->GetObject<LteEnbNetDevice>();
+    Ptr<LteUeNetDevice> ueDev =
+        lteHelper->InstallUeDevice(ueNodes).Get(0)->GetObject<LteUeNetDevice>();
+
+    ueDev->GetPhy()->SetAttribute("IdleSubframeSkipping", BooleanValue(idleSubframeSkipping));
+    ueDev->GetPhy()->TraceConnectWithoutContext(
+        "SkippedSubframes",
+        MakeCallback(&LteIdleSubframeSkippingTestCase::SkippedSubframes, this));
+    ueDev->GetMac()->TraceConnectWithoutContext(
+        "RaResponseTimeout",
+        MakeCallback(&LteIdleSubframeSkippingTestCase::RaResponseTimeout, this));
+    ueDev->GetRrc()->TraceConnectWithoutContext(
+        "StateTransition",
+        MakeCallback(&LteIdleSubframeSkippingTestCase::StateTransition, this));
+
+    // camp on the cell without connecting (unlike the initial cell selection,
+    // which connects the UE), and connect in the middle of a subframe, long
+    // after the MAC was told about its last subframe
+    ueDev->GetRrc()->GetAsSapProvider()->ForceCampedOnEnb(enbDev->GetCellId(),
+                                                          ueDev->GetDlEarfcn());
+    Ptr<EpcUeNas> ueNas = ueDev->GetNas();
+    Simulator::Schedule(MicroSeconds(500350), [ueNas]() { ueNas->Connect(); });
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+    return m_connectedTime;
+}
+
+void
+LteIdleSubframeSkippingTestCase::DoRun()
+{
+    Time referenceTime = Connect(false);
+    NS_TEST_ASSERT_MSG_GT(referenceTime, MilliSeconds(500), "The UE is not connected");
+    NS_TEST_EXPECT_MSG_EQ(m_resumes, 0, "Subframes skipped without IdleSubframeSkipping");
+
+    Time connectedTime = Connect(true);
+    NS_TEST_EXPECT_MSG_EQ(m_resumes, 1, "The subframe indications did not resume once");
+    // the UE is camped after the first MIB, received in the first 10 ms
+    NS_TEST_EXPECT_MSG_GT(m_skippedSubframes, 400, "Too few subframes skipped");
+    NS_TEST_EXPECT_MSG_LT(m_skippedSubframes, 500, "Too many subframes skipped");
+    NS_TEST_EXPECT_MSG_EQ(m_raTimeouts, 0, "The RA-RNTI of the preamble is not the right one");
+    NS_TEST_EXPECT_MSG_EQ(connectedTime,
+                          referenceTime,
+                          "The UE is not connected when it does not skip the subframes");
+}
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Test suite of the idle subframe skipping of the UE PHY
+ */
+class LteIdleSubframeSkippingTestSuite : public TestSuite
+{
+  public:
+    LteIdleSubframeSkippingTestSuite();
+};
+
+LteIdleSubframeSkippingTestSuite::LteIdleSubframeSkippingTestSuite()
+    : TestSuite("lte-idle-subframe-skipping", Type::SYSTEM)
+{
+    AddTestCase(new LteIdleSubframeSkippingTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static LteIdleSubframeSkippingTestSuite g_lteIdleSubframeSkippingTestSuite;
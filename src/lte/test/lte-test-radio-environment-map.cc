@@ -0,0 +1,388 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/lte-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/pointer.h"
+#include "ns3/radio-environment-map-helper.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/spectrum-transmit-filter.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstring>
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteRadioEnvironmentMapTest");
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief A transmit filter dropping the signals of a device
+ */
+class LteRemTestTransmitFilter : public SpectrumTransmitFilter
+{
+  public:
+    /**
+     * Constructor
+     * @param device the device whose signals are dropped
+     */
+    LteRemTestTransmitFilter(Ptr<NetDevice> device)
+        : m_device(device)
+    {
+    }
+
+    uint32_t m_filtered{0}; //!< the number of dropped signals
+
+  private:
+    bool DoFilter(Ptr<const SpectrumSignalParameters> params,
+                  Ptr<const SpectrumPhy> /* receiverPhy */) override
+    {
+        if (params->txPhy->GetDevice() == m_device)
+        {
+            m_filtered++;
+            return true;
+        }
+        return false;
+    }
+
+    int64_t DoAssignStreams(int64_t /* stream */) override
+    {
+        return 0;
+    }
+
+    Ptr<NetDevice> m_device; //!< the device whose signals are dropped
+};
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Check that the direct evaluation of a Radio Environment Map, serial
+ * or with worker threads, and with text or binary output, gives the same map
+ * as the RemSpectrumPhy listeners, with and without a transmit filter on the
+ * channel.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param filter whether a transmit filter drops the signals of an eNB
+     */
+    LteRadioEnvironmentMapTestCase(bool filter);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a REM of the downlink channel
+     * @param lteHelper the LTE helper
+     * @param fileName the output file
+     * @param direct the `DirectEvaluation` attribute
+     * @param workers the `Workers` attribute
+     * @param binary the `BinaryOutput` attribute
+     */
+    void InstallRem(Ptr<LteHelper> lteHelper,
+                    const std::string& fileName,
+                    bool direct,
+                    uint32_t workers,
+                    bool binary);
+
+    /**
+     * Read a text REM
+     * @param fileName the REM file
+     * @return the SINR of the points
+     */
+    std::vector<double> ReadText(const std::string& fileName);
+
+    /**
+     * Read a binary REM
+     * @param fileName the REM file
+     * @return the SINR of the points
+     */
+    std::vector<double> ReadBinary(const std::string& fileName);
+
+    static constexpr uint16_t X_RES = 10; //!< the resolution along the x axis
+    static constexpr uint16_t Y_RES = 8;  //!< the resolution along the y axis
+
+    bool m_filter;                                      //!< whether a transmit filter is used
+    std::vector<Ptr<RadioEnvironmentMapHelper>> m_rems; //!< the REM helpers
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase(bool filter)
+    : TestCase(std::string("Check the direct evaluation of the REM") +
+               (filter ? " with a transmit filter" : "")),
+      m_filter(filter)
+{
+}
+
+void
+LteRadioEnvironmentMapTestCase::InstallRem(Ptr<LteHelper> lteHelper,
+                                           const std::string& fileName,
+                                           bool direct,
+                                           uint32_t workers,
+                                           bool binary)
+{
+    Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper>();
+    remHelper->SetAttribute("Channel", PointerValue(lteHelper->GetDownlinkSpectrumChannel()));
+    remHelper->SetAttribute("OutputFile", StringValue(fileName));
+    remHelper->SetAttribute("XMin", DoubleValue(-200.0));
+    remHelper->SetAttribute("XMax", DoubleValue(500.0));
+    remHelper->SetAttribute("XRes", UintegerValue(X_RES));
+    remHelper->SetAttribute("YMin", DoubleValue(-150.0));
+    remHelper->SetAttribute("YMax", DoubleValue(150.0));
+    remHelper->SetAttribute("YRes", UintegerValue(Y_RES));
+    remHelper->SetAttribute("Z", DoubleValue(1.5));
+    remHelper->SetAttribute("StopWhenDone", BooleanValue(false));
+    remHelper->SetAttribute("DirectEvaluation", BooleanValue(direct));
+    remHelper->SetAttribute("Workers", UintegerValue(workers));
+    remHelper->SetAttribute("BinaryOutput", BooleanValue(binary));
+    remHelper->Install();
+    m_rems.push_back(remHelper);
+}
+
+std::vector<double>
+LteRadioEnvironmentMapTestCase::ReadText(const std::string& fileName)
+{
+    std::vector<double> sinrs;
+    std::ifstream is(fileName);
+    double x;
+    double y;
+    double z;
+    double sinr;
+    while (is >> x >> y >> z >> sinr)
+    {
+        // the points are written column by column
+        double expectedX = -200.0 + (sinrs.size() / Y_RES) * 700.0 / (X_RES - 1);
+        double expectedY = -150.0 + (sinrs.size() % Y_RES) * 300.0 / (Y_RES - 1);
+        NS_TEST_EXPECT_MSG_EQ_TOL(x, expectedX, 1e-3, "Wrong x coordinate in " << fileName);
+        NS_TEST_EXPECT_MSG_EQ_TOL(y, expectedY, 1e-3, "Wrong y coordinate in " << fileName);
+        sinrs.push_back(sinr);
+    }
+    return sinrs;
+}
+
+std::vector<double>
+LteRadioEnvironmentMapTestCase::ReadBinary(const std::string& fileName)
+{
+    std::vector<double> sinrs;
+    std::ifstream is(fileName, std::ios::in | std::ios::binary);
+    char magic[8];
+    uint32_t res[2];
+    double bounds[5];
+    is.read(magic, sizeof(magic));
+    is.read(reinterpret_cast<char*>(res), sizeof(res));
+    is.read(reinterpret_cast<char*>(bounds), sizeof(bounds));
+    NS_TEST_EXPECT_MSG_EQ(std::memcmp(magic, "ns3rem01", sizeof(magic)), 0, "Wrong magic");
+    NS_TEST_EXPECT_MSG_EQ(res[0], X_RES, "Wrong x resolution");
+    NS_TEST_EXPECT_MSG_EQ(res[1], Y_RES, "Wrong y resolution");
+    NS_TEST_EXPECT_MSG_EQ(bounds[1], 500.0, "Wrong max x coordinate");
+    NS_TEST_EXPECT_MSG_EQ(bounds[4], 1.5, "Wrong z coordinate");
+    float sinr;
+    while (is.read(reinterpret_cast<char*>(&sinr), sizeof(sinr)))
+    {
+        sinrs.push_back(sinr);
+    }
+    return sinrs;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun()
+{
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetAttribute("PathlossModel", StringValue("ns3::LogDistancePropagationLossModel"));
+    lteHelper->SetEnbAntennaModelType("ns3::CosineAntennaModel");
+
+    NodeContainer enbNodes;
+    enbNodes.Create(3);
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 30.0));
+    positionAlloc->Add(Vector(300.0, 0.0, 30.0));
+    positionAlloc->Add(Vector(150.0, 100.0, 30.0));
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.Install(enbNodes);
+    NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice(enbNodes);
+    Ptr<LteRemTestTransmitFilter> filter;
+    if (m_filter)
+    {
+        filter = CreateObject<LteRemTestTransmitFilter>(enbDevs.Get(1));
+        lteHelper->GetDownlinkSpectrumChannel()->AddSpectrumTransmitFilter(filter);
+    }
+
+    std::string listenersFile = CreateTempDirFilename("rem-listeners.out");
+    std::string directFile = CreateTempDirFilename("rem-direct.out");
+    std::string workersFile = CreateTempDirFilename("rem-workers.bin");
+    InstallRem(lteHelper, listenersFile, false, 1, false);
+    InstallRem(lteHelper, directFile, true, 1, false);
+    InstallRem(lteHelper, workersFile, true, 3, true);
+
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+    Simulator::Destroy();
+    m_rems.clear();
+    if (m_filter)
+    {
+        NS_TEST_EXPECT_MSG_GT(filter->m_filtered, 0, "No signal dropped by the filter");
+    }
+
+    std::vector<double> listeners = ReadText(listenersFile);
+    std::vector<double> direct = ReadText(directFile);
+    std::vector<double> workers = ReadBinary(workersFile);
+    NS_TEST_ASSERT_MSG_EQ(listeners.size(), X_RES * Y_RES, "Wrong number of points");
+    NS_TEST_ASSERT_MSG_EQ(direct.size(), X_RES * Y_RES, "Wrong number of points");
+    NS_TEST_ASSERT_MSG_EQ(workers.size(), X_RES * Y_RES, "Wrong number of points");
+    for (uint32_t i = 0; i < listeners.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_GT(listeners[i], 0, "No signal received at point " << i);
+        NS_TEST_EXPECT_MSG_EQ_TOL(direct[i],
+                                  listeners[i],
+                                  listeners[i] * 1e-5,
+                                  "Different SINR with the direct evaluation, point " << i);
+        NS_TEST_EXPECT_MSG_EQ_TOL(workers[i],
+                                  listeners[i],
+                                  listeners[i] * 1e-5,
+                                  "Different SINR with the worker threads, point " << i);
+    }
+}
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Check that the direct evaluation of a Radio Environment Map with a
+ * random propagation loss model gives the same map, and leaves the random
+ * variable of the model in the same state, whatever the number of workers.
+ */
+class LteRadioEnvironmentMapWorkersTestCase : public TestCase
+{
+  public:
+    LteRadioEnvironmentMapWorkersTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Compute a REM in a simulation of its own
+     * @param workers the `Workers` attribute
+     * @param nextLoss the loss drawn by the propagation loss model after the REM
+     * @return the SINR of the points
+     */
+    std::vector<double> ComputeRem(uint32_t workers, double& nextLoss);
+};
+
+LteRadioEnvironmentMapWorkersTestCase::LteRadioEnvironmentMapWorkersTestCase()
+    : TestCase("Check the REM with random losses and several workers")
+{
+}
+
+std::vector<double>
+LteRadioEnvironmentMapWorkersTestCase::ComputeRem(uint32_t workers, double& nextLoss)
+{
+    // the random variables of both simulations use the same streams
+    RngSeedManager::ResetNextStreamIndex();
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetAttribute("PathlossModel", StringValue("ns3::RandomPropagationLossModel"));
+    lteHelper->SetPathlossModelAttribute(
+        "Variable",
+        StringValue("ns3::UniformRandomVariable[Min=60.0|Max=120.0]"));
+
+    NodeContainer enbNodes;
+    enbNodes.Create(4);
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    for (uint32_t i = 0; i < enbNodes.GetN(); ++i)
+    {
+        positionAlloc->Add(Vector(i * 50.0, 0.0, 30.0));
+    }
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.Install(enbNodes);
+    lteHelper->InstallEnbDevice(enbNodes);
+
+    std::string fileName =
+        CreateTempDirFilename("rem-workers-" + std::to_string(workers) + ".out");
+    Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper>();
+    remHelper->SetAttribute("Channel", PointerValue(lteHelper->GetDownlinkSpectrumChannel()));
+    remHelper->SetAttribute("OutputFile", StringValue(fileName));
+    remHelper->SetAttribute("XMin", DoubleValue(10.0));
+    remHelper->SetAttribute("XMax", DoubleValue(200.0));
+    remHelper->SetAttribute("XRes", UintegerValue(7));
+    remHelper->SetAttribute("YMin", DoubleValue(10.0));
+    remHelper->SetAttribute("YMax", DoubleValue(100.0));
+    remHelper->SetAttribute("YRes", UintegerValue(5));
+    remHelper->SetAttribute("StopWhenDone", BooleanValue(false));
+    remHelper->SetAttribute("DirectEvaluation", BooleanValue(true));
+    remHelper->SetAttribute("Workers", UintegerValue(workers));
+    // several blocks of columns
+    remHelper->SetAttribute("MaxPointsPerIteration", UintegerValue(12));
+    remHelper->Install();
+
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+    Ptr<PropagationLossModel> loss =
+        lteHelper->GetDownlinkSpectrumChannel()->GetPropagationLossModel();
+    nextLoss = -loss->CalcRxPower(0,
+                                  enbNodes.Get(0)->GetObject<MobilityModel>(),
+                                  enbNodes.Get(1)->GetObject<MobilityModel>());
+    Simulator::Destroy();
+
+    std::vector<double> sinrs;
+    std::ifstream is(fileName);
+    double x;
+    double y;
+    double z;
+    double sinr;
+    while (is >> x >> y >> z >> sinr)
+    {
+        sinrs.push_back(sinr);
+    }
+    return sinrs;
+}
+
+void
+LteRadioEnvironmentMapWorkersTestCase::DoRun()
+{
+    double serialLoss;
+    double workersLoss;
+    std::vector<double> serial = ComputeRem(1, serialLoss);
+    std::vector<double> workers = ComputeRem(4, workersLoss);
+    NS_TEST_ASSERT_MSG_EQ(serial.size(), 7 * 5, "Wrong number of points");
+    NS_TEST_ASSERT_MSG_EQ(workers.size(), serial.size(), "Wrong number of points");
+    for (uint32_t i = 0; i < serial.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(workers[i], serial[i], "Different SINR with workers, point " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(workersLoss, serialLoss, "Different losses drawn after the REM");
+}
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Radio Environment Map TestSuite
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+  public:
+    LteRadioEnvironmentMapTestSuite();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite()
+    : TestSuite("lte-radio-environment-map", Type::SYSTEM)
+{
+    AddTestCase(new LteRadioEnvironmentMapTestCase(false), TestCase::Duration::QUICK);
+    AddTestCase(new LteRadioEnvironmentMapTestCase(true), TestCase::Duration::QUICK);
+    AddTestCase(new LteRadioEnvironmentMapWorkersTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite;
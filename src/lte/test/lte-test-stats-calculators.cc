@@ -0,0 +1,307 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-stats-writer.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteStatsCalculatorsTest");
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Check that the MAC and PHY statistics calculators write the same rows
+ * to text files and to binary files, and that the IMSI of the UE is reported
+ * on both the eNB and the UE side.
+ */
+class LteStatsCalculatorsTestCase : public TestCase
+{
+  public:
+    LteStatsCalculatorsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// A table of statistics: its column names and its rows
+    struct Table
+    {
+        std::vector<std::string> columns;      ///< the names of the columns
+        std::vector<std::vector<double>> rows; ///< the rows
+    };
+
+    /**
+     * Run a simulation with the MAC and PHY traces enabled
+     * @param prefix the prefix of the names of the output files
+     * @param binary the `BinaryOutput` attribute
+     * @return the IMSI of the UE
+     */
+    uint64_t RunSimulation(const std::string& prefix, bool binary);
+
+    /**
+     * Read a text statistics file
+     * @param fileName the name of the file
+     * @return the table
+     */
+    Table ReadText(const std::string& fileName);
+
+    /**
+     * Read a binary statistics file
+     * @param fileName the name of the file
+     * @return the table
+     */
+    Table ReadBinary(const std::string& fileName);
+};
+
+LteStatsCalculatorsTestCase::LteStatsCalculatorsTestCase()
+    : TestCase("Check the text and the binary statistics files")
+{
+}
+
+uint64_t
+LteStatsCalculatorsTestCase::RunSimulation(const std::string& prefix, bool binary)
+{
+    Config::SetDefault("ns3::LteStatsCalculator::BinaryOutput", BooleanValue(binary));
+    Config::SetDefault("ns3::LteStatsCalculator::RowGroupSize", UintegerValue(7));
+    Config::SetDefault("ns3::MacStatsCalculator::DlOutputFilename",
+                       StringValue(prefix + "DlMacStats"));
+    Config::SetDefault("ns3::MacStatsCalculator::UlOutputFilename",
+                       StringValue(prefix + "UlMacStats"));
+    Config::SetDefault("ns3::PhyTxStatsCalculator::DlTxOutputFilename",
+                       StringValue(prefix + "DlTxPhyStats"));
+    Config::SetDefault("ns3::PhyTxStatsCalculator::UlTxOutputFilename",
+                       StringValue(prefix + "UlTxPhyStats"));
+    Config::SetDefault("ns3::PhyRxStatsCalculator::DlRxOutputFilename",
+                       StringValue(prefix + "DlRxPhyStats"));
+    Config::SetDefault("ns3::PhyRxStatsCalculator::UlRxOutputFilename",
+                       StringValue(prefix + "UlRxPhyStats"));
+    Config::SetDefault("ns3::PhyStatsCalculator::DlRsrpSinrFilename",
+                       StringValue(prefix + "DlRsrpSinrStats"));
+    Config::SetDefault("ns3::PhyStatsCalculator::UlSinrFilename",
+                       StringValue(prefix + "UlSinrStats"));
+    Config::SetDefault("ns3::PhyStatsCalculator::UlInterferenceFilename",
+                       StringValue(prefix + "UlInterferenceStats"));
+
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    NodeContainer enbNodes;
+    NodeContainer ueNodes;
+    enbNodes.Create(1);
+    ueNodes.Create(1);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(enbNodes);
+    mobility.Install(ueNodes);
+    ueNodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(300.0, 0.0, 1.5));
+
+    NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice(enbNodes);
+    NetDeviceContainer ueDevs = lteHelper->InstallUeDevice(ueNodes);
+    lteHelper->Attach(ueDevs, enbDevs.Get(0));
+    lteHelper->ActivateDataRadioBearer(ueDevs, EpsBearer(EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+    lteHelper->EnableMacTraces();
+    lteHelper->EnablePhyTraces();
+
+    Simulator::Stop(MilliSeconds(200));
+    Simulator::Run();
+    uint64_t imsi = ueDevs.Get(0)->GetObject<LteUeNetDevice>()->GetImsi();
+    Simulator::Destroy();
+    return imsi;
+}
+
+LteStatsCalculatorsTestCase::Table
+LteStatsCalculatorsTestCase::ReadText(const std::string& fileName)
+{
+    Table table;
+    std::ifstream is(fileName);
+    NS_TEST_EXPECT_MSG_EQ(is.is_open(), true, "Can't open " << fileName);
+    std::string line;
+    std::getline(is, line);
+    std::istringstream header(line.substr(line.find_first_not_of("% ")));
+    std::string column;
+    while (std::getline(header, column, '\t'))
+    {
+        table.columns.push_back(column);
+    }
+    while (std::getline(is, line))
+    {
+        std::istringstream values(line);
+        std::vector<double> row;
+        double value;
+        while (values >> value)
+        {
+            row.push_back(value);
+        }
+        table.rows.push_back(row);
+    }
+    return table;
+}
+
+LteStatsCalculatorsTestCase::Table
+LteStatsCalculatorsTestCase::ReadBinary(const std::string& fileName)
+{
+    Table table;
+    std::ifstream is(fileName, std::ios::in | std::ios::binary);
+    NS_TEST_EXPECT_MSG_EQ(is.is_open(), true, "Can't open " << fileName);
+    char magic[8];
+    uint32_t columnsNum = 0;
+    is.read(magic, sizeof(magic));
+    is.read(reinterpret_cast<char*>(&columnsNum), sizeof(columnsNum));
+    NS_TEST_EXPECT_MSG_EQ(std::memcmp(magic, "ns3lts01", sizeof(magic)), 0, "Wrong magic");
+    std::vector<uint8_t> types;
+    for (uint32_t i = 0; i < columnsNum; ++i)
+    {
+        uint8_t description[2];
+        is.read(reinterpret_cast<char*>(description), sizeof(description));
+        std::string name(description[1], ' ');
+        is.read(name.data(), name.size());
+        types.push_back(description[0]);
+        table.columns.push_back(name);
+    }
+
+    uint32_t rowsNum;
+    while (is.read(reinterpret_cast<char*>(&rowsNum), sizeof(rowsNum)))
+    {
+        std::size_t first = table.rows.size();
+        table.rows.resize(first + rowsNum, std::vector<double>(columnsNum));
+        for (uint32_t i = 0; i < columnsNum; ++i)
+        {
+            for (uint32_t j = 0; j < rowsNum; ++j)
+            {
+                double& value = table.rows[first + j][i];
+                switch (types[i])
+                {
+                case LteStatsWriter::UINT8: {
+                    uint8_t v;
+                    is.read(reinterpret_cast<char*>(&v), sizeof(v));
+                    value = v;
+                    break;
+                }
+                case LteStatsWriter::UINT16: {
+                    uint16_t v;
+                    is.read(reinterpret_cast<char*>(&v), sizeof(v));
+                    value = v;
+                    break;
+                }
+                case LteStatsWriter::UINT32: {
+                    uint32_t v;
+                    is.read(reinterpret_cast<char*>(&v), sizeof(v));
+                    value = v;
+                    break;
+                }
+                case LteStatsWriter::UINT64: {
+                    uint64_t v;
+                    is.read(reinterpret_cast<char*>(&v), sizeof(v));
+                    value = v;
+                    break;
+                }
+                case LteStatsWriter::INT64: {
+                    int64_t v;
+                    is.read(reinterpret_cast<char*>(&v), sizeof(v));
+                    value = v;
+                    break;
+                }
+                default:
+                    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+                    break;
+                }
+            }
+        }
+    }
+    return table;
+}
+
+void
+LteStatsCalculatorsTestCase::DoRun()
+{
+    std::string textPrefix = CreateTempDirFilename("text-");
+    std::string binaryPrefix = CreateTempDirFilename("binary-");
+    uint64_t textImsi = RunSimulation(textPrefix, false);
+    uint64_t binaryImsi = RunSimulation(binaryPrefix, true);
+    Config::Reset();
+    NS_TEST_ASSERT_MSG_EQ(textImsi, binaryImsi, "Different IMSIs in the two simulations");
+
+    for (const std::string fileName : {"DlMacStats",
+                                       "UlMacStats",
+                                       "DlTxPhyStats",
+                                       "UlTxPhyStats",
+                                       "DlRxPhyStats",
+                                       "UlRxPhyStats",
+                                       "DlRsrpSinrStats",
+                                       "UlSinrStats"})
+    {
+        Table text = ReadText(textPrefix + fileName);
+        Table binary = ReadBinary(binaryPrefix + fileName);
+        NS_TEST_ASSERT_MSG_EQ(text.columns.size(),
+                              binary.columns.size(),
+                              "Different columns in " << fileName);
+        NS_TEST_ASSERT_MSG_GT(text.rows.size(), 0, "No statistics in " << fileName);
+        NS_TEST_ASSERT_MSG_EQ(text.rows.size(),
+                              binary.rows.size(),
+                              "Different number of rows in " << fileName);
+        uint32_t imsiColumn = 0;
+        for (uint32_t i = 0; i < text.columns.size(); ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(text.columns[i],
+                                  binary.columns[i],
+                                  "Different columns in " << fileName);
+            if (text.columns[i] == "IMSI")
+            {
+                imsiColumn = i;
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(text.columns[imsiColumn], "IMSI", "No IMSI in " << fileName);
+
+        for (std::size_t j = 0; j < text.rows.size(); ++j)
+        {
+            NS_TEST_ASSERT_MSG_EQ(text.rows[j].size(),
+                                  text.columns.size(),
+                                  "Wrong row " << j << " in " << fileName);
+            NS_TEST_EXPECT_MSG_EQ(binary.rows[j][imsiColumn],
+                                  binaryImsi,
+                                  "Wrong IMSI in row " << j << " of " << fileName);
+            for (uint32_t i = 0; i < text.columns.size(); ++i)
+            {
+                // the text files have 6 significant digits
+                NS_TEST_EXPECT_MSG_EQ_TOL(binary.rows[j][i],
+                                          text.rows[j][i],
+                                          std::abs(text.rows[j][i]) * 1e-5,
+                                          "Different " << text.columns[i] << " in row " << j
+                                                       << " of " << fileName);
+            }
+        }
+    }
+}
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief LTE statistics calculators TestSuite
+ */
+class LteStatsCalculatorsTestSuite : public TestSuite
+{
+  public:
+    LteStatsCalculatorsTestSuite();
+};
+
+LteStatsCalculatorsTestSuite::LteStatsCalculatorsTestSuite()
+    : TestSuite("lte-stats-calculators", Type::SYSTEM)
+{
+    AddTestCase(new LteStatsCalculatorsTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static LteStatsCalculatorsTestSuite g_lteStatsCalculatorsTestSuite;
@@ -2572,3 +2572,139 @@ LteUeMeasurementsHandoverTestCase::RecvMeasurementReportCallback(
                           "The RSRP observed differs with the reference RSRP");
 
 } // end of void LteUeMeasurementsHandoverTestCase::RecvMeasurementReportCallback
+
+// ===== LTE-UE-MEASUREMENTS-TRACKED-CELLS TEST SUITE ====================== //
+
+/*
+ * Test Suite
+ */
+
+LteUeMeasurementsTrackedCellsTestSuite::LteUeMeasurementsTrackedCellsTestSuite()
+    : TestSuite("lte-ue-measurements-tracked-cells", Type::SYSTEM)
+{
+    AddTestCase(new LteUeMeasurementsTrackedCellsTestCase("All cells tracked",
+                                                          0,
+                                                          {2, 3, 4, 5, 6, 7}),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LteUeMeasurementsTrackedCellsTestCase("3 cells tracked", 3, {2, 3}),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LteUeMeasurementsTrackedCellsTestCase("5 cells tracked", 5, {2, 3, 4, 5}),
+                TestCase::Duration::QUICK);
+} // end of LteUeMeasurementsTrackedCellsTestSuite::LteUeMeasurementsTrackedCellsTestSuite
+
+/**
+ * @ingroup lte-test
+ * Static variable for test initialization
+ */
+static LteUeMeasurementsTrackedCellsTestSuite lteUeMeasurementsTrackedCellsTestSuite;
+
+/*
+ * Test Case
+ */
+
+LteUeMeasurementsTrackedCellsTestCase::LteUeMeasurementsTrackedCellsTestCase(
+    std::string name,
+    uint16_t maxTrackedCells,
+    std::set<uint16_t> expectedCellIds)
+    : TestCase(name),
+      m_maxTrackedCells(maxTrackedCells),
+      m_expectedCellIds(expectedCellIds),
+      m_expectedMeasId(std::numeric_limits<uint8_t>::max()),
+      m_reportsNum(0)
+{
+    NS_LOG_INFO(this << " name=" << name);
+}
+
+void
+LteUeMeasurementsTrackedCellsTestCase::DoRun()
+{
+    NS_LOG_INFO(this << " " << GetName());
+
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetAttribute("PathlossModel", StringValue("ns3::FriisSpectrumPropagationLossModel"));
+    lteHelper->SetAttribute("UseIdealRrc", BooleanValue(true));
+
+    NodeContainer enbNodes;
+    NodeContainer ueNodes;
+    enbNodes.Create(7);
+    ueNodes.Create(1);
+
+    // the serving eNodeB is the nearest, the neighbours are 100 m apart
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    for (uint32_t i = 1; i < enbNodes.GetN(); ++i)
+    {
+        positionAlloc->Add(Vector(100.0 + 100.0 * i, 0.0, 0.0));
+    }
+    positionAlloc->Add(Vector(50.0, 0.0, 0.0)); // UE
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.Install(enbNodes);
+    mobility.Install(ueNodes);
+
+    NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice(enbNodes);
+    NetDeviceContainer ueDevs = lteHelper->InstallUeDevice(ueNodes);
+    ueDevs.Get(0)->GetObject<LteUeNetDevice>()->GetRrc()->SetAttribute(
+        "MaxTrackedCells",
+        UintegerValue(m_maxTrackedCells));
+
+    // an event A4 fulfilled by all the neighbour cells
+    LteRrcSap::ReportConfigEutra config;
+    config.triggerType = LteRrcSap::ReportConfigEutra::EVENT;
+    config.eventId = LteRrcSap::ReportConfigEutra::EVENT_A4;
+    config.threshold1.choice = LteRrcSap::ThresholdEutra::THRESHOLD_RSRP;
+    config.threshold1.range = 0;
+    config.triggerQuantity = LteRrcSap::ReportConfigEutra::RSRP;
+    config.reportInterval = LteRrcSap::ReportConfigEutra::MS240;
+    Ptr<LteEnbRrc> enbRrc = enbDevs.Get(0)->GetObject<LteEnbNetDevice>()->GetRrc();
+    m_expectedMeasId = enbRrc->AddUeMeasReportConfig(config).at(0);
+
+    for (uint32_t i = 1; i < enbDevs.GetN(); ++i)
+    {
+        enbDevs.Get(i)->GetObject<LteEnbNetDevice>()->GetRrc()->SetAttribute(
+            "AdmitHandoverRequest",
+            BooleanValue(false));
+    }
+
+    lteHelper->Attach(ueDevs.Get(0), enbDevs.Get(0));
+    lteHelper->ActivateDataRadioBearer(ueDevs, EpsBearer(EpsBearer::GBR_CONV_VOICE));
+
+    Config::Connect(
+        "/NodeList/0/DeviceList/0/LteEnbRrc/RecvMeasurementReport",
+        MakeCallback(&LteUeMeasurementsTrackedCellsTestCase::RecvMeasurementReportCallback, this));
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(m_reportsNum, 0, "No measurement report received");
+
+} // end of void LteUeMeasurementsTrackedCellsTestCase::DoRun ()
+
+void
+LteUeMeasurementsTrackedCellsTestCase::RecvMeasurementReportCallback(
+    std::string context,
+    uint64_t imsi,
+    uint16_t cellId,
+    uint16_t rnti,
+    LteRrcSap::MeasurementReport report)
+{
+    NS_LOG_FUNCTION(this << context);
+
+    if (report.measResults.measId != m_expectedMeasId)
+    {
+        return;
+    }
+
+    std::set<uint16_t> cellIds;
+    for (const auto& measResultEutra : report.measResults.measResultListEutra)
+    {
+        cellIds.insert(measResultEutra.physCellId);
+    }
+    NS_TEST_ASSERT_MSG_EQ((cellIds == m_expectedCellIds),
+                          true,
+                          "Unexpected neighbour cells at " << Simulator::Now().As(Time::MS));
+    ++m_reportsNum;
+
+} // end of void LteUeMeasurementsTrackedCellsTestCase::RecvMeasurementReportCallback
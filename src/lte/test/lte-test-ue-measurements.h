@@ -661,4 +661,67 @@ class LteUeMeasurementsHandoverTestCase : public TestCase
 
 }; // end of class LteUeMeasurementsHandoverTestCase
 
+// ===== LTE-UE-MEASUREMENTS-TRACKED-CELLS TEST SUITE ====================== //
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Test suite for bounding the number of cells tracked by the UE.
+ */
+class LteUeMeasurementsTrackedCellsTestSuite : public TestSuite
+{
+  public:
+    LteUeMeasurementsTrackedCellsTestSuite();
+};
+
+/**
+ * @ingroup lte-test
+ *
+ * @brief Test that a UE which tracks a bounded number of cells reports the
+ *        strongest neighbour cells only.
+ *
+ * The UE is attached to an eNodeB and detects 6 neighbour cells placed at
+ * increasing distances. The serving eNodeB configures an event A4 which is
+ * fulfilled by all the neighbour cells. The test verifies that the neighbour
+ * cells of each report are the strongest tracked ones.
+ */
+class LteUeMeasurementsTrackedCellsTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Constructor
+     * @param name the reference name
+     * @param maxTrackedCells the MaxTrackedCells attribute of the UE RRC
+     * @param expectedCellIds the expected neighbour cells of the reports
+     */
+    LteUeMeasurementsTrackedCellsTestCase(std::string name,
+                                          uint16_t maxTrackedCells,
+                                          std::set<uint16_t> expectedCellIds);
+
+    /**
+     * @brief Triggers when the serving eNodeB receives a measurement report
+     *        from the UE, then verifies its neighbour cells.
+     *
+     * @param context the context
+     * @param imsi the IMSI
+     * @param cellId the cell ID
+     * @param rnti the RNTI
+     * @param report LteRrcSap::MeasurementReport
+     */
+    void RecvMeasurementReportCallback(std::string context,
+                                       uint64_t imsi,
+                                       uint16_t cellId,
+                                       uint16_t rnti,
+                                       LteRrcSap::MeasurementReport report);
+
+  private:
+    void DoRun() override;
+
+    uint16_t m_maxTrackedCells;           ///< the MaxTrackedCells attribute of the UE RRC
+    std::set<uint16_t> m_expectedCellIds; ///< the expected neighbour cells of the reports
+    uint8_t m_expectedMeasId;             ///< the measurement identity of the event A4
+    uint32_t m_reportsNum;                ///< the number of reports of the event A4
+
+}; // end of class LteUeMeasurementsTrackedCellsTestCase
+
 #endif /* LTE_TEST_UE_MEASUREMENTS_H */
@@ -348,6 +348,11 @@ RrcConnectionRequestTestCase::DoRun()
     // Log serialized packet contents
     TestUtils::LogPacketContents(packet);
 
+    // Check the encoding octet by octet
+    NS_TEST_ASSERT_MSG_EQ(TestUtils::sprintPacketContentsHex(packet),
+                          "48 3f ec af ec a6 \n",
+                          "Wrong encoding");
+
     // Remove header
     RrcConnectionRequestHeader destination;
     packet->RemoveHeader(destination);
@@ -401,6 +406,12 @@ RrcConnectionSetupTestCase::DoRun()
     // Log serialized packet contents
     TestUtils::LogPacketContents(packet);
 
+    // Check the encoding octet by octet
+    NS_TEST_ASSERT_MSG_EQ(TestUtils::sprintPacketContentsHex(packet),
+                          "7f 81 c8 ce 14 e0 b8 80 80 4d 98 "
+                          "46 10 84 28 1a 60 00 30 04 00 \n",
+                          "Wrong encoding");
+
     // remove header
     RrcConnectionSetupHeader destination;
     packet->RemoveHeader(destination);
@@ -1150,6 +1161,11 @@ MeasurementReportTestCase::DoRun()
     // Log serialized packet contents
     TestUtils::LogPacketContents(packet);
 
+    // Check the encoding octet by octet
+    NS_TEST_ASSERT_MSG_EQ(TestUtils::sprintPacketContentsHex(packet),
+                          "08 02 42 4a 82 09 00 e0 00 00 06 00 05 68 56 \n",
+                          "Wrong encoding");
+
     // remove header
     MeasurementReportHeader destination;
     packet->RemoveHeader(destination);
@@ -1004,5 +1004,40 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite()
                                                  2,
                                                  useIpv6),
                     TestCase::Duration::QUICK);
+
+        ///////////////////////////////////////////////
+        // check TFTs matching all packets of a direction
+        ///////////////////////////////////////////////
+
+        Ptr<EpcTftClassifier> c5 = Create<EpcTftClassifier>();
+        c5->Add(EpcTft::Default(), 1);
+        Ptr<EpcTft> tft5_2 = Create<EpcTft>();
+        EpcTft::PacketFilter pf5_2_1;
+        pf5_2_1.direction = EpcTft::UPLINK;
+        tft5_2->Add(pf5_2_1);
+        c5->Add(tft5_2, 2);
+
+        // --------------------------------classifier---direction--------src_addr---dst_addr---src_port--dst_port--ToS--TFT_id
+
+        AddTestCase(new EpcTftClassifierTestCase(c5,
+                                                 EpcTft::UPLINK,
+                                                 "9.1.1.1",
+                                                 "8.1.1.1",
+                                                 9,
+                                                 10,
+                                                 0,
+                                                 2,
+                                                 useIpv6),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new EpcTftClassifierTestCase(c5,
+                                                 EpcTft::DOWNLINK,
+                                                 "9.1.1.1",
+                                                 "8.1.1.1",
+                                                 9,
+                                                 10,
+                                                 0,
+                                                 1,
+                                                 useIpv6),
+                    TestCase::Duration::QUICK);
     }
 }
@@ -33,9 +33,14 @@
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
 #include <fstream>
 #include <map>
 #include <sstream>
+#include <string_view>
+#include <type_traits>
 
 namespace ns3
 {
@@ -93,19 +98,125 @@ struct DestinationPoint
     }
 };
 
+/**
+ * Reads the lines of a trace file in large blocks. The lines are returned
+ * as views on the internal buffer, hence they are not copied.
+ */
+class Ns2TraceFile
+{
+  public:
+    /**
+     * Open a trace file
+     * @param filename the name of the trace file
+     */
+    Ns2TraceFile(const std::string& filename);
+
+    /**
+     * Read the next line of the file. The line is valid until the next call.
+     * @param line the line, without the end of line character
+     * @return false if the end of the file has been reached
+     */
+    bool ReadLine(std::string_view& line);
+
+  private:
+    static constexpr std::size_t BLOCK_SIZE = 1 << 20; //!< the size of the blocks read
+
+    std::ifstream m_file;       //!< the trace file
+    std::vector<char> m_buffer; //!< the blocks read from the file
+    std::size_t m_begin;        //!< the start of the data not returned yet
+    std::size_t m_end;          //!< the end of the data read from the file
+};
+
+/**
+ * Schedules the movements read from a trace file.
+ *
+ * When the scheduled lines of the trace file are sorted by time, they are
+ * read a window of time ahead of the simulation: only the movements starting
+ * before the end of the window are scheduled, and an event reading the
+ * following lines is scheduled when the window moves past the time of the
+ * next line. Hence, the number of pending events and the memory used do not
+ * grow with the length of the trace.
+ */
+class Ns2MovementScheduler : public SimpleRefCount<Ns2MovementScheduler>
+{
+  public:
+    /**
+     * @param filename the name of the trace file
+     * @param lookAhead how far ahead of the simulation the lines are read;
+     *        Time::Max () to read the whole file at once
+     */
+    Ns2MovementScheduler(const std::string& filename, Time lookAhead);
+
+    /**
+     * Add a node found in the trace file
+     * @param id the node id
+     * @param model the mobility model of the node
+     * @param lastPos the initial position of the node, as set by the trace file
+     */
+    void AddNode(int id, Ptr<ConstantVelocityMobilityModel> model, const DestinationPoint& lastPos);
+
+    /**
+     * Schedule the movements of the first window, using the current time
+     * as the time origin of the trace
+     */
+    void Start();
+
+  private:
+    /**
+     * The state of a node while the trace file is read
+     */
+    struct NodeMovement
+    {
+        Ptr<ConstantVelocityMobilityModel> m_model; //!< the mobility model of the node
+        DestinationPoint m_lastPos;                 //!< the last movement scheduled
+        Vector m_position; //!< the position resulting from the scheduled set positions
+    };
+
+    /**
+     * Read and schedule the lines up to the end of the current window
+     */
+    void ReadWindow();
+
+    /**
+     * Check a scheduled line, logging its errors
+     * @param pr the parsed line
+     * @param line the line
+     * @param at the time of the line, if valid
+     * @return true if the line is valid
+     */
+    bool CheckLine(const ParseResult& pr, std::string_view line, double& at) const;
+
+    /**
+     * Schedule the movement of a line
+     * @param pr the parsed line
+     * @param line the line
+     * @param at the time of the line
+     */
+    void ScheduleLine(const ParseResult& pr, std::string_view line, double at);
+
+    Ns2TraceFile m_file;                 //!< the trace file
+    Time m_lookAhead;                    //!< how far ahead of the simulation lines are read
+    Time m_start;                        //!< the time origin of the trace
+    std::map<int, NodeMovement> m_nodes; //!< the nodes of the trace file
+    ParseResult m_nextLine;              //!< the first line after the current window
+    std::string m_nextText;              //!< the text of m_nextLine
+    double m_nextAt;                     //!< the time of m_nextLine
+    bool m_hasNextLine;                  //!< true if m_nextLine has been read
+};
+
 /**
  * Parses a line of ns2 mobility
  * @param str the string to parse
  * @returns The parsed line
  */
-static ParseResult ParseNs2Line(const std::string& str);
+static ParseResult ParseNs2Line(std::string_view str);
 
 /**
  * Put out blank spaces at the start and end of a line
  * @param str input line
  * @returns the line trimmed
  */
-static std::string TrimNs2Line(const std::string& str);
+static std::string_view TrimNs2Line(std::string_view str);
 
 /**
  * Checks if a string represents a number or it has others characters than digits and point.
@@ -128,7 +239,7 @@ static bool IsVal(const std::string& str, T& ret);
  * @param str string to check
  * @returns true if the string represents a nodeId number
  */
-static bool HasNodeIdNumber(std::string str);
+static bool HasNodeIdNumber(std::string_view str);
 
 /**
  * Gets nodeId number in string format from the string like $node_(4)
@@ -142,14 +253,14 @@ static std::string GetNodeIdFromToken(std::string str);
  * @param pr the ParseResult to analyze
  * @returns the node ID (as an int)
  */
-static int GetNodeIdInt(ParseResult pr);
+static int GetNodeIdInt(const ParseResult& pr);
 
 /**
  * Get node id number in string format
  * @param pr the ParseResult to analyze
  * @returns the node ID (as a string)
  */
-static std::string GetNodeIdString(ParseResult pr);
+static std::string GetNodeIdString(const ParseResult& pr);
 
 /**
  * Add one coord to a vector position
@@ -158,32 +269,33 @@ static std::string GetNodeIdString(ParseResult pr);
  * @param value value of the coordinate
  * @return The vector of the position
  */
-static Vector SetOneInitialCoord(Vector actPos, std::string& coord, double value);
+static Vector SetOneInitialCoord(Vector actPos, const std::string& coord, double value);
 
 /**
  * Check if this corresponds to a line like this: $node_(0) set X_ 123
  * @param pr the ParseResult to analyze
  * @returns true if the ParseResult looks like a coordinate without a scheduled time
  */
-static bool IsSetInitialPos(ParseResult pr);
+static bool IsSetInitialPos(const ParseResult& pr);
 
 /**
  * Check if this corresponds to a line like this: $ns_ at 1 "$node_(0) setdest 2 3 4"
  * @param pr the ParseResult to analyze
  * @returns true if the ParseResult looks like a coordinate with a scheduled time and destination
  */
-static bool IsSchedSetPos(ParseResult pr);
+static bool IsSchedSetPos(const ParseResult& pr);
 
 /**
  * Check if this corresponds to a line like this: $ns_ at 1 "$node_(0) set X_ 2"
  * @param pr the ParseResult to analyze
  * @returns true if the ParseResult looks like a coordinate with a scheduled time
  */
-static bool IsSchedMobilityPos(ParseResult pr);
+static bool IsSchedMobilityPos(const ParseResult& pr);
 
 /**
  * Set waypoints and speed for movement.
  * @param model mobility model
+ * @param start the time origin of the trace
  * @param lastPos last position
  * @param at initial movement time
  * @param xFinalPosition final position (X axis)
@@ -192,6 +304,7 @@ static bool IsSchedMobilityPos(ParseResult pr);
  * @returns A descriptor of the movement
  */
 static DestinationPoint SetMovement(Ptr<ConstantVelocityMobilityModel> model,
+                                    Time start,
                                     Vector lastPos,
                                     double at,
                                     double xFinalPosition,
@@ -212,18 +325,23 @@ static Vector SetInitialPosition(Ptr<ConstantVelocityMobilityModel> model,
 /**
  * Schedule a set of position for a node
  * @param model mobility model
+ * @param start the time origin of the trace
+ * @param position the position of the node before the scheduled set
  * @param at initial movement time
  * @param coord coordinate (x, y, or z)
  * @param coordVal value of the coordinate
  * @return The vector of the position at the given time
  */
 static Vector SetSchedPosition(Ptr<ConstantVelocityMobilityModel> model,
+                               Time start,
+                               Vector position,
                                double at,
-                               std::string coord,
+                               const std::string& coord,
                                double coordVal);
 
 Ns2MobilityHelper::Ns2MobilityHelper(std::string filename)
-    : m_filename(filename)
+    : m_filename(filename),
+      m_lookAhead(Seconds(10))
 {
     std::ifstream file(m_filename, std::ios::in);
     if (!(file.is_open()))
@@ -254,10 +372,20 @@ Ns2MobilityHelper::GetMobilityModel(std::string idString, const ObjectStore& sto
     return model;
 }
 
+void
+Ns2MobilityHelper::SetLookAhead(Time lookAhead)
+{
+    NS_ASSERT_MSG(lookAhead.IsStrictlyPositive(), "The look-ahead must be positive");
+    m_lookAhead = lookAhead;
+}
+
 void
 Ns2MobilityHelper::ConfigNodesMovements(const ObjectStore& store) const
 {
-    std::map<int, DestinationPoint> last_pos; // Stores previous movement scheduled for each node
+    std::map<int, DestinationPoint> last_pos; // Stores initial position set for each node
+    std::map<int, Ptr<ConstantVelocityMobilityModel>> models; // Mobility model of each node
+    bool sorted = true; // true if the scheduled lines are sorted by time
+    double lastAt = 0;
 
     //*****************************************************************
     // Parse the file the first time to get the initial node positions.
@@ -265,71 +393,65 @@ Ns2MobilityHelper::ConfigNodesMovements(const ObjectStore& store) const
 
     // Look through the whole the file for the the initial node
     // positions to make this helper robust to handle trace files with
-    // the initial node positions at the end.
-    std::ifstream file(m_filename, std::ios::in);
-    if (file.is_open())
+    // the initial node positions at the end. The mobility models of all
+    // the nodes are created now, rather than while the simulation runs.
+    Ns2TraceFile file(m_filename);
+    std::string_view line;
+    while (file.ReadLine(line))
     {
-        while (!file.eof())
+        // ignore empty lines
+        if (line.empty())
         {
-            int iNodeId = 0;
-            std::string nodeId;
-            std::string line;
-
-            getline(file, line);
-
-            // ignore empty lines
-            if (line.empty())
-            {
-                continue;
-            }
+            continue;
+        }
 
-            ParseResult pr = ParseNs2Line(line); // Parse line and obtain tokens
+        ParseResult pr = ParseNs2Line(line); // Parse line and obtain tokens
 
-            // Check if the line corresponds with setting the initial
-            // node positions
-            if (pr.tokens.size() != 4)
-            {
-                continue;
-            }
+        // The errors are logged when the scheduled lines are read
+        if (pr.tokens.size() != 4 && pr.tokens.size() != 7 && pr.tokens.size() != 8)
+        {
+            continue;
+        }
 
-            // Get the node Id
-            nodeId = GetNodeIdString(pr);
-            iNodeId = GetNodeIdInt(pr);
-            if (iNodeId == -1)
-            {
-                NS_LOG_ERROR("Node number couldn't be obtained (corrupted file?): " << line
-                                                                                    << "\n");
-                continue;
-            }
+        // Get the node Id
+        std::string nodeId = GetNodeIdString(pr);
+        int iNodeId = GetNodeIdInt(pr);
+        if (iNodeId == -1)
+        {
+            continue;
+        }
 
-            // get mobility model of node
-            Ptr<ConstantVelocityMobilityModel> model = GetMobilityModel(nodeId, store);
+        // get mobility model of node
+        Ptr<ConstantVelocityMobilityModel> model = GetMobilityModel(nodeId, store);
 
-            // if model not exists, continue
-            if (!model)
-            {
-                NS_LOG_ERROR("Unknown node ID (corrupted file?): " << nodeId << "\n");
-                continue;
-            }
+        // if model not exists, continue
+        if (!model)
+        {
+            continue;
+        }
+        models[iNodeId] = model;
 
-            /*
-             * In this case a initial position is being seted
-             * line like $node_(0) set X_ 151.05190721688197
-             */
-            if (IsSetInitialPos(pr))
-            {
-                DestinationPoint point;
-                //                                                    coord         coord value
-                point.m_finalPosition = SetInitialPosition(model, pr.tokens[2], pr.dvals[3]);
-                last_pos[iNodeId] = point;
-
-                // Log new position
-                NS_LOG_DEBUG("Positions after parse for node "
-                             << iNodeId << " " << nodeId
-                             << " position = " << last_pos[iNodeId].m_finalPosition);
-            }
+        /*
+         * In this case a initial position is being seted
+         * line like $node_(0) set X_ 151.05190721688197
+         */
+        if (IsSetInitialPos(pr))
+        {
+            DestinationPoint point;
+            //                                                    coord         coord value
+            point.m_finalPosition = SetInitialPosition(model, pr.tokens[2], pr.dvals[3]);
+            last_pos[iNodeId] = point;
+
+            // Log new position
+            NS_LOG_DEBUG("Positions after parse for node "
+                         << iNodeId << " " << nodeId
+                         << " position = " << last_pos[iNodeId].m_finalPosition);
+        }
+        else if (pr.tokens.size() != 4 && pr.has_dval[2])
+        {
+            sorted = sorted && pr.dvals[2] >= lastAt;
+            lastAt = std::max(lastAt, pr.dvals[2]);
         }
-        file.close();
     }
 
     //*****************************************************************
@@ -338,169 +460,266 @@ Ns2MobilityHelper::ConfigNodesMovements(const ObjectStore& store) const
 
     // The reason the file is parsed again is to make this helper robust
     // to handle trace files with the initial node positions at the end.
-    file.open(m_filename, std::ios::in);
-    if (file.is_open())
+    // If the scheduled lines are not sorted by time (e.g., the lines of
+    // each node are grouped together), they are all scheduled now.
+    if (!sorted)
     {
-        while (!file.eof())
-        {
-            int iNodeId = 0;
-            std::string nodeId;
-            std::string line;
+        NS_LOG_INFO("The trace file is not sorted by time, reading it at once");
+    }
+    Ptr<Ns2MovementScheduler> scheduler =
+        Create<Ns2MovementScheduler>(m_filename, sorted ? m_lookAhead : Time::Max());
+    for (const auto& [iNodeId, model] : models)
+    {
+        scheduler->AddNode(iNodeId, model, last_pos[iNodeId]);
+    }
+    scheduler->Start();
+}
 
-            getline(file, line);
+Ns2TraceFile::Ns2TraceFile(const std::string& filename)
+    : m_file(filename, std::ios::in | std::ios::binary),
+      m_buffer(BLOCK_SIZE),
+      m_begin(0),
+      m_end(0)
+{
+}
 
-            // ignore empty lines
-            if (line.empty())
+bool
+Ns2TraceFile::ReadLine(std::string_view& line)
+{
+    while (true)
+    {
+        const char* data = m_buffer.data();
+        const void* newline = std::memchr(data + m_begin, '\n', m_end - m_begin);
+        if (newline)
+        {
+            std::size_t end = static_cast<const char*>(newline) - data;
+            line = std::string_view(data + m_begin, end - m_begin);
+            m_begin = end + 1;
+            return true;
+        }
+        if (!m_file.good())
+        {
+            // the last line may have no end of line character
+            if (m_begin == m_end)
             {
-                continue;
+                return false;
             }
+            line = std::string_view(data + m_begin, m_end - m_begin);
+            m_begin = m_end;
+            return true;
+        }
+        // keep the partial line at the start of the buffer and read the next block
+        std::copy(m_buffer.begin() + m_begin, m_buffer.begin() + m_end, m_buffer.begin());
+        m_end -= m_begin;
+        m_begin = 0;
+        if (m_buffer.size() < m_end + BLOCK_SIZE)
+        {
+            m_buffer.resize(m_end + BLOCK_SIZE);
+        }
+        m_file.read(m_buffer.data() + m_end, BLOCK_SIZE);
+        m_end += m_file.gcount();
+    }
+}
 
-            ParseResult pr = ParseNs2Line(line); // Parse line and obtain tokens
-
-            // Check if the line corresponds with one of the three types of line
-            if (pr.tokens.size() != 4 && pr.tokens.size() != 7 && pr.tokens.size() != 8)
-            {
-                NS_LOG_ERROR("Line has not correct number of parameters (corrupted file?): "
-                             << line << "\n");
-                continue;
-            }
+Ns2MovementScheduler::Ns2MovementScheduler(const std::string& filename, Time lookAhead)
+    : m_file(filename),
+      m_lookAhead(lookAhead),
+      m_nextAt(0),
+      m_hasNextLine(false)
+{
+}
 
-            // Get the node Id
-            nodeId = GetNodeIdString(pr);
-            iNodeId = GetNodeIdInt(pr);
-            if (iNodeId == -1)
-            {
-                NS_LOG_ERROR("Node number couldn't be obtained (corrupted file?): " << line
-                                                                                    << "\n");
-                continue;
-            }
+void
+Ns2MovementScheduler::AddNode(int id,
+                              Ptr<ConstantVelocityMobilityModel> model,
+                              const DestinationPoint& lastPos)
+{
+    NodeMovement& node = m_nodes[id];
+    node.m_model = model;
+    node.m_lastPos = lastPos;
+    node.m_position = model->GetPosition();
+}
 
-            // get mobility model of node
-            Ptr<ConstantVelocityMobilityModel> model = GetMobilityModel(nodeId, store);
+void
+Ns2MovementScheduler::Start()
+{
+    m_start = Simulator::Now();
+    ReadWindow();
+}
 
-            // if model not exists, continue
-            if (!model)
-            {
-                NS_LOG_ERROR("Unknown node ID (corrupted file?): " << nodeId << "\n");
-                continue;
-            }
+void
+Ns2MovementScheduler::ReadWindow()
+{
+    Time end = m_lookAhead == Time::Max() ? Time::Max() : Simulator::Now() + m_lookAhead;
+    if (m_hasNextLine)
+    {
+        m_hasNextLine = false;
+        ScheduleLine(m_nextLine, m_nextText, m_nextAt);
+    }
 
-            /*
-             * In this case a initial position is being seted
-             * line like $node_(0) set X_ 151.05190721688197
-             */
-            if (IsSetInitialPos(pr))
-            {
-                // This is the second time this file has been parsed,
-                // and the initial node positions were already set the
-                // first time.  So, do nothing this time with this line.
-                continue;
-            }
+    std::string_view line;
+    while (m_file.ReadLine(line))
+    {
+        // ignore empty lines
+        if (line.empty())
+        {
+            continue;
+        }
 
-            else // NOW EVENTS TO BE SCHEDULED
-            {
-                // This is a scheduled event, so time at should be present
-                double at;
-
-                if (!IsNumber(pr.tokens[2]))
-                {
-                    NS_LOG_WARN("Time is not a number: " << pr.tokens[2]);
-                    continue;
-                }
-
-                at = pr.dvals[2]; // set time at
-
-                if (at < 0)
-                {
-                    NS_LOG_WARN("Time is less than cero: " << at);
-                    continue;
-                }
-
-                /*
-                 * In this case a new waypoint is added
-                 * line like $ns_ at 1 "$node_(0) setdest 2 3 4"
-                 */
-                if (IsSchedMobilityPos(pr))
-                {
-                    if (last_pos[iNodeId].m_targetArrivalTime > at)
-                    {
-                        NS_LOG_LOGIC("Did not reach a destination! stoptime = "
-                                     << last_pos[iNodeId].m_targetArrivalTime << ", at = " << at);
-                        double actuallytraveled = at - last_pos[iNodeId].m_travelStartTime;
-                        Vector reached = Vector(last_pos[iNodeId].m_startPosition.x +
-                                                    last_pos[iNodeId].m_speed.x * actuallytraveled,
-                                                last_pos[iNodeId].m_startPosition.y +
-                                                    last_pos[iNodeId].m_speed.y * actuallytraveled,
-                                                0);
-                        NS_LOG_LOGIC("Final point = " << last_pos[iNodeId].m_finalPosition
-                                                      << ", actually reached = " << reached);
-                        last_pos[iNodeId].m_stopEvent.Cancel();
-                        last_pos[iNodeId].m_finalPosition = reached;
-                    }
-                    //                                     last position     time  X coord     Y
-                    //                                     coord      velocity
-                    last_pos[iNodeId] = SetMovement(model,
-                                                    last_pos[iNodeId].m_finalPosition,
-                                                    at,
-                                                    pr.dvals[5],
-                                                    pr.dvals[6],
-                                                    pr.dvals[7]);
-
-                    // Log new position
-                    NS_LOG_DEBUG("Positions after parse for node "
-                                 << iNodeId << " " << nodeId
-                                 << " position =" << last_pos[iNodeId].m_finalPosition);
-                }
-
-                /*
-                 * Scheduled set position
-                 * line like $ns_ at 4.634906291962 "$node_(0) set X_ 28.675920486450"
-                 */
-                else if (IsSchedSetPos(pr))
-                {
-                    //                                         time  coordinate   coord value
-                    last_pos[iNodeId].m_finalPosition =
-                        SetSchedPosition(model, at, pr.tokens[5], pr.dvals[6]);
-                    if (last_pos[iNodeId].m_targetArrivalTime > at)
-                    {
-                        last_pos[iNodeId].m_stopEvent.Cancel();
-                    }
-                    last_pos[iNodeId].m_targetArrivalTime = at;
-                    last_pos[iNodeId].m_travelStartTime = at;
-                    // Log new position
-                    NS_LOG_DEBUG("Positions after parse for node "
-                                 << iNodeId << " " << nodeId
-                                 << " position =" << last_pos[iNodeId].m_finalPosition);
-                }
-                else
-                {
-                    NS_LOG_WARN("Format Line is not correct: " << line << "\n");
-                }
-            }
+        ParseResult pr = ParseNs2Line(line); // Parse line and obtain tokens
+        double at;
+        if (!CheckLine(pr, line, at))
+        {
+            continue;
         }
-        file.close();
+        if (m_start + Seconds(at) > end)
+        {
+            // read the line again when it enters the window
+            m_nextLine = std::move(pr);
+            m_nextText = line;
+            m_nextAt = at;
+            m_hasNextLine = true;
+            Simulator::Schedule(m_start + Seconds(at) - m_lookAhead - Simulator::Now(),
+                                &Ns2MovementScheduler::ReadWindow,
+                                Ptr<Ns2MovementScheduler>(this));
+            return;
+        }
+        ScheduleLine(pr, line, at);
     }
+    NS_LOG_LOGIC("End of the trace file");
 }
 
-ParseResult
-ParseNs2Line(const std::string& str)
+bool
+Ns2MovementScheduler::CheckLine(const ParseResult& pr, std::string_view line, double& at) const
 {
-    ParseResult ret;
-    std::istringstream s;
-    std::string line;
+    // Check if the line corresponds with one of the three types of line
+    if (pr.tokens.size() != 4 && pr.tokens.size() != 7 && pr.tokens.size() != 8)
+    {
+        NS_LOG_ERROR("Line has not correct number of parameters (corrupted file?): " << line
+                                                                                      << "\n");
+        return false;
+    }
 
-    // ignore comments (#)
-    size_t pos_sharp = str.find_first_of('#');
-    if (pos_sharp != std::string::npos)
+    // Get the node Id
+    int iNodeId = GetNodeIdInt(pr);
+    if (iNodeId == -1)
+    {
+        NS_LOG_ERROR("Node number couldn't be obtained (corrupted file?): " << line << "\n");
+        return false;
+    }
+
+    // if model not exists, continue
+    if (m_nodes.find(iNodeId) == m_nodes.end())
     {
-        line = str.substr(0, pos_sharp);
+        NS_LOG_ERROR("Unknown node ID (corrupted file?): " << GetNodeIdString(pr) << "\n");
+        return false;
+    }
+
+    /*
+     * In this case a initial position is being seted
+     * line like $node_(0) set X_ 151.05190721688197
+     */
+    if (IsSetInitialPos(pr))
+    {
+        // This is the second time this file has been parsed,
+        // and the initial node positions were already set the
+        // first time.  So, do nothing this time with this line.
+        return false;
+    }
+
+    // This is a scheduled event, so time at should be present
+    if (!IsNumber(pr.tokens[2]))
+    {
+        NS_LOG_WARN("Time is not a number: " << pr.tokens[2]);
+        return false;
+    }
+
+    at = pr.dvals[2]; // set time at
+
+    if (at < 0)
+    {
+        NS_LOG_WARN("Time is less than cero: " << at);
+        return false;
+    }
+    return true;
+}
+
+void
+Ns2MovementScheduler::ScheduleLine(const ParseResult& pr, std::string_view line, double at)
+{
+    int iNodeId = GetNodeIdInt(pr);
+    std::string nodeId = GetNodeIdString(pr);
+    NodeMovement& node = m_nodes[iNodeId];
+    DestinationPoint& lastPos = node.m_lastPos;
+
+    /*
+     * In this case a new waypoint is added
+     * line like $ns_ at 1 "$node_(0) setdest 2 3 4"
+     */
+    if (IsSchedMobilityPos(pr))
+    {
+        if (lastPos.m_targetArrivalTime > at)
+        {
+            NS_LOG_LOGIC("Did not reach a destination! stoptime = "
+                         << lastPos.m_targetArrivalTime << ", at = " << at);
+            double actuallytraveled = at - lastPos.m_travelStartTime;
+            Vector reached =
+                Vector(lastPos.m_startPosition.x + lastPos.m_speed.x * actuallytraveled,
+                       lastPos.m_startPosition.y + lastPos.m_speed.y * actuallytraveled,
+                       0);
+            NS_LOG_LOGIC("Final point = " << lastPos.m_finalPosition
+                                          << ", actually reached = " << reached);
+            lastPos.m_stopEvent.Cancel();
+            lastPos.m_finalPosition = reached;
+        }
+        //                                    last position     time  X coord     Y
+        //                                    coord      velocity
+        lastPos = SetMovement(node.m_model,
+                              m_start,
+                              lastPos.m_finalPosition,
+                              at,
+                              pr.dvals[5],
+                              pr.dvals[6],
+                              pr.dvals[7]);
+
+        // Log new position
+        NS_LOG_DEBUG("Positions after parse for node " << iNodeId << " " << nodeId
+                                                       << " position =" << lastPos.m_finalPosition);
+    }
+
+    /*
+     * Scheduled set position
+     * line like $ns_ at 4.634906291962 "$node_(0) set X_ 28.675920486450"
+     */
+    else if (IsSchedSetPos(pr))
+    {
+        //                                         time  coordinate   coord value
+        node.m_position =
+            SetSchedPosition(node.m_model, m_start, node.m_position, at, pr.tokens[5], pr.dvals[6]);
+        lastPos.m_finalPosition = node.m_position;
+        if (lastPos.m_targetArrivalTime > at)
+        {
+            lastPos.m_stopEvent.Cancel();
+        }
+        lastPos.m_targetArrivalTime = at;
+        lastPos.m_travelStartTime = at;
+        // Log new position
+        NS_LOG_DEBUG("Positions after parse for node " << iNodeId << " " << nodeId
+                                                       << " position =" << lastPos.m_finalPosition);
     }
     else
     {
-        line = str;
+        NS_LOG_WARN("Format Line is not correct: " << line << "\n");
     }
+}
 
-    line = TrimNs2Line(line);
+ParseResult
+ParseNs2Line(std::string_view str)
+{
+    ParseResult ret;
+
+    // ignore comments (#)
+    std::string_view line = TrimNs2Line(str.substr(0, str.find_first_of('#')));
 
     // If line hasn't a correct node Id
     if (!HasNodeIdNumber(line))
@@ -509,16 +728,19 @@ ParseNs2Line(const std::string& str)
         return ret;
     }
 
-    s.str(line);
-
-    while (!s.eof())
+    // split the line at the white spaces
+    std::size_t end = 0;
+    while (true)
     {
-        std::string x;
-        s >> x;
-        if (x.empty())
+        auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)); };
+        auto begin = std::find_if_not(line.begin() + end, line.end(), isSpace);
+        if (begin == line.end())
         {
-            continue;
+            break;
         }
+        auto tokenEnd = std::find_if(begin, line.end(), isSpace);
+        end = tokenEnd - line.begin();
+        std::string x(begin, tokenEnd);
         ret.tokens.push_back(x);
         int ii(0);
         double d(0);
@@ -578,19 +800,19 @@ ParseNs2Line(const std::string& str)
     return ret;
 }
 
-std::string
-TrimNs2Line(const std::string& s)
+std::string_view
+TrimNs2Line(std::string_view s)
 {
-    std::string ret = s;
+    std::string_view ret = s;
 
     while (!ret.empty() && isblank(ret[0]))
     {
-        ret.erase(0, 1); // Removes blank spaces at the beginning of the line
+        ret.remove_prefix(1); // Removes blank spaces at the beginning of the line
     }
 
     while (!ret.empty() && (isblank(ret[ret.size() - 1]) || (ret[ret.size() - 1] == ';')))
     {
-        ret.erase(ret.size() - 1, 1); // Removes blank spaces from at end of line
+        ret.remove_suffix(1); // Removes blank spaces from at end of line
     }
 
     return ret;
@@ -613,35 +835,43 @@ IsVal(const std::string& str, T& ret)
         return false;
     }
 
-    if (IsNumber(str))
+    // strtod and strtol read the same values as an input stream, much faster
+    char* endp;
+    double value = std::strtod(str.c_str(), &endp);
+    if (endp != str.c_str() + str.size())
+    {
+        return false;
+    }
+    if constexpr (std::is_integral_v<T>)
     {
-        std::istringstream s(str);
-        s >> ret;
-        return true;
+        // the integer part of the number, as an input stream reads it
+        long integer = std::strtol(str.c_str(), nullptr, 10);
+        ret = static_cast<T>(std::clamp<long>(integer, INT_MIN, INT_MAX));
     }
     else
     {
-        return false;
+        ret = value;
     }
+    return true;
 }
 
 bool
-HasNodeIdNumber(std::string str)
+HasNodeIdNumber(std::string_view str)
 {
     // find brackets
-    std::string::size_type startNodeId = str.find_first_of('('); // index of left bracket
-    std::string::size_type endNodeId = str.find_first_of(')');   // index of right bracket
+    std::string_view::size_type startNodeId = str.find_first_of('('); // index of left bracket
+    std::string_view::size_type endNodeId = str.find_first_of(')');   // index of right bracket
 
     // Get de nodeId in a string and in a int value
     std::string nodeId; // node id
 
     // if no brackets, continue!
-    if (startNodeId == std::string::npos || endNodeId == std::string::npos)
+    if (startNodeId == std::string_view::npos || endNodeId == std::string_view::npos)
     {
         return false;
     }
 
-    nodeId = str.substr(startNodeId + 1, endNodeId - (startNodeId + 1)); // set node id
+    nodeId = std::string(str.substr(startNodeId + 1, endNodeId - (startNodeId + 1))); // set node id
 
     //     is number           is integer                                        is not negative
     return IsNumber(nodeId) && nodeId.find_first_of('.') == std::string::npos && nodeId[0] != '-';
@@ -665,7 +895,7 @@ GetNodeIdFromToken(std::string str)
 }
 
 int
-GetNodeIdInt(ParseResult pr)
+GetNodeIdInt(const ParseResult& pr)
 {
     int result = -1;
     switch (pr.tokens.size())
@@ -685,7 +915,7 @@ GetNodeIdInt(ParseResult pr)
 
 // Get node id number in string format
 std::string
-GetNodeIdString(ParseResult pr)
+GetNodeIdString(const ParseResult& pr)
 {
     switch (pr.tokens.size())
     {
@@ -700,7 +930,7 @@ GetNodeIdString(ParseResult pr)
 }
 
 Vector
-SetOneInitialCoord(Vector position, std::string& coord, double value)
+SetOneInitialCoord(Vector position, const std::string& coord, double value)
 {
     // set the position for the coord.
     if (coord == NS2_X_COORD)
@@ -722,7 +952,7 @@ SetOneInitialCoord(Vector position, std::string& coord, double value)
 }
 
 bool
-IsSetInitialPos(ParseResult pr)
+IsSetInitialPos(const ParseResult& pr)
 {
     //        number of tokens         has $node_( ?                        has "set"           has
     //        double for position?
@@ -734,7 +964,7 @@ IsSetInitialPos(ParseResult pr)
 }
 
 bool
-IsSchedSetPos(ParseResult pr)
+IsSchedSetPos(const ParseResult& pr)
 {
     //      correct number of tokens,    has $ns_                   and at
     return pr.tokens.size() == 7 && pr.tokens[0] == NS2_NS_SCH && pr.tokens[1] == NS2_AT &&
@@ -746,7 +976,7 @@ IsSchedSetPos(ParseResult pr)
 }
 
 bool
-IsSchedMobilityPos(ParseResult pr)
+IsSchedMobilityPos(const ParseResult& pr)
 {
     //     number of tokens      and    has $ns_                and    has at
     return pr.tokens.size() == 8 && pr.tokens[0] == NS2_NS_SCH &&
@@ -758,6 +988,7 @@ IsSchedMobilityPos(ParseResult pr)
 
 DestinationPoint
 SetMovement(Ptr<ConstantVelocityMobilityModel> model,
+            Time start,
             Vector last_pos,
             double at,
             double xFinalPosition,
@@ -773,7 +1004,7 @@ SetMovement(Ptr<ConstantVelocityMobilityModel> model,
     if (speed == 0)
     {
         // We have to maintain last position, and stop the movement
-        retval.m_stopEvent = Simulator::Schedule(Seconds(at),
+        retval.m_stopEvent = Simulator::Schedule(start + Seconds(at) - Simulator::Now(),
                                                  &ConstantVelocityMobilityModel::SetVelocity,
                                                  model,
                                                  Vector(0, 0, 0));
@@ -801,11 +1032,11 @@ SetMovement(Ptr<ConstantVelocityMobilityModel> model,
         NS_LOG_DEBUG("Calculated Speed: X=" << xSpeed << " Y=" << ySpeed << " Z=" << zSpeed);
 
         // Set the Values
-        Simulator::Schedule(Seconds(at),
+        Simulator::Schedule(start + Seconds(at) - Simulator::Now(),
                             &ConstantVelocityMobilityModel::SetVelocity,
                             model,
                             Vector(xSpeed, ySpeed, zSpeed));
-        retval.m_stopEvent = Simulator::Schedule(Seconds(at + time),
+        retval.m_stopEvent = Simulator::Schedule(start + Seconds(at + time) - Simulator::Now(),
                                                  &ConstantVelocityMobilityModel::SetVelocity,
                                                  model,
                                                  Vector(0, 0, 0));
@@ -832,20 +1063,20 @@ SetInitialPosition(Ptr<ConstantVelocityMobilityModel> model, std::string coord,
 // Schedule a set of position for a node
 Vector
 SetSchedPosition(Ptr<ConstantVelocityMobilityModel> model,
+                 Time start,
+                 Vector position,
                  double at,
-                 std::string coord,
+                 const std::string& coord,
                  double coordVal)
 {
     // update position
-    model->SetPosition(SetOneInitialCoord(model->GetPosition(), coord, coordVal));
-
-    Vector position;
-    position.x = model->GetPosition().x;
-    position.y = model->GetPosition().y;
-    position.z = model->GetPosition().z;
+    position = SetOneInitialCoord(position, coord, coordVal);
 
     // Schedule next positions
-    Simulator::Schedule(Seconds(at), &ConstantVelocityMobilityModel::SetPosition, model, position);
+    Simulator::Schedule(start + Seconds(at) - Simulator::Now(),
+                        &ConstantVelocityMobilityModel::SetPosition,
+                        model,
+                        position);
 
     return position;
 }
@@ -11,6 +11,7 @@
 #ifndef NS2_MOBILITY_HELPER_H
 #define NS2_MOBILITY_HELPER_H
 
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
@@ -57,6 +58,14 @@ class ConstantVelocityMobilityModel;
  *  - SUMO http://sourceforge.net/apps/mediawiki/sumo/index.php?title=Main_Page
  *  - TraNS https://web.archive.org/web/20190512111856/http://lca.epfl.ch/projects/trans/
  *
+ * The initial positions are set when the helper is installed, and the
+ * scheduled statements are read while the simulation runs: when they are
+ * sorted by time, as the traces generated by the tools above, only the
+ * statements of the next look-ahead window (see SetLookAhead) are
+ * scheduled at any time, so that long traces of many nodes do not fill
+ * the event list and the memory. Traces which are not sorted by time are
+ * scheduled at once when the helper is installed.
+ *
  *  See usage example in examples/mobility/ns2-mobility-trace.cc
  *
  * @bug Rounding errors may cause movement to diverge from the mobility
@@ -80,6 +89,15 @@ class Ns2MobilityHelper
      */
     void Install() const;
 
+    /**
+     * Set how far ahead of the simulation the scheduled statements of a
+     * trace sorted by time are read. Time::Max () reads the whole trace
+     * when the helper is installed.
+     *
+     * @param lookAhead the look-ahead window, 10 seconds by default
+     */
+    void SetLookAhead(Time lookAhead);
+
     /**
      * @param begin an iterator which points to the start of the input
      *        object array.
@@ -127,6 +145,7 @@ class Ns2MobilityHelper
     Ptr<ConstantVelocityMobilityModel> GetMobilityModel(std::string idString,
                                                         const ObjectStore& store) const;
     std::string m_filename; //!< filename of file containing ns-2 mobility trace
+    Time m_lookAhead;       //!< how far ahead of the simulation the trace is read
 };
 
 } // namespace ns3
@@ -59,6 +59,13 @@ class ConstantVelocityHelper
      * @param vel Velocity vector
      */
     void SetVelocity(const Vector& vel);
+    /**
+     * Set new velocity vector at a given time, which may precede the current
+     * simulation time when a trajectory is computed lazily
+     * @param vel Velocity vector
+     * @param now the time at which the velocity changes
+     */
+    void SetVelocity(const Vector& vel, Time now);
     /**
      * Pause mobility at current position
      */
@@ -83,6 +90,27 @@ class ConstantVelocityHelper
      * Update position, if not paused, from last position and time of last update
      */
     void Update() const;
+    /**
+     * Update position, if not paused, from last position and time of last update
+     * up to a given time
+     * @param rectangle 2D bounding rectangle for resulting position; object will not move outside
+     * the rectangle
+     * @param now the time of the update
+     */
+    void UpdateWithBounds(const Rectangle& rectangle, Time now) const;
+    /**
+     * Update position, if not paused, from last position and time of last update
+     * up to a given time
+     * @param bounds 3D bounding box for resulting position; object will not move outside the box
+     * @param now the time of the update
+     */
+    void UpdateWithBounds(const Box& bounds, Time now) const;
+    /**
+     * Update position, if not paused, from last position and time of last update
+     * up to a given time
+     * @param now the time of the update
+     */
+    void Update(Time now) const;
 
   private:
     mutable Time m_lastUpdate; //!< time of last update
@@ -84,11 +84,12 @@ GaussMarkovMobilityModel::GetTypeId()
 }
 
 GaussMarkovMobilityModel::GaussMarkovMobilityModel()
+    : m_stepEnd(Time::Max())
 {
     m_meanVelocity = 0.0;
     m_meanDirection = 0.0;
     m_meanPitch = 0.0;
-    m_event = Simulator::ScheduleNow(&GaussMarkovMobilityModel::Start, this);
+    m_event = Simulator::ScheduleNow(&GaussMarkovMobilityModel::Start, this, Simulator::Now());
     m_helper.Unpause();
 }
 
@@ -98,7 +99,7 @@ GaussMarkovMobilityModel::~GaussMarkovMobilityModel()
 }
 
 void
-GaussMarkovMobilityModel::Start()
+GaussMarkovMobilityModel::Start(Time now)
 {
     if (m_meanVelocity == 0.0)
     {
@@ -116,9 +117,10 @@ GaussMarkovMobilityModel::Start()
         m_Pitch = m_meanPitch;
         // Set the velocity vector to give to the constant velocity helper
         m_helper.SetVelocity(
-            Vector(m_Velocity * cosD * cosP, m_Velocity * sinD * cosP, m_Velocity * sinP));
+            Vector(m_Velocity * cosD * cosP, m_Velocity * sinD * cosP, m_Velocity * sinP),
+            now);
     }
-    m_helper.Update();
+    m_helper.Update(now);
 
     // Get the next values from the gaussian distributions for velocity, direction, and pitch
     double rv = m_normalVelocity->GetValue();
@@ -142,17 +144,17 @@ GaussMarkovMobilityModel::Start()
     double vx = m_Velocity * cosDir * cosPit;
     double vy = m_Velocity * sinDir * cosPit;
     double vz = m_Velocity * sinPit;
-    m_helper.SetVelocity(Vector(vx, vy, vz));
+    m_helper.SetVelocity(Vector(vx, vy, vz), now);
 
     m_helper.Unpause();
 
-    DoWalk(m_timeStep);
+    DoWalk(m_timeStep, now);
 }
 
 void
-GaussMarkovMobilityModel::DoWalk(Time delayLeft)
+GaussMarkovMobilityModel::DoWalk(Time delayLeft, Time now)
 {
-    m_helper.UpdateWithBounds(m_bounds);
+    m_helper.UpdateWithBounds(m_bounds, now);
     Vector position = m_helper.GetCurrentPosition();
     Vector speed = m_helper.GetVelocity();
     Vector nextPosition = position;
@@ -169,7 +171,7 @@ GaussMarkovMobilityModel::DoWalk(Time delayLeft)
     // in bounds
     if (m_bounds.IsInside(nextPosition))
     {
-        m_event = Simulator::Schedule(delayLeft, &GaussMarkovMobilityModel::Start, this);
+        SetStepEnd(now + delayLeft);
     }
     else
     {
@@ -193,13 +195,43 @@ GaussMarkovMobilityModel::DoWalk(Time delayLeft)
 
         m_Direction = m_meanDirection;
         m_Pitch = m_meanPitch;
-        m_helper.SetVelocity(speed);
+        m_helper.SetVelocity(speed, now);
         m_helper.Unpause();
-        m_event = Simulator::Schedule(delayLeft, &GaussMarkovMobilityModel::Start, this);
+        SetStepEnd(now + delayLeft);
     }
     NotifyCourseChange();
 }
 
+void
+GaussMarkovMobilityModel::SetStepEnd(Time end)
+{
+    m_event.Cancel();
+    m_stepEnd = end;
+    // while catching up, the time step may end before the current time
+    if (HasCourseChangeListeners() && end >= Simulator::Now())
+    {
+        m_event =
+            Simulator::Schedule(end - Simulator::Now(), &GaussMarkovMobilityModel::EndStep, this);
+    }
+}
+
+void
+GaussMarkovMobilityModel::EndStep()
+{
+    Time end = m_stepEnd;
+    m_stepEnd = Time::Max();
+    Start(end);
+}
+
+void
+GaussMarkovMobilityModel::CatchUp() const
+{
+    while (!m_event.IsPending() && m_stepEnd <= Simulator::Now())
+    {
+        const_cast<GaussMarkovMobilityModel*>(this)->EndStep();
+    }
+}
+
 void
 GaussMarkovMobilityModel::DoDispose()
 {
@@ -210,6 +242,7 @@ GaussMarkovMobilityModel::DoDispose()
 Vector
 GaussMarkovMobilityModel::DoGetPosition() const
 {
+    CatchUp();
     m_helper.Update();
     return m_helper.GetCurrentPosition();
 }
@@ -219,15 +252,31 @@ GaussMarkovMobilityModel::DoSetPosition(const Vector& position)
 {
     m_helper.SetPosition(position);
     m_event.Cancel();
-    m_event = Simulator::ScheduleNow(&GaussMarkovMobilityModel::Start, this);
+    m_stepEnd = Time::Max();
+    m_event = Simulator::ScheduleNow(&GaussMarkovMobilityModel::Start, this, Simulator::Now());
 }
 
 Vector
 GaussMarkovMobilityModel::DoGetVelocity() const
 {
+    CatchUp();
     return m_helper.GetVelocity();
 }
 
+void
+GaussMarkovMobilityModel::DoConnectCourseChangeListener()
+{
+    // process the past time steps before the listener is connected, and schedule the end of
+    // the current one for the listener to be notified of it
+    CatchUp();
+    if (!m_event.IsPending() && m_stepEnd != Time::Max())
+    {
+        m_event = Simulator::Schedule(m_stepEnd - Simulator::Now(),
+                                      &GaussMarkovMobilityModel::EndStep,
+                                      this);
+    }
+}
+
 int64_t
 GaussMarkovMobilityModel::DoAssignStreams(int64_t stream)
 {
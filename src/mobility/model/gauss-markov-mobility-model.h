@@ -41,6 +41,10 @@ namespace ns3
  * The motion field is limited by a 3D bounding box (called "box") which is a 3D
  * version of the "rectangle" field that is used in 2-dimensional ns-3 mobility models.
  *
+ * The time steps are scheduled as events only when the CourseChange trace source
+ * is connected; otherwise, they are computed lazily when the position or the
+ * velocity of the object is queried, without changing the trajectory.
+ *
  * Here is an example of how to implement the model and set the initial node positions:
  * @code
     MobilityHelper mobility;
@@ -81,18 +85,38 @@ class GaussMarkovMobilityModel : public MobilityModel
   private:
     /**
      * Initialize the model and calculate new velocity, direction, and pitch
+     * @param now the time at which the new values are calculated
      */
-    void Start();
+    void Start(Time now);
     /**
      * Perform a walk operation
      * @param timeLeft time until Start method is called again
+     * @param now the time at which the walk starts
+     */
+    void DoWalk(Time timeLeft, Time now);
+    /**
+     * Set the end of the current time step. The end of the time step is
+     * scheduled as an event only if the CourseChange trace source is
+     * connected; otherwise, it is processed by the first position or velocity
+     * query following it.
+     * @param end the time at which the time step ends
+     */
+    void SetStepEnd(Time end);
+    /**
+     * End the current time step, starting the next one
+     */
+    void EndStep();
+    /**
+     * Process the time steps ended before the current time and not
+     * scheduled as events
      */
-    void DoWalk(Time timeLeft);
+    void CatchUp() const;
     void DoDispose() override;
     Vector DoGetPosition() const override;
     void DoSetPosition(const Vector& position) override;
     Vector DoGetVelocity() const override;
     int64_t DoAssignStreams(int64_t) override;
+    void DoConnectCourseChangeListener() override;
     ConstantVelocityHelper m_helper; //!< constant velocity helper
     Time m_timeStep;                 //!< duraiton after which direction and speed should change
     double m_alpha;                  //!< tunable constant in the model
@@ -109,6 +133,7 @@ class GaussMarkovMobilityModel : public MobilityModel
     Ptr<RandomVariableStream> m_rndMeanPitch;     //!< rv used to assign avg. pitch
     Ptr<NormalRandomVariable> m_normalPitch;      //!< Gaussian rv for next pitch
     EventId m_event;                              //!< event id of scheduled start
+    Time m_stepEnd;                               //!< end of the current time step
     Box m_bounds;                                 //!< bounding box
 };
 
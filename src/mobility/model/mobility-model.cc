@@ -17,6 +17,62 @@ namespace ns3
 
 NS_OBJECT_ENSURE_REGISTERED(MobilityModel);
 
+/**
+ * @ingroup mobility
+ *
+ * Accessor of the CourseChange trace source, giving the mobility model the
+ * opportunity to prepare for a new listener before it is connected.
+ */
+class MobilityModel::CourseChangeAccessor : public TraceSourceAccessor
+{
+  public:
+    bool ConnectWithoutContext(ObjectBase* obj, const CallbackBase& cb) const override
+    {
+        auto model = dynamic_cast<MobilityModel*>(obj);
+        if (model == nullptr)
+        {
+            return false;
+        }
+        model->DoConnectCourseChangeListener();
+        model->m_courseChangeTrace.ConnectWithoutContext(cb);
+        return true;
+    }
+
+    bool Connect(ObjectBase* obj, std::string context, const CallbackBase& cb) const override
+    {
+        auto model = dynamic_cast<MobilityModel*>(obj);
+        if (model == nullptr)
+        {
+            return false;
+        }
+        model->DoConnectCourseChangeListener();
+        model->m_courseChangeTrace.Connect(cb, context);
+        return true;
+    }
+
+    bool DisconnectWithoutContext(ObjectBase* obj, const CallbackBase& cb) const override
+    {
+        auto model = dynamic_cast<MobilityModel*>(obj);
+        if (model == nullptr)
+        {
+            return false;
+        }
+        model->m_courseChangeTrace.DisconnectWithoutContext(cb);
+        return true;
+    }
+
+    bool Disconnect(ObjectBase* obj, std::string context, const CallbackBase& cb) const override
+    {
+        auto model = dynamic_cast<MobilityModel*>(obj);
+        if (model == nullptr)
+        {
+            return false;
+        }
+        model->m_courseChangeTrace.Disconnect(cb, context);
+        return true;
+    }
+};
+
 TypeId
 MobilityModel::GetTypeId()
 {
@@ -39,7 +95,7 @@ MobilityModel::GetTypeId()
                           MakeVectorChecker())
             .AddTraceSource("CourseChange",
                             "The value of the position and/or velocity vector changed",
-                            MakeTraceSourceAccessor(&MobilityModel::m_courseChangeTrace),
+                            Create<MobilityModel::CourseChangeAccessor>(),
                             "ns3::MobilityModel::TracedCallback");
     return tid;
 }
@@ -103,6 +159,17 @@ MobilityModel::NotifyCourseChange() const
     m_courseChangeTrace(this);
 }
 
+bool
+MobilityModel::HasCourseChangeListeners() const
+{
+    return !m_courseChangeTrace.IsEmpty();
+}
+
+void
+MobilityModel::DoConnectCourseChangeListener()
+{
+}
+
 int64_t
 MobilityModel::AssignStreams(int64_t start)
 {
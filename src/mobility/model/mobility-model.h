@@ -93,6 +93,14 @@ class MobilityModel : public Object
      * position changes to notify course change listeners.
      */
     void NotifyCourseChange() const;
+    /**
+     * Subclasses computing their trajectory lazily may use this method to
+     * schedule the events changing their course only when somebody listens
+     * to the course changes.
+     *
+     * @return true if the CourseChange trace source is connected
+     */
+    bool HasCourseChangeListeners() const;
 
   private:
     /**
@@ -132,6 +140,16 @@ class MobilityModel : public Object
      * @return the number of streams used
      */
     virtual int64_t DoAssignStreams(int64_t start);
+    /**
+     * Invoked before a listener is connected to the CourseChange trace source.
+     *
+     * The default implementation does nothing.  Subclasses computing their
+     * trajectory lazily override this to schedule the next change of their
+     * course, which they do not schedule while nobody listens.
+     */
+    virtual void DoConnectCourseChangeListener();
+
+    class CourseChangeAccessor;
 
     /**
      * Used to alert subscribers that a change in direction, velocity,
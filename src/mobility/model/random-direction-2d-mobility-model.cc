@@ -49,6 +49,8 @@ RandomDirection2dMobilityModel::GetTypeId()
 }
 
 RandomDirection2dMobilityModel::RandomDirection2dMobilityModel()
+    : m_legEnd(Time::Max()),
+      m_legPause(false)
 {
     m_direction = CreateObject<UniformRandomVariable>();
 }
@@ -68,52 +70,49 @@ RandomDirection2dMobilityModel::DoDispose()
 void
 RandomDirection2dMobilityModel::DoInitialize()
 {
-    DoInitializePrivate();
+    DoInitializePrivate(Simulator::Now());
     MobilityModel::DoInitialize();
 }
 
 void
-RandomDirection2dMobilityModel::DoInitializePrivate()
+RandomDirection2dMobilityModel::DoInitializePrivate(Time now)
 {
     double direction = m_direction->GetValue(0, 2 * M_PI);
-    SetDirectionAndSpeed(direction);
+    SetDirectionAndSpeed(direction, now);
 }
 
 void
-RandomDirection2dMobilityModel::BeginPause()
+RandomDirection2dMobilityModel::BeginPause(Time now)
 {
-    m_helper.Update();
+    m_helper.Update(now);
     m_helper.Pause();
     Time pause = Seconds(m_pause->GetValue());
-    m_event.Cancel();
-    m_event =
-        Simulator::Schedule(pause, &RandomDirection2dMobilityModel::ResetDirectionAndSpeed, this);
+    SetLegEnd(now + pause, false);
     NotifyCourseChange();
 }
 
 void
-RandomDirection2dMobilityModel::SetDirectionAndSpeed(double direction)
+RandomDirection2dMobilityModel::SetDirectionAndSpeed(double direction, Time now)
 {
-    NS_LOG_FUNCTION_NOARGS();
-    m_helper.UpdateWithBounds(m_bounds);
+    NS_LOG_FUNCTION(this << direction << now.As(Time::S));
+    m_helper.UpdateWithBounds(m_bounds, now);
     Vector position = m_helper.GetCurrentPosition();
     double speed = m_speed->GetValue();
     const Vector vector(std::cos(direction) * speed, std::sin(direction) * speed, 0.0);
-    m_helper.SetVelocity(vector);
+    m_helper.SetVelocity(vector, now);
     m_helper.Unpause();
     Vector next = m_bounds.CalculateIntersection(position, vector);
     Time delay = Seconds(CalculateDistance(position, next) / speed);
-    m_event.Cancel();
-    m_event = Simulator::Schedule(delay, &RandomDirection2dMobilityModel::BeginPause, this);
+    SetLegEnd(now + delay, true);
     NotifyCourseChange();
 }
 
 void
-RandomDirection2dMobilityModel::ResetDirectionAndSpeed()
+RandomDirection2dMobilityModel::ResetDirectionAndSpeed(Time now)
 {
     double direction = 0;
 
-    m_helper.UpdateWithBounds(m_bounds);
+    m_helper.UpdateWithBounds(m_bounds, now);
     Vector position = m_helper.GetCurrentPosition();
     switch (m_bounds.GetClosestSideOrCorner(position))
     {
@@ -143,12 +142,54 @@ RandomDirection2dMobilityModel::ResetDirectionAndSpeed()
         direction = m_direction->GetValue(M_PI_2, M_PI);
         break;
     }
-    SetDirectionAndSpeed(direction);
+    SetDirectionAndSpeed(direction, now);
+}
+
+void
+RandomDirection2dMobilityModel::SetLegEnd(Time end, bool pause)
+{
+    NS_LOG_FUNCTION(this << end.As(Time::S) << pause);
+    m_event.Cancel();
+    m_legEnd = end;
+    m_legPause = pause;
+    // while catching up, the leg may end before the current time
+    if (HasCourseChangeListeners() && end >= Simulator::Now())
+    {
+        m_event = Simulator::Schedule(end - Simulator::Now(),
+                                      &RandomDirection2dMobilityModel::EndLeg,
+                                      this);
+    }
+}
+
+void
+RandomDirection2dMobilityModel::EndLeg()
+{
+    NS_LOG_FUNCTION(this);
+    Time end = m_legEnd;
+    m_legEnd = Time::Max();
+    if (m_legPause)
+    {
+        BeginPause(end);
+    }
+    else
+    {
+        ResetDirectionAndSpeed(end);
+    }
+}
+
+void
+RandomDirection2dMobilityModel::CatchUp() const
+{
+    while (!m_event.IsPending() && m_legEnd <= Simulator::Now())
+    {
+        const_cast<RandomDirection2dMobilityModel*>(this)->EndLeg();
+    }
 }
 
 Vector
 RandomDirection2dMobilityModel::DoGetPosition() const
 {
+    CatchUp();
     m_helper.UpdateWithBounds(m_bounds);
     return m_helper.GetCurrentPosition();
 }
@@ -158,15 +199,34 @@ RandomDirection2dMobilityModel::DoSetPosition(const Vector& position)
 {
     m_helper.SetPosition(position);
     m_event.Cancel();
-    m_event = Simulator::ScheduleNow(&RandomDirection2dMobilityModel::DoInitializePrivate, this);
+    m_legEnd = Time::Max();
+    m_event = Simulator::ScheduleNow(&RandomDirection2dMobilityModel::DoInitializePrivate,
+                                     this,
+                                     Simulator::Now());
 }
 
 Vector
 RandomDirection2dMobilityModel::DoGetVelocity() const
 {
+    CatchUp();
     return m_helper.GetVelocity();
 }
 
+void
+RandomDirection2dMobilityModel::DoConnectCourseChangeListener()
+{
+    NS_LOG_FUNCTION(this);
+    // process the past legs before the listener is connected, and schedule the end of
+    // the current one for the listener to be notified of it
+    CatchUp();
+    if (!m_event.IsPending() && m_legEnd != Time::Max())
+    {
+        m_event = Simulator::Schedule(m_legEnd - Simulator::Now(),
+                                      &RandomDirection2dMobilityModel::EndLeg,
+                                      this);
+    }
+}
+
 int64_t
 RandomDirection2dMobilityModel::DoAssignStreams(int64_t stream)
 {
@@ -30,6 +30,11 @@ namespace ns3
  * then travels in the specific direction until it reaches one of
  * the boundaries of the model. When it reaches the boundary, it pauses,
  * and selects a new direction and speed.
+ *
+ * The ends of the movements and of the pauses are scheduled as events only
+ * when the CourseChange trace source is connected; otherwise, they are
+ * computed lazily when the position or the velocity of the object is
+ * queried, without changing the trajectory.
  */
 class RandomDirection2dMobilityModel : public MobilityModel
 {
@@ -45,27 +50,50 @@ class RandomDirection2dMobilityModel : public MobilityModel
   private:
     /**
      * Set a new direction and speed
+     * @param now the time at which the pause ends
      */
-    void ResetDirectionAndSpeed();
+    void ResetDirectionAndSpeed(Time now);
     /**
-     * Pause, cancel currently scheduled event, schedule end of pause event
+     * Pause, and set the end of the pause
+     * @param now the time at which the pause begins
      */
-    void BeginPause();
+    void BeginPause(Time now);
     /**
-     * Set new velocity and direction, and schedule next pause event
+     * Set new velocity and direction, and set the beginning of the next pause
      * @param direction (radians)
+     * @param now the time at which the velocity changes
      */
-    void SetDirectionAndSpeed(double direction);
+    void SetDirectionAndSpeed(double direction, Time now);
     /**
      * Sets a new random direction and calls SetDirectionAndSpeed
+     * @param now the time at which the direction is set
+     */
+    void DoInitializePrivate(Time now);
+    /**
+     * Set the end of the current leg of the trajectory. The end of the leg is
+     * scheduled as an event only if the CourseChange trace source is
+     * connected; otherwise, it is processed by the first position or velocity
+     * query following it.
+     * @param end the time at which the leg ends
+     * @param pause true if a pause begins at the end of the leg, false if it ends
+     */
+    void SetLegEnd(Time end, bool pause);
+    /**
+     * End the current leg of the trajectory, starting the next one
+     */
+    void EndLeg();
+    /**
+     * Process the legs of the trajectory ended before the current time
+     * and not scheduled as events
      */
-    void DoInitializePrivate();
+    void CatchUp() const;
     void DoDispose() override;
     void DoInitialize() override;
     Vector DoGetPosition() const override;
     void DoSetPosition(const Vector& position) override;
     Vector DoGetVelocity() const override;
     int64_t DoAssignStreams(int64_t) override;
+    void DoConnectCourseChangeListener() override;
 
     Ptr<UniformRandomVariable> m_direction; //!< rv to control direction
     Rectangle m_bounds;                     //!< the 2D bounding area
@@ -73,6 +101,8 @@ class RandomDirection2dMobilityModel : public MobilityModel
     Ptr<RandomVariableStream> m_pause;      //!< a random variable to control pause
     EventId m_event;                        //!< event ID of next scheduled event
     ConstantVelocityHelper m_helper;        //!< helper for velocity computations
+    Time m_legEnd;                          //!< end of the current leg of the trajectory
+    bool m_legPause;                        //!< whether a pause begins at the end of the leg
 };
 
 } // namespace ns3
@@ -69,6 +69,12 @@ RandomWalk2dMobilityModel::GetTypeId()
     return tid;
 }
 
+RandomWalk2dMobilityModel::RandomWalk2dMobilityModel()
+    : m_legEnd(Time::Max()),
+      m_legRebound(false)
+{
+}
+
 RandomWalk2dMobilityModel::~RandomWalk2dMobilityModel()
 {
     m_event.Cancel();
@@ -78,16 +84,16 @@ void
 RandomWalk2dMobilityModel::DoInitialize()
 {
     NS_LOG_FUNCTION(this);
-    DrawRandomVelocityAndDistance();
+    DrawRandomVelocityAndDistance(Simulator::Now());
     MobilityModel::DoInitialize();
 }
 
 // Set new velocity and distance to travel, and call DoWalk() to initiate movement
 void
-RandomWalk2dMobilityModel::DrawRandomVelocityAndDistance()
+RandomWalk2dMobilityModel::DrawRandomVelocityAndDistance(Time now)
 {
-    NS_LOG_FUNCTION(this);
-    m_helper.Update();
+    NS_LOG_FUNCTION(this << now.As(Time::S));
+    m_helper.Update(now);
     Vector position = m_helper.GetCurrentPosition();
 
     double speed = m_speed->GetValue();
@@ -128,7 +134,7 @@ RandomWalk2dMobilityModel::DrawRandomVelocityAndDistance()
         }
     }
     NS_LOG_INFO("Setting new velocity to " << velocity);
-    m_helper.SetVelocity(velocity);
+    m_helper.SetVelocity(velocity, now);
     m_helper.Unpause();
 
     Time delayLeft;
@@ -141,26 +147,23 @@ RandomWalk2dMobilityModel::DrawRandomVelocityAndDistance()
         delayLeft = Seconds(m_modeDistance / speed);
     }
     NS_LOG_INFO("Setting delayLeft for DoWalk() to " << delayLeft.As(Time::S));
-    DoWalk(delayLeft);
+    DoWalk(delayLeft, now);
 }
 
-// Notify course change and schedule event for either a wall rebound or a new velocity
+// Notify course change and set the end of the leg to either a wall rebound or a new velocity
 void
-RandomWalk2dMobilityModel::DoWalk(Time delayLeft)
+RandomWalk2dMobilityModel::DoWalk(Time delayLeft, Time now)
 {
-    NS_LOG_FUNCTION(this << delayLeft.As(Time::S));
+    NS_LOG_FUNCTION(this << delayLeft.As(Time::S) << now.As(Time::S));
     Vector position = m_helper.GetCurrentPosition();
     Vector velocity = m_helper.GetVelocity();
     Vector nextPosition = position;
     nextPosition.x += velocity.x * delayLeft.GetSeconds();
     nextPosition.y += velocity.y * delayLeft.GetSeconds();
-    m_event.Cancel();
     if (m_bounds.IsInside(nextPosition))
     {
-        NS_LOG_INFO("Scheduling new velocity in " << delayLeft.As(Time::S));
-        m_event = Simulator::Schedule(delayLeft,
-                                      &RandomWalk2dMobilityModel::DrawRandomVelocityAndDistance,
-                                      this);
+        NS_LOG_INFO("Setting new velocity in " << delayLeft.As(Time::S));
+        SetLegEnd(now + delayLeft, false, Time(0));
     }
     else
     {
@@ -182,21 +185,18 @@ RandomWalk2dMobilityModel::DoWalk(Time delayLeft)
                          "(the node is stationary).");
         }
         Time delay = Seconds(delaySeconds);
-        NS_LOG_INFO("Scheduling a rebound event in " << (delayLeft - delay).As(Time::S));
-        m_event = Simulator::Schedule(delay,
-                                      &RandomWalk2dMobilityModel::Rebound,
-                                      this,
-                                      delayLeft - delay);
+        NS_LOG_INFO("Setting a rebound in " << delay.As(Time::S));
+        SetLegEnd(now + delay, true, delayLeft - delay);
     }
     NotifyCourseChange();
 }
 
 // Set a velocity from the previous velocity, and start motion with remaining time
 void
-RandomWalk2dMobilityModel::Rebound(Time delayLeft)
+RandomWalk2dMobilityModel::Rebound(Time delayLeft, Time now)
 {
-    NS_LOG_FUNCTION(this << delayLeft.As(Time::S));
-    m_helper.UpdateWithBounds(m_bounds);
+    NS_LOG_FUNCTION(this << delayLeft.As(Time::S) << now.As(Time::S));
+    m_helper.UpdateWithBounds(m_bounds, now);
     Vector position = m_helper.GetCurrentPosition();
     Vector velocity = m_helper.GetVelocity();
     switch (m_bounds.GetClosestSideOrCorner(position))
@@ -217,10 +217,51 @@ RandomWalk2dMobilityModel::Rebound(Time delayLeft)
         velocity.y = -velocity.y;
         break;
     }
-    m_helper.SetVelocity(velocity);
+    m_helper.SetVelocity(velocity, now);
     m_helper.Unpause();
     NS_LOG_INFO("Rebounding with new velocity " << velocity);
-    DoWalk(delayLeft);
+    DoWalk(delayLeft, now);
+}
+
+void
+RandomWalk2dMobilityModel::SetLegEnd(Time end, bool rebound, Time timeLeft)
+{
+    NS_LOG_FUNCTION(this << end.As(Time::S) << rebound << timeLeft.As(Time::S));
+    m_event.Cancel();
+    m_legEnd = end;
+    m_legRebound = rebound;
+    m_legTimeLeft = timeLeft;
+    // while catching up, the leg may end before the current time
+    if (HasCourseChangeListeners() && end >= Simulator::Now())
+    {
+        m_event =
+            Simulator::Schedule(end - Simulator::Now(), &RandomWalk2dMobilityModel::EndLeg, this);
+    }
+}
+
+void
+RandomWalk2dMobilityModel::EndLeg()
+{
+    NS_LOG_FUNCTION(this);
+    Time end = m_legEnd;
+    m_legEnd = Time::Max();
+    if (m_legRebound)
+    {
+        Rebound(m_legTimeLeft, end);
+    }
+    else
+    {
+        DrawRandomVelocityAndDistance(end);
+    }
+}
+
+void
+RandomWalk2dMobilityModel::CatchUp() const
+{
+    while (!m_event.IsPending() && m_legEnd <= Simulator::Now())
+    {
+        const_cast<RandomWalk2dMobilityModel*>(this)->EndLeg();
+    }
 }
 
 void
@@ -234,6 +275,7 @@ RandomWalk2dMobilityModel::DoDispose()
 Vector
 RandomWalk2dMobilityModel::DoGetPosition() const
 {
+    CatchUp();
     m_helper.UpdateWithBounds(m_bounds);
     return m_helper.GetCurrentPosition();
 }
@@ -245,16 +287,34 @@ RandomWalk2dMobilityModel::DoSetPosition(const Vector& position)
     NS_ASSERT(m_bounds.IsInside(position));
     m_helper.SetPosition(position);
     m_event.Cancel();
-    m_event =
-        Simulator::ScheduleNow(&RandomWalk2dMobilityModel::DrawRandomVelocityAndDistance, this);
+    m_legEnd = Time::Max();
+    m_event = Simulator::ScheduleNow(&RandomWalk2dMobilityModel::DrawRandomVelocityAndDistance,
+                                     this,
+                                     Simulator::Now());
 }
 
 Vector
 RandomWalk2dMobilityModel::DoGetVelocity() const
 {
+    CatchUp();
     return m_helper.GetVelocity();
 }
 
+void
+RandomWalk2dMobilityModel::DoConnectCourseChangeListener()
+{
+    NS_LOG_FUNCTION(this);
+    // process the past legs before the listener is connected, and schedule the end of
+    // the current one for the listener to be notified of it
+    CatchUp();
+    if (!m_event.IsPending() && m_legEnd != Time::Max())
+    {
+        m_event = Simulator::Schedule(m_legEnd - Simulator::Now(),
+                                      &RandomWalk2dMobilityModel::EndLeg,
+                                      this);
+    }
+}
+
 int64_t
 RandomWalk2dMobilityModel::DoAssignStreams(int64_t stream)
 {
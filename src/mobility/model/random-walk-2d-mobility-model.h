@@ -36,6 +36,14 @@ namespace ns3
  * inside the boundaries. The points on the boundary have their
  * direction chosen randomly, without considering the Direction
  * Attribute.
+ *
+ * The trajectory is made of legs with constant velocity. The end of
+ * each leg is scheduled as an event only when the CourseChange trace
+ * source is connected; otherwise, the legs are computed lazily when
+ * the position or the velocity of the node is queried, so that idle
+ * nodes do not add events to the simulator. In both cases the
+ * trajectory is the same. When a CourseChange listener is connected
+ * while the node is moving, the end of the current leg is scheduled.
  */
 class RandomWalk2dMobilityModel : public MobilityModel
 {
@@ -46,6 +54,7 @@ class RandomWalk2dMobilityModel : public MobilityModel
      */
     static TypeId GetTypeId();
 
+    RandomWalk2dMobilityModel();
     ~RandomWalk2dMobilityModel() override;
 
     /** An enum representing the different working modes of this module. */
@@ -59,24 +68,47 @@ class RandomWalk2dMobilityModel : public MobilityModel
     /**
      * @brief Performs the rebound of the node if it reaches a boundary
      * @param timeLeft The remaining time of the walk
+     * @param now The time of the rebound
      */
-    void Rebound(Time timeLeft);
+    void Rebound(Time timeLeft, Time now);
     /**
      * Walk according to position and velocity, until distance is reached,
      * time is reached, or intersection with the bounding box
      * @param timeLeft The remaining time of the walk
+     * @param now The time at which the walk starts
      */
-    void DoWalk(Time timeLeft);
+    void DoWalk(Time timeLeft, Time now);
     /**
      * Draw a new random velocity and distance to travel, and call DoWalk()
+     * @param now The time at which the new velocity is drawn
+     */
+    void DrawRandomVelocityAndDistance(Time now);
+    /**
+     * Set the end of the current leg of the trajectory. The end of the leg is
+     * scheduled as an event only if the CourseChange trace source is
+     * connected; otherwise, it is processed by the first position or velocity
+     * query following it.
+     * @param end The time at which the leg ends
+     * @param rebound True if the leg ends with a rebound on the boundary
+     * @param timeLeft The remaining time of the walk after the rebound
+     */
+    void SetLegEnd(Time end, bool rebound, Time timeLeft);
+    /**
+     * End the current leg of the trajectory, starting the next one
+     */
+    void EndLeg();
+    /**
+     * Process the legs of the trajectory ended before the current time
+     * and not scheduled as events
      */
-    void DrawRandomVelocityAndDistance();
+    void CatchUp() const;
     void DoDispose() override;
     void DoInitialize() override;
     Vector DoGetPosition() const override;
     void DoSetPosition(const Vector& position) override;
     Vector DoGetVelocity() const override;
     int64_t DoAssignStreams(int64_t) override;
+    void DoConnectCourseChangeListener() override;
 
     ConstantVelocityHelper m_helper;       //!< helper for this object
     EventId m_event;                       //!< stored event ID
@@ -86,6 +118,9 @@ class RandomWalk2dMobilityModel : public MobilityModel
     Ptr<RandomVariableStream> m_speed;     //!< rv for picking speed
     Ptr<RandomVariableStream> m_direction; //!< rv for picking direction
     Rectangle m_bounds;                    //!< Bounds of the area to cruise
+    Time m_legEnd;                         //!< End of the current leg of the trajectory
+    bool m_legRebound;                     //!< Whether the current leg ends with a rebound
+    Time m_legTimeLeft;                    //!< Remaining time of the walk after the rebound
 };
 
 } // namespace ns3
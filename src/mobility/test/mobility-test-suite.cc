@@ -14,12 +14,17 @@
 #include "ns3/boolean.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/mobility-model.h"
+#include "ns3/object-factory.h"
+#include "ns3/rectangle.h"
 #include "ns3/scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/vector.h"
 #include "ns3/waypoint-mobility-model.h"
 
+#include <algorithm>
+
 using namespace ns3;
 
 /**
@@ -461,6 +466,156 @@ WaypointMobilityModelViaHelper::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Test that the mobility models computing their trajectory lazily
+ * follow the same trajectory whether or not the CourseChange trace source is
+ * connected, that they do not schedule events when it is not, and that a
+ * listener connected while the node is moving is notified of the following
+ * course changes
+ */
+class LazyTrajectoryTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param factory the factory of the mobility model
+     * @param position the initial position
+     * @param minCourseChanges the minimum number of course changes in 100 seconds
+     */
+    LazyTrajectoryTest(ObjectFactory factory, Vector position, uint32_t minCourseChanges);
+
+  private:
+    /**
+     * Create a mobility model
+     * @return the mobility model, at the initial position
+     */
+    Ptr<MobilityModel> CreateModel() const;
+    /**
+     * Check that two mobility models have the same position and velocity
+     * @param eager the mobility model notifying its course changes
+     * @param lazy the mobility model computing its trajectory lazily
+     */
+    void TestPositions(Ptr<MobilityModel> eager, Ptr<MobilityModel> lazy);
+    /**
+     * Course change callback of the mobility model connected from the start
+     * @param model the mobility model
+     */
+    void CourseChange(Ptr<const MobilityModel> model);
+    /**
+     * Connect a listener to the course changes of a mobility model
+     * @param model the mobility model
+     */
+    void ConnectLate(Ptr<MobilityModel> model);
+    /**
+     * Course change callback of the mobility model connected while moving
+     * @param model the mobility model
+     */
+    void LateCourseChange(Ptr<const MobilityModel> model);
+    void DoRun() override;
+
+    ObjectFactory m_factory;           //!< the factory of the mobility model
+    Vector m_position;                 //!< the initial position
+    uint32_t m_minCourseChanges;       //!< the minimum number of course changes
+    std::vector<Time> m_courseChanges; //!< the times of the course changes
+    Time m_connectTime;                //!< the time the late listener is connected
+    uint32_t m_lateCourseChanges;      //!< the number of course changes of the late listener
+};
+
+LazyTrajectoryTest::LazyTrajectoryTest(ObjectFactory factory,
+                                       Vector position,
+                                       uint32_t minCourseChanges)
+    : TestCase("Test the lazy trajectory of " + factory.GetTypeId().GetName()),
+      m_factory(factory),
+      m_position(position),
+      m_minCourseChanges(minCourseChanges),
+      m_connectTime(Seconds(50)),
+      m_lateCourseChanges(0)
+{
+}
+
+Ptr<MobilityModel>
+LazyTrajectoryTest::CreateModel() const
+{
+    Ptr<MobilityModel> model = m_factory.Create<MobilityModel>();
+    model->AssignStreams(1);
+    model->SetPosition(m_position);
+    model->Initialize();
+    return model;
+}
+
+void
+LazyTrajectoryTest::TestPositions(Ptr<MobilityModel> eager, Ptr<MobilityModel> lazy)
+{
+    NS_TEST_EXPECT_MSG_EQ_TOL(CalculateDistance(lazy->GetPosition(), eager->GetPosition()),
+                              0,
+                              1e-9,
+                              "Position not equal");
+    NS_TEST_EXPECT_MSG_EQ_TOL(CalculateDistance(lazy->GetVelocity(), eager->GetVelocity()),
+                              0,
+                              1e-9,
+                              "Velocity not equal");
+}
+
+void
+LazyTrajectoryTest::CourseChange(Ptr<const MobilityModel> model)
+{
+    m_courseChanges.push_back(Simulator::Now());
+}
+
+void
+LazyTrajectoryTest::ConnectLate(Ptr<MobilityModel> model)
+{
+    model->TraceConnectWithoutContext("CourseChange",
+                                      MakeCallback(&LazyTrajectoryTest::LateCourseChange, this));
+}
+
+void
+LazyTrajectoryTest::LateCourseChange(Ptr<const MobilityModel> model)
+{
+    NS_TEST_EXPECT_MSG_GT(Simulator::Now(), m_connectTime, "Past course change notified");
+    m_lateCourseChanges++;
+}
+
+void
+LazyTrajectoryTest::DoRun()
+{
+    // without listeners, the model does not schedule any event while moving
+    Ptr<MobilityModel> idle = CreateModel();
+    Simulator::Stop(Seconds(100));
+    Simulator::Run();
+    // at most the start events scheduled when the model is created and
+    // positioned (whether or not they are cancelled), and the Stop event
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(Simulator::GetEventCount(), 3, "Unexpected events");
+    Simulator::Destroy();
+
+    Ptr<MobilityModel> eager = CreateModel();
+    eager->TraceConnectWithoutContext("CourseChange",
+                                      MakeCallback(&LazyTrajectoryTest::CourseChange, this));
+    Ptr<MobilityModel> lazy = CreateModel();
+    for (double t : {0.3, 1.7, 5.0, 12.5, 12.5, 40.0, 77.7, 100.0})
+    {
+        Simulator::Schedule(Seconds(t), &LazyTrajectoryTest::TestPositions, this, eager, lazy);
+    }
+    // the lazy model is not queried between 40 s and the connection of the listener
+    Simulator::Schedule(m_connectTime, &LazyTrajectoryTest::ConnectLate, this, lazy);
+    Simulator::Stop(Seconds(100));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_courseChanges.size(),
+                                m_minCourseChanges,
+                                "Too few course changes");
+    uint32_t lateCourseChanges =
+        std::count_if(m_courseChanges.begin(), m_courseChanges.end(), [this](Time t) {
+            return t > m_connectTime;
+        });
+    NS_TEST_EXPECT_MSG_GT(lateCourseChanges, 0, "No course change after the connection");
+    NS_TEST_EXPECT_MSG_EQ(m_lateCourseChanges,
+                          lateCourseChanges,
+                          "The late listener missed course changes");
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup mobility-test
  *
@@ -479,6 +634,26 @@ MobilityTestSuite::MobilityTestSuite()
     AddTestCase(new WaypointLazyNotifyTrue, TestCase::Duration::QUICK);
     AddTestCase(new WaypointInitialPositionIsWaypoint, TestCase::Duration::QUICK);
     AddTestCase(new WaypointMobilityModelViaHelper, TestCase::Duration::QUICK);
+    // the course changes in 100 seconds are, besides the one at initialization:
+    // - RandomWalk2d: at least 199, as the walks of 1 m at 2 m/s or more last 0.5 s at most
+    // - RandomDirection2d: at least 12 in a 20 m x 20 m area, as the legs last at most
+    //   14.2 s at 2 m/s and are followed by a pause of 0.5 s
+    // - GaussMarkov: at least 99, as the velocity is updated every second
+    ObjectFactory randomWalk("ns3::RandomWalk2dMobilityModel");
+    AddTestCase(new LazyTrajectoryTest(randomWalk, Vector(50.0, 50.0, 0.0), 200),
+                TestCase::Duration::QUICK);
+    ObjectFactory randomDirection("ns3::RandomDirection2dMobilityModel",
+                                  "Bounds",
+                                  RectangleValue(Rectangle(0, 20, 0, 20)),
+                                  "Speed",
+                                  StringValue("ns3::ConstantRandomVariable[Constant=2.0]"),
+                                  "Pause",
+                                  StringValue("ns3::ConstantRandomVariable[Constant=0.5]"));
+    AddTestCase(new LazyTrajectoryTest(randomDirection, Vector(10.0, 10.0, 0.0), 13),
+                TestCase::Duration::QUICK);
+    ObjectFactory gaussMarkov("ns3::GaussMarkovMobilityModel");
+    AddTestCase(new LazyTrajectoryTest(gaussMarkov, Vector(0.0, 0.0, 50.0), 100),
+                TestCase::Duration::QUICK);
 }
 
 /**
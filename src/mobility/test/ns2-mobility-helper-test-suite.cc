@@ -122,7 +122,8 @@ class Ns2MobilityHelperTest : public TestCase
         : TestCase(name),
           m_timeLimit(timeLimit),
           m_nodeCount(nodes),
-          m_nextRefPoint(0)
+          m_nextRefPoint(0),
+          m_lookAhead(Seconds(10))
     {
     }
 
@@ -140,6 +141,15 @@ class Ns2MobilityHelperTest : public TestCase
         m_trace = trace;
     }
 
+    /**
+     * Set how far ahead of the simulation the trace is read
+     * @param lookAhead the look-ahead window
+     */
+    void SetLookAhead(Time lookAhead)
+    {
+        m_lookAhead = lookAhead;
+    }
+
     /**
      * Add next reference point
      * @param r reference point to add
@@ -174,6 +184,8 @@ class Ns2MobilityHelperTest : public TestCase
     size_t m_nextRefPoint;
     /// TMP trace file name
     std::string m_traceFile;
+    /// How far ahead of the simulation the trace is read
+    Time m_lookAhead;
 
   private:
     /**
@@ -295,6 +307,7 @@ class Ns2MobilityHelperTest : public TestCase
             return;
         }
         Ns2MobilityHelper mobility(m_traceFile);
+        mobility.SetLookAhead(m_lookAhead);
         mobility.Install();
         if (CheckInitialPositions())
         {
@@ -606,5 +619,45 @@ class Ns2MobilityHelperTestSuite : public TestSuite
                              Vector(300.000, 650.000, 0.000),
                              Vector(0.000, 0.000, 0.000));
         AddTestCase(t, TestCase::Duration::QUICK);
+
+        // Trace read while the simulation runs, with a window shorter than
+        // the interval between the lines: the interrupted movement must be
+        // truncated as when the whole trace is read at once
+        t = new Ns2MobilityHelperTest("short look-ahead window", Seconds(22), 2);
+        t->SetLookAhead(Seconds(0.5));
+        t->SetTrace("$node_(0) set X_ 0.0\n"
+                    "$node_(0) set Y_ 0.0\n"
+                    "$ns_ at 1.0 \"$node_(0) setdest 0  10       1\"\n"
+                    "$ns_ at 3.0 \"$node_(1) set X_ 5\"\n"
+                    "$ns_ at 6.0 \"$node_(0) setdest 0  -10       1\"\n"
+                    "$ns_ at 8.0 \"$node_(1) setdest 5  4       2\"\n"
+                    "$node_(1) set Y_ 2.0\n");
+        //                     id  t  position         velocity
+        t->AddReferencePoint("0", 0, Vector(0, 0, 0), Vector(0, 0, 0));
+        t->AddReferencePoint("1", 0, Vector(0, 2, 0), Vector(0, 0, 0));
+        t->AddReferencePoint("0", 1, Vector(0, 0, 0), Vector(0, 1, 0));
+        t->AddReferencePoint("1", 3, Vector(5, 2, 0), Vector(0, 0, 0));
+        t->AddReferencePoint("0", 6, Vector(0, 5, 0), Vector(0, -1, 0));
+        t->AddReferencePoint("1", 8, Vector(5, 2, 0), Vector(0, 2, 0));
+        t->AddReferencePoint("1", 9, Vector(5, 4, 0), Vector(0, 0, 0));
+        t->AddReferencePoint("0", 21, Vector(0, -10, 0), Vector(0, 0, 0));
+        AddTestCase(t, TestCase::Duration::QUICK);
+
+        // Lines grouped by node rather than sorted by time
+        t = new Ns2MobilityHelperTest("trace not sorted by time", Seconds(10), 2);
+        t->SetLookAhead(Seconds(0.5));
+        t->SetTrace("$ns_ at 1.0 \"$node_(0) setdest 5  0  5\"\n"
+                    "$ns_ at 4.0 \"$node_(0) setdest 5  5  5\"\n"
+                    "$ns_ at 2.0 \"$node_(1) setdest 0  5  5\"\n");
+        //                     id  t  position         velocity
+        t->AddReferencePoint("0", 0, Vector(0, 0, 0), Vector(0, 0, 0));
+        t->AddReferencePoint("1", 0, Vector(0, 0, 0), Vector(0, 0, 0));
+        t->AddReferencePoint("0", 1, Vector(0, 0, 0), Vector(5, 0, 0));
+        t->AddReferencePoint("0", 2, Vector(5, 0, 0), Vector(0, 0, 0));
+        t->AddReferencePoint("1", 2, Vector(0, 0, 0), Vector(0, 5, 0));
+        t->AddReferencePoint("1", 3, Vector(0, 5, 0), Vector(0, 0, 0));
+        t->AddReferencePoint("0", 4, Vector(5, 0, 0), Vector(0, 5, 0));
+        t->AddReferencePoint("0", 5, Vector(5, 5, 0), Vector(0, 0, 0));
+        AddTestCase(t, TestCase::Duration::QUICK);
     }
 } g_ns2TransmobilityHelperTestSuite; ///< the test suite
@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <thread>
+
+using namespace ns3;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief NetDeviceQueue Wake Test Case
+ *
+ * Check that a device transmission queue woken from another thread is woken
+ * by an event processed by the thread running the simulation.
+ */
+class NetDeviceQueueWakeTestCase : public TestCase
+{
+  public:
+    NetDeviceQueueWakeTestCase();
+
+  private:
+    void DoRun() override;
+    /// Wake callback of the device transmission queue
+    void WakeCallback();
+    uint32_t m_nWakes;            //!< the number of times the wake callback was invoked
+    std::thread::id m_wakeThread; //!< the thread which invoked the wake callback
+};
+
+NetDeviceQueueWakeTestCase::NetDeviceQueueWakeTestCase()
+    : TestCase("Check that a device transmission queue can be woken from another thread"),
+      m_nWakes(0)
+{
+}
+
+void
+NetDeviceQueueWakeTestCase::WakeCallback()
+{
+    m_nWakes++;
+    m_wakeThread = std::this_thread::get_id();
+}
+
+void
+NetDeviceQueueWakeTestCase::DoRun()
+{
+    Ptr<NetDeviceQueue> txq = CreateObject<NetDeviceQueue>();
+    txq->SetWakeCallback(MakeCallback(&NetDeviceQueueWakeTestCase::WakeCallback, this));
+    txq->Stop();
+
+    // a queue disposed and deleted before the deferred wake is processed is not woken
+    Ptr<NetDeviceQueue> disposedTxq = CreateObject<NetDeviceQueue>();
+    disposedTxq->SetWakeCallback(MakeCallback(&NetDeviceQueueWakeTestCase::WakeCallback, this));
+    disposedTxq->Stop();
+
+    // the other thread does not copy the Ptrs, whose reference count is not thread safe
+    NetDeviceQueue* queue = PeekPointer(txq);
+    NetDeviceQueue* disposedQueue = PeekPointer(disposedTxq);
+    std::thread t([queue, disposedQueue]() {
+        queue->Wake();
+        disposedQueue->Wake();
+    });
+    t.join();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nWakes, 0, "The queue must not be woken by another thread");
+    NS_TEST_EXPECT_MSG_EQ(txq->IsStopped(), true, "The queue must still be stopped");
+
+    disposedTxq->Dispose();
+    disposedTxq = nullptr;
+
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nWakes, 1, "The queue must have been woken once");
+    NS_TEST_EXPECT_MSG_EQ((m_wakeThread == std::this_thread::get_id()),
+                          true,
+                          "The queue must be woken by the thread running the simulation");
+    NS_TEST_EXPECT_MSG_EQ(txq->IsStopped(), false, "The queue must not be stopped");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief NetDeviceQueueInterface TestSuite
+ */
+class NetDeviceQueueInterfaceTestSuite : public TestSuite
+{
+  public:
+    NetDeviceQueueInterfaceTestSuite()
+        : TestSuite("net-device-queue-interface", Type::UNIT)
+    {
+        AddTestCase(new NetDeviceQueueWakeTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static NetDeviceQueueInterfaceTestSuite
+    g_netDeviceQueueInterfaceTestSuite; //!< Static variable for test initialization
@@ -32,6 +32,9 @@ NetDeviceQueue::GetTypeId()
 NetDeviceQueue::NetDeviceQueue()
     : m_stoppedByDevice(false),
       m_stoppedByQueueLimits(false),
+      m_ownerThread(std::this_thread::get_id()),
+      m_ownerContext(Simulator::NO_CONTEXT),
+      m_alive(std::make_shared<std::atomic<bool>>(true)),
       NS_LOG_TEMPLATE_DEFINE("NetDeviceQueueInterface")
 {
     NS_LOG_FUNCTION(this);
@@ -46,6 +49,15 @@ NetDeviceQueue::~NetDeviceQueue()
     m_device = nullptr;
 }
 
+void
+NetDeviceQueue::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    // the queue may be deleted before the pending deferred wakes are processed
+    *m_alive = false;
+    Object::DoDispose();
+}
+
 bool
 NetDeviceQueue::IsStopped() const
 {
@@ -58,6 +70,8 @@ NetDeviceQueue::Start()
 {
     NS_LOG_FUNCTION(this);
     m_stoppedByDevice = false;
+    m_ownerThread = std::this_thread::get_id();
+    m_ownerContext = Simulator::GetContext();
 }
 
 void
@@ -65,6 +79,8 @@ NetDeviceQueue::Stop()
 {
     NS_LOG_FUNCTION(this);
     m_stoppedByDevice = true;
+    m_ownerThread = std::this_thread::get_id();
+    m_ownerContext = Simulator::GetContext();
 }
 
 void
@@ -72,6 +88,19 @@ NetDeviceQueue::Wake()
 {
     NS_LOG_FUNCTION(this);
 
+    if (std::this_thread::get_id() != m_ownerThread)
+    {
+        // defer the wake to the thread owning this queue, which will process the
+        // event scheduled here (ScheduleWithContext is thread safe). The event does
+        // not copy a Ptr to this queue, whose reference count is not thread safe
+        Simulator::ScheduleWithContext(m_ownerContext,
+                                       Time(0),
+                                       &NetDeviceQueue::DeferredWake,
+                                       this,
+                                       m_alive);
+        return;
+    }
+
     bool wasStoppedByDevice = m_stoppedByDevice;
     m_stoppedByDevice = false;
 
@@ -82,6 +111,15 @@ NetDeviceQueue::Wake()
     }
 }
 
+void
+NetDeviceQueue::DeferredWake(NetDeviceQueue* queue, std::shared_ptr<std::atomic<bool>> alive)
+{
+    if (*alive)
+    {
+        queue->Wake();
+    }
+}
+
 void
 NetDeviceQueue::NotifyAggregatedObject(Ptr<NetDeviceQueueInterface> ndqi)
 {
@@ -268,7 +306,7 @@ NetDeviceQueueInterface::SetSelectQueueCallback(SelectQueueCallback cb)
     m_selectQueueCallback = cb;
 }
 
-NetDeviceQueueInterface::SelectQueueCallback
+const NetDeviceQueueInterface::SelectQueueCallback&
 NetDeviceQueueInterface::GetSelectQueueCallback() const
 {
     return m_selectQueueCallback;
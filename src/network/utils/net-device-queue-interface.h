@@ -16,7 +16,10 @@
 #include "ns3/ptr.h"
 #include "ns3/simulator.h"
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <thread>
 #include <vector>
 
 namespace ns3
@@ -71,6 +74,15 @@ class NetDeviceQueue : public Object
      * Called by the device to wake the queue disc associated with this
      * device transmission queue. This is done by invoking the wake callback.
      * This is the analogous to the netif_tx_wake_queue function of the Linux kernel.
+     *
+     * This method can be called from a thread other than the one which started
+     * or stopped this device transmission queue last (e.g., by a device driven
+     * by another thread). In such a case, the queue is woken by an event
+     * scheduled now (through Simulator::ScheduleWithContext, in the context in
+     * which the queue was started or stopped last), so that the state of the
+     * queue and of the queue disc is only accessed by the thread owning them.
+     * Such an event does not hold a reference to the queue, and does nothing
+     * if the queue is disposed before the event is processed.
      */
     virtual void Wake();
 
@@ -193,9 +205,26 @@ class NetDeviceQueue : public Object
     template <typename QueueType>
     void ConnectQueueTraces(Ptr<QueueType> queue);
 
+  protected:
+    void DoDispose() override;
+
   private:
+    /**
+     * Wake a device transmission queue on behalf of another thread, unless the
+     * queue has been disposed since.
+     * @param queue the device transmission queue
+     * @param alive whether the queue has not been disposed
+     */
+    static void DeferredWake(NetDeviceQueue* queue, std::shared_ptr<std::atomic<bool>> alive);
+
     bool m_stoppedByDevice;         //!< True if the queue has been stopped by the device
     bool m_stoppedByQueueLimits;    //!< True if the queue has been stopped by a queue limits object
+    /// The thread which started or stopped the queue last, read by any thread calling Wake
+    std::atomic<std::thread::id> m_ownerThread;
+    /// The context in which the queue was started or stopped last, read by any thread calling Wake
+    std::atomic<uint32_t> m_ownerContext;
+    /// False once the queue is disposed, shared with the pending deferred wakes
+    std::shared_ptr<std::atomic<bool>> m_alive;
     Ptr<QueueLimits> m_queueLimits; //!< Queue limits object
     WakeCallback m_wakeCallback;    //!< Wake callback
     Ptr<NetDevice> m_device;        //!< the netdevice aggregated to the NetDeviceQueueInterface
@@ -286,7 +315,7 @@ class NetDeviceQueueInterface : public Object
      * Called by the traffic control layer to get the select queue callback set
      * by a multi-queue device.
      */
-    SelectQueueCallback GetSelectQueueCallback() const;
+    const SelectQueueCallback& GetSelectQueueCallback() const;
 
   protected:
     /**
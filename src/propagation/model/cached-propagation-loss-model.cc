@@ -0,0 +1,213 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "cached-propagation-loss-model.h"
+
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("LossModel",
+                          "The chain of propagation loss models whose loss is cached.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::SetLossModel,
+                                              &CachedPropagationLossModel::GetLossModel),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("Symmetric",
+                          "If true, the loss of the path a-->b is reused for the path b-->a.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CachedPropagationLossModel::SetSymmetric,
+                                              &CachedPropagationLossModel::IsSymmetric),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxAge",
+                          "The maximum time a cached loss is used before being computed again, "
+                          "also if the nodes did not move. Zero means unbounded.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&CachedPropagationLossModel::m_maxAge),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("CacheHits",
+                          "The number of times a cached loss has been used.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::GetHits),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("CacheMisses",
+                          "The number of times the loss has been computed by the wrapped model.",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CachedPropagationLossModel::GetMisses),
+                          MakeUintegerChecker<uint64_t>());
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+    : PropagationLossModel(),
+      m_hits(0),
+      m_misses(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+    m_lossModel = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+CachedPropagationLossModel::SetLossModel(Ptr<PropagationLossModel> lossModel)
+{
+    NS_LOG_FUNCTION(this << lossModel);
+    m_lossModel = lossModel;
+    Clear();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetLossModel() const
+{
+    return m_lossModel;
+}
+
+void
+CachedPropagationLossModel::SetSymmetric(bool symmetric)
+{
+    NS_LOG_FUNCTION(this << symmetric);
+    Clear();
+    m_cache.SetSymmetric(symmetric);
+}
+
+bool
+CachedPropagationLossModel::IsSymmetric() const
+{
+    return m_cache.IsSymmetric();
+}
+
+void
+CachedPropagationLossModel::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    // the endpoints go first, since their mobility models are kept alive by the cache
+    for (const auto& endpoint : m_endpoints)
+    {
+        endpoint.second->m_mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&CachedPropagationLossModel::NotifyCourseChange, this));
+    }
+    m_endpoints.clear();
+    m_cache.Clear();
+}
+
+uint64_t
+CachedPropagationLossModel::GetHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+CachedPropagationLossModel::GetMisses() const
+{
+    return m_misses;
+}
+
+Ptr<CachedPropagationLossModel::EndpointState>
+CachedPropagationLossModel::GetEndpointState(Ptr<MobilityModel> mobility) const
+{
+    auto it = m_endpoints.find(PeekPointer(mobility));
+    if (it != m_endpoints.end())
+    {
+        return it->second;
+    }
+    Ptr<EndpointState> state = Create<EndpointState>();
+    state->m_mobility = PeekPointer(mobility);
+    mobility->TraceConnectWithoutContext(
+        "CourseChange",
+        MakeCallback(&CachedPropagationLossModel::NotifyCourseChange,
+                     const_cast<CachedPropagationLossModel*>(this)));
+    m_endpoints.emplace(PeekPointer(mobility), state);
+    return state;
+}
+
+void
+CachedPropagationLossModel::NotifyCourseChange(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_endpoints.find(PeekPointer(mobility));
+    if (it != m_endpoints.end())
+    {
+        it->second->m_epoch++;
+    }
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_lossModel, "The LossModel attribute has not been set");
+
+    Ptr<LossEntry> entry = m_cache.GetPathData(a, b, 0);
+    if (entry && (m_maxAge.IsZero() || Simulator::Now() - entry->m_time <= m_maxAge) &&
+        entry->m_src->m_epoch == entry->m_srcEpoch && entry->m_dst->m_epoch == entry->m_dstEpoch)
+    {
+        m_hits++;
+        return txPowerDbm - entry->m_lossDb;
+    }
+
+    m_misses++;
+    double rxPowerDbm = m_lossModel->CalcRxPower(txPowerDbm, a, b);
+    const Vector zero(0.0, 0.0, 0.0);
+    if (a->GetVelocity() != zero || b->GetVelocity() != zero)
+    {
+        NS_LOG_LOGIC("moving nodes, the loss is not cached");
+        return rxPowerDbm;
+    }
+
+    if (!entry)
+    {
+        entry = Create<LossEntry>();
+        entry->m_src = GetEndpointState(a);
+        entry->m_dst = GetEndpointState(b);
+        m_cache.AddPathData(entry, a, b, 0);
+    }
+    entry->m_lossDb = txPowerDbm - rxPowerDbm;
+    entry->m_time = Simulator::Now();
+    entry->m_srcEpoch = entry->m_src->m_epoch;
+    entry->m_dstEpoch = entry->m_dst->m_epoch;
+    NS_LOG_LOGIC("cached loss " << entry->m_lossDb << " dB");
+    return rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_lossModel ? m_lossModel->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include "propagation-cache.h"
+#include "propagation-loss-model.h"
+
+#include "ns3/nstime.h"
+
+#include <unordered_map>
+
+namespace ns3
+{
+
+/**
+ * @ingroup propagation
+ *
+ * @brief Caches the propagation loss computed by another chain of loss models
+ *
+ * The loss computed by the wrapped chain of PropagationLossModels (set with
+ * the LossModel attribute) is stored for each pair of mobility models and
+ * reused until one of the following events occurs:
+ *
+ * - one of the two mobility models fires its CourseChange trace, e.g.,
+ *   because its position or velocity is set, or because a pause ends;
+ * - the entry is older than the MaxAge attribute, if non-zero.
+ *
+ * The loss is cached only when both nodes have zero velocity, hence the loss
+ * of moving nodes is always computed by the wrapped model, while static
+ * topologies pay for the computation of the loss once per link. A cached
+ * loss is used without querying the mobility models: the cache relies on
+ * every change of the course of a static node being notified through the
+ * CourseChange trace, which is not the case for a WaypointMobilityModel
+ * whose LazyNotify attribute is true.
+ *
+ * The cache listens to the CourseChange trace of the mobility models of the
+ * cached links. The listeners are disconnected when the cache is cleared
+ * or disposed of.
+ *
+ * The cache assumes that the loss computed by the wrapped chain does not
+ * depend on the transmit power, and that it is deterministic for a given
+ * pair of positions; stochastic models that draw a new value for every
+ * packet (e.g., NakagamiPropagationLossModel) must not be wrapped, or must
+ * be chained after this model with SetNext. When the Symmetric attribute
+ * is true, the loss of the path a-->b is reused for the path b-->a.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    /**
+     * Set the chain of loss models whose loss is cached
+     * @param lossModel the first model of the chain
+     */
+    void SetLossModel(Ptr<PropagationLossModel> lossModel);
+
+    /**
+     * @return the first model of the chain whose loss is cached
+     */
+    Ptr<PropagationLossModel> GetLossModel() const;
+
+    /**
+     * Set whether the loss of the path a-->b is reused for the path b-->a.
+     * Changing this setting empties the cache.
+     * @param symmetric true if the links are symmetric
+     */
+    void SetSymmetric(bool symmetric);
+
+    /**
+     * @return true if the loss of the path a-->b is reused for the path b-->a
+     */
+    bool IsSymmetric() const;
+
+    /**
+     * Remove all the entries from the cache, and disconnect from the
+     * CourseChange traces of their mobility models
+     */
+    void Clear();
+
+    /**
+     * @return the number of times a cached loss has been used
+     */
+    uint64_t GetHits() const;
+
+    /**
+     * @return the number of times the loss has been computed by the wrapped model
+     */
+    uint64_t GetMisses() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /**
+     * The state of a mobility model seen by the cache
+     */
+    struct EndpointState : public SimpleRefCount<EndpointState>
+    {
+        uint32_t m_epoch{0}; //!< incremented at every course change
+        /// the mobility model, kept alive by the keys of m_cache
+        MobilityModel* m_mobility{nullptr};
+    };
+
+    /**
+     * A cached loss value
+     */
+    struct LossEntry : public SimpleRefCount<LossEntry>
+    {
+        double m_lossDb;                //!< the loss, in dB
+        Time m_time;                    //!< the time the loss was computed
+        Ptr<const EndpointState> m_src; //!< the state of the first mobility model
+        Ptr<const EndpointState> m_dst; //!< the state of the second mobility model
+        uint32_t m_srcEpoch;            //!< the epoch of the first mobility model
+        uint32_t m_dstEpoch;            //!< the epoch of the second mobility model
+    };
+
+    /**
+     * Get the state of a mobility model, connecting to its CourseChange trace
+     * the first time the mobility model is seen
+     * @param mobility the mobility model
+     * @return the state of the mobility model
+     */
+    Ptr<EndpointState> GetEndpointState(Ptr<MobilityModel> mobility) const;
+
+    /**
+     * Invalidate the cached losses of a mobility model
+     * @param mobility the mobility model whose course changed
+     */
+    void NotifyCourseChange(Ptr<const MobilityModel> mobility);
+
+    Ptr<PropagationLossModel> m_lossModel;       //!< the chain of loss models whose loss is cached
+    Time m_maxAge;                               //!< the maximum age of a cached loss
+    mutable PropagationCache<LossEntry> m_cache; //!< the cached losses
+    mutable std::unordered_map<const MobilityModel*, Ptr<EndpointState>>
+        m_endpoints;           //!< the states of the mobility models of the cached links
+    mutable uint64_t m_hits;   //!< the number of times a cached loss has been used
+    mutable uint64_t m_misses; //!< the number of times the loss has been computed
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
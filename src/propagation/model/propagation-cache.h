@@ -10,15 +10,20 @@
 
 #include "ns3/mobility-model.h"
 
-#include <map>
+#include <cstdint>
+#include <vector>
 
 namespace ns3
 {
 /**
  * @ingroup propagation
  * @brief Constructs a cache of objects, where each object is responsible for a single propagation
- * path loss calculations. Propagation path a-->b and b-->a is the same thing. Propagation path is
- * identified by a couple of MobilityModels and a spectrum model UID
+ * path loss calculations. Propagation path is identified by a couple of MobilityModels and a
+ * spectrum model UID. By default, propagation path a-->b and b-->a is the same thing.
+ *
+ * The cache is an open-addressing hash table with linear probing, indexed by the addresses of
+ * the mobility models. Entries are never removed individually, hence no tombstones are needed;
+ * the table is doubled when more than half of the slots are used.
  */
 template <class T>
 class PropagationCache
@@ -32,6 +37,25 @@ class PropagationCache
     {
     }
 
+    /**
+     * Set whether the paths a-->b and b-->a are the same path. It can only be
+     * changed while the cache is empty.
+     * @param symmetric true if the links are symmetric
+     */
+    void SetSymmetric(bool symmetric)
+    {
+        NS_ASSERT_MSG(m_size == 0, "Cannot change the symmetry of a non-empty cache");
+        m_symmetric = symmetric;
+    }
+
+    /**
+     * @return true if the paths a-->b and b-->a are the same path
+     */
+    bool IsSymmetric() const
+    {
+        return m_symmetric;
+    }
+
     /**
      * Get the model associated with the path
      * @param a 1st node mobility model
@@ -41,13 +65,20 @@ class PropagationCache
      */
     Ptr<T> GetPathData(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
     {
-        PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid);
-        auto it = m_pathCache.find(key);
-        if (it == m_pathCache.end())
+        PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid, m_symmetric);
+        if (m_size == 0)
+        {
+            m_misses++;
+            return nullptr;
+        }
+        const Slot& slot = m_slots[FindSlot(key)];
+        if (!slot.m_data)
         {
+            m_misses++;
             return nullptr;
         }
-        return it->second;
+        m_hits++;
+        return slot.m_data;
     }
 
     /**
@@ -62,9 +93,17 @@ class PropagationCache
                      Ptr<const MobilityModel> b,
                      uint32_t modelUid)
     {
-        PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid);
-        NS_ASSERT(m_pathCache.find(key) == m_pathCache.end());
-        m_pathCache.insert(std::make_pair(key, data));
+        NS_ASSERT(data);
+        if (2 * (m_size + 1) > m_slots.size())
+        {
+            Grow();
+        }
+        PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid, m_symmetric);
+        Slot& slot = m_slots[FindSlot(key)];
+        NS_ASSERT(!slot.m_data);
+        slot.m_key = key;
+        slot.m_data = data;
+        m_size++;
     }
 
     /**
@@ -72,76 +111,157 @@ class PropagationCache
      */
     void Cleanup()
     {
-        for (auto i : m_pathCache)
+        for (auto& slot : m_slots)
         {
-            i.second->Dispose();
+            if (slot.m_data)
+            {
+                slot.m_data->Dispose();
+            }
         }
-        m_pathCache.clear();
+        Clear();
+    }
+
+    /**
+     * Remove all the paths from the cache, without disposing the associated data.
+     * Statistics are not reset.
+     */
+    void Clear()
+    {
+        m_slots.clear();
+        m_size = 0;
+    }
+
+    /**
+     * @return the number of paths in the cache
+     */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @return the number of lookups which found the path
+     */
+    uint64_t GetHits() const
+    {
+        return m_hits;
+    }
+
+    /**
+     * @return the number of lookups which did not find the path
+     */
+    uint64_t GetMisses() const
+    {
+        return m_misses;
     }
 
   private:
     /// Each path is identified by
     struct PropagationPathIdentifier
     {
+        PropagationPathIdentifier() = default;
+
         /**
          * Constructor
          * @param a 1st node mobility model
          * @param b 2nd node mobility model
          * @param modelUid model UID
+         * @param symmetric whether the path a-->b is the same as b-->a
          */
         PropagationPathIdentifier(Ptr<const MobilityModel> a,
                                   Ptr<const MobilityModel> b,
-                                  uint32_t modelUid)
+                                  uint32_t modelUid,
+                                  bool symmetric)
             : m_srcMobility(a),
               m_dstMobility(b),
               m_spectrumModelUid(modelUid)
         {
+            /// Symmetric links are identified by the ordered pair of mobility models
+            if (symmetric && PeekPointer(b) < PeekPointer(a))
+            {
+                std::swap(m_srcMobility, m_dstMobility);
+            }
         }
 
         Ptr<const MobilityModel> m_srcMobility; //!< 1st node mobility model
         Ptr<const MobilityModel> m_dstMobility; //!< 2nd node mobility model
-        uint32_t m_spectrumModelUid;            //!< model UID
+        uint32_t m_spectrumModelUid{0};         //!< model UID
 
         /**
-         * Less-than operator.
-         *
-         * The goal of this operator is just to provide a stable comparison
-         * to be used in containers requiring a order (of any kind).
-         *
-         * If the models are different, the comparison is based on their Uid.
-         * Otherwise, the comparison is based on the pointers of the Mobility models.
-         *
+         * Equality operator.
          * @param other Right value of the operator.
-         * @returns True if the Left value is less than the Right value.
+         * @returns True if the identifiers refer to the same path.
          */
-        bool operator<(const PropagationPathIdentifier& other) const
+        bool operator==(const PropagationPathIdentifier& other) const
         {
-            if (m_spectrumModelUid != other.m_spectrumModelUid)
-            {
-                return m_spectrumModelUid < other.m_spectrumModelUid;
-            }
-            /// Links are supposed to be symmetrical!
-            if (std::min(m_dstMobility, m_srcMobility) !=
-                std::min(other.m_dstMobility, other.m_srcMobility))
-            {
-                return std::min(m_dstMobility, m_srcMobility) <
-                       std::min(other.m_dstMobility, other.m_srcMobility);
-            }
-            if (std::max(m_dstMobility, m_srcMobility) !=
-                std::max(other.m_dstMobility, other.m_srcMobility))
-            {
-                return std::max(m_dstMobility, m_srcMobility) <
-                       std::max(other.m_dstMobility, other.m_srcMobility);
-            }
-            return false;
+            return m_srcMobility == other.m_srcMobility && m_dstMobility == other.m_dstMobility &&
+                   m_spectrumModelUid == other.m_spectrumModelUid;
+        }
+
+        /**
+         * @return the hash of the identifier
+         */
+        uint64_t Hash() const
+        {
+            auto src = reinterpret_cast<uintptr_t>(PeekPointer(m_srcMobility));
+            auto dst = reinterpret_cast<uintptr_t>(PeekPointer(m_dstMobility));
+            // mix the addresses with a 64-bit finalizer, so that the low bits
+            // used to index the table depend on all the bits of the key
+            uint64_t h = src ^ (dst * 0x9e3779b97f4a7c15ULL) ^ m_spectrumModelUid;
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
         }
     };
 
-    /// Typedef: PropagationPathIdentifier, Ptr<T>
-    typedef std::map<PropagationPathIdentifier, Ptr<T>> PathCache;
+    /// A slot of the hash table, empty if m_data is null
+    struct Slot
+    {
+        PropagationPathIdentifier m_key; //!< the path identifier
+        Ptr<T> m_data;                   //!< the data associated to the path
+    };
 
-  private:
-    PathCache m_pathCache; //!< Path cache
+    /**
+     * Find the slot containing the path, or the empty slot where it would be inserted.
+     * The table must not be empty.
+     * @param key the path identifier
+     * @return the index of the slot
+     */
+    std::size_t FindSlot(const PropagationPathIdentifier& key) const
+    {
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t index = key.Hash() & mask;
+        while (m_slots[index].m_data && !(m_slots[index].m_key == key))
+        {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    /**
+     * Double the number of slots and reinsert the paths
+     */
+    void Grow()
+    {
+        std::vector<Slot> oldSlots(m_slots.empty() ? 16 : 2 * m_slots.size());
+        oldSlots.swap(m_slots);
+        for (auto& slot : oldSlots)
+        {
+            if (slot.m_data)
+            {
+                m_slots[FindSlot(slot.m_key)] = std::move(slot);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots; //!< the slots, their number is a power of two
+    std::size_t m_size{0};     //!< the number of used slots
+    bool m_symmetric{true};    //!< whether the links are symmetric
+    uint64_t m_hits{0};        //!< the number of hits
+    uint64_t m_misses{0};      //!< the number of misses
 };
 } // namespace ns3
 
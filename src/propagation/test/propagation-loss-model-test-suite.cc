@@ -5,12 +5,17 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/cached-propagation-loss-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/pointer.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/random-direction-2d-mobility-model.h"
+#include "ns3/rectangle.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
 using namespace ns3;
@@ -478,6 +483,122 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief CachedPropagationLossModel Test
+ *
+ * Checks that the loss computed by the wrapped model is reused for static
+ * nodes, also for the reverse path if the links are symmetric, and that it
+ * is computed again when a node moves, also if the node resumes moving
+ * at the end of a pause it did not schedule before the cache listened to it,
+ * and that the cache stops listening to the nodes when it is cleared.
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+    ~CachedPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(100, 0, 0));
+
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<CachedPropagationLossModel> lossModel = CreateObject<CachedPropagationLossModel>();
+    lossModel->SetLossModel(logDistance);
+    lossModel->SetSymmetric(true);
+
+    double txPwrdBm = 10.0;
+    double tolerance = 1e-9;
+    double expecteddBm = logDistance->CalcRxPower(txPwrdBm, a, b);
+    double resultdBm = lossModel->CalcRxPower(txPwrdBm, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expecteddBm, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetMisses(), 1, "The loss should have been computed");
+
+    // the cached loss is used for both directions, with any tx power
+    resultdBm = lossModel->CalcRxPower(txPwrdBm, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expecteddBm, tolerance, "Got unexpected rcv power");
+    resultdBm = lossModel->CalcRxPower(txPwrdBm + 3, b, a);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expecteddBm + 3, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetHits(), 2, "The cached loss should have been used");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetMisses(), 1, "The loss should not have been computed");
+
+    // moving a node invalidates the cached loss
+    b->SetPosition(Vector(200, 0, 0));
+    expecteddBm = logDistance->CalcRxPower(txPwrdBm, a, b);
+    resultdBm = lossModel->CalcRxPower(txPwrdBm, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expecteddBm, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetMisses(), 2, "The loss should have been computed");
+    resultdBm = lossModel->CalcRxPower(txPwrdBm, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expecteddBm, tolerance, "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetHits(), 3, "The cached loss should have been used");
+
+    // with asymmetric links, the reverse path is a different entry
+    lossModel->SetSymmetric(false);
+    lossModel->CalcRxPower(txPwrdBm, a, b);
+    lossModel->CalcRxPower(txPwrdBm, b, a);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetMisses(), 4, "The loss should have been computed");
+    lossModel->CalcRxPower(txPwrdBm, b, a);
+    NS_TEST_EXPECT_MSG_EQ(lossModel->GetHits(), 4, "The cached loss should have been used");
+
+    // a node which is paused when the loss is cached schedules the end of its
+    // pause when the cache connects to its CourseChange trace
+    Ptr<MobilityModel> c = CreateObjectWithAttributes<RandomDirection2dMobilityModel>(
+        "Bounds",
+        RectangleValue(Rectangle(0, 1, 0, 1)),
+        "Speed",
+        StringValue("ns3::ConstantRandomVariable[Constant=100]"),
+        "Pause",
+        StringValue("ns3::ConstantRandomVariable[Constant=10]"));
+    c->Initialize();
+    lossModel->SetSymmetric(true);
+    Simulator::Schedule(Seconds(1), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(c->GetVelocity(), Vector(0, 0, 0), "The node should be paused");
+        lossModel->CalcRxPower(txPwrdBm, a, c);
+        NS_TEST_EXPECT_MSG_EQ(lossModel->GetMisses(), 5, "The loss should have been computed");
+        lossModel->CalcRxPower(txPwrdBm, a, c);
+        NS_TEST_EXPECT_MSG_EQ(lossModel->GetHits(), 5, "The cached loss should have been used");
+    });
+    uint64_t eventCount = 0;
+    Simulator::Schedule(Seconds(15), [&]() {
+        resultdBm = lossModel->CalcRxPower(txPwrdBm, a, c);
+        expecteddBm = logDistance->CalcRxPower(txPwrdBm, a, c);
+        NS_TEST_EXPECT_MSG_EQ_TOL(resultdBm, expecteddBm, tolerance, "Got unexpected rcv power");
+        NS_TEST_EXPECT_MSG_EQ(lossModel->GetMisses(), 6, "The loss should have been computed");
+        // once nobody listens to it, the node stops scheduling the ends of its legs
+        lossModel->Clear();
+        eventCount = Simulator::GetEventCount();
+    });
+    Simulator::Stop(Seconds(100));
+    Simulator::Run();
+    // at most the end of the current leg, scheduled before the cache was cleared,
+    // and the Stop event
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(Simulator::GetEventCount() - eventCount,
+                                2,
+                                "The cache should have disconnected from the node");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -489,6 +610,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - CachedPropagationLossModel
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -504,6 +626,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
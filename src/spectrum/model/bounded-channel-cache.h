@@ -0,0 +1,284 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BOUNDED_CHANNEL_CACHE_H
+#define BOUNDED_CHANNEL_CACHE_H
+
+#include <ns3/callback.h>
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+#include <ns3/simulator.h>
+
+#include <list>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/**
+ * @ingroup spectrum
+ * @brief Bounded, evicting cache for per-link channel objects
+ *
+ * Stores reference-counted channel objects (channel matrices, channel
+ * parameters, long term components) indexed by a reciprocal 64-bit link key,
+ * such as the one returned by MatrixBasedChannelModel::GetKey. Entries are
+ * kept in least-recently-used order and are evicted when:
+ *
+ * - the number of entries exceeds the maximum number of entries,
+ * - the estimated memory used by the entries exceeds the memory limit,
+ * - an entry has not been accessed for longer than the maximum idle time.
+ *
+ * A zero value disables the corresponding bound, so a default constructed
+ * cache behaves like an unbounded map. Eviction only depends on the
+ * simulation time and on the order of the accesses, hence it is
+ * deterministic for a given simulation run.
+ *
+ * @tparam T the type of the cached objects
+ */
+template <class T>
+class BoundedChannelCache
+{
+  public:
+    /**
+     * Set the maximum number of cached entries
+     * @param maxEntries the maximum number of entries, zero means unbounded
+     */
+    void SetMaxEntries(uint32_t maxEntries)
+    {
+        m_maxEntries = maxEntries;
+        Shrink();
+    }
+
+    /**
+     * @return the maximum number of cached entries, zero means unbounded
+     */
+    uint32_t GetMaxEntries() const
+    {
+        return m_maxEntries;
+    }
+
+    /**
+     * Set the maximum memory used by the cached entries
+     * @param maxBytes the maximum memory in bytes, zero means unbounded
+     */
+    void SetMaxBytes(uint64_t maxBytes)
+    {
+        m_maxBytes = maxBytes;
+        Shrink();
+    }
+
+    /**
+     * @return the maximum memory used by the cached entries, zero means unbounded
+     */
+    uint64_t GetMaxBytes() const
+    {
+        return m_maxBytes;
+    }
+
+    /**
+     * Set the maximum time an entry is kept without being accessed
+     * @param maxIdleTime the maximum idle time, zero means unbounded
+     */
+    void SetMaxIdleTime(Time maxIdleTime)
+    {
+        m_maxIdleTime = maxIdleTime;
+    }
+
+    /**
+     * @return the maximum time an entry is kept without being accessed, zero means unbounded
+     */
+    Time GetMaxIdleTime() const
+    {
+        return m_maxIdleTime;
+    }
+
+    /**
+     * Set the callback invoked with the key of every evicted entry
+     * @param cb the eviction callback
+     */
+    void SetEvictionCallback(Callback<void, uint64_t> cb)
+    {
+        m_evictionCallback = cb;
+    }
+
+    /**
+     * Look up an entry and mark it as the most recently used one.
+     * Hits and misses are accounted in the cache statistics.
+     * @param key the link key
+     * @return the cached object, or nullptr if not present
+     */
+    Ptr<T> Get(uint64_t key)
+    {
+        ExpireIdle();
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            m_misses++;
+            return nullptr;
+        }
+        m_hits++;
+        it->second->m_lastAccess = Simulator::Now();
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->m_value;
+    }
+
+    /**
+     * Look up an entry without updating its recency or the cache statistics
+     * @param key the link key
+     * @return the cached object, or nullptr if not present
+     */
+    Ptr<T> Peek(uint64_t key) const
+    {
+        auto it = m_index.find(key);
+        return it == m_index.end() ? nullptr : it->second->m_value;
+    }
+
+    /**
+     * Store or replace an entry, marking it as the most recently used one,
+     * and evict the least recently used entries exceeding the bounds.
+     * The entry just stored is never evicted by this call.
+     * @param key the link key
+     * @param value the object to cache
+     * @param bytes the estimated memory used by the object
+     */
+    void Put(uint64_t key, Ptr<T> value, uint64_t bytes)
+    {
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_bytes -= it->second->m_bytes;
+            m_entries.erase(it->second);
+        }
+        m_entries.push_front({key, value, bytes, Simulator::Now()});
+        m_index[key] = m_entries.begin();
+        m_bytes += bytes;
+        ExpireIdle();
+        Shrink();
+    }
+
+    /**
+     * Remove all the entries. Statistics are not reset.
+     */
+    void Clear()
+    {
+        m_entries.clear();
+        m_index.clear();
+        m_bytes = 0;
+    }
+
+    /**
+     * @return the number of cached entries
+     */
+    std::size_t GetSize() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * @return the estimated memory used by the cached entries, in bytes
+     */
+    uint64_t GetBytes() const
+    {
+        return m_bytes;
+    }
+
+    /**
+     * @return the number of lookups which found the entry
+     */
+    uint64_t GetHits() const
+    {
+        return m_hits;
+    }
+
+    /**
+     * @return the number of lookups which did not find the entry
+     */
+    uint64_t GetMisses() const
+    {
+        return m_misses;
+    }
+
+    /**
+     * @return the number of evicted entries
+     */
+    uint64_t GetEvictions() const
+    {
+        return m_evictions;
+    }
+
+  private:
+    /**
+     * A cached entry
+     */
+    struct Entry
+    {
+        uint64_t m_key;    //!< the link key
+        Ptr<T> m_value;    //!< the cached object
+        uint64_t m_bytes;  //!< the estimated memory used by the object
+        Time m_lastAccess; //!< the time of the last access
+    };
+
+    /**
+     * Evict the least recently used entry
+     */
+    void EvictLast()
+    {
+        const Entry& last = m_entries.back();
+        uint64_t key = last.m_key;
+        m_bytes -= last.m_bytes;
+        m_index.erase(key);
+        m_entries.pop_back();
+        m_evictions++;
+        if (!m_evictionCallback.IsNull())
+        {
+            m_evictionCallback(key);
+        }
+    }
+
+    /**
+     * Evict the entries which have not been accessed for longer than the maximum idle time.
+     * Since the entries are sorted by access time, only the tail of the list is inspected.
+     */
+    void ExpireIdle()
+    {
+        if (m_maxIdleTime.IsZero())
+        {
+            return;
+        }
+        Time now = Simulator::Now();
+        while (!m_entries.empty() && now - m_entries.back().m_lastAccess > m_maxIdleTime)
+        {
+            EvictLast();
+        }
+    }
+
+    /**
+     * Evict the least recently used entries until the size and memory bounds are met.
+     * The most recently used entry is always kept.
+     */
+    void Shrink()
+    {
+        while (m_entries.size() > 1 && ((m_maxEntries > 0 && m_entries.size() > m_maxEntries) ||
+                                        (m_maxBytes > 0 && m_bytes > m_maxBytes)))
+        {
+            EvictLast();
+        }
+    }
+
+    std::list<Entry> m_entries; //!< the entries, from the most to the least recently used
+    std::unordered_map<uint64_t, typename std::list<Entry>::iterator>
+        m_index;                                 //!< the entries indexed by link key
+    uint32_t m_maxEntries{0};                    //!< the maximum number of entries
+    uint64_t m_maxBytes{0};                      //!< the memory limit in bytes
+    Time m_maxIdleTime{0};                       //!< the maximum idle time
+    uint64_t m_bytes{0};                         //!< the estimated memory used
+    uint64_t m_hits{0};                          //!< the number of hits
+    uint64_t m_misses{0};                        //!< the number of misses
+    uint64_t m_evictions{0};                     //!< the number of evictions
+    Callback<void, uint64_t> m_evictionCallback; //!< invoked on every eviction
+};
+
+} // namespace ns3
+
+#endif /* BOUNDED_CHANNEL_CACHE_H */
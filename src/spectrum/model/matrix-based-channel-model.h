@@ -156,7 +156,9 @@ class MatrixBasedChannelModel : public Object
         mutable double m_cachedRbWidth = 0.0;
 
         /**
-         * Matrix array that holds the precomputed delay sincos
+         * Matrix array that holds the precomputed delay sincos, with dimensions
+         * numClusters x numRBs, so that the sincos of all the clusters of a RB
+         * are contiguous
          */
         mutable ComplexMatrixArray m_cachedDelaySincos;
 
@@ -212,6 +214,14 @@ class MatrixBasedChannelModel : public Object
         return (uint64_t)std::min(a, b) << 32 | std::max(a, b);
     }
 
+    /**
+     * TracedCallback signature for the hits, misses and evictions of the
+     * caches storing per-link channel objects.
+     *
+     * @param [in] key the reciprocal key of the link, see GetKey
+     */
+    typedef void (*CacheEventTracedCallback)(uint64_t key);
+
     static const uint8_t AOA_INDEX = 0; //!< index of the AOA value in the m_angle array
     static const uint8_t ZOA_INDEX = 1; //!< index of the ZOA value in the m_angle array
     static const uint8_t AOD_INDEX = 2; //!< index of the AOD value in the m_angle array
@@ -12,6 +12,7 @@
 #include <ns3/log.h>
 
 #include <algorithm>
+#include <iterator>
 
 namespace ns3
 {
@@ -29,12 +30,40 @@ SpectrumConverter::SpectrumConverter(Ptr<const SpectrumModel> fromSpectrumModel,
     m_fromSpectrumModel = fromSpectrumModel;
     m_toSpectrumModel = toSpectrumModel;
 
+    // If the bands to convert from are sorted and do not overlap, only the
+    // bands overlapping each band to convert to are inspected, which makes
+    // the construction linear in the number of non-zero coefficients rather
+    // than proportional to the product of the number of bands
+    bool sorted = true;
+    for (auto fromit = fromSpectrumModel->Begin(); fromit != fromSpectrumModel->End(); ++fromit)
+    {
+        auto nextit = std::next(fromit);
+        if (nextit != fromSpectrumModel->End() && nextit->fl < fromit->fh)
+        {
+            sorted = false;
+            break;
+        }
+    }
+
     size_t rowPtr = 0;
     for (auto toit = toSpectrumModel->Begin(); toit != toSpectrumModel->End(); ++toit)
     {
-        size_t colInd = 0;
-        for (auto fromit = fromSpectrumModel->Begin(); fromit != fromSpectrumModel->End(); ++fromit)
+        auto fromit = fromSpectrumModel->Begin();
+        if (sorted)
+        {
+            // first band whose upper frequency is above the lower frequency of the target band
+            fromit = std::upper_bound(fromSpectrumModel->Begin(),
+                                      fromSpectrumModel->End(),
+                                      toit->fl,
+                                      [](double f, const BandInfo& band) { return f < band.fh; });
+        }
+        size_t colInd = std::distance(fromSpectrumModel->Begin(), fromit);
+        for (; fromit != fromSpectrumModel->End(); ++fromit)
         {
+            if (sorted && fromit->fl >= toit->fh)
+            {
+                break;
+            }
             double c = GetCoefficient(*fromit, *toit);
             NS_LOG_LOGIC("(" << fromit->fl << "," << fromit->fh << ")"
                              << " --> "
@@ -65,26 +94,32 @@ SpectrumConverter::GetCoefficient(const BandInfo& from, const BandInfo& to) cons
 Ptr<SpectrumValue>
 SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
 {
-    NS_ASSERT(*(fvvf->GetSpectrumModel()) == *m_fromSpectrumModel);
-
     Ptr<SpectrumValue> tvvf = Create<SpectrumValue>(m_toSpectrumModel);
+    Convert(*fvvf, *tvvf);
+    return tvvf;
+}
 
-    auto tvit = tvvf->ValuesBegin();
+void
+SpectrumConverter::Convert(const SpectrumValue& from, SpectrumValue& to) const
+{
+    NS_ASSERT(*(from.GetSpectrumModel()) == *m_fromSpectrumModel);
+    NS_ASSERT(*(to.GetSpectrumModel()) == *m_toSpectrumModel);
+
+    const double* fromValues = from.GetValues().data();
+    const double* coefficients = m_conversionMatrix.data();
+    const size_t* colInd = m_conversionColInd.data();
+    Values& toValues = to.GetValues();
     size_t i = 0; // Index of conversion coefficient
 
-    for (auto convIt = m_conversionRowPtr.begin(); convIt != m_conversionRowPtr.end(); ++convIt)
+    for (size_t row = 0; row < m_conversionRowPtr.size(); ++row)
     {
         double sum = 0;
-        while (i < *convIt)
+        for (; i < m_conversionRowPtr[row]; i++)
         {
-            sum += (*fvvf)[m_conversionColInd.at(i)] * m_conversionMatrix.at(i);
-            i++;
+            sum += fromValues[colInd[i]] * coefficients[i];
         }
-        *tvit = sum;
-        ++tvit;
+        toValues[row] = sum;
     }
-
-    return tvvf;
 }
 
 } // namespace ns3
@@ -52,6 +52,16 @@ class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
      */
     Ptr<SpectrumValue> Convert(Ptr<const SpectrumValue> vvf) const;
 
+    /**
+     * Convert a particular ValueVsFreq instance into an existing ValueVsFreq
+     * instance defined over the SpectrumModel to convert to, without
+     * allocating memory
+     *
+     * @param from the ValueVsFreq instance to be converted
+     * @param to the ValueVsFreq instance where the converted values are stored
+     */
+    void Convert(const SpectrumValue& from, SpectrumValue& to) const;
+
   private:
     /**
      * Calculate the coefficient for value conversion between elements
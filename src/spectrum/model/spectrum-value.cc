@@ -509,6 +509,127 @@ operator/(double lhs, const SpectrumValue& rhs)
     return res;
 }
 
+SpectrumValue
+operator+(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.Add(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator+(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.ChangeSign();
+    rhs.Add(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    rhs.Multiply(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(const SpectrumValue& lhs, SpectrumValue&& rhs)
+{
+    NS_ASSERT(lhs.m_spectrumModel == rhs.m_spectrumModel);
+    NS_ASSERT(lhs.m_values.size() == rhs.m_values.size());
+
+    const double* l = lhs.m_values.data();
+    double* r = rhs.m_values.data();
+    for (size_t i = 0; i < rhs.m_values.size(); ++i)
+    {
+        r[i] = l[i] / r[i];
+    }
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, SpectrumValue&& rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
 SpectrumValue
 operator+(const SpectrumValue& rhs)
 {
@@ -523,6 +644,13 @@ operator-(const SpectrumValue& rhs)
     return res;
 }
 
+SpectrumValue
+operator-(SpectrumValue&& rhs)
+{
+    rhs.ChangeSign();
+    return std::move(rhs);
+}
+
 SpectrumValue
 Pow(double lhs, const SpectrumValue& rhs)
 {
@@ -319,6 +319,166 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     friend SpectrumValue operator/(double lhs, const SpectrumValue& rhs);
 
+    /**
+     * addition operator reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * addition operator reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * addition operator reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * addition operator reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs + rhs
+     */
+    friend SpectrumValue operator+(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * subtraction operator reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * subtraction operator reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * subtraction operator reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * subtraction operator reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs - rhs
+     */
+    friend SpectrumValue operator-(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * multiplication component-by-component reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * multiplication component-by-component reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * multiplication component-by-component reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * multiplication component-by-component reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs * rhs
+     */
+    friend SpectrumValue operator*(SpectrumValue&& lhs, double rhs);
+
+    /**
+     * division component-by-component reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, const SpectrumValue& rhs);
+
+    /**
+     * division component-by-component reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(const SpectrumValue& lhs, SpectrumValue&& rhs);
+
+    /**
+     * division component-by-component reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, SpectrumValue&& rhs);
+
+    /**
+     * division component-by-component reusing the storage of a temporary operand
+     *
+     * @param lhs Left Hand Side of the operator
+     * @param rhs Right Hand Side of the operator
+     *
+     * @return the value of lhs / rhs
+     */
+    friend SpectrumValue operator/(SpectrumValue&& lhs, double rhs);
+
     /**
      * Compare two spectrum values
      *
@@ -355,6 +515,14 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     friend SpectrumValue operator-(const SpectrumValue& rhs);
 
+    /**
+     * unary minus operator reusing the storage of a temporary operand
+     *
+     * @param rhs Right Hand Side of the operator
+     * @return the value of - *this
+     */
+    friend SpectrumValue operator-(SpectrumValue&& rhs);
+
     /**
      * left shift operator
      *
@@ -19,6 +19,8 @@
 #include "ns3/phased-array-model.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
 #include <ns3/simulator.h>
 
 #include <algorithm>
@@ -1065,8 +1067,13 @@ static const std::map<std::string, std::map<int, std::array<float, 22>>> NTNRura
 };
 
 ThreeGppChannelModel::ThreeGppChannelModel()
+    : m_evictStaleParams(false)
 {
     NS_LOG_FUNCTION(this);
+    m_channelMatrixCache.SetEvictionCallback(
+        MakeCallback(&ThreeGppChannelModel::NotifyChannelCacheEviction, this));
+    m_channelParamsCache.SetEvictionCallback(
+        MakeCallback(&ThreeGppChannelModel::NotifyParamsCacheEviction, this));
     m_uniformRv = CreateObject<UniformRandomVariable>();
     m_uniformRvShuffle = CreateObject<UniformRandomVariable>();
     m_uniformRvDoppler = CreateObject<UniformRandomVariable>();
@@ -1089,8 +1096,8 @@ ThreeGppChannelModel::DoDispose()
     {
         m_channelConditionModel->Dispose();
     }
-    m_channelMatrixMap.clear();
-    m_channelParamsMap.clear();
+    m_channelMatrixCache.Clear();
+    m_channelParamsCache.Clear();
     m_channelConditionModel = nullptr;
 }
 
@@ -1125,8 +1132,85 @@ ThreeGppChannelModel::GetTypeId()
             .AddAttribute("UpdatePeriod",
                           "Specify the channel coherence time",
                           TimeValue(MilliSeconds(0)),
-                          MakeTimeAccessor(&ThreeGppChannelModel::m_updatePeriod),
+                          MakeTimeAccessor(&ThreeGppChannelModel::SetUpdatePeriod,
+                                           &ThreeGppChannelModel::GetUpdatePeriod),
                           MakeTimeChecker())
+            // attributes for the channel caches
+            .AddAttribute("ChannelCacheMaxEntries",
+                          "The maximum number of cached channel matrices (0 means unbounded). "
+                          "The least recently used matrices are evicted first and are "
+                          "regenerated from the cached channel params when needed again.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::SetChannelCacheMaxEntries,
+                                               &ThreeGppChannelModel::GetChannelCacheMaxEntries),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ChannelCacheMaxBytes",
+                          "The maximum memory in bytes used by the cached channel matrices "
+                          "(0 means unbounded)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::SetChannelCacheMaxBytes,
+                                               &ThreeGppChannelModel::GetChannelCacheMaxBytes),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("ChannelCacheIdleTime",
+                          "The channel matrices not accessed for longer than this time are "
+                          "evicted (0 means never)",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ThreeGppChannelModel::SetChannelCacheIdleTime,
+                                           &ThreeGppChannelModel::GetChannelCacheIdleTime),
+                          MakeTimeChecker())
+            .AddAttribute("EvictStaleParams",
+                          "If true and UpdatePeriod is not zero, evict the channel params not "
+                          "accessed for longer than UpdatePeriod. These would be regenerated "
+                          "at the next access anyway, so the results are not affected.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ThreeGppChannelModel::SetEvictStaleParams,
+                                              &ThreeGppChannelModel::GetEvictStaleParams),
+                          MakeBooleanChecker())
+            .AddAttribute("ParamsCacheMaxEntries",
+                          "The maximum number of cached channel params (0 means unbounded). "
+                          "When the params of a pair of nodes are evicted, a new independent "
+                          "realization is drawn at the next access, hence a non-zero value "
+                          "changes the results with respect to an unbounded cache.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::SetParamsCacheMaxEntries,
+                                               &ThreeGppChannelModel::GetParamsCacheMaxEntries),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ChannelCacheHits",
+                          "The number of channel matrix cache hits",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetChannelCacheHits),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("ChannelCacheMisses",
+                          "The number of channel matrix cache misses",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetChannelCacheMisses),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("ChannelCacheEvictions",
+                          "The number of evicted channel matrices",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetChannelCacheEvictions),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("ParamsCacheHits",
+                          "The number of channel params cache hits",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetParamsCacheHits),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("ParamsCacheMisses",
+                          "The number of channel params cache misses",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetParamsCacheMisses),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("ParamsCacheEvictions",
+                          "The number of evicted channel params",
+                          TypeId::ATTR_GET,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::GetParamsCacheEvictions),
+                          MakeUintegerChecker<uint64_t>())
             // attributes for the blockage model
             .AddAttribute("Blockage",
                           "Enable blockage model A (sec 7.6.4.1)",
@@ -1156,8 +1240,32 @@ ThreeGppChannelModel::GetTypeId()
                           DoubleValue(0.0),
                           MakeDoubleAccessor(&ThreeGppChannelModel::m_vScatt),
                           MakeDoubleChecker<double>(0.0))
-
-        ;
+            .AddTraceSource("ChannelCacheHit",
+                            "A channel matrix has been found in the cache",
+                            MakeTraceSourceAccessor(&ThreeGppChannelModel::m_channelCacheHitTrace),
+                            "ns3::MatrixBasedChannelModel::CacheEventTracedCallback")
+            .AddTraceSource("ChannelCacheMiss",
+                            "A channel matrix has not been found in the cache",
+                            MakeTraceSourceAccessor(&ThreeGppChannelModel::m_channelCacheMissTrace),
+                            "ns3::MatrixBasedChannelModel::CacheEventTracedCallback")
+            .AddTraceSource(
+                "ChannelCacheEviction",
+                "A channel matrix has been evicted from the cache",
+                MakeTraceSourceAccessor(&ThreeGppChannelModel::m_channelCacheEvictionTrace),
+                "ns3::MatrixBasedChannelModel::CacheEventTracedCallback")
+            .AddTraceSource("ParamsCacheHit",
+                            "The channel params have been found in the cache",
+                            MakeTraceSourceAccessor(&ThreeGppChannelModel::m_paramsCacheHitTrace),
+                            "ns3::MatrixBasedChannelModel::CacheEventTracedCallback")
+            .AddTraceSource("ParamsCacheMiss",
+                            "The channel params have not been found in the cache",
+                            MakeTraceSourceAccessor(&ThreeGppChannelModel::m_paramsCacheMissTrace),
+                            "ns3::MatrixBasedChannelModel::CacheEventTracedCallback")
+            .AddTraceSource(
+                "ParamsCacheEviction",
+                "The channel params have been evicted from the cache",
+                MakeTraceSourceAccessor(&ThreeGppChannelModel::m_paramsCacheEvictionTrace),
+                "ns3::MatrixBasedChannelModel::CacheEventTracedCallback");
     return tid;
 }
 
@@ -1213,6 +1321,144 @@ ThreeGppChannelModel::GetScenario() const
     return m_scenario;
 }
 
+void
+ThreeGppChannelModel::SetUpdatePeriod(Time updatePeriod)
+{
+    NS_LOG_FUNCTION(this << updatePeriod);
+    m_updatePeriod = updatePeriod;
+    UpdateParamsCacheIdleTime();
+}
+
+Time
+ThreeGppChannelModel::GetUpdatePeriod() const
+{
+    return m_updatePeriod;
+}
+
+void
+ThreeGppChannelModel::SetEvictStaleParams(bool evict)
+{
+    NS_LOG_FUNCTION(this << evict);
+    m_evictStaleParams = evict;
+    UpdateParamsCacheIdleTime();
+}
+
+bool
+ThreeGppChannelModel::GetEvictStaleParams() const
+{
+    return m_evictStaleParams;
+}
+
+void
+ThreeGppChannelModel::UpdateParamsCacheIdleTime()
+{
+    // an entry which has not been accessed for longer than the update period
+    // was generated more than an update period ago, see ChannelParamsNeedsUpdate
+    m_channelParamsCache.SetMaxIdleTime(m_evictStaleParams ? m_updatePeriod : Time(0));
+}
+
+void
+ThreeGppChannelModel::SetChannelCacheMaxEntries(uint32_t maxEntries)
+{
+    NS_LOG_FUNCTION(this << maxEntries);
+    m_channelMatrixCache.SetMaxEntries(maxEntries);
+}
+
+uint32_t
+ThreeGppChannelModel::GetChannelCacheMaxEntries() const
+{
+    return m_channelMatrixCache.GetMaxEntries();
+}
+
+void
+ThreeGppChannelModel::SetChannelCacheMaxBytes(uint64_t maxBytes)
+{
+    NS_LOG_FUNCTION(this << maxBytes);
+    m_channelMatrixCache.SetMaxBytes(maxBytes);
+}
+
+uint64_t
+ThreeGppChannelModel::GetChannelCacheMaxBytes() const
+{
+    return m_channelMatrixCache.GetMaxBytes();
+}
+
+void
+ThreeGppChannelModel::SetChannelCacheIdleTime(Time idleTime)
+{
+    NS_LOG_FUNCTION(this << idleTime);
+    m_channelMatrixCache.SetMaxIdleTime(idleTime);
+}
+
+Time
+ThreeGppChannelModel::GetChannelCacheIdleTime() const
+{
+    return m_channelMatrixCache.GetMaxIdleTime();
+}
+
+void
+ThreeGppChannelModel::SetParamsCacheMaxEntries(uint32_t maxEntries)
+{
+    NS_LOG_FUNCTION(this << maxEntries);
+    m_channelParamsCache.SetMaxEntries(maxEntries);
+}
+
+uint32_t
+ThreeGppChannelModel::GetParamsCacheMaxEntries() const
+{
+    return m_channelParamsCache.GetMaxEntries();
+}
+
+uint64_t
+ThreeGppChannelModel::GetChannelCacheHits() const
+{
+    return m_channelMatrixCache.GetHits();
+}
+
+uint64_t
+ThreeGppChannelModel::GetChannelCacheMisses() const
+{
+    return m_channelMatrixCache.GetMisses();
+}
+
+uint64_t
+ThreeGppChannelModel::GetChannelCacheEvictions() const
+{
+    return m_channelMatrixCache.GetEvictions();
+}
+
+uint64_t
+ThreeGppChannelModel::GetParamsCacheHits() const
+{
+    return m_channelParamsCache.GetHits();
+}
+
+uint64_t
+ThreeGppChannelModel::GetParamsCacheMisses() const
+{
+    return m_channelParamsCache.GetMisses();
+}
+
+uint64_t
+ThreeGppChannelModel::GetParamsCacheEvictions() const
+{
+    return m_channelParamsCache.GetEvictions();
+}
+
+void
+ThreeGppChannelModel::NotifyChannelCacheEviction(uint64_t key)
+{
+    NS_LOG_DEBUG("channel matrix " << key << " evicted");
+    m_channelCacheEvictionTrace(key);
+}
+
+void
+ThreeGppChannelModel::NotifyParamsCacheEviction(uint64_t key)
+{
+    NS_LOG_DEBUG("channel params " << key << " evicted");
+    m_paramsCacheEvictionTrace(key);
+}
+
 Ptr<const ThreeGppChannelModel::ParamsTable>
 ThreeGppChannelModel::GetThreeGppTable(const Ptr<const MobilityModel> aMob,
                                        const Ptr<const MobilityModel> bMob,
@@ -2482,24 +2728,25 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     Ptr<const ChannelCondition> condition =
         m_channelConditionModel->GetChannelCondition(aMob, bMob);
 
-    // Check if the channel is present in the map and return it, otherwise
+    // Check if the channel is present in the cache and return it, otherwise
     // generate a new channel
     bool updateParams = false;
     bool updateMatrix = false;
     bool notFoundParams = false;
     bool notFoundMatrix = false;
     Ptr<ChannelMatrix> channelMatrix;
-    Ptr<ThreeGppChannelParams> channelParams;
+    Ptr<ThreeGppChannelParams> channelParams = m_channelParamsCache.Get(channelParamsKey);
 
-    if (m_channelParamsMap.find(channelParamsKey) != m_channelParamsMap.end())
+    if (channelParams)
     {
-        channelParams = m_channelParamsMap[channelParamsKey];
+        m_paramsCacheHitTrace(channelParamsKey);
         // check if it has to be updated
         updateParams = ChannelParamsNeedsUpdate(channelParams, condition);
     }
     else
     {
         NS_LOG_DEBUG("channel params not found");
+        m_paramsCacheMissTrace(channelParamsKey);
         notFoundParams = true;
     }
 
@@ -2518,25 +2765,29 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
         // Step 10: Draw initial phases
         channelParams = GenerateChannelParameters(condition, table3gpp, aMob, bMob);
         // store or replace the channel parameters
-        m_channelParamsMap[channelParamsKey] = channelParams;
+        m_channelParamsCache.Put(channelParamsKey, channelParams, sizeof(ThreeGppChannelParams));
     }
 
-    if (m_channelMatrixMap.find(channelMatrixKey) != m_channelMatrixMap.end())
+    channelMatrix = m_channelMatrixCache.Get(channelMatrixKey);
+    if (channelMatrix)
     {
-        // channel matrix present in the map
-        NS_LOG_DEBUG("channel matrix present in the map");
-        channelMatrix = m_channelMatrixMap[channelMatrixKey];
+        // channel matrix present in the cache
+        NS_LOG_DEBUG("channel matrix present in the cache");
+        m_channelCacheHitTrace(channelMatrixKey);
         updateMatrix = ChannelMatrixNeedsUpdate(channelParams, channelMatrix);
         updateMatrix |= AntennaSetupChanged(aAntenna, bAntenna, channelMatrix);
     }
     else
     {
         NS_LOG_DEBUG("channel matrix not found");
+        m_channelCacheMissTrace(channelMatrixKey);
         notFoundMatrix = true;
     }
 
-    // If the channel is not present in the map or if it has to be updated
-    // generate a new realization
+    // If the channel is not present in the cache or if it has to be updated
+    // generate a new realization. GetNewChannel does not draw any random
+    // variable, hence a matrix evicted from the cache is regenerated identical
+    // from the same channel params.
     if (notFoundMatrix || updateMatrix)
     {
         // channel matrix not found or has to be updated, generate a new one
@@ -2546,13 +2797,22 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
                            bAntenna->GetId()); // save antenna pair, with the exact order of s and u
                                                // antennas at the moment of the channel generation
 
-        // store or replace the channel matrix in the channel map
-        m_channelMatrixMap[channelMatrixKey] = channelMatrix;
+        // store or replace the channel matrix in the channel cache
+        m_channelMatrixCache.Put(channelMatrixKey,
+                                 channelMatrix,
+                                 GetMemoryFootprint(channelMatrix));
     }
 
     return channelMatrix;
 }
 
+uint64_t
+ThreeGppChannelModel::GetMemoryFootprint(Ptr<const ChannelMatrix> channelMatrix)
+{
+    return sizeof(ChannelMatrix) +
+           channelMatrix->m_channel.GetSize() * sizeof(std::complex<double>);
+}
+
 Ptr<const MatrixBasedChannelModel::ChannelParams>
 ThreeGppChannelModel::GetParams(Ptr<const MobilityModel> aMob, Ptr<const MobilityModel> bMob) const
 {
@@ -2562,15 +2822,12 @@ ThreeGppChannelModel::GetParams(Ptr<const MobilityModel> aMob, Ptr<const Mobilit
     uint64_t channelParamsKey =
         GetKey(aMob->GetObject<Node>()->GetId(), bMob->GetObject<Node>()->GetId());
 
-    if (m_channelParamsMap.find(channelParamsKey) != m_channelParamsMap.end())
+    Ptr<const ChannelParams> channelParams = m_channelParamsCache.Peek(channelParamsKey);
+    if (!channelParams)
     {
-        return m_channelParamsMap.find(channelParamsKey)->second;
-    }
-    else
-    {
-        NS_LOG_WARN("Channel params map not found. Returning a nullptr.");
-        return nullptr;
+        NS_LOG_WARN("Channel params not found. Returning a nullptr.");
     }
+    return channelParams;
 }
 
 Ptr<ThreeGppChannelModel::ThreeGppChannelParams>
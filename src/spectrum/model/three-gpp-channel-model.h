@@ -10,15 +10,16 @@
 #ifndef THREE_GPP_CHANNEL_H
 #define THREE_GPP_CHANNEL_H
 
+#include "bounded-channel-cache.h"
 #include "matrix-based-channel-model.h"
 
 #include "ns3/angles.h"
 #include "ns3/deprecated.h"
 #include <ns3/boolean.h>
 #include <ns3/channel-condition-model.h>
+#include <ns3/traced-callback.h>
 
 #include <complex.h>
-#include <unordered_map>
 
 namespace ns3
 {
@@ -92,10 +93,14 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
     std::string GetScenario() const;
 
     /**
-     * Looks for the channel matrix associated to the aMob and bMob pair in m_channelMatrixMap.
+     * Looks for the channel matrix associated to the aMob and bMob pair in m_channelMatrixCache.
      * If found, it checks if it has to be updated. If not found or if it has to
      * be updated, it generates a new uncorrelated channel matrix using the
-     * method GetNewChannel and updates m_channelMap.
+     * method GetNewChannel and updates m_channelMatrixCache.
+     *
+     * Channel matrices evicted from the cache are regenerated from the cached
+     * channel parameters, which is deterministic, so that bounding the matrix
+     * cache does not change the simulation results.
      *
      * @param aMob mobility model of the a device
      * @param bMob mobility model of the b device
@@ -110,7 +115,7 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
 
     /**
      * Looks for the channel params associated to the aMob and bMob pair in
-     * m_channelParamsMap. If not found it will return a nullptr.
+     * m_channelParamsCache. If not found it will return a nullptr.
      *
      * @param aMob mobility model of the a device
      * @param bMob mobility model of the b device
@@ -351,14 +356,22 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
                              Ptr<const PhasedArrayModel> bAntenna,
                              Ptr<const ChannelMatrix> channelMatrix);
 
-    std::unordered_map<uint64_t, Ptr<ChannelMatrix>>
-        m_channelMatrixMap; //!< map containing the channel realizations per pair of
-                            //!< PhasedAntennaArray instances, the key of this map is reciprocal
-                            //!< uniquely identifies a pair of PhasedAntennaArrays
-    std::unordered_map<uint64_t, Ptr<ThreeGppChannelParams>>
-        m_channelParamsMap; //!< map containing the common channel parameters per pair of nodes, the
-                            //!< key of this map is reciprocal and uniquely identifies a pair of
-                            //!< nodes
+    /**
+     * Estimate the memory used by a channel matrix, used to enforce the
+     * ChannelCacheMaxBytes bound
+     * @param channelMatrix the channel matrix
+     * @return the estimated memory in bytes
+     */
+    static uint64_t GetMemoryFootprint(Ptr<const ChannelMatrix> channelMatrix);
+
+    BoundedChannelCache<ChannelMatrix>
+        m_channelMatrixCache; //!< cache containing the channel realizations per pair of
+                              //!< PhasedAntennaArray instances, the key of this cache is
+                              //!< reciprocal and uniquely identifies a pair of PhasedAntennaArrays
+    BoundedChannelCache<ThreeGppChannelParams>
+        m_channelParamsCache; //!< cache containing the common channel parameters per pair of
+                              //!< nodes, the key of this cache is reciprocal and uniquely
+                              //!< identifies a pair of nodes
     Time m_updatePeriod;    //!< the channel update period
     double m_frequency;     //!< the operating frequency
     std::string m_scenario; //!< the 3GPP scenario
@@ -381,12 +394,138 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
     bool m_portraitMode;           //!< true if portrait mode, false if landscape
     double m_blockerSpeed;         //!< the blocker speed
 
+    // parameters for the channel caches
+    bool m_evictStaleParams; //!< evict the channel params older than the update period
+    TracedCallback<uint64_t> m_channelCacheHitTrace;      //!< channel matrix cache hit trace
+    TracedCallback<uint64_t> m_channelCacheMissTrace;     //!< channel matrix cache miss trace
+    TracedCallback<uint64_t> m_channelCacheEvictionTrace; //!< channel matrix eviction trace
+    TracedCallback<uint64_t> m_paramsCacheHitTrace;       //!< channel params cache hit trace
+    TracedCallback<uint64_t> m_paramsCacheMissTrace;      //!< channel params cache miss trace
+    TracedCallback<uint64_t> m_paramsCacheEvictionTrace;  //!< channel params eviction trace
+
     static const uint8_t PHI_INDEX = 0; //!< index of the PHI value in the m_nonSelfBlocking array
     static const uint8_t X_INDEX = 1;   //!< index of the X value in the m_nonSelfBlocking array
     static const uint8_t THETA_INDEX =
         2;                            //!< index of the THETA value in the m_nonSelfBlocking array
     static const uint8_t Y_INDEX = 3; //!< index of the Y value in the m_nonSelfBlocking array
     static const uint8_t R_INDEX = 4; //!< index of the R value in the m_nonSelfBlocking array
+
+  private:
+    /**
+     * Set the channel update period and the idle time of the channel params cache
+     * @param updatePeriod the channel update period
+     */
+    void SetUpdatePeriod(Time updatePeriod);
+
+    /**
+     * @return the channel update period
+     */
+    Time GetUpdatePeriod() const;
+
+    /**
+     * Enable or disable the eviction of the channel params older than the update period
+     * @param evict true to evict the stale channel params
+     */
+    void SetEvictStaleParams(bool evict);
+
+    /**
+     * @return true if the channel params older than the update period are evicted
+     */
+    bool GetEvictStaleParams() const;
+
+    /**
+     * Configure the idle time of the channel params cache. Channel params
+     * not accessed for longer than the update period would be regenerated at
+     * the next access anyway, hence evicting them does not change the
+     * sequence of the generated random numbers.
+     */
+    void UpdateParamsCacheIdleTime();
+
+    /**
+     * Set the maximum number of cached channel matrices
+     * @param maxEntries the maximum number of entries, zero means unbounded
+     */
+    void SetChannelCacheMaxEntries(uint32_t maxEntries);
+
+    /**
+     * @return the maximum number of cached channel matrices
+     */
+    uint32_t GetChannelCacheMaxEntries() const;
+
+    /**
+     * Set the maximum memory used by the cached channel matrices
+     * @param maxBytes the maximum memory in bytes, zero means unbounded
+     */
+    void SetChannelCacheMaxBytes(uint64_t maxBytes);
+
+    /**
+     * @return the maximum memory used by the cached channel matrices
+     */
+    uint64_t GetChannelCacheMaxBytes() const;
+
+    /**
+     * Set the maximum time a channel matrix is cached without being accessed
+     * @param idleTime the maximum idle time, zero means unbounded
+     */
+    void SetChannelCacheIdleTime(Time idleTime);
+
+    /**
+     * @return the maximum time a channel matrix is cached without being accessed
+     */
+    Time GetChannelCacheIdleTime() const;
+
+    /**
+     * Set the maximum number of cached channel params
+     * @param maxEntries the maximum number of entries, zero means unbounded
+     */
+    void SetParamsCacheMaxEntries(uint32_t maxEntries);
+
+    /**
+     * @return the maximum number of cached channel params
+     */
+    uint32_t GetParamsCacheMaxEntries() const;
+
+    /**
+     * @return the number of channel matrix cache hits
+     */
+    uint64_t GetChannelCacheHits() const;
+
+    /**
+     * @return the number of channel matrix cache misses
+     */
+    uint64_t GetChannelCacheMisses() const;
+
+    /**
+     * @return the number of evicted channel matrices
+     */
+    uint64_t GetChannelCacheEvictions() const;
+
+    /**
+     * @return the number of channel params cache hits
+     */
+    uint64_t GetParamsCacheHits() const;
+
+    /**
+     * @return the number of channel params cache misses
+     */
+    uint64_t GetParamsCacheMisses() const;
+
+    /**
+     * @return the number of evicted channel params
+     */
+    uint64_t GetParamsCacheEvictions() const;
+
+    /**
+     * Fire the channel matrix eviction trace
+     * @param key the key of the evicted channel matrix
+     */
+    void NotifyChannelCacheEviction(uint64_t key);
+
+    /**
+     * Fire the channel params eviction trace
+     * @param key the key of the evicted channel params
+     */
+    void NotifyParamsCacheEviction(uint64_t key);
 };
 } // namespace ns3
 
@@ -20,6 +20,8 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
 
 #include <map>
 
@@ -33,6 +35,8 @@ NS_OBJECT_ENSURE_REGISTERED(ThreeGppSpectrumPropagationLossModel);
 ThreeGppSpectrumPropagationLossModel::ThreeGppSpectrumPropagationLossModel()
 {
     NS_LOG_FUNCTION(this);
+    m_longTermCache.SetEvictionCallback(
+        MakeCallback(&ThreeGppSpectrumPropagationLossModel::NotifyLongTermCacheEviction, this));
 }
 
 ThreeGppSpectrumPropagationLossModel::~ThreeGppSpectrumPropagationLossModel()
@@ -43,7 +47,8 @@ ThreeGppSpectrumPropagationLossModel::~ThreeGppSpectrumPropagationLossModel()
 void
 ThreeGppSpectrumPropagationLossModel::DoDispose()
 {
-    m_longTermMap.clear();
+    m_longTermCache.Clear();
+    m_portWeightsCache.Clear();
     m_channelModel->Dispose();
     m_channelModel = nullptr;
 }
@@ -62,7 +67,75 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId()
                 StringValue("ns3::ThreeGppChannelModel"),
                 MakePointerAccessor(&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                     &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
-                MakePointerChecker<MatrixBasedChannelModel>());
+                MakePointerChecker<MatrixBasedChannelModel>())
+            .AddAttribute(
+                "LongTermCacheMaxEntries",
+                "The maximum number of cached long term components (0 means unbounded). "
+                "The least recently used components are evicted first. The port weights "
+                "of the antenna arrays are cached with the same bound.",
+                UintegerValue(0),
+                MakeUintegerAccessor(
+                    &ThreeGppSpectrumPropagationLossModel::SetLongTermCacheMaxEntries,
+                    &ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMaxEntries),
+                MakeUintegerChecker<uint32_t>())
+            .AddAttribute(
+                "LongTermCacheMaxBytes",
+                "The maximum memory in bytes used by the cached long term components, "
+                "and separately by the cached port weights (0 means unbounded)",
+                UintegerValue(0),
+                MakeUintegerAccessor(
+                    &ThreeGppSpectrumPropagationLossModel::SetLongTermCacheMaxBytes,
+                    &ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMaxBytes),
+                MakeUintegerChecker<uint64_t>())
+            .AddAttribute(
+                "LongTermCacheIdleTime",
+                "The long term components and the port weights not accessed for longer "
+                "than this time are evicted (0 means never)",
+                TimeValue(Seconds(0)),
+                MakeTimeAccessor(&ThreeGppSpectrumPropagationLossModel::SetLongTermCacheIdleTime,
+                                 &ThreeGppSpectrumPropagationLossModel::GetLongTermCacheIdleTime),
+                MakeTimeChecker())
+            .AddAttribute(
+                "LongTermCacheHits",
+                "The number of long term cache hits",
+                TypeId::ATTR_GET,
+                UintegerValue(0),
+                MakeUintegerAccessor(&ThreeGppSpectrumPropagationLossModel::GetLongTermCacheHits),
+                MakeUintegerChecker<uint64_t>())
+            .AddAttribute(
+                "LongTermCacheMisses",
+                "The number of long term cache misses",
+                TypeId::ATTR_GET,
+                UintegerValue(0),
+                MakeUintegerAccessor(
+                    &ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMisses),
+                MakeUintegerChecker<uint64_t>())
+            .AddAttribute(
+                "LongTermCacheEvictions",
+                "The number of evicted long term components",
+                TypeId::ATTR_GET,
+                UintegerValue(0),
+                MakeUintegerAccessor(
+                    &ThreeGppSpectrumPropagationLossModel::GetLongTermCacheEvictions),
+                MakeUintegerChecker<uint64_t>())
+            .AddTraceSource(
+                "LongTermCacheHit",
+                "A long term component has been found in the cache",
+                MakeTraceSourceAccessor(
+                    &ThreeGppSpectrumPropagationLossModel::m_longTermCacheHitTrace),
+                "ns3::MatrixBasedChannelModel::CacheEventTracedCallback")
+            .AddTraceSource(
+                "LongTermCacheMiss",
+                "A long term component has not been found in the cache",
+                MakeTraceSourceAccessor(
+                    &ThreeGppSpectrumPropagationLossModel::m_longTermCacheMissTrace),
+                "ns3::MatrixBasedChannelModel::CacheEventTracedCallback")
+            .AddTraceSource(
+                "LongTermCacheEviction",
+                "A long term component has been evicted from the cache",
+                MakeTraceSourceAccessor(
+                    &ThreeGppSpectrumPropagationLossModel::m_longTermCacheEvictionTrace),
+                "ns3::MatrixBasedChannelModel::CacheEventTracedCallback");
     return tid;
 }
 
@@ -78,6 +151,82 @@ ThreeGppSpectrumPropagationLossModel::GetChannelModel() const
     return m_channelModel;
 }
 
+void
+ThreeGppSpectrumPropagationLossModel::SetLongTermCacheMaxEntries(uint32_t maxEntries)
+{
+    NS_LOG_FUNCTION(this << maxEntries);
+    m_longTermCache.SetMaxEntries(maxEntries);
+    m_portWeightsCache.SetMaxEntries(maxEntries);
+}
+
+uint32_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMaxEntries() const
+{
+    return m_longTermCache.GetMaxEntries();
+}
+
+void
+ThreeGppSpectrumPropagationLossModel::SetLongTermCacheMaxBytes(uint64_t maxBytes)
+{
+    NS_LOG_FUNCTION(this << maxBytes);
+    m_longTermCache.SetMaxBytes(maxBytes);
+    m_portWeightsCache.SetMaxBytes(maxBytes);
+}
+
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMaxBytes() const
+{
+    return m_longTermCache.GetMaxBytes();
+}
+
+void
+ThreeGppSpectrumPropagationLossModel::SetLongTermCacheIdleTime(Time idleTime)
+{
+    NS_LOG_FUNCTION(this << idleTime);
+    m_longTermCache.SetMaxIdleTime(idleTime);
+    m_portWeightsCache.SetMaxIdleTime(idleTime);
+}
+
+Time
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheIdleTime() const
+{
+    return m_longTermCache.GetMaxIdleTime();
+}
+
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheHits() const
+{
+    return m_longTermCache.GetHits();
+}
+
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheMisses() const
+{
+    return m_longTermCache.GetMisses();
+}
+
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheEvictions() const
+{
+    return m_longTermCache.GetEvictions();
+}
+
+void
+ThreeGppSpectrumPropagationLossModel::NotifyLongTermCacheEviction(uint64_t key)
+{
+    NS_LOG_DEBUG("long term component " << key << " evicted");
+    m_longTermCacheEvictionTrace(key);
+}
+
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetMemoryFootprint(Ptr<const LongTerm> longTerm)
+{
+    return sizeof(LongTerm) +
+           (longTerm->m_longTerm->GetSize() + longTerm->m_txProduct->GetSize() +
+            longTerm->m_sW.GetSize() + longTerm->m_uW.GetSize()) *
+               sizeof(std::complex<double>);
+}
+
 double
 ThreeGppSpectrumPropagationLossModel::GetFrequency() const
 {
@@ -100,6 +249,82 @@ ThreeGppSpectrumPropagationLossModel::GetChannelModelAttribute(const std::string
     m_channelModel->GetAttribute(name, value);
 }
 
+Ptr<const ThreeGppSpectrumPropagationLossModel::PortWeights>
+ThreeGppSpectrumPropagationLossModel::GetPortWeights(Ptr<const PhasedArrayModel> antenna) const
+{
+    NS_LOG_FUNCTION(this << antenna);
+
+    const PhasedArrayModel::ComplexVector& w = antenna->GetBeamformingVectorRef();
+    size_t numElems = antenna->GetNumElems();
+    uint16_t numPorts = antenna->GetNumPorts();
+
+    Ptr<const PortWeights> cached = m_portWeightsCache.Get(antenna->GetId());
+    if (cached && cached->m_weights.GetNumRows() == numElems &&
+        cached->m_weights.GetNumCols() == numPorts && cached->m_w == w)
+    {
+        return cached;
+    }
+
+    NS_LOG_DEBUG("compute the port weights of antenna " << antenna->GetId());
+    Ptr<PortWeights> portWeights = Create<PortWeights>();
+    portWeights->m_w = w;
+    portWeights->m_weights = MatrixBasedChannelModel::Complex2DVector(numElems, numPorts);
+    // The elements of a port are mapped to the array as done by CalculateLongTermComponent,
+    // i.e., the same beam weights are used for all the ports
+    const auto elemsPerPort = antenna->GetNumElemsPerPort();
+    const auto hElemsPerPort = antenna->GetHElemsPerPort();
+    for (uint16_t portIdx = 0; portIdx < numPorts; portIdx++)
+    {
+        size_t start = antenna->ArrayIndexFromPortIndex(portIdx, 0);
+        size_t index = start;
+        for (size_t elemIdx = 0; elemIdx < elemsPerPort; elemIdx++, index++)
+        {
+            portWeights->m_weights(index, portIdx) = w[index - start];
+            if (elemIdx % hElemsPerPort == hElemsPerPort - 1)
+            {
+                index += antenna->GetNumColumns() - hElemsPerPort; // reach the next column
+            }
+        }
+    }
+    portWeights->m_weightsTransposed = portWeights->m_weights.Transpose();
+    m_portWeightsCache.Put(antenna->GetId(),
+                           portWeights,
+                           sizeof(PortWeights) + (w.GetSize() + 2 * numElems * numPorts) *
+                                                     sizeof(std::complex<double>));
+    return portWeights;
+}
+
+Ptr<const MatrixBasedChannelModel::Complex3DVector>
+ThreeGppSpectrumPropagationLossModel::CalcTxProduct(
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+    Ptr<const PhasedArrayModel> sAnt) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(sAnt, "Improper call to the method");
+    NS_ASSERT(sAnt->GetNumElems() == channelMatrix->m_channel.GetNumCols());
+
+    Ptr<const PortWeights> sWeights = GetPortWeights(sAnt);
+    size_t numClusters = channelMatrix->m_channel.GetNumPages();
+    // H * W_s for all the clusters, the result has dimensions #uElems, #sPorts, #cluster
+    return Create<MatrixBasedChannelModel::Complex3DVector>(
+        channelMatrix->m_channel * sWeights->m_weights.MakeNCopies(numClusters));
+}
+
+Ptr<const MatrixBasedChannelModel::Complex3DVector>
+ThreeGppSpectrumPropagationLossModel::CalcLongTermFromTxProduct(
+    Ptr<const MatrixBasedChannelModel::Complex3DVector> txProduct,
+    Ptr<const PhasedArrayModel> uAnt) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(uAnt, "Improper call to the method");
+    NS_ASSERT(uAnt->GetNumElems() == txProduct->GetNumRows());
+
+    Ptr<const PortWeights> uWeights = GetPortWeights(uAnt);
+    // W_u^T * (H * W_s) for all the clusters, the result has dimensions #uPorts, #sPorts, #cluster
+    return Create<MatrixBasedChannelModel::Complex3DVector>(
+        uWeights->m_weightsTransposed.MakeNCopies(txProduct->GetNumPages()) * (*txProduct));
+}
+
 Ptr<const MatrixBasedChannelModel::Complex3DVector>
 ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
     Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
@@ -107,38 +332,14 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
     Ptr<const PhasedArrayModel> uAnt) const
 {
     NS_LOG_FUNCTION(this);
-
-    const PhasedArrayModel::ComplexVector& sW = sAnt->GetBeamformingVectorRef();
-    const PhasedArrayModel::ComplexVector& uW = uAnt->GetBeamformingVectorRef();
-    size_t sAntNumElems = sW.GetSize();
-    size_t uAntNumElems = uW.GetSize();
-    NS_ASSERT(uAntNumElems == params->m_channel.GetNumRows());
-    NS_ASSERT(sAntNumElems == params->m_channel.GetNumCols());
-    NS_LOG_DEBUG("CalcLongTerm with " << uW.GetSize() << " u antenna elements and " << sW.GetSize()
-                                      << " s antenna elements, and with "
+    NS_ASSERT_MSG((sAnt != nullptr) && (uAnt != nullptr), "Improper call to the method");
+    NS_LOG_DEBUG("CalcLongTerm with " << uAnt->GetNumElems() << " u antenna elements and "
+                                      << sAnt->GetNumElems() << " s antenna elements, and with "
                                       << " s ports: " << sAnt->GetNumPorts()
                                       << " u ports: " << uAnt->GetNumPorts());
-    NS_ASSERT_MSG((sAnt != nullptr) && (uAnt != nullptr), "Improper call to the method");
-    size_t numClusters = params->m_channel.GetNumPages();
-    // create and initialize the size of the longTerm 3D matrix
-    Ptr<MatrixBasedChannelModel::Complex3DVector> longTerm =
-        Create<MatrixBasedChannelModel::Complex3DVector>(uAnt->GetNumPorts(),
-                                                         sAnt->GetNumPorts(),
-                                                         numClusters);
     // Calculate long term uW * Husn * sW, the result is a matrix
     // with the dimensions #uPorts, #sPorts, #cluster
-    for (auto sPortIdx = 0; sPortIdx < sAnt->GetNumPorts(); sPortIdx++)
-    {
-        for (auto uPortIdx = 0; uPortIdx < uAnt->GetNumPorts(); uPortIdx++)
-        {
-            for (size_t cIndex = 0; cIndex < numClusters; cIndex++)
-            {
-                longTerm->Elem(uPortIdx, sPortIdx, cIndex) =
-                    CalculateLongTermComponent(params, sAnt, uAnt, sPortIdx, uPortIdx, cIndex);
-            }
-        }
-    }
-    return longTerm;
+    return CalcLongTermFromTxProduct(CalcTxProduct(params, sAnt), uAnt);
 }
 
 std::complex<double>
@@ -341,8 +542,6 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
     size_t numCluster = channelMatrix->m_channel.GetNumPages();
     auto numRb = inPsd->GetValuesN();
 
-    auto directionalLongTerm = isReverse ? longTerm->Transpose() : (*longTerm);
-
     Ptr<MatrixBasedChannelModel::Complex3DVector> chanSpct =
         Create<MatrixBasedChannelModel::Complex3DVector>(numRxPorts, numTxPorts, (uint16_t)numRb);
 
@@ -351,12 +550,12 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
     // and RB width (12*SCS) are reset, ensuring these values are updated too
     double rbWidth = inPsd->ConstBandsBegin()->fh - inPsd->ConstBandsBegin()->fl;
 
-    if (channelParams->m_cachedDelaySincos.GetNumRows() != numRb ||
-        channelParams->m_cachedDelaySincos.GetNumCols() != numCluster ||
+    if (channelParams->m_cachedDelaySincos.GetNumRows() != numCluster ||
+        channelParams->m_cachedDelaySincos.GetNumCols() != numRb ||
         channelParams->m_cachedRbWidth != rbWidth)
     {
         channelParams->m_cachedRbWidth = rbWidth;
-        channelParams->m_cachedDelaySincos = ComplexMatrixArray(numRb, numCluster);
+        channelParams->m_cachedDelaySincos = ComplexMatrixArray(numCluster, numRb);
         auto sbit = inPsd->ConstBandsBegin(); // band iterator
         for (unsigned i = 0; i < numRb; i++)
         {
@@ -364,27 +563,33 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
             for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
                 double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
-                channelParams->m_cachedDelaySincos(i, cIndex) =
+                channelParams->m_cachedDelaySincos(cIndex, i) =
                     std::complex<double>(cos(delay), sin(delay));
             }
             sbit++;
         }
     }
 
-    // Compute the product between the doppler and the delay sincos
-    auto delaySincosCopy = channelParams->m_cachedDelaySincos;
-    for (size_t iRb = 0; iRb < inPsd->GetValuesN(); iRb++)
+    // If "params" (ChannelMatrix) and longTerm were computed for the reverse direction (e.g. this
+    // is a DL transmission but params and longTerm were last updated during UL), then the elements
+    // in longTerm start from different offsets.
+    auto directionalLongTerm = isReverse ? longTerm->Transpose() : (*longTerm);
+
+    // Apply the doppler term to the long term component once, rather than
+    // once for every RB
+    const size_t numPortPairs = numRxPorts * numTxPorts;
+    for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
     {
-        for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
+        std::complex<double>* ltPage = directionalLongTerm.GetPagePtr(cIndex);
+        for (size_t i = 0; i < numPortPairs; i++)
         {
-            delaySincosCopy(iRb, cIndex) *= doppler[cIndex];
+            ltPage[i] *= doppler[cIndex];
         }
     }
 
-    // If "params" (ChannelMatrix) and longTerm were computed for the reverse direction (e.g. this
-    // is a DL transmission but params and longTerm were last updated during UL), then the elements
-    // in longTerm start from different offsets.
-
+    // The delay sincos of the clusters of a RB are contiguous, so that the channel
+    // matrix of each RB is a linear combination of the pages of the long term component
+    const std::complex<double>* delaySincos = channelParams->m_cachedDelaySincos.GetPagePtr(0);
     auto vit = inPsd->ValuesBegin(); // psd iterator
     size_t iRb = 0;
     // Compute the frequency-domain channel matrix
@@ -392,22 +597,23 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
     {
         if ((*vit) != 0.00)
         {
-            auto sqrtVit = sqrt(*vit);
-            for (auto rxPortIdx = 0; rxPortIdx < numRxPorts; rxPortIdx++)
+            std::complex<double>* rbPage = chanSpct->GetPagePtr(iRb);
+            const std::complex<double>* rbDelaySincos = delaySincos + iRb * numCluster;
+            for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
-                for (auto txPortIdx = 0; txPortIdx < numTxPorts; txPortIdx++)
+                const std::complex<double>* ltPage = directionalLongTerm.GetPagePtr(cIndex);
+                for (size_t i = 0; i < numPortPairs; i++)
                 {
-                    std::complex<double> subsbandGain(0.0, 0.0);
-                    for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
-                    {
-                        subsbandGain += directionalLongTerm(rxPortIdx, txPortIdx, cIndex) *
-                                        delaySincosCopy(iRb, cIndex);
-                    }
-                    // Multiply with the square root of the input PSD so that the norm (absolute
-                    // value squared) of chanSpct will be the output PSD
-                    chanSpct->Elem(rxPortIdx, txPortIdx, iRb) = sqrtVit * subsbandGain;
+                    rbPage[i] += ltPage[i] * rbDelaySincos[cIndex];
                 }
             }
+            // Multiply with the square root of the input PSD so that the norm (absolute
+            // value squared) of chanSpct will be the output PSD
+            auto sqrtVit = sqrt(*vit);
+            for (size_t i = 0; i < numPortPairs; i++)
+            {
+                rbPage[i] *= sqrtVit;
+            }
         }
         vit++;
         iRb++;
@@ -451,39 +657,54 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm(
     uint64_t longTermId =
         MatrixBasedChannelModel::GetKey(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId());
 
-    // look for the long term in the map and check if it is valid
-    if (m_longTermMap.find(longTermId) != m_longTermMap.end())
+    // look for the long term in the cache and check if it is valid
+    Ptr<const LongTerm> longTermItem = m_longTermCache.Get(longTermId);
+    if (longTermItem)
     {
-        NS_LOG_DEBUG("found the long term component in the map");
-        longTerm = m_longTermMap[longTermId]->m_longTerm;
+        NS_LOG_DEBUG("found the long term component in the cache");
+        m_longTermCacheHitTrace(longTermId);
+        longTerm = longTermItem->m_longTerm;
 
         // check if the channel matrix has been updated
         // or the s beam has been changed
         // or the u beam has been changed
-        update = (m_longTermMap[longTermId]->m_channel->m_generatedTime !=
-                      channelMatrix->m_generatedTime ||
-                  m_longTermMap[longTermId]->m_sW != sW || m_longTermMap[longTermId]->m_uW != uW);
+        update = (longTermItem->m_channelGeneratedTime != channelMatrix->m_generatedTime ||
+                  longTermItem->m_sW != sW || longTermItem->m_uW != uW);
     }
     else
     {
         NS_LOG_DEBUG("long term component NOT found");
+        m_longTermCacheMissTrace(longTermId);
         notFound = true;
     }
 
     if (update || notFound)
     {
         NS_LOG_DEBUG("compute the long term");
-        // compute the long term component
-        longTerm = CalcLongTerm(channelMatrix, sAntenna, uAntenna);
-        Ptr<LongTerm> longTermItem = Create<LongTerm>();
-        longTermItem->m_longTerm = longTerm;
-        longTermItem->m_channel = channelMatrix;
-        longTermItem->m_sW = std::move(sW);
-        longTermItem->m_uW = std::move(uW);
+        // compute the long term component, reusing the product between the
+        // channel matrix and the s port weights if only the u beam has changed
+        Ptr<const MatrixBasedChannelModel::Complex3DVector> txProduct;
+        if (update && longTermItem->m_channelGeneratedTime == channelMatrix->m_generatedTime &&
+            longTermItem->m_sW == sW)
+        {
+            NS_LOG_DEBUG("reuse the product between the channel matrix and the s port weights");
+            txProduct = longTermItem->m_txProduct;
+        }
+        else
+        {
+            txProduct = CalcTxProduct(channelMatrix, sAntenna);
+        }
+        longTerm = CalcLongTermFromTxProduct(txProduct, uAntenna);
+        Ptr<LongTerm> newLongTermItem = Create<LongTerm>();
+        newLongTermItem->m_longTerm = longTerm;
+        newLongTermItem->m_txProduct = txProduct;
+        newLongTermItem->m_channelGeneratedTime = channelMatrix->m_generatedTime;
+        newLongTermItem->m_sW = std::move(sW);
+        newLongTermItem->m_uW = std::move(uW);
         // store the long term to reduce computation load
         // only the small scale fading needs to be updated if the large scale parameters and antenna
         // weights remain unchanged.
-        m_longTermMap[longTermId] = longTermItem;
+        m_longTermCache.Put(longTermId, newLongTermItem, GetMemoryFootprint(newLongTermItem));
     }
 
     return longTerm;
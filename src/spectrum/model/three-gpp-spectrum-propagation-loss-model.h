@@ -10,10 +10,12 @@
 #ifndef THREE_GPP_SPECTRUM_PROPAGATION_LOSS_H
 #define THREE_GPP_SPECTRUM_PROPAGATION_LOSS_H
 
+#include "bounded-channel-cache.h"
 #include "matrix-based-channel-model.h"
 #include "phased-array-spectrum-propagation-loss-model.h"
 
 #include "ns3/random-variable-stream.h"
+#include "ns3/traced-callback.h"
 
 #include <complex.h>
 #include <map>
@@ -105,7 +107,9 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
      * the propagation delay.
      * To reduce the computational load, the long term component associated with
      * a certain channel is cached and recomputed only when the channel realization
-     * is updated, or when the beamforming vectors change.
+     * is updated, or when the beamforming vectors change. The cache can be
+     * bounded through the LongTermCache* attributes; evicted components are
+     * recomputed from the channel matrix, so the results are not affected.
      *
      * @param spectrumSignalParams spectrum signal tx parameters
      * @param a first node mobility model
@@ -129,14 +133,33 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
     {
         Ptr<const MatrixBasedChannelModel::Complex3DVector>
             m_longTerm; //!< vector containing the long term component for each cluster
-        Ptr<const MatrixBasedChannelModel::ChannelMatrix>
-            m_channel; //!< pointer to the channel matrix used to compute the long term
+        Time m_channelGeneratedTime; //!< generation time of the channel matrix used to compute
+                                     //!< the long term
+        Ptr<const MatrixBasedChannelModel::Complex3DVector>
+            m_txProduct; //!< the product between the channel matrix and the port weights of
+                         //!< the s node, reused when only the beamforming vector of the u node
+                         //!< changes
         PhasedArrayModel::ComplexVector
             m_sW; //!< the beamforming vector for the node s used to compute the long term
         PhasedArrayModel::ComplexVector
             m_uW; //!< the beamforming vector for the node u used to compute the long term
     };
 
+    /**
+     * Data structure that stores the beamforming weights of an antenna array
+     * arranged per port, i.e., as a matrix with dimensions numElems x numPorts
+     * whose column p contains the weights applied to the elements of port p
+     * and zero elsewhere. This allows computing the long term component of all
+     * the port pairs as a matrix product.
+     */
+    struct PortWeights : public SimpleRefCount<PortWeights>
+    {
+        PhasedArrayModel::ComplexVector m_w; //!< the beamforming vector used to compute the weights
+        MatrixBasedChannelModel::Complex2DVector m_weights; //!< weights, numElems x numPorts
+        MatrixBasedChannelModel::Complex2DVector
+            m_weightsTransposed; //!< transposed weights, numPorts x numElems
+    };
+
     /**
      * Computes the frequency-domain channel matrix with the dimensions numRxPorts*numTxPorts*numRBs
      * @param inPsd the input PSD
@@ -166,7 +189,7 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
     double GetFrequency() const;
 
     /**
-     * Looks for the long term component in m_longTermMap. If found, checks
+     * Looks for the long term component in m_longTermCache. If found, checks
      * whether it has to be updated. If not found or if it has to be updated,
      * calls the method CalcLongTerm to compute it.
      * @param channelMatrix the channel matrix
@@ -190,6 +213,37 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         Ptr<const PhasedArrayModel> sAnt,
         Ptr<const PhasedArrayModel> uAnt) const;
 
+    /**
+     * Computes the product between the channel matrix and the port weights of
+     * the s device, i.e., for each cluster, H * W_s
+     * @param channelMatrix the channel matrix H
+     * @param sAnt the pointer to the antenna of the s device
+     * @return the product, with dimensions numElems(u) x numPorts(s) x numClusters
+     */
+    Ptr<const MatrixBasedChannelModel::Complex3DVector> CalcTxProduct(
+        Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+        Ptr<const PhasedArrayModel> sAnt) const;
+
+    /**
+     * Computes the long term component from the product between the channel
+     * matrix and the port weights of the s device, i.e., for each cluster,
+     * W_u^T * (H * W_s)
+     * @param txProduct the product computed by CalcTxProduct
+     * @param uAnt the pointer to the antenna of the u device
+     * @return the long term component
+     */
+    Ptr<const MatrixBasedChannelModel::Complex3DVector> CalcLongTermFromTxProduct(
+        Ptr<const MatrixBasedChannelModel::Complex3DVector> txProduct,
+        Ptr<const PhasedArrayModel> uAnt) const;
+
+    /**
+     * Returns the port weights of an antenna array. They are recomputed only
+     * when the beamforming vector or the configuration of the array change.
+     * @param antenna the antenna array
+     * @return the port weights
+     */
+    Ptr<const PortWeights> GetPortWeights(Ptr<const PhasedArrayModel> antenna) const;
+
     /**
      * @brief Computes a longTerm component from a specific port of s device to the
      * specific port of u device and for a specific cluster index
@@ -235,9 +289,78 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
 
     int64_t DoAssignStreams(int64_t stream) override;
 
-    mutable std::unordered_map<uint64_t, Ptr<const LongTerm>>
-        m_longTermMap;                           //!< map containing the long term components
+    /**
+     * Estimate the memory used by a long term component, used to enforce the
+     * LongTermCacheMaxBytes bound
+     * @param longTerm the long term component
+     * @return the estimated memory in bytes
+     */
+    static uint64_t GetMemoryFootprint(Ptr<const LongTerm> longTerm);
+
+    mutable BoundedChannelCache<const LongTerm>
+        m_longTermCache;                         //!< cache containing the long term components
     Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
+    /// the port weights of the antenna arrays, indexed by array ID, bounded as m_longTermCache
+    mutable BoundedChannelCache<const PortWeights> m_portWeightsCache;
+
+    TracedCallback<uint64_t> m_longTermCacheHitTrace;      //!< long term cache hit trace
+    TracedCallback<uint64_t> m_longTermCacheMissTrace;     //!< long term cache miss trace
+    TracedCallback<uint64_t> m_longTermCacheEvictionTrace; //!< long term eviction trace
+
+  private:
+    /**
+     * Set the maximum number of cached long term components
+     * @param maxEntries the maximum number of entries, zero means unbounded
+     */
+    void SetLongTermCacheMaxEntries(uint32_t maxEntries);
+
+    /**
+     * @return the maximum number of cached long term components
+     */
+    uint32_t GetLongTermCacheMaxEntries() const;
+
+    /**
+     * Set the maximum memory used by the cached long term components
+     * @param maxBytes the maximum memory in bytes, zero means unbounded
+     */
+    void SetLongTermCacheMaxBytes(uint64_t maxBytes);
+
+    /**
+     * @return the maximum memory used by the cached long term components
+     */
+    uint64_t GetLongTermCacheMaxBytes() const;
+
+    /**
+     * Set the maximum time a long term component is cached without being accessed
+     * @param idleTime the maximum idle time, zero means unbounded
+     */
+    void SetLongTermCacheIdleTime(Time idleTime);
+
+    /**
+     * @return the maximum time a long term component is cached without being accessed
+     */
+    Time GetLongTermCacheIdleTime() const;
+
+    /**
+     * @return the number of long term cache hits
+     */
+    uint64_t GetLongTermCacheHits() const;
+
+    /**
+     * @return the number of long term cache misses
+     */
+    uint64_t GetLongTermCacheMisses() const;
+
+    /**
+     * @return the number of evicted long term components
+     */
+    uint64_t GetLongTermCacheEvictions() const;
+
+    /**
+     * Fire the long term eviction trace
+     * @param key the key of the evicted long term component
+     */
+    void NotifyLongTermCacheEviction(uint64_t key);
 };
 } // namespace ns3
 
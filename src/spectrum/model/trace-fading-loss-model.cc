@@ -13,13 +13,23 @@
 #include "spectrum-value.h"
 
 #include "ns3/uinteger.h"
+#include <ns3/abort.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
 #include <ns3/simulator.h>
 #include <ns3/string.h>
 
+#include <cstring>
 #include <fstream>
+#include <map>
+#include <tuple>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace ns3
 {
@@ -28,6 +38,169 @@ NS_LOG_COMPONENT_DEFINE("TraceFadingLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED(TraceFadingLossModel);
 
+/**
+ * The header of a binary trace, followed by the samples of all the RBs for
+ * each time instant
+ */
+struct BinaryFadingTraceHeader
+{
+    char m_magic[8];       ///< identifies the binary traces
+    uint32_t m_rbNum;      ///< the number of RBs
+    uint32_t m_samplesNum; ///< the number of samples of each RB
+};
+
+/// The magic string of the binary traces (version 1)
+static const char BINARY_FADING_TRACE_MAGIC[8] = {'n', 's', '3', 'f', 'a', 'd', 'e', '1'};
+
+class TraceFadingLossModel::FadingTrace
+{
+  public:
+    /**
+     * Load a trace file
+     * @param fileName the trace file
+     * @param rbNum the number of RBs to load
+     * @param samplesNum the number of samples of each RB to load
+     */
+    FadingTrace(const std::string& fileName, uint32_t rbNum, uint32_t samplesNum);
+    ~FadingTrace();
+
+    // the samples may be memory-mapped
+    FadingTrace(const FadingTrace&) = delete;
+    FadingTrace& operator=(const FadingTrace&) = delete;
+
+    /**
+     * Get a trace file, loading it only if no model is using it
+     * @param fileName the trace file
+     * @param rbNum the number of RBs to load
+     * @param samplesNum the number of samples of each RB to load
+     * @return the trace
+     */
+    static std::shared_ptr<const FadingTrace> Get(const std::string& fileName,
+                                                  uint32_t rbNum,
+                                                  uint32_t samplesNum);
+
+    /**
+     * @param index the index of the time instant
+     * @return the samples of all the RBs at the time instant
+     */
+    const double* GetSamples(uint32_t index) const
+    {
+        return m_samples + static_cast<std::size_t>(index) * m_stride;
+    }
+
+  private:
+    const double* m_samples;     ///< the samples, all the RBs of each time instant contiguously
+    std::size_t m_stride;        ///< the distance between two time instants in m_samples
+    std::vector<double> m_buffer; ///< the samples, if they are not memory-mapped
+    void* m_mapping;             ///< the memory-mapped trace file
+    std::size_t m_mappingSize;   ///< the size of the memory-mapped trace file
+};
+
+TraceFadingLossModel::FadingTrace::FadingTrace(const std::string& fileName,
+                                               uint32_t rbNum,
+                                               uint32_t samplesNum)
+    : m_samples(nullptr),
+      m_stride(rbNum),
+      m_mapping(nullptr),
+      m_mappingSize(0)
+{
+    NS_LOG_FUNCTION(this << fileName << rbNum << samplesNum);
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    NS_ABORT_MSG_IF(!file.good(), "Fading trace file not found: " << fileName);
+
+    BinaryFadingTraceHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (file.gcount() == sizeof(header) &&
+        std::memcmp(header.m_magic, BINARY_FADING_TRACE_MAGIC, sizeof(header.m_magic)) == 0)
+    {
+        NS_ABORT_MSG_IF(header.m_rbNum < rbNum || header.m_samplesNum < samplesNum,
+                        "The fading trace " << fileName << " has " << header.m_rbNum
+                                            << " RBs and " << header.m_samplesNum << " samples");
+        m_stride = header.m_rbNum;
+        std::size_t samplesSize = sizeof(double) * m_stride * header.m_samplesNum;
+        file.seekg(0, std::ios::end);
+        NS_ABORT_MSG_IF(static_cast<std::size_t>(file.tellg()) < sizeof(header) + samplesSize,
+                        "The fading trace " << fileName << " is truncated");
+#ifdef HAVE_SYS_MMAN_H
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            std::size_t size = sizeof(header) + samplesSize;
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (mapping != MAP_FAILED)
+            {
+                m_mapping = mapping;
+                m_mappingSize = size;
+                m_samples = reinterpret_cast<const double*>(static_cast<const char*>(mapping) +
+                                                            sizeof(header));
+                return;
+            }
+        }
+        NS_LOG_WARN("Cannot map the fading trace " << fileName << ", reading it");
+#endif
+        m_buffer.resize(m_stride * header.m_samplesNum);
+        file.seekg(sizeof(header));
+        file.read(reinterpret_cast<char*>(m_buffer.data()), samplesSize);
+        NS_ABORT_MSG_IF(!file, "Cannot read the fading trace " << fileName);
+        m_samples = m_buffer.data();
+        return;
+    }
+
+    // text trace: the samples of each RB on a line
+    file.clear();
+    file.seekg(0);
+    m_buffer.resize(m_stride * samplesNum);
+    for (uint32_t i = 0; i < rbNum; i++)
+    {
+        for (uint32_t j = 0; j < samplesNum; j++)
+        {
+            file >> m_buffer[j * m_stride + i];
+        }
+    }
+    NS_ABORT_MSG_IF(!file,
+                    "The fading trace " << fileName << " has less than " << rbNum << " RBs of "
+                                        << samplesNum << " samples");
+    m_samples = m_buffer.data();
+}
+
+TraceFadingLossModel::FadingTrace::~FadingTrace()
+{
+    NS_LOG_FUNCTION(this);
+#ifdef HAVE_SYS_MMAN_H
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+std::shared_ptr<const TraceFadingLossModel::FadingTrace>
+TraceFadingLossModel::FadingTrace::Get(const std::string& fileName,
+                                       uint32_t rbNum,
+                                       uint32_t samplesNum)
+{
+    // the traces are released when the last model using them is destroyed
+    static std::map<std::tuple<std::string, uint32_t, uint32_t>, std::weak_ptr<const FadingTrace>>
+        traces;
+    std::weak_ptr<const FadingTrace>& trace = traces[{fileName, rbNum, samplesNum}];
+    std::shared_ptr<const FadingTrace> sharedTrace = trace.lock();
+    if (!sharedTrace)
+    {
+        sharedTrace = std::make_shared<const FadingTrace>(fileName, rbNum, samplesNum);
+        trace = sharedTrace;
+    }
+    return sharedTrace;
+}
+
+std::size_t
+TraceFadingLossModel::ChannelRealizationHash::operator()(const ChannelRealizationId_t& id) const
+{
+    std::size_t h1 = std::hash<const MobilityModel*>()(PeekPointer(id.first));
+    std::size_t h2 = std::hash<const MobilityModel*>()(PeekPointer(id.second));
+    return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+}
+
 TraceFadingLossModel::TraceFadingLossModel()
     : m_streamsAssigned(false)
 {
@@ -37,9 +210,8 @@ TraceFadingLossModel::TraceFadingLossModel()
 
 TraceFadingLossModel::~TraceFadingLossModel()
 {
-    m_fadingTrace.clear();
-    m_windowOffsetsMap.clear();
-    m_startVariableMap.clear();
+    m_fadingTrace.reset();
+    m_channelRealizations.clear();
 }
 
 TypeId
@@ -51,7 +223,8 @@ TraceFadingLossModel::GetTypeId()
             .SetGroupName("Spectrum")
             .AddConstructor<TraceFadingLossModel>()
             .AddAttribute("TraceFilename",
-                          "Name of file to load a trace from.",
+                          "Name of file to load a trace from, either a text trace or a binary "
+                          "trace created with TraceFadingLossModel::ConvertTrace.",
                           StringValue(""),
                           MakeStringAccessor(&TraceFadingLossModel::SetTraceFileName),
                           MakeStringChecker())
@@ -109,30 +282,33 @@ void
 TraceFadingLossModel::LoadTrace()
 {
     NS_LOG_FUNCTION(this << "Loading Fading Trace " << m_traceFile);
-    std::ifstream ifTraceFile;
-    ifTraceFile.open(m_traceFile, std::ifstream::in);
-    m_fadingTrace.clear();
-    if (!ifTraceFile.good())
-    {
-        NS_LOG_INFO(this << " File: " << m_traceFile);
-        NS_ASSERT_MSG(ifTraceFile.good(), " Fading trace file not found");
-    }
+    m_fadingTrace = FadingTrace::Get(m_traceFile, m_rbNum, m_samplesNum);
+    m_timeGranularity = m_traceLength.GetMilliSeconds() / m_samplesNum;
+    m_lastWindowUpdate = Simulator::Now();
+}
 
-    //   NS_LOG_INFO (this << " length " << m_traceLength.GetSeconds ());
-    //   NS_LOG_INFO (this << " RB " << (uint32_t)m_rbNum << " samples " << m_samplesNum);
-    for (uint32_t i = 0; i < m_rbNum; i++)
+void
+TraceFadingLossModel::ConvertTrace(const std::string& textFileName,
+                                   const std::string& binaryFileName,
+                                   uint32_t rbNum,
+                                   uint32_t samplesNum)
+{
+    NS_LOG_FUNCTION(textFileName << binaryFileName << rbNum << samplesNum);
+    FadingTrace trace(textFileName, rbNum, samplesNum);
+
+    std::ofstream file(binaryFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_IF(!file.good(), "Cannot create the fading trace " << binaryFileName);
+    BinaryFadingTraceHeader header;
+    std::memcpy(header.m_magic, BINARY_FADING_TRACE_MAGIC, sizeof(header.m_magic));
+    header.m_rbNum = rbNum;
+    header.m_samplesNum = samplesNum;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (uint32_t j = 0; j < samplesNum; j++)
     {
-        FadingTraceSample rbTimeFadingTrace;
-        for (uint32_t j = 0; j < m_samplesNum; j++)
-        {
-            double sample;
-            ifTraceFile >> sample;
-            rbTimeFadingTrace.push_back(sample);
-        }
-        m_fadingTrace.push_back(rbTimeFadingTrace);
+        file.write(reinterpret_cast<const char*>(trace.GetSamples(j)), sizeof(double) * rbNum);
     }
-    m_timeGranularity = m_traceLength.GetMilliSeconds() / m_samplesNum;
-    m_lastWindowUpdate = Simulator::Now();
+    file.close();
+    NS_ABORT_MSG_IF(!file, "Cannot write the fading trace " << binaryFileName);
 }
 
 Ptr<SpectrumValue>
@@ -143,27 +319,25 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParam
     NS_LOG_FUNCTION(this << *params->psd << a << b);
 
     ChannelRealizationId_t mobilityPair = std::make_pair(a, b);
-    auto itOff = m_windowOffsetsMap.find(mobilityPair);
-    if (itOff != m_windowOffsetsMap.end())
+    auto itOff = m_channelRealizations.find(mobilityPair);
+    if (itOff != m_channelRealizations.end())
     {
         if (Simulator::Now().GetSeconds() >=
             m_lastWindowUpdate.GetSeconds() + m_windowSize.GetSeconds())
         {
             // update all the offsets
             NS_LOG_INFO("Fading Windows Updated");
-            for (auto itOff2 = m_windowOffsetsMap.begin(); itOff2 != m_windowOffsetsMap.end();
-                 itOff2++)
+            for (auto& [id, channel] : m_channelRealizations)
             {
-                auto itVar = m_startVariableMap.find((*itOff2).first);
-                (*itOff2).second = (*itVar).second->GetValue();
+                channel.m_windowOffset = channel.m_startV->GetValue();
             }
             m_lastWindowUpdate = Simulator::Now();
         }
     }
     else
     {
-        NS_LOG_LOGIC(this << "insert new channel realization, m_windowOffsetMap.size () = "
-                          << m_windowOffsetsMap.size());
+        NS_LOG_LOGIC(this << "insert new channel realization, m_channelRealizations.size () = "
+                          << m_channelRealizations.size());
         Ptr<UniformRandomVariable> startV = CreateObject<UniformRandomVariable>();
         startV->SetAttribute("Min", DoubleValue(1.0));
         startV->SetAttribute(
@@ -176,13 +350,10 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParam
             startV->SetStream(m_currentStream);
             m_currentStream += 1;
         }
-        ChannelRealizationId_t mobilityPair = std::make_pair(a, b);
-        m_startVariableMap.insert(
-            std::pair<ChannelRealizationId_t, Ptr<UniformRandomVariable>>(mobilityPair, startV));
-        itOff =
-            m_windowOffsetsMap
-                .insert(std::pair<ChannelRealizationId_t, int>(mobilityPair, startV->GetValue()))
-                .first;
+        ChannelRealization channel;
+        channel.m_startV = startV;
+        channel.m_windowOffset = startV->GetValue();
+        itOff = m_channelRealizations.emplace(mobilityPair, channel).first;
     }
 
     Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(params->psd);
@@ -195,18 +366,20 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParam
     // (aSpeedVector.y-bSpeedVector.y,2));
 
     NS_LOG_LOGIC(this << *rxPsd);
-    NS_ASSERT(!m_fadingTrace.empty());
+    NS_ASSERT(m_fadingTrace);
     int now_ms = static_cast<int>(Simulator::Now().GetMilliSeconds() * m_timeGranularity);
     int lastUpdate_ms = static_cast<int>(m_lastWindowUpdate.GetMilliSeconds() * m_timeGranularity);
-    int index = ((*itOff).second + now_ms - lastUpdate_ms) % m_samplesNum;
-    int subChannel = 0;
+    int windowOffset = itOff->second.m_windowOffset;
+    int index = (windowOffset + now_ms - lastUpdate_ms) % m_samplesNum;
+    const double* samples = m_fadingTrace->GetSamples(index);
+    uint32_t subChannel = 0;
     while (vit != rxPsd->ValuesEnd())
     {
-        NS_ASSERT(subChannel < 100);
+        NS_ASSERT(subChannel < m_rbNum);
         if (*vit != 0.)
         {
-            double fading = m_fadingTrace.at(subChannel).at(index);
-            NS_LOG_INFO(this << " FADING now " << now_ms << " offset " << (*itOff).second << " id "
+            double fading = samples[subChannel];
+            NS_LOG_INFO(this << " FADING now " << now_ms << " offset " << windowOffset << " id "
                              << index << " fading " << fading);
             double power = *vit;                     // in Watt/Hz
             power = 10 * std::log10(180000 * power); // in dB
@@ -234,14 +407,13 @@ TraceFadingLossModel::DoAssignStreams(int64_t stream)
     m_streamsAssigned = true;
     m_currentStream = stream;
     m_lastStream = stream + m_streamSetSize - 1;
-    auto itVar = m_startVariableMap.begin();
     // the following loop is for eventually pre-existing ChannelRealization instances
     // note that more instances are expected to be created at run time
-    while (itVar != m_startVariableMap.end())
+    for (auto& [id, channel] : m_channelRealizations)
     {
         NS_ASSERT_MSG(m_currentStream <= m_lastStream,
                       "not enough streams, consider increasing the StreamSetSize attribute");
-        (*itVar).second->SetStream(m_currentStream);
+        channel.m_startV->SetStream(m_currentStream);
         m_currentStream += 1;
     }
     return m_streamSetSize;
@@ -16,7 +16,8 @@
 #include <ns3/nstime.h>
 #include <ns3/object.h>
 
-#include <map>
+#include <memory>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -27,6 +28,12 @@ class MobilityModel;
  * @ingroup spectrum
  *
  * @brief fading loss model based on precalculated fading traces
+ *
+ * The trace is either a text file, with the samples of each RB on a line,
+ * or a binary file created from a text file with ConvertTrace(). A binary
+ * trace is memory-mapped, where supported, rather than read. The samples
+ * of a trace file are stored only once in memory, and shared by all the
+ * instances of the model that use the same file.
  */
 class TraceFadingLossModel : public SpectrumPropagationLossModel
 {
@@ -47,6 +54,22 @@ class TraceFadingLossModel : public SpectrumPropagationLossModel
      */
     typedef std::pair<Ptr<const MobilityModel>, Ptr<const MobilityModel>> ChannelRealizationId_t;
 
+    /**
+     * @brief Convert a text trace to the binary format
+     *
+     * The binary trace stores the samples of each time instant contiguously,
+     * in the byte order of the host.
+     *
+     * @param textFileName the text trace, with the samples of each RB on a line
+     * @param binaryFileName the binary trace to create
+     * @param rbNum the number of RBs of the trace
+     * @param samplesNum the number of samples of each RB
+     */
+    static void ConvertTrace(const std::string& textFileName,
+                             const std::string& binaryFileName,
+                             uint32_t rbNum,
+                             uint32_t samplesNum);
+
   protected:
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -84,23 +107,32 @@ class TraceFadingLossModel : public SpectrumPropagationLossModel
     /// Load trace function
     void LoadTrace();
 
-    mutable std::map<ChannelRealizationId_t, int> m_windowOffsetsMap; ///< windows offsets map
-
-    mutable std::map<ChannelRealizationId_t, Ptr<UniformRandomVariable>>
-        m_startVariableMap; ///< start variable map
-
-    /**
-     * Vector with fading samples in time domain (for a fixed RB)
-     */
-    typedef std::vector<double> FadingTraceSample;
-    /**
-     * Vector collecting the time fading traces in the frequency domain (per RB)
-     */
-    typedef std::vector<FadingTraceSample> FadingTrace;
+    /// The samples of a trace file, shared by the models using the file
+    class FadingTrace;
+
+    /// The state of the fading channel between two nodes
+    struct ChannelRealization
+    {
+        int m_windowOffset;                  ///< the offset of the current window in the trace
+        Ptr<UniformRandomVariable> m_startV; ///< the random variable of the window offsets
+    };
+
+    /// Hash function of ChannelRealizationId_t
+    struct ChannelRealizationHash
+    {
+        /**
+         * @param id the channel realization ID
+         * @return the hash of the ID
+         */
+        std::size_t operator()(const ChannelRealizationId_t& id) const;
+    };
+
+    mutable std::unordered_map<ChannelRealizationId_t, ChannelRealization, ChannelRealizationHash>
+        m_channelRealizations; ///< the fading channels between the pairs of nodes
 
     std::string m_traceFile; ///< the trace file name
 
-    FadingTrace m_fadingTrace; ///< fading trace
+    std::shared_ptr<const FadingTrace> m_fadingTrace; ///< fading trace
 
     Time m_traceLength;               ///< the trace time
     uint32_t m_samplesNum;            ///< number of samples
@@ -215,6 +215,21 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     AddTestCase(new SpectrumValueTestCase(tv5, v5, "tv5 *= v2"), TestCase::Duration::QUICK);
     AddTestCase(new SpectrumValueTestCase(tv6, v6, "tv6 div= v2"), TestCase::Duration::QUICK);
 
+    // the operators reusing the storage of temporary operands give the same results
+    tv3 = (v1 * 1.0) + v2;
+    tv4 = v1 - (v2 * 1.0);
+    tv5 = (v1 * 1.0) * (v2 * 1.0);
+    tv6 = v1 / (v2 * 1.0);
+
+    AddTestCase(new SpectrumValueTestCase(tv3, v3, "tv3 = (v1 * 1) + v2"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv4, v4, "tv4 = v1 - (v2 * 1)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv5, v5, "tv5 = (v1 * 1) * (v2 * 1)"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumValueTestCase(tv6, v6, "tv6 = v1 div (v2 * 1)"),
+                TestCase::Duration::QUICK);
+
     SpectrumValue tv7a(f);
     SpectrumValue tv8a(f);
     SpectrumValue tv9a(f);
@@ -343,6 +358,11 @@ SpectrumConverterTestSuite::SpectrumConverterTestSuite()
     //   NS_LOG_LOGIC(t21b);
     //   NS_LOG_LOGIC(*res);
     AddTestCase(new SpectrumValueTestCase(t21b, *res, ""), TestCase::Duration::QUICK);
+
+    SpectrumValue t21c(sof1);
+    c21.Convert(*v2b, t21c);
+    AddTestCase(new SpectrumValueTestCase(t21b, t21c, "in-place conversion"),
+                TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
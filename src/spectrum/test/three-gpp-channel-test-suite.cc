@@ -6,6 +6,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/angles.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
@@ -713,6 +714,124 @@ ThreeGppAntennaSetupChangedTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup spectrum-tests
+ *
+ * Test case for the bounded channel caches of the ThreeGppChannelModel class.
+ * 1) checks that the least recently used channel matrix is evicted when the
+ *    number of cached matrices exceeds ChannelCacheMaxEntries, and that an
+ *    evicted matrix is regenerated identical from the cached channel params
+ * 2) checks that, with EvictStaleParams, the channel params not accessed for
+ *    longer than the update period are evicted
+ */
+class ThreeGppChannelCacheEvictionTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelCacheEvictionTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Retrieve the channel params cache statistics
+     * @param channelModel the ThreeGppChannelModel object
+     * @param name the name of the statistic attribute
+     * @return the value of the statistic
+     */
+    uint64_t GetStat(Ptr<ThreeGppChannelModel> channelModel, const std::string& name) const;
+};
+
+ThreeGppChannelCacheEvictionTest::ThreeGppChannelCacheEvictionTest()
+    : TestCase("Check the eviction of the channel matrices and params from the caches")
+{
+}
+
+uint64_t
+ThreeGppChannelCacheEvictionTest::GetStat(Ptr<ThreeGppChannelModel> channelModel,
+                                          const std::string& name) const
+{
+    UintegerValue value;
+    channelModel->GetAttribute(name, value);
+    return value.Get();
+}
+
+void
+ThreeGppChannelCacheEvictionTest::DoRun()
+{
+    // create the ThreeGppChannelModel object with room for a single channel matrix
+    Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(60.0e9));
+    channelModel->SetAttribute("Scenario", StringValue("UMa"));
+    channelModel->SetAttribute("ChannelConditionModel",
+                               PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+    channelModel->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(100)));
+    channelModel->SetAttribute("EvictStaleParams", BooleanValue(true));
+    channelModel->SetAttribute("ChannelCacheMaxEntries", UintegerValue(1));
+
+    // create a tx node and two rx nodes
+    NodeContainer nodes;
+    nodes.Create(3);
+    std::vector<Ptr<MobilityModel>> mobs;
+    std::vector<Ptr<PhasedArrayModel>> antennas;
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+        nodes.Get(i)->AddDevice(dev);
+        dev->SetNode(nodes.Get(i));
+        Ptr<MobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+        mob->SetPosition(Vector(i * 50.0, 0.0, i == 0 ? 10.0 : 1.6));
+        nodes.Get(i)->AggregateObject(mob);
+        mobs.push_back(mob);
+        antennas.push_back(CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(2),
+            "NumRows",
+            UintegerValue(2),
+            "AntennaElement",
+            PointerValue(CreateObject<IsotropicAntennaModel>())));
+    }
+
+    Ptr<const ThreeGppChannelModel::ChannelMatrix> first =
+        channelModel->GetChannel(mobs[0], mobs[1], antennas[0], antennas[1]);
+    channelModel->GetChannel(mobs[0], mobs[2], antennas[0], antennas[2]);
+    NS_TEST_ASSERT_MSG_EQ(GetStat(channelModel, "ChannelCacheEvictions"),
+                          1,
+                          "The least recently used channel matrix should have been evicted");
+
+    // the evicted matrix is regenerated from the cached channel params
+    Ptr<const ThreeGppChannelModel::ChannelMatrix> regenerated =
+        channelModel->GetChannel(mobs[0], mobs[1], antennas[0], antennas[1]);
+    NS_TEST_ASSERT_MSG_NE(first, regenerated, "The channel matrix should have been regenerated");
+    NS_TEST_ASSERT_MSG_EQ((first->m_channel == regenerated->m_channel),
+                          true,
+                          "The regenerated channel matrix should be equal to the evicted one");
+    NS_TEST_ASSERT_MSG_EQ(GetStat(channelModel, "ChannelCacheMisses"), 3, "Wrong number of misses");
+    NS_TEST_ASSERT_MSG_EQ(GetStat(channelModel, "ChannelCacheEvictions"),
+                          2,
+                          "Wrong number of evictions");
+    NS_TEST_ASSERT_MSG_EQ(GetStat(channelModel, "ParamsCacheHits"), 1, "Wrong number of hits");
+
+    // after the update period, the channel params of both links are stale and evicted
+    Simulator::Schedule(MilliSeconds(150), [&]() {
+        channelModel->GetChannel(mobs[0], mobs[1], antennas[0], antennas[1]);
+        NS_TEST_ASSERT_MSG_EQ(GetStat(channelModel, "ParamsCacheEvictions"),
+                              2,
+                              "The stale channel params should have been evicted");
+        NS_TEST_ASSERT_MSG_EQ(GetStat(channelModel, "ParamsCacheMisses"),
+                              3,
+                              "Wrong number of misses");
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup spectrum-tests
  * @brief A structure that holds the parameters for the function
@@ -985,6 +1104,9 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun()
  * long term channel matrix using the both gNB and UE having beams directed towards the other.
  * The resulting long term matrix dimensions are gNBports = 4, UE ports = 2, num Clusters.
  * This channel matrix is called matrixA.
+ * Checks that matrixA is equal to the long term component computed port by port
+ * and cluster by cluster, and to the one computed by the batched method,
+ * both when the channel matrix is used in the same and in the reverse direction.
  * 3) Constructs a single port to single port long term channel matrix
  * using the initial time domain channel matrix (channelMatrixM0) and beams
  * from gNB and UE towards each other. Single port mapping means gNB: 1 vertical port,
@@ -1108,6 +1230,27 @@ ThreeGppCalcLongTermMultiPortTest::DoRun()
     Ptr<const MatrixBasedChannelModel::Complex3DVector> matrixA =
         threeGppSplm->CalcLongTerm(channelMatrixM0, txAntenna1, rxAntenna1);
 
+    for (uint16_t sPortIdx = 0; sPortIdx < txAntenna1->GetNumPorts(); sPortIdx++)
+    {
+        for (uint16_t uPortIdx = 0; uPortIdx < rxAntenna1->GetNumPorts(); uPortIdx++)
+        {
+            for (uint16_t cIndex = 0; cIndex < matrixA->GetNumPages(); cIndex++)
+            {
+                std::complex<double> component =
+                    threeGppSplm->CalculateLongTermComponent(channelMatrixM0,
+                                                             txAntenna1,
+                                                             rxAntenna1,
+                                                             sPortIdx,
+                                                             uPortIdx,
+                                                             cIndex);
+                NS_TEST_ASSERT_MSG_LT(std::abs(matrixA->Elem(uPortIdx, sPortIdx, cIndex) -
+                                               component),
+                                      1e-6,
+                                      "Matrix A should be equal to the per-port long term");
+            }
+        }
+    }
+
     // create the tx and rx antennas and set the their dimensions
     Ptr<PhasedArrayModel> txAntenna2 = CreateObjectWithAttributes<UniformPlanarArray>(
         "NumColumns",
@@ -1457,6 +1600,7 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
     AddTestCase(new ThreeGppChannelMatrixUpdateTest(2, 4, 2, 2), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppChannelMatrixUpdateTest(2, 2, 2, 2), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppAntennaSetupChangedTest(), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelCacheEvictionTest(), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 4, 1, 1),
                 TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 4, 2, 2),
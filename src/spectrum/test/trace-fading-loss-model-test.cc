@@ -0,0 +1,170 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+#include <ns3/trace-fading-loss-model.h>
+#include <ns3/uinteger.h>
+
+#include <cmath>
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TraceFadingLossModelTest");
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Check that TraceFadingLossModel applies the same fading with a
+ * text trace and with the binary trace converted from it, and that the
+ * fading of all the RBs is taken from the same time instant of the trace.
+ */
+class TraceFadingLossModelTestCase : public TestCase
+{
+  public:
+    TraceFadingLossModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a fading model
+     * @param fileName the trace file
+     * @return the fading model
+     */
+    Ptr<TraceFadingLossModel> CreateModel(const std::string& fileName) const;
+
+    /**
+     * Compare the received PSDs computed by the models
+     */
+    void Check();
+
+    static constexpr uint32_t RB_NUM = 4;        //!< the number of RBs of the trace
+    static constexpr uint32_t SAMPLES_NUM = 200; //!< the number of samples of the trace
+
+    Ptr<TraceFadingLossModel> m_textModel;   //!< the model using the text trace
+    Ptr<TraceFadingLossModel> m_binaryModel; //!< the model using the binary trace
+    Ptr<TraceFadingLossModel> m_sharedModel; //!< another model using the binary trace
+    Ptr<SpectrumSignalParameters> m_params;  //!< the transmitted signal
+    Ptr<MobilityModel> m_a;                  //!< the mobility model of the transmitter
+    Ptr<MobilityModel> m_b;                  //!< the mobility model of the receiver
+};
+
+TraceFadingLossModelTestCase::TraceFadingLossModelTestCase()
+    : TestCase("Check the text and the binary fading traces")
+{
+}
+
+Ptr<TraceFadingLossModel>
+TraceFadingLossModelTestCase::CreateModel(const std::string& fileName) const
+{
+    Ptr<TraceFadingLossModel> model = CreateObject<TraceFadingLossModel>();
+    model->SetAttribute("TraceFilename", StringValue(fileName));
+    model->SetAttribute("TraceLength", TimeValue(MilliSeconds(SAMPLES_NUM)));
+    model->SetAttribute("SamplesNum", UintegerValue(SAMPLES_NUM));
+    model->SetAttribute("WindowSize", TimeValue(MilliSeconds(100)));
+    model->SetAttribute("RbNum", UintegerValue(RB_NUM));
+    model->Initialize();
+    model->AssignStreams(1);
+    return model;
+}
+
+void
+TraceFadingLossModelTestCase::Check()
+{
+    Ptr<SpectrumValue> textPsd = m_textModel->CalcRxPowerSpectralDensity(m_params, m_a, m_b);
+    Ptr<SpectrumValue> binaryPsd = m_binaryModel->CalcRxPowerSpectralDensity(m_params, m_a, m_b);
+    Ptr<SpectrumValue> sharedPsd = m_sharedModel->CalcRxPowerSpectralDensity(m_params, m_a, m_b);
+
+    double firstFading = 10 * std::log10((*textPsd)[0] / (*m_params->psd)[0]);
+    for (uint32_t rb = 0; rb < RB_NUM; rb++)
+    {
+        NS_TEST_ASSERT_MSG_EQ((*textPsd)[rb],
+                              (*binaryPsd)[rb],
+                              "Different fading with the binary trace, RB " << rb);
+        NS_TEST_ASSERT_MSG_EQ((*binaryPsd)[rb],
+                              (*sharedPsd)[rb],
+                              "Different fading with the shared binary trace, RB " << rb);
+        // the samples of the trace differ by 0.001 dB between two RBs
+        double fading = 10 * std::log10((*textPsd)[rb] / (*m_params->psd)[rb]);
+        NS_TEST_ASSERT_MSG_EQ_TOL(fading - firstFading,
+                                  -0.001 * rb,
+                                  1e-6,
+                                  "The RBs use different time instants of the trace");
+    }
+}
+
+void
+TraceFadingLossModelTestCase::DoRun()
+{
+    // the sample of RB i at time instant j is -0.1 * j - 0.001 * i dB
+    std::string textFileName = CreateTempDirFilename("fading-trace.fad");
+    std::ofstream textFile(textFileName);
+    for (uint32_t i = 0; i < RB_NUM; i++)
+    {
+        for (uint32_t j = 0; j < SAMPLES_NUM; j++)
+        {
+            textFile << -0.1 * j - 0.001 * i << " ";
+        }
+        textFile << std::endl;
+    }
+    textFile.close();
+    std::string binaryFileName = CreateTempDirFilename("fading-trace.bin");
+    TraceFadingLossModel::ConvertTrace(textFileName, binaryFileName, RB_NUM, SAMPLES_NUM);
+
+    m_textModel = CreateModel(textFileName);
+    m_binaryModel = CreateModel(binaryFileName);
+    m_sharedModel = CreateModel(binaryFileName);
+
+    std::vector<double> frequencies;
+    for (uint32_t rb = 0; rb < RB_NUM; rb++)
+    {
+        frequencies.push_back(2e9 + rb * 180e3);
+    }
+    Ptr<SpectrumValue> psd = Create<SpectrumValue>(Create<SpectrumModel>(frequencies));
+    (*psd) = 1e-16;
+    m_params = Create<SpectrumSignalParameters>();
+    m_params->psd = psd;
+    m_a = CreateObject<ConstantPositionMobilityModel>();
+    m_b = CreateObject<ConstantPositionMobilityModel>();
+
+    // the fading window is moved after 100 ms
+    for (uint32_t t : {0, 10, 99, 100, 150})
+    {
+        Simulator::Schedule(MilliSeconds(t), &TraceFadingLossModelTestCase::Check, this);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    m_textModel = nullptr;
+    m_binaryModel = nullptr;
+    m_sharedModel = nullptr;
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief TraceFadingLossModel TestSuite
+ */
+class TraceFadingLossModelTestSuite : public TestSuite
+{
+  public:
+    TraceFadingLossModelTestSuite();
+};
+
+TraceFadingLossModelTestSuite::TraceFadingLossModelTestSuite()
+    : TestSuite("trace-fading-loss-model", Type::UNIT)
+{
+    AddTestCase(new TraceFadingLossModelTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static TraceFadingLossModelTestSuite g_traceFadingLossModelTestSuite;
@@ -9,6 +9,7 @@
  * Modified by: Bhaskar Kataria <bhaskar.k7920@gmail.com> (COBALT changes)
  */
 
+#include "ns3/boolean.h"
 #include "ns3/cobalt-queue-disc.h"
 #include "ns3/fq-cobalt-queue-disc.h"
 #include "ns3/ipv4-address.h"
@@ -24,6 +25,7 @@
 #include "ns3/tcp-header.h"
 #include "ns3/test.h"
 #include "ns3/udp-header.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -1695,6 +1697,355 @@ FqCobaltQueueDiscL4sMode::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * Enqueue a packet of a flow. The hash of the flow is set as the classification
+ * result of the test packet filter, and as the host part of the IPv4 source address.
+ * @param queue The queue disc.
+ * @param hash The hash of the flow.
+ */
+static void
+AddFlowPacket(Ptr<FqCobaltQueueDisc> queue, int32_t hash)
+{
+    Ipv4Header hdr;
+    hdr.SetPayloadSize(100);
+    hdr.SetSource(Ipv4Address(Ipv4Address("10.0.0.0").Get() + hash));
+    hdr.SetDestination(Ipv4Address("10.10.1.2"));
+    hdr.SetProtocol(7);
+    g_hash = hash;
+    Ptr<Packet> p = Create<Packet>(100);
+    Address dest;
+    Ptr<Ipv4QueueDiscItem> item = Create<Ipv4QueueDiscItem>(p, dest, 0, hdr);
+    queue->Enqueue(item);
+}
+
+/**
+ * Dequeue a packet.
+ * @param queue The queue disc.
+ * @return the hash of the flow of the dequeued packet, or -1 if no packet is dequeued.
+ */
+static int32_t
+GetFlowPacket(Ptr<FqCobaltQueueDisc> queue)
+{
+    Ptr<QueueDiscItem> item = queue->Dequeue();
+    if (!item)
+    {
+        return -1;
+    }
+    Ipv4Address source = DynamicCast<Ipv4QueueDiscItem>(item)->GetHeader().GetSource();
+    return source.Get() - Ipv4Address("10.0.0.0").Get();
+}
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * @brief This class tests the order in which the deficit round robin scheduler
+ * serves the flows. The quantum equals the size of a packet, hence a flow is
+ * served one packet per round. A new flow is served before the old flows, and
+ * an old flow found empty becomes inactive.
+ */
+class FqCobaltQueueDiscDrrOrder : public TestCase
+{
+  public:
+    FqCobaltQueueDiscDrrOrder();
+    ~FqCobaltQueueDiscDrrOrder() override;
+
+  private:
+    void DoRun() override;
+};
+
+FqCobaltQueueDiscDrrOrder::FqCobaltQueueDiscDrrOrder()
+    : TestCase("Test the order in which the flows are served")
+{
+}
+
+FqCobaltQueueDiscDrrOrder::~FqCobaltQueueDiscDrrOrder()
+{
+}
+
+void
+FqCobaltQueueDiscDrrOrder::DoRun()
+{
+    Ptr<FqCobaltQueueDisc> queueDisc = CreateObject<FqCobaltQueueDisc>();
+    queueDisc->SetQuantum(120);
+    queueDisc->Initialize();
+
+    Ptr<Ipv4FqCobaltTestPacketFilter> filter = CreateObject<Ipv4FqCobaltTestPacketFilter>();
+    queueDisc->AddPacketFilter(filter);
+
+    for (int32_t i = 0; i < 3; i++)
+    {
+        AddFlowPacket(queueDisc, 0);
+        AddFlowPacket(queueDisc, 1);
+        AddFlowPacket(queueDisc, 2);
+    }
+    for (int32_t hash : {0, 1, 2, 0})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+
+    // the new flow is served first, then the old flows resume from where they stopped
+    AddFlowPacket(queueDisc, 3);
+    for (int32_t hash : {3, 1, 2, 0, 1, 2, -1})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+    for (std::size_t i = 0; i < queueDisc->GetNQueueDiscClasses(); i++)
+    {
+        Ptr<FqCobaltFlow> flow = StaticCast<FqCobaltFlow>(queueDisc->GetQueueDiscClass(i));
+        NS_TEST_ASSERT_MSG_EQ(flow->GetStatus(),
+                              FqCobaltFlow::INACTIVE,
+                              "the flows of an empty queue disc must be inactive");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * @brief This class tests the collisions of the set associative hash. When all
+ * the queues of a set are used by active flows, a flow of the set is enqueued in
+ * the first queue of the set, whose tag is then set to the hash of the flow.
+ */
+class FqCobaltQueueDiscSetAssociativeCollision : public TestCase
+{
+  public:
+    FqCobaltQueueDiscSetAssociativeCollision();
+    ~FqCobaltQueueDiscSetAssociativeCollision() override;
+
+  private:
+    void DoRun() override;
+};
+
+FqCobaltQueueDiscSetAssociativeCollision::FqCobaltQueueDiscSetAssociativeCollision()
+    : TestCase("Test the collisions of the set associative hash")
+{
+}
+
+FqCobaltQueueDiscSetAssociativeCollision::~FqCobaltQueueDiscSetAssociativeCollision()
+{
+}
+
+void
+FqCobaltQueueDiscSetAssociativeCollision::DoRun()
+{
+    Ptr<FqCobaltQueueDisc> queueDisc =
+        CreateObjectWithAttributes<FqCobaltQueueDisc>("EnableSetAssociativeHash",
+                                                      BooleanValue(true),
+                                                      "Flows",
+                                                      UintegerValue(16),
+                                                      "SetWays",
+                                                      UintegerValue(8));
+    queueDisc->SetQuantum(120);
+    queueDisc->Initialize();
+
+    Ptr<Ipv4FqCobaltTestPacketFilter> filter = CreateObject<Ipv4FqCobaltTestPacketFilter>();
+    queueDisc->AddPacketFilter(filter);
+
+    for (int32_t hash = 0; hash < 8; hash++)
+    {
+        AddFlowPacket(queueDisc, hash);
+    }
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          8,
+                          "unexpected number of flow queues");
+
+    // flow 16 collides with flow 0, then flow 0 collides with flow 16
+    AddFlowPacket(queueDisc, 16);
+    AddFlowPacket(queueDisc, 0);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          8,
+                          "no flow queue must be created for a colliding flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+                          3,
+                          "unexpected number of packets in the first flow queue of set one");
+
+    // flow 8 belongs to the second set
+    AddFlowPacket(queueDisc, 8);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          9,
+                          "unexpected number of flow queues");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(8)->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "unexpected number of packets in the first flow queue of set two");
+
+    // the packets of the colliding flows share the deficit of their queue
+    for (int32_t hash : {0, 1, 2, 3, 4, 5, 6, 7, 8, 16, 0, -1})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * @brief This class tests that the set associative hash reuses the inactive
+ * queues of a set for new flows, which start as new flows with a full quantum.
+ */
+class FqCobaltQueueDiscInactiveFlowReuse : public TestCase
+{
+  public:
+    FqCobaltQueueDiscInactiveFlowReuse();
+    ~FqCobaltQueueDiscInactiveFlowReuse() override;
+
+  private:
+    void DoRun() override;
+};
+
+FqCobaltQueueDiscInactiveFlowReuse::FqCobaltQueueDiscInactiveFlowReuse()
+    : TestCase("Test the reuse of the inactive flow queues")
+{
+}
+
+FqCobaltQueueDiscInactiveFlowReuse::~FqCobaltQueueDiscInactiveFlowReuse()
+{
+}
+
+void
+FqCobaltQueueDiscInactiveFlowReuse::DoRun()
+{
+    Ptr<FqCobaltQueueDisc> queueDisc =
+        CreateObjectWithAttributes<FqCobaltQueueDisc>("EnableSetAssociativeHash",
+                                                      BooleanValue(true),
+                                                      "Flows",
+                                                      UintegerValue(16),
+                                                      "SetWays",
+                                                      UintegerValue(8));
+    queueDisc->SetQuantum(120);
+    queueDisc->Initialize();
+
+    Ptr<Ipv4FqCobaltTestPacketFilter> filter = CreateObject<Ipv4FqCobaltTestPacketFilter>();
+    queueDisc->AddPacketFilter(filter);
+
+    AddFlowPacket(queueDisc, 0);
+    AddFlowPacket(queueDisc, 1);
+    for (int32_t hash : {0, 1, -1})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+    Ptr<FqCobaltFlow> flow1 = StaticCast<FqCobaltFlow>(queueDisc->GetQueueDiscClass(0));
+    Ptr<FqCobaltFlow> flow2 = StaticCast<FqCobaltFlow>(queueDisc->GetQueueDiscClass(1));
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+                          FqCobaltFlow::INACTIVE,
+                          "the first flow queue must be inactive");
+    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+                          FqCobaltFlow::INACTIVE,
+                          "the second flow queue must be inactive");
+
+    // flow 2 takes the first inactive queue of the set
+    AddFlowPacket(queueDisc, 2);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          2,
+                          "an inactive flow queue must be reused");
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "unexpected number of packets in the first flow queue");
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+                          FqCobaltFlow::NEW_FLOW,
+                          "the reused flow queue must be in the list of new queues");
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(),
+                          static_cast<int32_t>(queueDisc->GetQuantum()),
+                          "the deficit of the reused flow queue must equal the quantum");
+
+    // flow 0 finds its former queue used by flow 2, and takes the next inactive queue
+    AddFlowPacket(queueDisc, 0);
+    AddFlowPacket(queueDisc, 2);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          2,
+                          "an inactive flow queue must be reused");
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetQueueDisc()->GetNPackets(),
+                          2,
+                          "unexpected number of packets in the first flow queue");
+    NS_TEST_ASSERT_MSG_EQ(flow2->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "unexpected number of packets in the second flow queue");
+    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+                          FqCobaltFlow::NEW_FLOW,
+                          "the reused flow queue must be in the list of new queues");
+
+    for (int32_t hash : {2, 0, 2, -1})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * @brief This class tests that the UseEcn, CeThreshold, UseL4s and BlueThreshold
+ * attributes of the queue disc are set on the queue discs of all the flow queues.
+ */
+class FqCobaltQueueDiscFlowAttributes : public TestCase
+{
+  public:
+    FqCobaltQueueDiscFlowAttributes();
+    ~FqCobaltQueueDiscFlowAttributes() override;
+
+  private:
+    void DoRun() override;
+};
+
+FqCobaltQueueDiscFlowAttributes::FqCobaltQueueDiscFlowAttributes()
+    : TestCase("Test the attributes of the flow queues")
+{
+}
+
+FqCobaltQueueDiscFlowAttributes::~FqCobaltQueueDiscFlowAttributes()
+{
+}
+
+void
+FqCobaltQueueDiscFlowAttributes::DoRun()
+{
+    for (bool enabled : {false, true})
+    {
+        Time ceThreshold = enabled ? MilliSeconds(2) : MilliSeconds(3);
+        Time blueThreshold = enabled ? MilliSeconds(200) : MilliSeconds(300);
+        Ptr<FqCobaltQueueDisc> queueDisc =
+            CreateObjectWithAttributes<FqCobaltQueueDisc>("UseEcn",
+                                                          BooleanValue(enabled),
+                                                          "CeThreshold",
+                                                          TimeValue(ceThreshold),
+                                                          "UseL4s",
+                                                          BooleanValue(enabled),
+                                                          "BlueThreshold",
+                                                          TimeValue(blueThreshold));
+        queueDisc->SetQuantum(1500);
+        queueDisc->Initialize();
+
+        Ptr<Ipv4FqCobaltTestPacketFilter> filter = CreateObject<Ipv4FqCobaltTestPacketFilter>();
+        queueDisc->AddPacketFilter(filter);
+
+        AddFlowPacket(queueDisc, 0);
+        AddFlowPacket(queueDisc, 1);
+        NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                              2,
+                              "unexpected number of flow queues");
+        for (std::size_t i = 0; i < queueDisc->GetNQueueDiscClasses(); i++)
+        {
+            Ptr<QueueDisc> qd = queueDisc->GetQueueDiscClass(i)->GetQueueDisc();
+            BooleanValue useEcn;
+            qd->GetAttribute("UseEcn", useEcn);
+            NS_TEST_EXPECT_MSG_EQ(useEcn.Get(), enabled, "unexpected UseEcn of flow queue " << i);
+            TimeValue ce;
+            qd->GetAttribute("CeThreshold", ce);
+            NS_TEST_EXPECT_MSG_EQ(ce.Get(),
+                                  ceThreshold,
+                                  "unexpected CeThreshold of flow queue " << i);
+            BooleanValue useL4s;
+            qd->GetAttribute("UseL4s", useL4s);
+            NS_TEST_EXPECT_MSG_EQ(useL4s.Get(), enabled, "unexpected UseL4s of flow queue " << i);
+            TimeValue blue;
+            qd->GetAttribute("BlueThreshold", blue);
+            NS_TEST_EXPECT_MSG_EQ(blue.Get(),
+                                  blueThreshold,
+                                  "unexpected BlueThreshold of flow queue " << i);
+        }
+        Simulator::Destroy();
+    }
+}
+
 /**
  * @ingroup system-tests-tc
  *
@@ -1717,6 +2068,10 @@ FqCobaltQueueDiscTestSuite::FqCobaltQueueDiscTestSuite()
     AddTestCase(new FqCobaltQueueDiscEcnMarking, TestCase::Duration::QUICK);
     AddTestCase(new FqCobaltQueueDiscSetLinearProbing, TestCase::Duration::QUICK);
     AddTestCase(new FqCobaltQueueDiscL4sMode, TestCase::Duration::QUICK);
+    AddTestCase(new FqCobaltQueueDiscDrrOrder, TestCase::Duration::QUICK);
+    AddTestCase(new FqCobaltQueueDiscSetAssociativeCollision, TestCase::Duration::QUICK);
+    AddTestCase(new FqCobaltQueueDiscInactiveFlowReuse, TestCase::Duration::QUICK);
+    AddTestCase(new FqCobaltQueueDiscFlowAttributes, TestCase::Duration::QUICK);
 }
 
 /// Do not forget to allocate an instance of this TestSuite.
@@ -7,6 +7,7 @@
  *          Stefano Avallone <stefano.avallone@unina.it>
  */
 
+#include "ns3/boolean.h"
 #include "ns3/codel-queue-disc.h"
 #include "ns3/fq-codel-queue-disc.h"
 #include "ns3/ipv4-address.h"
@@ -22,6 +23,7 @@
 #include "ns3/tcp-header.h"
 #include "ns3/test.h"
 #include "ns3/udp-header.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -1745,6 +1747,347 @@ FqCoDelQueueDiscL4sMode::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * Enqueue a packet of a flow. The hash of the flow is set as the classification
+ * result of the test packet filter, and as the host part of the IPv4 source address.
+ * @param queue The queue disc.
+ * @param hash The hash of the flow.
+ */
+static void
+AddFlowPacket(Ptr<FqCoDelQueueDisc> queue, int32_t hash)
+{
+    Ipv4Header hdr;
+    hdr.SetPayloadSize(100);
+    hdr.SetSource(Ipv4Address(Ipv4Address("10.0.0.0").Get() + hash));
+    hdr.SetDestination(Ipv4Address("10.10.1.2"));
+    hdr.SetProtocol(7);
+    g_hash = hash;
+    Ptr<Packet> p = Create<Packet>(100);
+    Address dest;
+    Ptr<Ipv4QueueDiscItem> item = Create<Ipv4QueueDiscItem>(p, dest, 0, hdr);
+    queue->Enqueue(item);
+}
+
+/**
+ * Dequeue a packet.
+ * @param queue The queue disc.
+ * @return the hash of the flow of the dequeued packet, or -1 if no packet is dequeued.
+ */
+static int32_t
+GetFlowPacket(Ptr<FqCoDelQueueDisc> queue)
+{
+    Ptr<QueueDiscItem> item = queue->Dequeue();
+    if (!item)
+    {
+        return -1;
+    }
+    Ipv4Address source = DynamicCast<Ipv4QueueDiscItem>(item)->GetHeader().GetSource();
+    return source.Get() - Ipv4Address("10.0.0.0").Get();
+}
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * @brief This class tests the order in which the deficit round robin scheduler
+ * serves the flows. The quantum equals the size of a packet, hence a flow is
+ * served one packet per round. A new flow is served before the old flows, and
+ * an old flow found empty becomes inactive.
+ */
+class FqCoDelQueueDiscDrrOrder : public TestCase
+{
+  public:
+    FqCoDelQueueDiscDrrOrder();
+    ~FqCoDelQueueDiscDrrOrder() override;
+
+  private:
+    void DoRun() override;
+};
+
+FqCoDelQueueDiscDrrOrder::FqCoDelQueueDiscDrrOrder()
+    : TestCase("Test the order in which the flows are served")
+{
+}
+
+FqCoDelQueueDiscDrrOrder::~FqCoDelQueueDiscDrrOrder()
+{
+}
+
+void
+FqCoDelQueueDiscDrrOrder::DoRun()
+{
+    Ptr<FqCoDelQueueDisc> queueDisc = CreateObject<FqCoDelQueueDisc>();
+    queueDisc->SetQuantum(120);
+    queueDisc->Initialize();
+
+    Ptr<Ipv4TestPacketFilter> filter = CreateObject<Ipv4TestPacketFilter>();
+    queueDisc->AddPacketFilter(filter);
+
+    for (int32_t i = 0; i < 3; i++)
+    {
+        AddFlowPacket(queueDisc, 0);
+        AddFlowPacket(queueDisc, 1);
+        AddFlowPacket(queueDisc, 2);
+    }
+    for (int32_t hash : {0, 1, 2, 0})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+
+    // the new flow is served first, then the old flows resume from where they stopped
+    AddFlowPacket(queueDisc, 3);
+    for (int32_t hash : {3, 1, 2, 0, 1, 2, -1})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+    for (std::size_t i = 0; i < queueDisc->GetNQueueDiscClasses(); i++)
+    {
+        Ptr<FqCoDelFlow> flow = StaticCast<FqCoDelFlow>(queueDisc->GetQueueDiscClass(i));
+        NS_TEST_ASSERT_MSG_EQ(flow->GetStatus(),
+                              FqCoDelFlow::INACTIVE,
+                              "the flows of an empty queue disc must be inactive");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * @brief This class tests the collisions of the set associative hash. When all
+ * the queues of a set are used by active flows, a flow of the set is enqueued in
+ * the first queue of the set, whose tag is then set to the hash of the flow.
+ */
+class FqCoDelQueueDiscSetAssociativeCollision : public TestCase
+{
+  public:
+    FqCoDelQueueDiscSetAssociativeCollision();
+    ~FqCoDelQueueDiscSetAssociativeCollision() override;
+
+  private:
+    void DoRun() override;
+};
+
+FqCoDelQueueDiscSetAssociativeCollision::FqCoDelQueueDiscSetAssociativeCollision()
+    : TestCase("Test the collisions of the set associative hash")
+{
+}
+
+FqCoDelQueueDiscSetAssociativeCollision::~FqCoDelQueueDiscSetAssociativeCollision()
+{
+}
+
+void
+FqCoDelQueueDiscSetAssociativeCollision::DoRun()
+{
+    Ptr<FqCoDelQueueDisc> queueDisc =
+        CreateObjectWithAttributes<FqCoDelQueueDisc>("EnableSetAssociativeHash",
+                                                     BooleanValue(true),
+                                                     "Flows",
+                                                     UintegerValue(16),
+                                                     "SetWays",
+                                                     UintegerValue(8));
+    queueDisc->SetQuantum(120);
+    queueDisc->Initialize();
+
+    Ptr<Ipv4TestPacketFilter> filter = CreateObject<Ipv4TestPacketFilter>();
+    queueDisc->AddPacketFilter(filter);
+
+    for (int32_t hash = 0; hash < 8; hash++)
+    {
+        AddFlowPacket(queueDisc, hash);
+    }
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          8,
+                          "unexpected number of flow queues");
+
+    // flow 16 collides with flow 0, then flow 0 collides with flow 16
+    AddFlowPacket(queueDisc, 16);
+    AddFlowPacket(queueDisc, 0);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          8,
+                          "no flow queue must be created for a colliding flow");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+                          3,
+                          "unexpected number of packets in the first flow queue of set one");
+
+    // flow 8 belongs to the second set
+    AddFlowPacket(queueDisc, 8);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          9,
+                          "unexpected number of flow queues");
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetQueueDiscClass(8)->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "unexpected number of packets in the first flow queue of set two");
+
+    // the packets of the colliding flows share the deficit of their queue
+    for (int32_t hash : {0, 1, 2, 3, 4, 5, 6, 7, 8, 16, 0, -1})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * @brief This class tests that the set associative hash reuses the inactive
+ * queues of a set for new flows, which start as new flows with a full quantum.
+ */
+class FqCoDelQueueDiscInactiveFlowReuse : public TestCase
+{
+  public:
+    FqCoDelQueueDiscInactiveFlowReuse();
+    ~FqCoDelQueueDiscInactiveFlowReuse() override;
+
+  private:
+    void DoRun() override;
+};
+
+FqCoDelQueueDiscInactiveFlowReuse::FqCoDelQueueDiscInactiveFlowReuse()
+    : TestCase("Test the reuse of the inactive flow queues")
+{
+}
+
+FqCoDelQueueDiscInactiveFlowReuse::~FqCoDelQueueDiscInactiveFlowReuse()
+{
+}
+
+void
+FqCoDelQueueDiscInactiveFlowReuse::DoRun()
+{
+    Ptr<FqCoDelQueueDisc> queueDisc =
+        CreateObjectWithAttributes<FqCoDelQueueDisc>("EnableSetAssociativeHash",
+                                                     BooleanValue(true),
+                                                     "Flows",
+                                                     UintegerValue(16),
+                                                     "SetWays",
+                                                     UintegerValue(8));
+    queueDisc->SetQuantum(120);
+    queueDisc->Initialize();
+
+    Ptr<Ipv4TestPacketFilter> filter = CreateObject<Ipv4TestPacketFilter>();
+    queueDisc->AddPacketFilter(filter);
+
+    AddFlowPacket(queueDisc, 0);
+    AddFlowPacket(queueDisc, 1);
+    for (int32_t hash : {0, 1, -1})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+    Ptr<FqCoDelFlow> flow1 = StaticCast<FqCoDelFlow>(queueDisc->GetQueueDiscClass(0));
+    Ptr<FqCoDelFlow> flow2 = StaticCast<FqCoDelFlow>(queueDisc->GetQueueDiscClass(1));
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+                          FqCoDelFlow::INACTIVE,
+                          "the first flow queue must be inactive");
+    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+                          FqCoDelFlow::INACTIVE,
+                          "the second flow queue must be inactive");
+
+    // flow 2 takes the first inactive queue of the set
+    AddFlowPacket(queueDisc, 2);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          2,
+                          "an inactive flow queue must be reused");
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "unexpected number of packets in the first flow queue");
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetStatus(),
+                          FqCoDelFlow::NEW_FLOW,
+                          "the reused flow queue must be in the list of new queues");
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetDeficit(),
+                          static_cast<int32_t>(queueDisc->GetQuantum()),
+                          "the deficit of the reused flow queue must equal the quantum");
+
+    // flow 0 finds its former queue used by flow 2, and takes the next inactive queue
+    AddFlowPacket(queueDisc, 0);
+    AddFlowPacket(queueDisc, 2);
+    NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                          2,
+                          "an inactive flow queue must be reused");
+    NS_TEST_ASSERT_MSG_EQ(flow1->GetQueueDisc()->GetNPackets(),
+                          2,
+                          "unexpected number of packets in the first flow queue");
+    NS_TEST_ASSERT_MSG_EQ(flow2->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "unexpected number of packets in the second flow queue");
+    NS_TEST_ASSERT_MSG_EQ(flow2->GetStatus(),
+                          FqCoDelFlow::NEW_FLOW,
+                          "the reused flow queue must be in the list of new queues");
+
+    for (int32_t hash : {2, 0, 2, -1})
+    {
+        NS_TEST_ASSERT_MSG_EQ(GetFlowPacket(queueDisc), hash, "unexpected flow served");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup system-tests-tc
+ *
+ * @brief This class tests that the UseEcn, CeThreshold and UseL4s attributes of the queue disc are
+ * set on the queue discs of all the flow queues.
+ */
+class FqCoDelQueueDiscFlowAttributes : public TestCase
+{
+  public:
+    FqCoDelQueueDiscFlowAttributes();
+    ~FqCoDelQueueDiscFlowAttributes() override;
+
+  private:
+    void DoRun() override;
+};
+
+FqCoDelQueueDiscFlowAttributes::FqCoDelQueueDiscFlowAttributes()
+    : TestCase("Test the attributes of the flow queues")
+{
+}
+
+FqCoDelQueueDiscFlowAttributes::~FqCoDelQueueDiscFlowAttributes()
+{
+}
+
+void
+FqCoDelQueueDiscFlowAttributes::DoRun()
+{
+    for (bool enabled : {false, true})
+    {
+        Time ceThreshold = enabled ? MilliSeconds(2) : MilliSeconds(3);
+        Ptr<FqCoDelQueueDisc> queueDisc =
+            CreateObjectWithAttributes<FqCoDelQueueDisc>("UseEcn",
+                                                         BooleanValue(enabled),
+                                                         "CeThreshold",
+                                                         TimeValue(ceThreshold),
+                                                         "UseL4s",
+                                                         BooleanValue(enabled));
+        queueDisc->SetQuantum(1500);
+        queueDisc->Initialize();
+
+        Ptr<Ipv4TestPacketFilter> filter = CreateObject<Ipv4TestPacketFilter>();
+        queueDisc->AddPacketFilter(filter);
+
+        AddFlowPacket(queueDisc, 0);
+        AddFlowPacket(queueDisc, 1);
+        NS_TEST_ASSERT_MSG_EQ(queueDisc->GetNQueueDiscClasses(),
+                              2,
+                              "unexpected number of flow queues");
+        for (std::size_t i = 0; i < queueDisc->GetNQueueDiscClasses(); i++)
+        {
+            Ptr<QueueDisc> qd = queueDisc->GetQueueDiscClass(i)->GetQueueDisc();
+            BooleanValue useEcn;
+            qd->GetAttribute("UseEcn", useEcn);
+            NS_TEST_EXPECT_MSG_EQ(useEcn.Get(), enabled, "unexpected UseEcn of flow queue " << i);
+            TimeValue ce;
+            qd->GetAttribute("CeThreshold", ce);
+            NS_TEST_EXPECT_MSG_EQ(ce.Get(),
+                                  ceThreshold,
+                                  "unexpected CeThreshold of flow queue " << i);
+            BooleanValue useL4s;
+            qd->GetAttribute("UseL4s", useL4s);
+            NS_TEST_EXPECT_MSG_EQ(useL4s.Get(), enabled, "unexpected UseL4s of flow queue " << i);
+        }
+        Simulator::Destroy();
+    }
+}
+
 /**
  * @ingroup system-tests-tc
  *
@@ -1767,6 +2110,10 @@ FqCoDelQueueDiscTestSuite::FqCoDelQueueDiscTestSuite()
     AddTestCase(new FqCoDelQueueDiscECNMarking, TestCase::Duration::QUICK);
     AddTestCase(new FqCoDelQueueDiscSetLinearProbing, TestCase::Duration::QUICK);
     AddTestCase(new FqCoDelQueueDiscL4sMode, TestCase::Duration::QUICK);
+    AddTestCase(new FqCoDelQueueDiscDrrOrder, TestCase::Duration::QUICK);
+    AddTestCase(new FqCoDelQueueDiscSetAssociativeCollision, TestCase::Duration::QUICK);
+    AddTestCase(new FqCoDelQueueDiscInactiveFlowReuse, TestCase::Duration::QUICK);
+    AddTestCase(new FqCoDelQueueDiscFlowAttributes, TestCase::Duration::QUICK);
 }
 
 /// Do not forget to allocate an instance of this TestSuite.
@@ -140,4 +140,10 @@ FifoQueueDisc::InitializeParams()
     NS_LOG_FUNCTION(this);
 }
 
+bool
+FifoQueueDisc::CanBypass() const
+{
+    return true;
+}
+
 } // namespace ns3
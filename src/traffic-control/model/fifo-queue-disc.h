@@ -47,6 +47,7 @@ class FifoQueueDisc : public QueueDisc
     Ptr<const QueueDiscItem> DoPeek() override;
     bool CheckConfig() override;
     void InitializeParams() override;
+    bool CanBypass() const override;
 };
 
 } // namespace ns3
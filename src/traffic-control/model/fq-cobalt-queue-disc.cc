@@ -214,36 +214,6 @@ FqCobaltQueueDisc::GetQuantum() const
     return m_quantum;
 }
 
-uint32_t
-FqCobaltQueueDisc::SetAssociativeHash(uint32_t flowHash)
-{
-    NS_LOG_FUNCTION(this << flowHash);
-
-    uint32_t h = (flowHash % m_flows);
-    uint32_t innerHash = h % m_setWays;
-    uint32_t outerHash = h - innerHash;
-
-    for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
-    {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCobaltFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCobaltFlow::INACTIVE)
-        {
-            // this queue has not been created yet or is associated with this flow
-            // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
-            return i;
-        }
-    }
-
-    // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
-    return outerHash;
-}
-
 bool
 FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 {
@@ -274,50 +244,32 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 
     if (m_enableSetAssociativeHash)
     {
-        h = SetAssociativeHash(flowHash);
+        h = m_flowTable.SetAssociativeHash(flowHash, m_setWays);
     }
     else
     {
         h = flowHash % m_flows;
     }
 
-    Ptr<FqCobaltFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    FqCobaltFlow* flow = m_flowTable.Get(h);
+    if (!flow)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
-        flow = m_flowFactory.Create<FqCobaltFlow>();
+        Ptr<FqCobaltFlow> newFlow = m_flowFactory.Create<FqCobaltFlow>();
         Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc>();
-        // If Cobalt, Set values of CobaltQueueDisc to match this QueueDisc
-        Ptr<CobaltQueueDisc> cobalt = qd->GetObject<CobaltQueueDisc>();
-        if (cobalt)
-        {
-            cobalt->SetAttribute("UseEcn", BooleanValue(m_useEcn));
-            cobalt->SetAttribute("CeThreshold", TimeValue(m_ceThreshold));
-            cobalt->SetAttribute("UseL4s", BooleanValue(m_useL4s));
-            cobalt->SetAttribute("BlueThreshold", TimeValue(m_blueThreshold));
-        }
         qd->Initialize();
-        flow->SetQueueDisc(qd);
-        flow->SetIndex(h);
-        AddQueueDiscClass(flow);
-
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
-    }
-    else
-    {
-        flow = StaticCast<FqCobaltFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        newFlow->SetQueueDisc(qd);
+        newFlow->SetIndex(h);
+        AddQueueDiscClass(newFlow);
+        m_flowTable.Set(newFlow);
+        flow = PeekPointer(newFlow);
     }
 
-    if (flow->GetStatus() == FqCobaltFlow::INACTIVE)
-    {
-        flow->SetStatus(FqCobaltFlow::NEW_FLOW);
-        flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
-    }
+    m_flowTable.Activate(flow, m_quantum);
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -333,72 +285,26 @@ FqCobaltQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqCobaltFlow> flow;
+    FqCobaltFlow* flow;
     Ptr<QueueDiscItem> item;
 
     do
     {
-        bool found = false;
+        flow = m_flowTable.Select(m_quantum);
 
-        while (!found && !m_newFlows.empty())
-        {
-            flow = m_newFlows.front();
-
-            if (flow->GetDeficit() <= 0)
-            {
-                NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
-            }
-            else
-            {
-                NS_LOG_DEBUG("Found a new flow " << flow->GetIndex() << " with positive deficit");
-                found = true;
-            }
-        }
-
-        while (!found && !m_oldFlows.empty())
-        {
-            flow = m_oldFlows.front();
-
-            if (flow->GetDeficit() <= 0)
-            {
-                NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
-            }
-            else
-            {
-                NS_LOG_DEBUG("Found an old flow " << flow->GetIndex() << " with positive deficit");
-                found = true;
-            }
-        }
-
-        if (!found)
+        if (!flow)
         {
             NS_LOG_DEBUG("No flow found to dequeue a packet");
             return nullptr;
         }
 
+        NS_LOG_DEBUG("Found a flow " << flow->GetIndex() << " with positive deficit");
         item = flow->GetQueueDisc()->Dequeue();
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
-            {
-                flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
-            }
-            else
-            {
-                flow->SetStatus(FqCobaltFlow::INACTIVE);
-                m_oldFlows.pop_front();
-            }
+            m_flowTable.SetEmpty(flow);
         }
         else
         {
@@ -475,11 +381,17 @@ FqCobaltQueueDisc::InitializeParams()
 
     m_queueDiscFactory.SetTypeId("ns3::CobaltQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
+    m_queueDiscFactory.Set("UseEcn", BooleanValue(m_useEcn));
+    m_queueDiscFactory.Set("CeThreshold", TimeValue(m_ceThreshold));
+    m_queueDiscFactory.Set("UseL4s", BooleanValue(m_useL4s));
+    m_queueDiscFactory.Set("BlueThreshold", TimeValue(m_blueThreshold));
     m_queueDiscFactory.Set("Interval", StringValue(m_interval));
     m_queueDiscFactory.Set("Target", StringValue(m_target));
     m_queueDiscFactory.Set("Pdrop", DoubleValue(m_Pdrop));
     m_queueDiscFactory.Set("Increment", DoubleValue(m_increment));
     m_queueDiscFactory.Set("Decrement", DoubleValue(m_decrement));
+
+    m_flowTable.Reset(m_flows);
 }
 
 uint32_t
@@ -16,13 +16,11 @@
 #ifndef FQ_COBALT_QUEUE_DISC
 #define FQ_COBALT_QUEUE_DISC
 
+#include "fq-flow-table.h"
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
-
 namespace ns3
 {
 
@@ -154,15 +152,6 @@ class FqCobaltQueueDisc : public QueueDisc
      */
     uint32_t FqCobaltDrop();
 
-    /**
-     * Compute the index of the queue for the flow having the given flowHash,
-     * according to the set associative hash approach.
-     *
-     * @param flowHash the hash of the flow 5-tuple
-     * @return the index of the queue for the given flow
-     */
-    uint32_t SetAssociativeHash(uint32_t flowHash);
-
     std::string m_interval;   //!< CoDel interval attribute
     std::string m_target;     //!< CoDel target attribute
     uint32_t m_quantum;       //!< Deficit assigned to flows at each round
@@ -179,11 +168,7 @@ class FqCobaltQueueDisc : public QueueDisc
     double m_Pdrop;       //!< Drop Probability
     Time m_blueThreshold; //!< Threshold to enable blue enhancement
 
-    std::list<Ptr<FqCobaltFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCobaltFlow>> m_oldFlows; //!< The list of old flows
-
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    FqFlowTable<FqCobaltFlow> m_flowTable; //!< The flow queues
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
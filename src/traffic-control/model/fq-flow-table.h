@@ -0,0 +1,238 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FQ_FLOW_TABLE_H
+#define FQ_FLOW_TABLE_H
+
+#include "ns3/assert.h"
+#include "ns3/ptr.h"
+
+#include <limits>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic-control
+ *
+ * @brief The flow queues of a flow queue scheduler (FqCoDel, FqPie, FqCobalt)
+ *
+ * The flow queues are stored in a flat table, indexed by the hash bucket
+ * of the flows, and the new and the old flows are scheduled through
+ * intrusive lists of table indices, so that classifying a packet and
+ * selecting the next flow to serve take constant time, without any memory
+ * allocation.
+ *
+ * The flow queues are still created lazily by the queue disc, and are also
+ * added to the queue disc as classes. A flow queue is kept as a class with a
+ * child CoDel, PIE or COBALT queue disc rather than as a plain slot, because
+ * the child queue disc runs the AQM algorithm of the flow, its trace sources
+ * feed the statistics of the parent queue disc (see
+ * QueueDisc::AddQueueDiscClass), and the fat flow drop reaches the packets
+ * through QueueDisc::GetQueueDiscClass. These objects are only created the
+ * first time a hash bucket is used, and are reused afterwards, including
+ * after the flow becomes inactive. The Flow type must provide the
+ * GetIndex, GetStatus, SetStatus, GetDeficit, SetDeficit and IncreaseDeficit
+ * methods, and the INACTIVE, NEW_FLOW and OLD_FLOW statuses.
+ */
+template <typename Flow>
+class FqFlowTable
+{
+  public:
+    /**
+     * @brief Remove all the flows, and set the size of the table
+     * @param flows the number of flow queues
+     */
+    void Reset(uint32_t flows)
+    {
+        m_flows.assign(flows, nullptr);
+        m_tags.assign(flows, 0);
+        m_next.assign(flows, NONE);
+        m_newFlows = FlowList();
+        m_oldFlows = FlowList();
+    }
+
+    /**
+     * @brief Get the flow queue of a hash bucket
+     * @param index the index of the hash bucket
+     * @return the flow queue, or nullptr if it has not been created yet
+     */
+    Flow* Get(uint32_t index) const
+    {
+        return PeekPointer(m_flows[index]);
+    }
+
+    /**
+     * @brief Set the flow queue of a hash bucket
+     * @param flow the flow queue, whose index is the index of the hash bucket
+     */
+    void Set(Ptr<Flow> flow)
+    {
+        NS_ASSERT(!m_flows[flow->GetIndex()]);
+        m_flows[flow->GetIndex()] = flow;
+    }
+
+    /**
+     * Compute the index of the queue for the flow having the given flowHash,
+     * according to the set associative hash approach.
+     *
+     * @param flowHash the hash of the flow 5-tuple
+     * @param setWays the size of a set of queues
+     * @return the index of the queue for the given flow
+     */
+    uint32_t SetAssociativeHash(uint32_t flowHash, uint32_t setWays)
+    {
+        uint32_t h = (flowHash % m_flows.size());
+        uint32_t innerHash = h % setWays;
+        uint32_t outerHash = h - innerHash;
+
+        for (uint32_t i = outerHash; i < outerHash + setWays; i++)
+        {
+            // the tag of a queue is set before the queue is created
+            if (!m_flows[i] || m_tags[i] == flowHash ||
+                m_flows[i]->GetStatus() == Flow::INACTIVE)
+            {
+                // this queue has not been created yet or is associated with this flow
+                // or is inactive, hence we can use it
+                m_tags[i] = flowHash;
+                return i;
+            }
+        }
+
+        // all the queues of the set are used. Use the first queue of the set
+        m_tags[outerHash] = flowHash;
+        return outerHash;
+    }
+
+    /**
+     * @brief Add an inactive flow at the end of the list of the new flows
+     * @param flow the flow queue
+     * @param quantum the initial deficit of the flow
+     */
+    void Activate(Flow* flow, uint32_t quantum)
+    {
+        if (flow->GetStatus() == Flow::INACTIVE)
+        {
+            flow->SetStatus(Flow::NEW_FLOW);
+            flow->SetDeficit(quantum);
+            PushBack(m_newFlows, flow->GetIndex());
+        }
+    }
+
+    /**
+     * @brief Select the flow to serve, according to the deficit round robin
+     * scheduler: the first new flow with a positive deficit, otherwise the
+     * first old flow with a positive deficit. The flows with no deficit left
+     * get a quantum and are moved to the end of the list of the old flows.
+     *
+     * @param quantum the deficit assigned to flows at each round
+     * @return the flow, or nullptr if there are no active flows
+     */
+    Flow* Select(uint32_t quantum)
+    {
+        while (m_newFlows.head != NONE)
+        {
+            Flow* flow = Get(m_newFlows.head);
+            if (flow->GetDeficit() > 0)
+            {
+                return flow;
+            }
+            flow->IncreaseDeficit(quantum);
+            flow->SetStatus(Flow::OLD_FLOW);
+            PushBack(m_oldFlows, PopFront(m_newFlows));
+        }
+
+        while (m_oldFlows.head != NONE)
+        {
+            Flow* flow = Get(m_oldFlows.head);
+            if (flow->GetDeficit() > 0)
+            {
+                return flow;
+            }
+            flow->IncreaseDeficit(quantum);
+            PushBack(m_oldFlows, PopFront(m_oldFlows));
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Handle a selected flow found empty: a new flow is moved to the end
+     * of the list of the old flows, while an old flow becomes inactive.
+     * @param flow the flow returned by the last call to Select
+     */
+    void SetEmpty(Flow* flow)
+    {
+        if (m_newFlows.head != NONE)
+        {
+            NS_ASSERT(m_newFlows.head == flow->GetIndex());
+            flow->SetStatus(Flow::OLD_FLOW);
+            PushBack(m_oldFlows, PopFront(m_newFlows));
+        }
+        else
+        {
+            NS_ASSERT(m_oldFlows.head == flow->GetIndex());
+            flow->SetStatus(Flow::INACTIVE);
+            PopFront(m_oldFlows);
+        }
+    }
+
+  private:
+    /// The end of a list
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /// A list of flows, linked through the m_next table
+    struct FlowList
+    {
+        uint32_t head{NONE}; //!< the index of the first flow
+        uint32_t tail{NONE}; //!< the index of the last flow
+    };
+
+    /**
+     * @brief Add a flow at the end of a list
+     * @param list the list
+     * @param index the index of the flow
+     */
+    void PushBack(FlowList& list, uint32_t index)
+    {
+        m_next[index] = NONE;
+        if (list.tail == NONE)
+        {
+            list.head = index;
+        }
+        else
+        {
+            m_next[list.tail] = index;
+        }
+        list.tail = index;
+    }
+
+    /**
+     * @brief Remove the first flow of a non-empty list
+     * @param list the list
+     * @return the index of the removed flow
+     */
+    uint32_t PopFront(FlowList& list)
+    {
+        uint32_t index = list.head;
+        list.head = m_next[index];
+        if (list.head == NONE)
+        {
+            list.tail = NONE;
+        }
+        return index;
+    }
+
+    std::vector<Ptr<Flow>> m_flows; //!< the flow queue of each hash bucket
+    std::vector<uint32_t> m_tags;   //!< the tags used by set associative hash
+    std::vector<uint32_t> m_next;   //!< the next flow of the list of each flow
+    FlowList m_newFlows;            //!< the list of new flows
+    FlowList m_oldFlows;            //!< the list of old flows
+};
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_TABLE_H */
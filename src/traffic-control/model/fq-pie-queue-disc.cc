@@ -243,36 +243,6 @@ FqPieQueueDisc::GetQuantum() const
     return m_quantum;
 }
 
-uint32_t
-FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
-{
-    NS_LOG_FUNCTION(this << flowHash);
-
-    uint32_t h = (flowHash % m_flows);
-    uint32_t innerHash = h % m_setWays;
-    uint32_t outerHash = h - innerHash;
-
-    for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
-    {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqPieFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqPieFlow::INACTIVE)
-        {
-            // this queue has not been created yet or is associated with this flow
-            // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
-            return i;
-        }
-    }
-
-    // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
-    return outerHash;
-}
-
 bool
 FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 {
@@ -303,49 +273,32 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
 
     if (m_enableSetAssociativeHash)
     {
-        h = SetAssociativeHash(flowHash);
+        h = m_flowTable.SetAssociativeHash(flowHash, m_setWays);
     }
     else
     {
         h = flowHash % m_flows;
     }
 
-    Ptr<FqPieFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    FqPieFlow* flow = m_flowTable.Get(h);
+    if (!flow)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
-        flow = m_flowFactory.Create<FqPieFlow>();
+        Ptr<FqPieFlow> newFlow = m_flowFactory.Create<FqPieFlow>();
         Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc>();
-        // If Pie, Set values of PieQueueDisc to match this QueueDisc
-        Ptr<PieQueueDisc> pie = qd->GetObject<PieQueueDisc>();
-        if (pie)
-        {
-            pie->SetAttribute("UseEcn", BooleanValue(m_useEcn));
-            pie->SetAttribute("CeThreshold", TimeValue(m_ceThreshold));
-            pie->SetAttribute("UseL4s", BooleanValue(m_useL4s));
-        }
         qd->Initialize();
-        flow->SetQueueDisc(qd);
-        flow->SetIndex(h);
-        AddQueueDiscClass(flow);
-
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
-    }
-    else
-    {
-        flow = StaticCast<FqPieFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        newFlow->SetQueueDisc(qd);
+        newFlow->SetIndex(h);
+        AddQueueDiscClass(newFlow);
+        m_flowTable.Set(newFlow);
+        flow = PeekPointer(newFlow);
     }
 
-    if (flow->GetStatus() == FqPieFlow::INACTIVE)
-    {
-        flow->SetStatus(FqPieFlow::NEW_FLOW);
-        flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
-    }
+    m_flowTable.Activate(flow, m_quantum);
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -361,72 +314,26 @@ FqPieQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqPieFlow> flow;
+    FqPieFlow* flow;
     Ptr<QueueDiscItem> item;
 
     do
     {
-        bool found = false;
+        flow = m_flowTable.Select(m_quantum);
 
-        while (!found && !m_newFlows.empty())
-        {
-            flow = m_newFlows.front();
-
-            if (flow->GetDeficit() <= 0)
-            {
-                NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
-            }
-            else
-            {
-                NS_LOG_DEBUG("Found a new flow " << flow->GetIndex() << " with positive deficit");
-                found = true;
-            }
-        }
-
-        while (!found && !m_oldFlows.empty())
-        {
-            flow = m_oldFlows.front();
-
-            if (flow->GetDeficit() <= 0)
-            {
-                NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
-                flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
-            }
-            else
-            {
-                NS_LOG_DEBUG("Found an old flow " << flow->GetIndex() << " with positive deficit");
-                found = true;
-            }
-        }
-
-        if (!found)
+        if (!flow)
         {
             NS_LOG_DEBUG("No flow found to dequeue a packet");
             return nullptr;
         }
 
+        NS_LOG_DEBUG("Found a flow " << flow->GetIndex() << " with positive deficit");
         item = flow->GetQueueDisc()->Dequeue();
 
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
-            {
-                flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
-            }
-            else
-            {
-                flow->SetStatus(FqPieFlow::INACTIVE);
-                m_oldFlows.pop_front();
-            }
+            m_flowTable.SetEmpty(flow);
         }
         else
         {
@@ -503,6 +410,9 @@ FqPieQueueDisc::InitializeParams()
 
     m_queueDiscFactory.SetTypeId("ns3::PieQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
+    m_queueDiscFactory.Set("UseEcn", BooleanValue(m_useEcn));
+    m_queueDiscFactory.Set("CeThreshold", TimeValue(m_ceThreshold));
+    m_queueDiscFactory.Set("UseL4s", BooleanValue(m_useL4s));
     m_queueDiscFactory.Set("MeanPktSize", UintegerValue(m_meanPktSize));
     m_queueDiscFactory.Set("A", DoubleValue(m_a));
     m_queueDiscFactory.Set("B", DoubleValue(m_b));
@@ -514,6 +424,8 @@ FqPieQueueDisc::InitializeParams()
     m_queueDiscFactory.Set("UseDequeueRateEstimator", BooleanValue(m_useDqRateEstimator));
     m_queueDiscFactory.Set("UseCapDropAdjustment", BooleanValue(m_isCapDropAdjustment));
     m_queueDiscFactory.Set("UseDerandomization", BooleanValue(m_useDerandomization));
+
+    m_flowTable.Reset(m_flows);
 }
 
 uint32_t
@@ -189,4 +189,10 @@ PfifoFastQueueDisc::InitializeParams()
     NS_LOG_FUNCTION(this);
 }
 
+bool
+PfifoFastQueueDisc::CanBypass() const
+{
+    return true;
+}
+
 } // namespace ns3
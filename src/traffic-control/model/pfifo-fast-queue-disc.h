@@ -68,6 +68,7 @@ class PfifoFastQueueDisc : public QueueDisc
     Ptr<const QueueDiscItem> DoPeek() override;
     bool CheckConfig() override;
     void InitializeParams() override;
+    bool CanBypass() const override;
 };
 
 } // namespace ns3
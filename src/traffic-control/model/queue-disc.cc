@@ -8,6 +8,7 @@
 #include "queue-disc.h"
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-vector.h"
@@ -246,6 +247,12 @@ QueueDisc::GetTypeId()
                           UintegerValue(DEFAULT_QUOTA),
                           MakeUintegerAccessor(&QueueDisc::SetQuota, &QueueDisc::GetQuota),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("EnableBypass",
+                          "Whether packets are sent directly to the device when the queue "
+                          "disc is empty and allows it",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&QueueDisc::m_enableBypass),
+                          MakeBooleanChecker())
             .AddAttribute("InternalQueueList",
                           "The list of internal queues.",
                           ObjectVectorValue(),
@@ -311,7 +318,9 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
       m_running(false),
       m_peeked(false),
       m_sizePolicy(policy),
-      m_prohibitChangeMode(false)
+      m_prohibitChangeMode(false),
+      m_enableBypass(true),
+      m_isolatedChildren(false)
 {
     NS_LOG_FUNCTION(this << (uint16_t)policy);
 
@@ -400,6 +409,17 @@ QueueDisc::DoInitialize()
 const QueueDisc::Stats&
 QueueDisc::GetStats()
 {
+    if (m_isolatedChildren)
+    {
+        // sum up the statistics kept by the child queue discs
+        m_stats = Stats();
+        for (const auto& cl : m_classes)
+        {
+            AddChildStats(cl->GetQueueDisc()->GetStats());
+        }
+        return m_stats;
+    }
+
     NS_ASSERT(m_stats.nTotalDroppedPackets ==
               m_stats.nTotalDroppedPacketsBeforeEnqueue + m_stats.nTotalDroppedPacketsAfterDequeue);
     NS_ASSERT(m_stats.nTotalDroppedBytes ==
@@ -417,10 +437,71 @@ QueueDisc::GetStats()
     return m_stats;
 }
 
+void
+QueueDisc::AddChildStats(const Stats& childStats)
+{
+    NS_LOG_FUNCTION(this);
+
+    m_stats.nTotalReceivedPackets += childStats.nTotalReceivedPackets;
+    m_stats.nTotalReceivedBytes += childStats.nTotalReceivedBytes;
+    m_stats.nTotalSentPackets += childStats.nTotalSentPackets;
+    m_stats.nTotalSentBytes += childStats.nTotalSentBytes;
+    m_stats.nTotalEnqueuedPackets += childStats.nTotalEnqueuedPackets;
+    m_stats.nTotalEnqueuedBytes += childStats.nTotalEnqueuedBytes;
+    m_stats.nTotalDequeuedPackets += childStats.nTotalDequeuedPackets;
+    m_stats.nTotalDequeuedBytes += childStats.nTotalDequeuedBytes;
+    m_stats.nTotalDroppedPackets += childStats.nTotalDroppedPackets;
+    m_stats.nTotalDroppedPacketsBeforeEnqueue += childStats.nTotalDroppedPacketsBeforeEnqueue;
+    m_stats.nTotalDroppedPacketsAfterDequeue += childStats.nTotalDroppedPacketsAfterDequeue;
+    m_stats.nTotalDroppedBytes += childStats.nTotalDroppedBytes;
+    m_stats.nTotalDroppedBytesBeforeEnqueue += childStats.nTotalDroppedBytesBeforeEnqueue;
+    m_stats.nTotalDroppedBytesAfterDequeue += childStats.nTotalDroppedBytesAfterDequeue;
+    m_stats.nTotalRequeuedPackets += childStats.nTotalRequeuedPackets;
+    m_stats.nTotalRequeuedBytes += childStats.nTotalRequeuedBytes;
+    m_stats.nTotalMarkedPackets += childStats.nTotalMarkedPackets;
+    m_stats.nTotalMarkedBytes += childStats.nTotalMarkedBytes;
+
+    // the reasons are those a parent queue disc reports for its children
+    for (const auto& [reason, n] : childStats.nDroppedPacketsBeforeEnqueue)
+    {
+        m_stats.nDroppedPacketsBeforeEnqueue[CHILD_QUEUE_DISC_DROP + reason] += n;
+    }
+    for (const auto& [reason, n] : childStats.nDroppedPacketsAfterDequeue)
+    {
+        m_stats.nDroppedPacketsAfterDequeue[CHILD_QUEUE_DISC_DROP + reason] += n;
+    }
+    for (const auto& [reason, n] : childStats.nDroppedBytesBeforeEnqueue)
+    {
+        m_stats.nDroppedBytesBeforeEnqueue[CHILD_QUEUE_DISC_DROP + reason] += n;
+    }
+    for (const auto& [reason, n] : childStats.nDroppedBytesAfterDequeue)
+    {
+        m_stats.nDroppedBytesAfterDequeue[CHILD_QUEUE_DISC_DROP + reason] += n;
+    }
+    for (const auto& [reason, n] : childStats.nMarkedPackets)
+    {
+        m_stats.nMarkedPackets[CHILD_QUEUE_DISC_MARK + reason] += n;
+    }
+    for (const auto& [reason, n] : childStats.nMarkedBytes)
+    {
+        m_stats.nMarkedBytes[CHILD_QUEUE_DISC_MARK + reason] += n;
+    }
+}
+
 uint32_t
 QueueDisc::GetNPackets() const
 {
     NS_LOG_FUNCTION(this);
+
+    if (m_isolatedChildren)
+    {
+        uint32_t nPackets = 0;
+        for (const auto& cl : m_classes)
+        {
+            nPackets += cl->GetQueueDisc()->GetNPackets();
+        }
+        return nPackets;
+    }
     return m_nPackets;
 }
 
@@ -428,6 +509,16 @@ uint32_t
 QueueDisc::GetNBytes() const
 {
     NS_LOG_FUNCTION(this);
+
+    if (m_isolatedChildren)
+    {
+        uint32_t nBytes = 0;
+        for (const auto& cl : m_classes)
+        {
+            nBytes += cl->GetQueueDisc()->GetNBytes();
+        }
+        return nBytes;
+    }
     return m_nBytes;
 }
 
@@ -507,11 +598,11 @@ QueueDisc::GetCurrentSize() const
 
     if (GetMaxSize().GetUnit() == QueueSizeUnit::PACKETS)
     {
-        return QueueSize(QueueSizeUnit::PACKETS, m_nPackets);
+        return QueueSize(QueueSizeUnit::PACKETS, GetNPackets());
     }
     if (GetMaxSize().GetUnit() == QueueSizeUnit::BYTES)
     {
-        return QueueSize(QueueSizeUnit::BYTES, m_nBytes);
+        return QueueSize(QueueSizeUnit::BYTES, GetNBytes());
     }
     NS_ABORT_MSG("Unknown queue size unit");
 }
@@ -619,6 +710,50 @@ QueueDisc::AddQueueDiscClass(Ptr<QueueDiscClass> qdClass)
     NS_ABORT_MSG_IF(qdClass->GetQueueDisc()->GetWakeMode() == WAKE_CHILD,
                     "A queue disc with WAKE_CHILD as wake mode can only be a root queue disc");
 
+    if (GetWakeMode() == WAKE_CHILD)
+    {
+        // the child queue discs of a queue disc with wake mode equal to WAKE_CHILD
+        // are attached to distinct device transmission queues and run independently
+        // of each other, hence they must not update the state of this queue disc.
+        // Their statistics are summed up by GetStats and only the packets they drop
+        // or mark are forwarded to the trace sources of this queue disc
+        m_isolatedChildren = true;
+        qdClass->GetQueueDisc()->TraceConnectWithoutContext(
+            "DropBeforeEnqueue",
+            Callback<void, Ptr<const QueueDiscItem>, const char*>(
+                [this](Ptr<const QueueDiscItem> item, const char* r) {
+                    m_traceDrop(item);
+                    if (!m_traceDropBeforeEnqueue.IsEmpty())
+                    {
+                        std::string reason(CHILD_QUEUE_DISC_DROP);
+                        m_traceDropBeforeEnqueue(item, reason.append(r).data());
+                    }
+                }));
+        qdClass->GetQueueDisc()->TraceConnectWithoutContext(
+            "DropAfterDequeue",
+            Callback<void, Ptr<const QueueDiscItem>, const char*>(
+                [this](Ptr<const QueueDiscItem> item, const char* r) {
+                    m_traceDrop(item);
+                    if (!m_traceDropAfterDequeue.IsEmpty())
+                    {
+                        std::string reason(CHILD_QUEUE_DISC_DROP);
+                        m_traceDropAfterDequeue(item, reason.append(r).data());
+                    }
+                }));
+        qdClass->GetQueueDisc()->TraceConnectWithoutContext(
+            "Mark",
+            Callback<void, Ptr<const QueueDiscItem>, const char*>(
+                [this](Ptr<const QueueDiscItem> item, const char* r) {
+                    if (!m_traceMark.IsEmpty())
+                    {
+                        std::string reason(CHILD_QUEUE_DISC_MARK);
+                        m_traceMark(item, reason.append(r).data());
+                    }
+                }));
+        m_classes.push_back(qdClass);
+        return;
+    }
+
     // set the parent callbacks on the child queue disc, so that it can notify
     // the parent queue disc of packets enqueued, dequeued, dropped, or marked
     qdClass->GetQueueDisc()->TraceConnectWithoutContext(
@@ -951,6 +1086,48 @@ QueueDisc::Run()
     }
 }
 
+bool
+QueueDisc::Bypass(Ptr<QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << item);
+
+    // the classes and child queue discs would not see the packet, hence a queue
+    // disc with classes is never bypassed
+    if (!m_enableBypass || m_running || GetNPackets() > 0 || m_requeued || !m_classes.empty() ||
+        !CanBypass() ||
+        (m_sizePolicy != QueueDiscSizePolicy::NO_LIMITS &&
+         GetCurrentSize() + item > GetMaxSize()) ||
+        (m_devQueueIface && m_devQueueIface->GetTxQueue(item->GetTxQueueIndex())->IsStopped()) ||
+        !m_traceEnqueue.IsEmpty() || !m_traceDequeue.IsEmpty() || !m_sojourn.IsEmpty() ||
+        !m_nPackets.IsEmpty() || !m_nBytes.IsEmpty())
+    {
+        return false;
+    }
+
+    NS_LOG_LOGIC("Bypass the empty queue disc");
+
+    // the packet goes through the queue disc with a null sojourn time
+    m_stats.nTotalReceivedPackets++;
+    m_stats.nTotalReceivedBytes += item->GetSize();
+    m_stats.nTotalEnqueuedPackets++;
+    m_stats.nTotalEnqueuedBytes += item->GetSize();
+    m_stats.nTotalDequeuedPackets++;
+    m_stats.nTotalDequeuedBytes += item->GetSize();
+    item->SetTimeStamp(Simulator::Now());
+
+    RunBegin();
+    item->AddHeader();
+    Transmit(item);
+    RunEnd();
+    return true;
+}
+
+bool
+QueueDisc::CanBypass() const
+{
+    return false;
+}
+
 bool
 QueueDisc::RunBegin()
 {
@@ -287,7 +287,8 @@ class QueueDisc : public Object
      * @brief Get the number of packets stored by the queue disc
      * @return the number of packets stored by the queue disc.
      *
-     * The requeued packet, if any, is counted.
+     * The requeued packet, if any, is counted. The packets stored by a queue disc
+     * with wake mode equal to WAKE_CHILD are those stored by its child queue discs.
      */
     uint32_t GetNPackets() const;
 
@@ -295,7 +296,8 @@ class QueueDisc : public Object
      * @brief Get the amount of bytes stored by the queue disc
      * @return the amount of bytes stored by the queue disc.
      *
-     * The requeued packet, if any, is counted.
+     * The requeued packet, if any, is counted. The bytes stored by a queue disc
+     * with wake mode equal to WAKE_CHILD are those stored by its child queue discs.
      */
     uint32_t GetNBytes() const;
 
@@ -328,6 +330,10 @@ class QueueDisc : public Object
 
     /**
      * @brief Retrieve all the collected statistics.
+     *
+     * The statistics of a queue disc with wake mode equal to WAKE_CHILD are the
+     * sum of the statistics of its child queue discs.
+     *
      * @return the collected statistics.
      */
     const Stats& GetStats();
@@ -413,6 +419,23 @@ class QueueDisc : public Object
      */
     void Run();
 
+    /**
+     * Modelled after the bypass of the queue disc in the Linux function
+     * __dev_xmit_skb (net/core/dev.c). If the queue disc is empty and idle, the
+     * device queue the packet is destined to is not stopped and the queue disc
+     * allows it (see CanBypass), the packet is sent directly to the device,
+     * without being enqueued in and dequeued from the queue disc. The packet is
+     * nevertheless accounted in the statistics as received, enqueued and
+     * dequeued, but not in the statistics of the internal queues. The bypass is
+     * not used if the queue disc has classes, or if a sink is connected to the
+     * Enqueue, Dequeue, SojournTime, PacketsInQueue or BytesInQueue trace
+     * sources, so that traces are not affected.
+     * @param item the packet to send
+     * @return true if the packet was sent to the device, false if it has to be
+     * enqueued in the queue disc
+     */
+    bool Bypass(Ptr<QueueDiscItem> item);
+
     /// Internal queues store QueueDiscItem objects
     typedef Queue<QueueDiscItem> InternalQueue;
 
@@ -617,6 +640,15 @@ class QueueDisc : public Object
      */
     virtual void InitializeParams() = 0;
 
+    /**
+     * Check whether a packet can bypass this queue disc when it is empty, i.e.,
+     * whether this queue disc, when empty, accepts any packet that does not
+     * exceed its maximum size and dequeues it right away. The default
+     * implementation returns false.
+     * @return true if a packet can bypass this queue disc when it is empty
+     */
+    virtual bool CanBypass() const;
+
     /**
      * Modelled after the Linux function qdisc_run_begin (include/net/sch_generic.h).
      * @return false if the qdisc is already running; otherwise, set the qdisc as running and return
@@ -673,6 +705,13 @@ class QueueDisc : public Object
      */
     void PacketDequeued(Ptr<const QueueDiscItem> item);
 
+    /**
+     * @brief Add the statistics of a child queue disc to the statistics of this
+     *        queue disc
+     * @param childStats the statistics of the child queue disc
+     */
+    void AddChildStats(const Stats& childStats);
+
     /// Default quota (as in /proc/sys/net/core/dev_weight)
     static const uint32_t DEFAULT_QUOTA = 64;
 
@@ -696,6 +735,8 @@ class QueueDisc : public Object
     std::string m_childQueueDiscMarkMsg; //!< Reason why a packet was marked by a child queue disc
     QueueDiscSizePolicy m_sizePolicy;    //!< The queue disc size policy
     bool m_prohibitChangeMode;           //!< True if changing mode is prohibited
+    bool m_enableBypass; //!< True if packets can bypass the queue disc when it is empty
+    bool m_isolatedChildren; //!< True if the child queue discs do not update this queue disc
 
     /// Traced callback: fired when a packet is enqueued
     TracedCallback<Ptr<const QueueDiscItem>> m_traceEnqueue;
@@ -353,12 +353,12 @@ TrafficControlLayer::Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
 
     NS_LOG_DEBUG("Send packet to device " << device << " protocol number " << item->GetProtocol());
 
-    Ptr<NetDeviceQueueInterface> devQueueIface;
+    NetDeviceQueueInterface* devQueueIface = nullptr;
     auto ndi = m_netDevices.find(device);
 
     if (ndi != m_netDevices.end())
     {
-        devQueueIface = ndi->second.m_ndqi;
+        devQueueIface = PeekPointer(ndi->second.m_ndqi);
     }
 
     // determine the transmission queue of the device where the packet will be enqueued
@@ -402,10 +402,13 @@ TrafficControlLayer::Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
         // selected for the packet and try to dequeue packets from such queue disc
         item->SetTxQueueIndex(txq);
 
-        Ptr<QueueDisc> qDisc = ndi->second.m_queueDiscsToWake[txq];
+        const Ptr<QueueDisc>& qDisc = ndi->second.m_queueDiscsToWake[txq];
         NS_ASSERT(qDisc);
-        qDisc->Enqueue(item);
-        qDisc->Run();
+        if (!qDisc->Bypass(item))
+        {
+            qDisc->Enqueue(item);
+            qDisc->Run();
+        }
     }
 }
 
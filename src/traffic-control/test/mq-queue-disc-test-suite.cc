@@ -0,0 +1,169 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/mq-queue-disc.h"
+#include "ns3/object-factory.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <string>
+
+using namespace ns3;
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Mq Queue Disc Test Item
+ */
+class MqQueueDiscTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param p the packet
+     */
+    MqQueueDiscTestItem(Ptr<Packet> p);
+    ~MqQueueDiscTestItem() override;
+
+    // Delete default constructor, copy constructor and assignment operator to avoid misuse
+    MqQueueDiscTestItem() = delete;
+    MqQueueDiscTestItem(const MqQueueDiscTestItem&) = delete;
+    MqQueueDiscTestItem& operator=(const MqQueueDiscTestItem&) = delete;
+
+    void AddHeader() override;
+    bool Mark() override;
+};
+
+MqQueueDiscTestItem::MqQueueDiscTestItem(Ptr<Packet> p)
+    : QueueDiscItem(p, Mac48Address(), 0)
+{
+}
+
+MqQueueDiscTestItem::~MqQueueDiscTestItem()
+{
+}
+
+void
+MqQueueDiscTestItem::AddHeader()
+{
+}
+
+bool
+MqQueueDiscTestItem::Mark()
+{
+    return false;
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Mq Queue Disc Statistics Test Case
+ *
+ * Check that the statistics of an mq queue disc are the sum of the statistics
+ * kept by its child queue discs, and that the packets dropped by the child queue
+ * discs are reported by the trace sources of the mq queue disc.
+ */
+class MqQueueDiscStatsTestCase : public TestCase
+{
+  public:
+    MqQueueDiscStatsTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Sink connected to the DropBeforeEnqueue trace of the mq queue disc
+     * @param item the dropped item
+     * @param reason the reason why the item was dropped
+     */
+    void DropBeforeEnqueueSink(Ptr<const QueueDiscItem> item, const char* reason);
+    uint32_t m_nDropped;  //!< the number of packets notified by the DropBeforeEnqueue trace
+    std::string m_reason; //!< the reason notified by the DropBeforeEnqueue trace
+};
+
+MqQueueDiscStatsTestCase::MqQueueDiscStatsTestCase()
+    : TestCase("Check the statistics of an mq queue disc"),
+      m_nDropped(0)
+{
+}
+
+void
+MqQueueDiscStatsTestCase::DropBeforeEnqueueSink(Ptr<const QueueDiscItem> item, const char* reason)
+{
+    m_nDropped++;
+    m_reason = reason;
+}
+
+void
+MqQueueDiscStatsTestCase::DoRun()
+{
+    Ptr<MqQueueDisc> mq = CreateObject<MqQueueDisc>();
+    ObjectFactory factory("ns3::FifoQueueDisc", "MaxSize", StringValue("2p"));
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<QueueDiscClass> c = CreateObject<QueueDiscClass>();
+        c->SetQueueDisc(factory.Create<QueueDisc>());
+        mq->AddQueueDiscClass(c);
+    }
+    mq->TraceConnectWithoutContext(
+        "DropBeforeEnqueue",
+        MakeCallback(&MqQueueDiscStatsTestCase::DropBeforeEnqueueSink, this));
+    mq->Initialize();
+
+    Ptr<QueueDisc> child0 = mq->GetQueueDiscClass(0)->GetQueueDisc();
+    Ptr<QueueDisc> child1 = mq->GetQueueDiscClass(1)->GetQueueDisc();
+
+    // the second child queue disc drops the third packet
+    child0->Enqueue(Create<MqQueueDiscTestItem>(Create<Packet>(100)));
+    child1->Enqueue(Create<MqQueueDiscTestItem>(Create<Packet>(200)));
+    child1->Enqueue(Create<MqQueueDiscTestItem>(Create<Packet>(200)));
+    child1->Enqueue(Create<MqQueueDiscTestItem>(Create<Packet>(200)));
+    child0->Dequeue();
+
+    NS_TEST_EXPECT_MSG_EQ(mq->GetNPackets(), 2, "There must be 2 packets in the mq queue disc");
+    NS_TEST_EXPECT_MSG_EQ(mq->GetNBytes(), 400, "There must be 400 bytes in the mq queue disc");
+
+    QueueDisc::Stats st = mq->GetStats();
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalReceivedPackets, 4, "Unexpected number of received packets");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalReceivedBytes, 700, "Unexpected number of received bytes");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalEnqueuedPackets, 3, "Unexpected number of enqueued packets");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalDequeuedPackets, 1, "Unexpected number of dequeued packets");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalDequeuedBytes, 100, "Unexpected number of dequeued bytes");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalDroppedPackets, 1, "Unexpected number of dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalDroppedBytes, 200, "Unexpected number of dropped bytes");
+
+    std::string reason = std::string(QueueDisc::CHILD_QUEUE_DISC_DROP) +
+                         FifoQueueDisc::LIMIT_EXCEEDED_DROP;
+    NS_TEST_EXPECT_MSG_EQ(st.GetNDroppedPackets(reason),
+                          1,
+                          "The drop must be reported as a drop by a child queue disc");
+    NS_TEST_EXPECT_MSG_EQ(m_nDropped, 1, "The drop must be notified by the mq queue disc");
+    NS_TEST_EXPECT_MSG_EQ(m_reason, reason, "Unexpected drop reason");
+
+    // the child queue discs keep their own statistics
+    NS_TEST_EXPECT_MSG_EQ(child1->GetStats().nTotalReceivedPackets,
+                          3,
+                          "Unexpected number of packets received by the second child");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Mq Queue Disc Test Suite
+ */
+static class MqQueueDiscTestSuite : public TestSuite
+{
+  public:
+    MqQueueDiscTestSuite()
+        : TestSuite("mq-queue-disc", Type::UNIT)
+    {
+        AddTestCase(new MqQueueDiscStatsTestCase(), TestCase::Duration::QUICK);
+    }
+} g_mqQueueDiscTestSuite; ///< the test suite
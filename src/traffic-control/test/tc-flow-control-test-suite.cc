@@ -7,6 +7,7 @@
  *
  */
 
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/data-rate.h"
 #include "ns3/double.h"
@@ -481,6 +482,137 @@ TcFlowControlTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Traffic Control Queue Disc Bypass Test Case
+ */
+class TcBypassTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param queueDiscType the type of the root queue disc
+     * @param enableBypass whether the queue disc bypass is enabled
+     * @param connectTrace whether a sink is connected to the Enqueue trace of the queue disc
+     */
+    TcBypassTestCase(std::string queueDiscType, bool enableBypass, bool connectTrace);
+
+  private:
+    void DoRun() override;
+    /**
+     * Instruct a node to send a specified number of packets
+     * @param n the node
+     * @param nPackets the number of packets to send
+     */
+    void SendPackets(Ptr<Node> n, uint16_t nPackets);
+    /**
+     * Sink connected to the Enqueue trace of the queue disc
+     * @param item the enqueued item
+     */
+    void EnqueueSink(Ptr<const QueueDiscItem> item);
+    std::string m_queueDiscType; //!< the type of the root queue disc
+    bool m_enableBypass;         //!< whether the queue disc bypass is enabled
+    bool m_connectTrace;         //!< whether a sink is connected to the Enqueue trace
+    uint32_t m_nEnqueued;        //!< the number of packets notified by the Enqueue trace
+};
+
+TcBypassTestCase::TcBypassTestCase(std::string queueDiscType, bool enableBypass, bool connectTrace)
+    : TestCase("Test the bypass of an empty " + queueDiscType),
+      m_queueDiscType(queueDiscType),
+      m_enableBypass(enableBypass),
+      m_connectTrace(connectTrace),
+      m_nEnqueued(0)
+{
+}
+
+void
+TcBypassTestCase::SendPackets(Ptr<Node> n, uint16_t nPackets)
+{
+    Ptr<TrafficControlLayer> tc = n->GetObject<TrafficControlLayer>();
+    for (uint16_t i = 0; i < nPackets; i++)
+    {
+        tc->Send(n->GetDevice(0), Create<QueueDiscTestItem>(Create<Packet>(1000)));
+    }
+}
+
+void
+TcBypassTestCase::EnqueueSink(Ptr<const QueueDiscItem> item)
+{
+    m_nEnqueued++;
+}
+
+void
+TcBypassTestCase::DoRun()
+{
+    NodeContainer n;
+    n.Create(2);
+
+    n.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+    n.Get(1)->AggregateObject(CreateObject<TrafficControlLayer>());
+
+    SimpleNetDeviceHelper simple;
+
+    NetDeviceContainer rxDevC = simple.Install(n.Get(1));
+
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mb/s")));
+    simple.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("3p"));
+
+    Ptr<NetDevice> txDev;
+    txDev =
+        simple.Install(n.Get(0), DynamicCast<SimpleChannel>(rxDevC.Get(0)->GetChannel())).Get(0);
+    txDev->SetMtu(2500);
+
+    TrafficControlHelper tch;
+    tch.SetRootQueueDisc(m_queueDiscType, "EnableBypass", BooleanValue(m_enableBypass));
+    Ptr<QueueDisc> qdisc = tch.Install(txDev).Get(0);
+
+    if (m_connectTrace)
+    {
+        qdisc->TraceConnectWithoutContext("Enqueue",
+                                          MakeCallback(&TcBypassTestCase::EnqueueSink, this));
+    }
+
+    // transmit 10 packets at time 0: the packets that find the queue disc empty and
+    // the device queue not stopped (i.e., the packet being transmitted and the 3 packets
+    // stored in the device queue) can bypass the queue disc
+    Simulator::Schedule(Seconds(0), &TcBypassTestCase::SendPackets, this, n.Get(0), 10);
+
+    Simulator::Run();
+
+    QueueDisc::Stats st = qdisc->GetStats();
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalReceivedPackets, 10, "Unexpected number of received packets");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalEnqueuedPackets, 10, "Unexpected number of enqueued packets");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalDequeuedPackets, 10, "Unexpected number of dequeued packets");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalDroppedPackets, 0, "Unexpected number of dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalReceivedBytes, 10000, "Unexpected number of received bytes");
+    NS_TEST_EXPECT_MSG_EQ(st.nTotalDequeuedBytes, 10000, "Unexpected number of dequeued bytes");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->GetNPackets(), 0, "The queue disc must be empty");
+
+    if (qdisc->GetNQueueDiscClasses() > 0)
+    {
+        // a queue disc with classes is never bypassed, hence its classes see all the packets
+        Ptr<QueueDisc> child = qdisc->GetQueueDiscClass(0)->GetQueueDisc();
+        NS_TEST_EXPECT_MSG_EQ(child->GetStats().nTotalReceivedPackets,
+                              10,
+                              "Unexpected number of packets received by the class");
+    }
+    else
+    {
+        uint32_t expected = (m_enableBypass && !m_connectTrace ? 6 : 10);
+        NS_TEST_EXPECT_MSG_EQ(qdisc->GetInternalQueue(0)->GetTotalReceivedPackets(),
+                              expected,
+                              "Unexpected number of packets stored in the internal queue");
+    }
+    if (m_connectTrace)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nEnqueued, 10, "All the packets must be traced");
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup traffic-control-test
  *
@@ -515,5 +647,14 @@ static class TcFlowControlTestSuite : public TestSuite
         // also be made parametric.
         AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10),
                     TestCase::Duration::QUICK);
+
+        AddTestCase(new TcBypassTestCase("ns3::FifoQueueDisc", true, false),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcBypassTestCase("ns3::FifoQueueDisc", false, false),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcBypassTestCase("ns3::FifoQueueDisc", true, true),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcBypassTestCase("ns3::FqCoDelQueueDisc", true, false),
+                    TestCase::Duration::QUICK);
     }
 } g_tcFlowControlTestSuite; ///< the test suite
@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program converts a text fading trace of TraceFadingLossModel to the
+// binary format, which the model maps in memory instead of parsing it.
+// Sample usage:
+//   ./ns3 run 'convert-fading-trace --input=fading_trace_EPA_3kmph.fad
+//              --output=fading_trace_EPA_3kmph.bin'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/trace-fading-loss-model.h"
+
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+    uint32_t rbNum = 100;
+    uint32_t samplesNum = 10000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("input", "The text fading trace", input);
+    cmd.AddValue("output", "The binary fading trace to write", output);
+    cmd.AddValue("rbNum", "The number of RBs of the trace", rbNum);
+    cmd.AddValue("samplesNum", "The number of samples per RB of the trace", samplesNum);
+    cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(input.empty() || output.empty(), "Both --input and --output are needed");
+    TraceFadingLossModel::ConvertTrace(input, output, rbNum, samplesNum);
+    return 0;
+}